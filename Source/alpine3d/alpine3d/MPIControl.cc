@@ -18,6 +18,12 @@
 #include <alpine3d/MPIControl.h>
 #include <alpine3d/SnowpackInterfaceWorker.h>
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
+
 #if (defined _WIN32 || defined __MINGW32__) && ! defined __CYGWIN__
 	#include <winsock.h>
 #else
@@ -92,6 +98,11 @@ std::string MPIControl::name() const
 	return name_;
 }
 
+bool MPIControl::threads_allowed() const
+{
+	return threads_allowed_;
+}
+
 bool MPIControl::master() const
 {
 	return (rank_ == 0); //HACK: this assumes the master is always 0
@@ -100,7 +111,10 @@ bool MPIControl::master() const
 #ifdef ENABLE_MPI
 MPIControl::MPIControl()
 {
-	MPI_Init(NULL, NULL);
+	//only the main thread performs MPI calls (MeteoObj may read the meteo data in a background thread)
+	int thread_support;
+	MPI_Init_thread(NULL, NULL, MPI_THREAD_FUNNELED, &thread_support);
+	threads_allowed_ = (thread_support>=MPI_THREAD_FUNNELED);
 
 	#ifdef ENABLE_PETSC
 	PetscInitialize(NULL, NULL, NULL, NULL);
@@ -142,43 +156,44 @@ void MPIControl::checkSuccess(const int& ierr)
 	}
 }
 
+//Messages are transmitted as a 64 bits length followed by the payload, split in chunks that fit MPI's int counts
+static const size_t max_chunk_len = static_cast<size_t>( std::numeric_limits<int>::max() );
+
 void MPIControl::broadcast(std::string& message, const size_t& root)
 {
-	int ierr;
-	unsigned int msg_len = (unsigned int) message.size();
+	unsigned long long msg_len = static_cast<unsigned long long>( message.size() );
 
 	//Now broadcast the size of the object and then the object itself
-	ierr = MPI_Bcast(&msg_len, 1, MPI_UNSIGNED, root, MPI_COMM_WORLD);
-	checkSuccess(ierr);
+	checkSuccess( MPI_Bcast(&msg_len, 1, MPI_UNSIGNED_LONG_LONG, static_cast<int>(root), MPI_COMM_WORLD) );
 
-	if (rank_ != root) message.resize(msg_len);
-	ierr = MPI_Bcast(const_cast<char*>(message.c_str()), msg_len, MPI_CHAR, root, MPI_COMM_WORLD);
-	checkSuccess(ierr);
+	if (rank_ != root) message.resize( static_cast<size_t>(msg_len) );
+	for (size_t offset=0; offset<message.size(); offset+=max_chunk_len) {
+		const int chunk_len = static_cast<int>( std::min(max_chunk_len, message.size()-offset) );
+		checkSuccess( MPI_Bcast(&message[offset], chunk_len, MPI_CHAR, static_cast<int>(root), MPI_COMM_WORLD) );
+	}
 }
 
 void MPIControl::send(std::string& message, const size_t& recipient, const int& tag)
 {
-	int ierr;
-	unsigned int msg_len = (unsigned int) message.size();
-
-	ierr = MPI_Send(&msg_len, 1, MPI_UNSIGNED, static_cast<int>(recipient), tag, MPI_COMM_WORLD);
-	checkSuccess(ierr);
+	unsigned long long msg_len = static_cast<unsigned long long>( message.size() );
+	checkSuccess( MPI_Send(&msg_len, 1, MPI_UNSIGNED_LONG_LONG, static_cast<int>(recipient), tag, MPI_COMM_WORLD) );
 
-	ierr = MPI_Send(const_cast<char*>(message.c_str()), msg_len, MPI_CHAR, static_cast<int>(recipient), tag, MPI_COMM_WORLD);
-	checkSuccess(ierr);
+	for (size_t offset=0; offset<message.size(); offset+=max_chunk_len) {
+		const int chunk_len = static_cast<int>( std::min(max_chunk_len, message.size()-offset) );
+		checkSuccess( MPI_Send(&message[offset], chunk_len, MPI_CHAR, static_cast<int>(recipient), tag, MPI_COMM_WORLD) );
+	}
 }
 
 void MPIControl::receive(std::string& message, const size_t& source, const int& tag)
 {
-	int ierr;
-	unsigned int msg_len;
-
-	ierr = MPI_Recv(&msg_len, 1, MPI_UNSIGNED, static_cast<int>(source), tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-	checkSuccess(ierr);
+	unsigned long long msg_len;
+	checkSuccess( MPI_Recv(&msg_len, 1, MPI_UNSIGNED_LONG_LONG, static_cast<int>(source), tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE) );
 
-	message.resize(msg_len);
-	ierr = MPI_Recv(const_cast<char*>(message.c_str()), msg_len, MPI_CHAR, static_cast<int>(source), tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-	checkSuccess(ierr);
+	message.resize( static_cast<size_t>(msg_len) );
+	for (size_t offset=0; offset<message.size(); offset+=max_chunk_len) {
+		const int chunk_len = static_cast<int>( std::min(max_chunk_len, message.size()-offset) );
+		checkSuccess( MPI_Recv(&message[offset], chunk_len, MPI_CHAR, static_cast<int>(source), tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE) );
+	}
 }
 
 void MPIControl::send(const int& value, const size_t& recipient, const int& tag)
@@ -237,6 +252,150 @@ void MPIControl::barrier() const
 	MPI_Barrier(MPI_COMM_WORLD);
 }
 
+//Same as Array2D::operator+= when keep_nodata is set: nodata on any process remains nodata
+static void op_sum_nodata(void* in, void* inout, int* len, MPI_Datatype* /*datatype*/)
+{
+	const double* in_cells = static_cast<const double*>(in);
+	double* out_cells = static_cast<double*>(inout);
+
+	for (int ii=0; ii<*len; ii++) {
+		if (in_cells[ii]==IOUtils::nodata || out_cells[ii]==IOUtils::nodata)
+			out_cells[ii] = IOUtils::nodata;
+		else
+			out_cells[ii] += in_cells[ii];
+	}
+}
+
+void MPIControl::allreduce_sum(double* data, const size_t& nr_cells, const bool& keep_nodata)
+{
+	if (size_ <= 1 || nr_cells == 0) return;
+
+	MPI_Op op = MPI_SUM;
+	if (keep_nodata) MPI_Op_create(op_sum_nodata, true, &op);
+
+	for (size_t offset=0; offset<nr_cells; offset+=max_chunk_len) {
+		const int chunk_len = static_cast<int>( std::min(max_chunk_len, nr_cells-offset) );
+		checkSuccess( MPI_Allreduce(MPI_IN_PLACE, data+offset, chunk_len, MPI_DOUBLE, op, MPI_COMM_WORLD) );
+	}
+
+	if (keep_nodata) MPI_Op_free(&op);
+}
+
+void MPIControl::allreduce_sum(mio::Grid2DObject& array)
+{
+	allreduce_sum(array.grid2D);
+}
+
+void MPIControl::allreduce_sum(mio::Array2D<double>& array)
+{
+	if (array.size() == 0) return;
+	allreduce_sum(&array(0), array.size(), array.getKeepNodata());
+}
+
+void MPIControl::allreduce_sum(mio::Array3D<double>& array)
+{
+	if (array.size() == 0) return;
+	allreduce_sum(&array(0), array.size(), array.getKeepNodata());
+}
+
+void MPIControl::allreduce_sum(mio::Array4D<double>& array)
+{
+	if (array.size() == 0) return;
+	allreduce_sum(&array(0), array.size(), array.getKeepNodata());
+}
+
+void MPIControl::broadcast(mio::Grid2DObject& grid, const size_t& root)
+{
+	if (size_ <= 1) return;
+
+	//the geolocalization goes as a small header, the cells as a typed buffer
+	unsigned long long header[3] = {0, 0, 0}; //nx, ny, keep_nodata
+	double cellsize = grid.cellsize;
+	mio::Coords llcorner( grid.llcorner );
+	if (rank_ == root) {
+		header[0] = static_cast<unsigned long long>( grid.grid2D.getNx() );
+		header[1] = static_cast<unsigned long long>( grid.grid2D.getNy() );
+		header[2] = (grid.grid2D.getKeepNodata())? 1 : 0;
+	}
+
+	checkSuccess( MPI_Bcast(header, 3, MPI_UNSIGNED_LONG_LONG, static_cast<int>(root), MPI_COMM_WORLD) );
+	checkSuccess( MPI_Bcast(&cellsize, 1, MPI_DOUBLE, static_cast<int>(root), MPI_COMM_WORLD) );
+	broadcast(llcorner, root);
+
+	if (rank_ != root) {
+		grid.set(static_cast<size_t>(header[0]), static_cast<size_t>(header[1]), cellsize, llcorner);
+		grid.grid2D.setKeepNodata( header[2]==1 );
+	}
+
+	const size_t nr_cells = grid.grid2D.size();
+	for (size_t offset=0; offset<nr_cells; offset+=max_chunk_len) {
+		const int chunk_len = static_cast<int>( std::min(max_chunk_len, nr_cells-offset) );
+		checkSuccess( MPI_Bcast(&grid.grid2D(offset), chunk_len, MPI_DOUBLE, static_cast<int>(root), MPI_COMM_WORLD) );
+	}
+}
+
+void MPIControl::gather(mio::Grid2DObject& grid, const size_t& startx, const size_t& nx, const size_t& root)
+{
+	gatherColumns(grid, startx, nx, false, root);
+}
+
+void MPIControl::allgather(mio::Grid2DObject& grid, const size_t& startx, const size_t& nx)
+{
+	gatherColumns(grid, startx, nx, true, master_rank());
+}
+
+void MPIControl::gatherColumns(mio::Grid2DObject& grid, const size_t& startx, const size_t& nx, const bool& to_all, const size_t& root)
+{
+	if (size_ <= 1) return;
+
+	const size_t dimx = grid.getNx(), dimy = grid.getNy();
+	if (startx+nx > dimx)
+		throw mio::IndexOutOfBoundsException("The band of columns to gather is outside of the grid", AT);
+
+	//every process needs to know the bands of all the others
+	int band[2] = {static_cast<int>(startx), static_cast<int>(nx)};
+	std::vector<int> bands(2*size_);
+	checkSuccess( MPI_Allgather(band, 2, MPI_INT, &bands[0], 2, MPI_INT, MPI_COMM_WORLD) );
+
+	std::vector<int> counts(size_), displs(size_);
+	size_t nr_cells = 0;
+	for (size_t ii=0; ii<size_; ii++) {
+		counts[ii] = static_cast<int>( static_cast<size_t>(bands[2*ii+1])*dimy );
+		displs[ii] = static_cast<int>( nr_cells );
+		nr_cells += static_cast<size_t>(bands[2*ii+1])*dimy;
+	}
+	if (nr_cells == 0) return;
+	if (nr_cells > max_chunk_len)
+		throw mio::IOException("Grid too large to be gathered in one MPI call", AT);
+
+	//the own band is sent straight out of the grid as a strided datatype
+	const bool has_band = (nx>0 && dimy>0);
+	MPI_Datatype band_type;
+	checkSuccess( MPI_Type_vector(static_cast<int>(dimy), static_cast<int>(nx), static_cast<int>(dimx), MPI_DOUBLE, &band_type) );
+	checkSuccess( MPI_Type_commit(&band_type) );
+	double* send_data = (has_band)? &grid.grid2D(startx, 0) : NULL;
+	const int send_count = (has_band)? 1 : 0;
+
+	const bool receives = (to_all || rank_ == root);
+	std::vector<double> recv_data( (receives)? nr_cells : 0 );
+	double* recv_ptr = (recv_data.empty())? NULL : &recv_data[0];
+	if (to_all)
+		checkSuccess( MPI_Allgatherv(send_data, send_count, band_type, recv_ptr, &counts[0], &displs[0], MPI_DOUBLE, MPI_COMM_WORLD) );
+	else
+		checkSuccess( MPI_Gatherv(send_data, send_count, band_type, recv_ptr, &counts[0], &displs[0], MPI_DOUBLE, static_cast<int>(root), MPI_COMM_WORLD) );
+	MPI_Type_free(&band_type);
+
+	if (!receives) return;
+	for (size_t ii=0; ii<size_; ii++) {
+		const size_t band_x = static_cast<size_t>(bands[2*ii]), band_nx = static_cast<size_t>(bands[2*ii+1]);
+		const double* band_data = &recv_data[0] + displs[ii];
+		for (size_t jj=0; jj<dimy; jj++) {
+			for (size_t kk=0; kk<band_nx; kk++)
+				grid.grid2D(band_x+kk, jj) = band_data[jj*band_nx + kk];
+		}
+	}
+}
+
 #else
 std::string getHostName() {
 	static const size_t len = 4096;
@@ -259,7 +418,7 @@ std::string getHostName() {
 	#endif
 }
 
-MPIControl::MPIControl() : rank_(0), size_(1), name_( getHostName() )
+MPIControl::MPIControl() : rank_(0), size_(1), name_( getHostName() ), threads_allowed_(true)
 {
 	#ifdef _OPENMP
 		std::cout << "[i] Init of OpenMP on '" << name_ << "' with a pool of " << omp_get_max_threads() << " threads\n";
@@ -273,10 +432,142 @@ void MPIControl::allreduce_min(double&) {}
 void MPIControl::allreduce_sum(double&) {}
 void MPIControl::allreduce_sum(int&) {}
 void MPIControl::gather(const int& val, std::vector<int>& vec, const size_t&) { vec.resize(1, val); }
+void MPIControl::allreduce_sum(mio::Grid2DObject&) {}
+void MPIControl::allreduce_sum(mio::Array2D<double>&) {}
+void MPIControl::allreduce_sum(mio::Array3D<double>&) {}
+void MPIControl::allreduce_sum(mio::Array4D<double>&) {}
+void MPIControl::broadcast(mio::Grid2DObject&, const size_t&) {}
+void MPIControl::gather(mio::Grid2DObject&, const size_t&, const size_t&, const size_t&) {}
+void MPIControl::allgather(mio::Grid2DObject&, const size_t&, const size_t&) {}
 #endif
 
 
 #ifdef ENABLE_MPI
+/*
+ * Vectors of objects are transmitted as one binary buffer per destination:
+ *   version (unsigned short), endianness tag (unsigned short), number of objects (unsigned long long),
+ *   the length of each serialized object (unsigned long long each) and then the objects themselves,
+ *   as written by their << operator.
+ * The objects' operators write their members in native representation, so a buffer can only be read back
+ * on a process with the same endianness (this is checked).
+ */
+static const unsigned short mpi_buffer_version = 1;
+static const unsigned short mpi_buffer_endianness = 0x0102;
+static const size_t mpi_buffer_header_len = 2*sizeof(unsigned short) + sizeof(unsigned long long);
+
+//read-only stream buffer on top of a received message, so objects are deserialized without copying it
+class MessageInBuf : public std::streambuf {
+	public:
+		MessageInBuf(char* data, const size_t& len) { setg(data, data, data+len); }
+		size_t consumed() const { return static_cast<size_t>( gptr() - eback() ); }
+};
+
+//stream buffer that writes straight into the message to send, so the packed objects are not copied again
+class MessageOutBuf : public std::streambuf {
+	public:
+		MessageOutBuf(std::string& message) : msg(message), len(0) { msg.clear(); }
+		size_t size() const { return len; }
+		void reserve(const size_t& capacity) { if (capacity > msg.size()) msg.resize(capacity); }
+		void finish() { msg.resize(len); }
+
+	protected:
+		virtual std::streamsize xsputn(const char* s, std::streamsize n)
+		{
+			const size_t n_len = static_cast<size_t>(n);
+			if (len+n_len > msg.size()) reserve( std::max(2*msg.size(), len+n_len) );
+			std::copy(s, s+n_len, msg.begin()+len);
+			len += n_len;
+			return n;
+		}
+		virtual int_type overflow(int_type c)
+		{
+			if (c == traits_type::eof()) return traits_type::not_eof(c);
+			const char ch = traits_type::to_char_type(c);
+			xsputn(&ch, 1);
+			return c;
+		}
+
+	private:
+		std::string& msg;
+		size_t len;
+};
+
+template <class T> const T& getObject(const T& obj) { return obj; }
+template <class T> const T& getObject(T* obj) { return *obj; }
+template <class T> void readObject(std::istream& is, T& slot) { is >> slot; }
+template <class T> void readObject(std::istream& is, T*& slot)
+{
+	std::unique_ptr<T> obj(new T); //only handed over to the slot once it has been read, otherwise it is freed
+	is >> *obj;
+	if (!is.fail()) slot = obj.release();
+}
+
+template <class Iterator> void packObjects(const Iterator& begin, const Iterator& end, std::string& buffer)
+{
+	const unsigned long long nr_objs = static_cast<unsigned long long>( std::distance(begin, end) );
+	const size_t nr = static_cast<size_t>( nr_objs );
+	std::vector<unsigned long long> obj_len(nr, 0);
+
+	MessageOutBuf msg_buf(buffer);
+	std::ostream os(&msg_buf);
+	os.write(reinterpret_cast<const char*>(&mpi_buffer_version), sizeof(mpi_buffer_version));
+	os.write(reinterpret_cast<const char*>(&mpi_buffer_endianness), sizeof(mpi_buffer_endianness));
+	os.write(reinterpret_cast<const char*>(&nr_objs), sizeof(nr_objs));
+	if (nr > 0) os.write(reinterpret_cast<const char*>(&obj_len[0]), static_cast<std::streamsize>(nr*sizeof(obj_len[0]))); //filled in below
+
+	size_t ii = 0;
+	for (Iterator it=begin; it!=end; ++it, ++ii) {
+		const size_t start = msg_buf.size();
+		os << getObject(*it);
+		obj_len[ii] = static_cast<unsigned long long>( msg_buf.size() - start );
+		if (ii == 0) msg_buf.reserve( msg_buf.size() + (nr-1)*(obj_len[0] + obj_len[0]/8) ); //assume similar objects
+	}
+	if (os.fail())
+		throw mio::IOException("Could not serialize objects for MPI transmission", AT);
+
+	msg_buf.finish();
+	if (nr > 0) std::copy(reinterpret_cast<const char*>(&obj_len[0]), reinterpret_cast<const char*>(&obj_len[0] + nr), buffer.begin()+mpi_buffer_header_len);
+}
+
+template <class Slot> void unpackObjects(std::string& buffer, std::vector<Slot>& vec_local)
+{
+	if (buffer.size() < mpi_buffer_header_len)
+		throw mio::IOException("Truncated MPI message", AT);
+
+	unsigned short version, endianness;
+	unsigned long long nr_objs;
+	std::copy(buffer.begin(), buffer.begin()+sizeof(version), reinterpret_cast<char*>(&version));
+	std::copy(buffer.begin()+sizeof(version), buffer.begin()+2*sizeof(version), reinterpret_cast<char*>(&endianness));
+	std::copy(buffer.begin()+2*sizeof(version), buffer.begin()+mpi_buffer_header_len, reinterpret_cast<char*>(&nr_objs));
+	if (endianness != mpi_buffer_endianness)
+		throw mio::IOException("MPI message sent by a process with a different endianness", AT);
+	if (version != mpi_buffer_version) {
+		std::ostringstream ss;
+		ss << "MPI message version " << version << " is not supported (expecting version " << mpi_buffer_version << ")";
+		throw mio::IOException(ss.str(), AT);
+	}
+
+	const size_t nr = static_cast<size_t>( nr_objs );
+	if (buffer.size() < mpi_buffer_header_len + nr*sizeof(unsigned long long))
+		throw mio::IOException("Truncated MPI message", AT);
+	std::vector<unsigned long long> obj_len(nr, 0);
+	if (nr > 0) std::copy(buffer.begin()+mpi_buffer_header_len, buffer.begin()+mpi_buffer_header_len+nr*sizeof(unsigned long long), reinterpret_cast<char*>(&obj_len[0]));
+
+	const size_t data_offset = mpi_buffer_header_len + nr*sizeof(unsigned long long);
+	MessageInBuf msg_buf(&buffer[0] + data_offset, buffer.size() - data_offset);
+	std::istream is(&msg_buf);
+
+	const size_t offset = vec_local.size();
+	vec_local.resize(offset + nr);
+	size_t expected_pos = 0;
+	for (size_t ii=0; ii<nr; ii++) {
+		readObject(is, vec_local[offset+ii]);
+		expected_pos += static_cast<size_t>( obj_len[ii] );
+		if (is.fail() || msg_buf.consumed() != expected_pos)
+			throw mio::IOException("Corrupted MPI message: object length does not match its serialization", AT);
+	}
+}
+
 /**
  * @brief	Send the objects pointed to by vector<T*> to process \#destination
  * @param[in] vec_local A vector of T* pointers to objects that shall be sent
@@ -288,17 +579,9 @@ template <class T> void MPIControl::send(const std::vector<T*>& vec_local, const
 {
 	if ((size_ <= 1) || (rank_ == destination)) return;
 
-	const size_t v_size = vec_local.size();
-
-	send((int)v_size, destination, tag); // first send the size of the vector
-	for (size_t ii=0; ii<v_size; ii++) {
-		std::string obj_string;
-		std::stringstream objs_stream;
-
-		objs_stream << *(vec_local[ii]);
-		obj_string.insert(0, objs_stream.str());
-		send(obj_string, destination, tag);
-	}
+	std::string buffer;
+	packObjects(vec_local.begin(), vec_local.end(), buffer);
+	send(buffer, destination, tag);
 }
 /**
  * @brief	Receive vector of objects from process \#source
@@ -314,21 +597,9 @@ template <class T> void MPIControl::receive(std::vector<T*>& vec_local, const si
 	if (!vec_local.empty())
 		throw mio::IOException("The vector to receive pointers has to be empty (please properly free the vector)", AT);
 
-	std::string obj_string;
-	int v_size;
-	receive(v_size, source, tag);
-	vec_local.resize((size_t)v_size);
-
-	T obj; // temporary object
-	for (size_t ii=0; ii<vec_local.size(); ii++) {
-		std::stringstream objs_stream;
-		receive(obj_string, source, tag);
-
-		objs_stream << obj_string;
-
-		objs_stream >> obj;
-		vec_local[ii] = new T(obj);
-	}
+	std::string buffer;
+	receive(buffer, source, tag);
+	unpackObjects(buffer, vec_local);
 }
 
 /**
@@ -342,17 +613,9 @@ template <class T> void MPIControl::send(const std::vector<T>& vec_local, const
 {
 	if ((size_ <= 1) || (rank_ == destination)) return;
 
-	const size_t v_size = vec_local.size();
-
-	send((int)v_size, destination, tag); // first send the size of the vector
-	for (size_t ii=0; ii<v_size; ii++) {
-		std::string obj_string;
-		std::stringstream objs_stream;
-
-		objs_stream << vec_local[ii];
-		obj_string.insert(0, objs_stream.str());
-		send(obj_string, destination, tag);
-	}
+	std::string buffer;
+	packObjects(vec_local.begin(), vec_local.end(), buffer);
+	send(buffer, destination, tag);
 }
 /**
  * @brief	Receive vector of objects from process \#source
@@ -368,20 +631,52 @@ template <class T> void MPIControl::receive(std::vector<T>& vec_local, const siz
 	if (!vec_local.empty())
 		throw mio::IOException("The vector to receive pointers has to be empty (please properly free the vector)", AT);
 
-	std::string obj_string;
-	int v_size;
-	receive(v_size, source, tag);
-	vec_local.resize((size_t)v_size);
+	std::string buffer;
+	receive(buffer, source, tag);
+	unpackObjects(buffer, vec_local);
+}
 
-	T obj; // temporary object
-	for (size_t ii=0; ii<vec_local.size(); ii++) {
-		std::stringstream objs_stream;
-		receive(obj_string, source, tag);
+template <class T> void MPIControl::scatter(std::vector<T*>& vec_local, const size_t& root)
+{
+	if (size_ <= 1) return;
 
-		objs_stream << obj_string;
+	if (rank_ == root) {
+		for (size_t ii=1; ii<size_; ii++) { // HACK: Assuming root is master
+			size_t startx, deltax;
+			getArraySliceParams(vec_local.size(), ii, startx, deltax);
+
+			std::string buffer;
+			packObjects(vec_local.begin()+startx, vec_local.begin()+startx+deltax, buffer);
+			send(buffer, ii);
+			for (size_t jj=startx; jj<(startx+deltax); jj++)
+				delete vec_local[jj];
+		}
 
-		objs_stream >> obj;
-		vec_local[ii] = T(obj);
+		size_t startx, deltax;
+		getArraySliceParams(vec_local.size(), startx, deltax);
+		vec_local.resize(deltax);
+	} else {
+		vec_local.clear();
+		std::string buffer;
+		receive(buffer, root);
+		unpackObjects(buffer, vec_local);
+	}
+}
+
+template <class T> void MPIControl::gather(std::vector<T*>& vec_local, const size_t& root)
+{
+	if (size_ <= 1) return;
+
+	if (rank_ == root) {
+		for (size_t ii=1; ii<size_; ii++) { //HACK: Assuming master is always rank 0
+			std::string buffer;
+			receive(buffer, ii);
+			unpackObjects(buffer, vec_local);
+		}
+	} else {
+		std::string buffer;
+		packObjects(vec_local.begin(), vec_local.end(), buffer);
+		send(buffer, root);
 	}
 }
 
@@ -390,12 +685,18 @@ template <class T> void MPIControl::receive(std::vector<T>& vec_local, const siz
 // conflict with other h files).
 template void MPIControl::receive<SnowStation>(std::vector<SnowStation*>&, const size_t&, const int&);
 template void MPIControl::send<SnowStation>(const std::vector<SnowStation*>&, const size_t&, const int&);
+template void MPIControl::scatter<SnowStation>(std::vector<SnowStation*>&, const size_t&);
+template void MPIControl::gather<SnowStation>(std::vector<SnowStation*>&, const size_t&);
 
 template void MPIControl::receive<CurrentMeteo>(std::vector<CurrentMeteo*>&, const size_t&, const int&);
 template void MPIControl::send<CurrentMeteo>(const std::vector<CurrentMeteo*>&, const size_t&, const int&);
+template void MPIControl::scatter<CurrentMeteo>(std::vector<CurrentMeteo*>&, const size_t&);
+template void MPIControl::gather<CurrentMeteo>(std::vector<CurrentMeteo*>&, const size_t&);
 
 template void MPIControl::receive<SurfaceFluxes>(std::vector<SurfaceFluxes*>&, const size_t&, const int&);
 template void MPIControl::send<SurfaceFluxes>(const std::vector<SurfaceFluxes*>&, const size_t&, const int&);
+template void MPIControl::scatter<SurfaceFluxes>(std::vector<SurfaceFluxes*>&, const size_t&);
+template void MPIControl::gather<SurfaceFluxes>(std::vector<SurfaceFluxes*>&, const size_t&);
 
 template void MPIControl::receive< std::pair<unsigned long, unsigned long> >(std::vector<std::pair<unsigned long, unsigned long> >&, const size_t&, const int&);
 template void MPIControl::send< std::pair<unsigned long, unsigned long> >(const std::vector<std::pair<unsigned long, unsigned long> >&, const size_t&, const int&);
@@ -100,6 +100,13 @@ class MPIControl
 		 */
 		std::string name() const;
 
+		/**
+		 * Returns whether other threads than the main one can run next to MPI, that is if the MPI library
+		 * provides at least MPI_THREAD_FUNNELED (always true if MPI was not activated)
+		 * @return true if helper threads (that do not call MPI) can be started
+		 */
+		bool threads_allowed() const;
+
 		/**
 		 * This method allows to synchronize all MPI processes. It blocks the calling process until all
 		 * processes have called barrier()
@@ -129,6 +136,34 @@ class MPIControl
 		void allreduce_sum(int& value);
 		//@}
 
+		//@{
+		/**
+		 * Adds up the cells of a grid or array from all processes and distributes the sum back to all processes.
+		 * The cells are reduced in place as a typed MPI_DOUBLE buffer. If the array keeps nodata, a cell
+		 * that is nodata on any process remains nodata (as with operator+=).
+		 * @param[in,out] array The grid or array that is used to perform the reduction and to hold the result
+		 */
+		void allreduce_sum(mio::Grid2DObject& array);
+		void allreduce_sum(mio::Array2D<double>& array);
+		void allreduce_sum(mio::Array3D<double>& array);
+		void allreduce_sum(mio::Array4D<double>& array);
+		//@}
+
+		//@{
+		/**
+		 * Collects the band of columns that each process computed into the full grid. Each process
+		 * calls it with a grid covering the whole domain, of which only the columns startx to startx+nx-1
+		 * are its own. Only these columns are transmitted: gather() fills the grid of the root process,
+		 * allgather() fills the grids of all processes. In case MPI is not activated the grid is not changed.
+		 * @param[in,out] grid Grid of the whole domain, holding the own band of columns and the result
+		 * @param[in] startx First column of the band owned by the calling process
+		 * @param[in] nx Number of columns of the band owned by the calling process
+		 * @param[in] root The process rank that will gather the grid
+		 */
+		void gather(mio::Grid2DObject& grid, const size_t& startx, const size_t& nx, const size_t& root = 0);
+		void allgather(mio::Grid2DObject& grid, const size_t& startx, const size_t& nx);
+		//@}
+
 		/**
 		 * This method is used when deserializing a class T from a void* representing a char*,
 		 * instantiating an object from a string
@@ -256,6 +291,17 @@ class MPIControl
 		template <class T> void broadcast(T& /*obj*/, const size_t& root=0) {(void)root;}
 		#endif
 
+		/**
+		 * @brief Broadcast a grid via MPI or in case MPI is not activated don't do anything. The geolocalization
+		 * is broadcasted as a small header and the cells as a typed MPI_DOUBLE buffer, so the grid is never
+		 * serialized as a whole.
+		 * @param grid The grid that shall be broadcasted, or if not root the grid that will hold the broadcasted values
+		 * @param[in] root The process rank that will commit the broadcast value, all others receive only
+		 * @note The upper right corner of lat/lon grids is not transmitted, since Alpine3D works on projected grids.
+		 * A DEMObject is still broadcasted through its own serialization, since it also carries its derived fields.
+		 */
+		void broadcast(mio::Grid2DObject& grid, const size_t& root = 0);
+
 		#ifdef ENABLE_MPI
 		/**
 		 * @brief Broadcast a vector of class T objects via MPI or in case MPI is not activated don't do anything.
@@ -303,55 +349,14 @@ class MPIControl
 		/**
 		 * @brief	Scatter the objects pointed to by vector<T*> by slices to all preocesses.
 		 *        Internally no MPI_Scatterv or the like is used, because the size of the
-		 *        strings may become extremely large. Thusly internally blocking send and receive calls
-		 *        are utilized. In case MPI is not activated vec_local is not changed in any way.
+		 *        buffers may become extremely large. Thusly each slice is packed into one binary buffer
+		 *        that is sent with blocking calls. In case MPI is not activated vec_local is not changed in any way.
 		 * @param[in, out] vec_local A vector of T* pointers to objects that shall be scattered;
 		 *                 if root then this vector will also hold the pointers to the scattered objects
 		 * @param[in] root The process rank that will scatter the values, all others receive only
 		 * @note Class T needs to have the serialize and deseralize operator << and >> implemented
 		 */
-		template <class T> void scatter(std::vector<T*>& vec_local, const size_t& root = 0)
-		{
-			if (size_ <= 1) return;
-
-			if (rank_ == root) {
-				for (size_t ii=1; ii<size_; ii++) { // HACK: Assuming root is master
-					size_t startx, deltax;
-					getArraySliceParams(vec_local.size(), ii, startx, deltax);
-
-					send((int)deltax, ii);
-					for (size_t jj=startx; jj<(startx+deltax); jj++) {
-						std::string obj_string;
-						std::stringstream objs_stream;
-
-						objs_stream << *(vec_local[jj]);
-						obj_string.insert(0, objs_stream.str());
-						send(obj_string, ii);
-						delete vec_local[jj];
-					}
-				}
-
-				size_t startx, deltax;
-				getArraySliceParams(vec_local.size(), startx, deltax);
-				vec_local.resize(deltax);
-			} else {
-				std::string obj_string;
-				int deltax;
-				receive(deltax, root);
-				vec_local.resize((size_t)deltax);
-
-				T obj; // temporary object
-				for (size_t ii=0; ii<vec_local.size(); ii++) {
-					std::stringstream objs_stream;
-					receive(obj_string, root);
-
-					objs_stream << obj_string;
-
-					objs_stream >> obj;
-					vec_local[ii] = new T(obj);
-				}
-			}
-		}
+		template <class T> void scatter(std::vector<T*>& vec_local, const size_t& root = 0);
 		#else
 		template <class T> void scatter(std::vector<T*>& /*vec_local*/, const size_t& root=0) {(void)root;}
 		#endif
@@ -390,53 +395,14 @@ class MPIControl
 		/**
 		 * @brief	Gathers the objects pointed to by vector<T*> from all processes into a vector<T*> on
 		 *        the root node. Internally no MPI_Gatherv or the like is used, because the size of the
-		 *        strings may become extremely large. Thusly internally blocking send and receive calls
-		 *        are utilized. In case MPI is not activated vec_local is not changed in any way.
+		 *        buffers may become extremely large. Thusly each process packs its objects into one binary
+		 *        buffer that is sent with blocking calls. In case MPI is not activated vec_local is not changed in any way.
 		 * @param[in, out] vec_local A vector of T* pointers to objects that shall be transmitted to root;
 		 *                 if root then this vector will also hold the pointers to the gathered objects
 		 * @param[in] root The process rank that will commit the broadcast value, all others receive only
 		 * @note Class T needs to have the serialize and deseralize operator \<\< and \>\> implemented
 		 */
-		template <class T> void gather(std::vector<T*>& vec_local, const size_t& root = 0)
-		{
-			if (size_ <= 1) return;
-
-			std::vector<int> vec_sizes;
-			const size_t sum = vec_local.size();
-
-			gather(vec_local.size(), vec_sizes); //global offsets
-			allreduce_sum(sum); //global amount of T*
-
-			if (rank_ == root) {
-				std::string obj_string;
-				size_t local_sum = vec_local.size();
-
-				vec_local.resize(sum);
-
-				T obj; //temporary object
-				for (size_t ii=1; ii<vec_sizes.size(); ii++) {//HACK: Assuming master is always rank 0
-					for (size_t jj=0; jj<vec_sizes[ii]; jj++) {
-						std::stringstream objs_stream;
-						receive(obj_string, ii);
-
-						objs_stream << obj_string;
-						objs_stream >> obj;
-						vec_local[local_sum+jj] = new T(obj);
-					}
-					local_sum += vec_sizes[ii];
-				}
-
-			} else {
-				for (size_t ii=0; ii<vec_local.size(); ii++) {
-					std::string obj_string;
-					std::stringstream objs_stream;
-
-					objs_stream << *(vec_local[ii]);
-					obj_string.insert(0, objs_stream.str());
-					send(obj_string, root);
-				}
-			}
-		}
+		template <class T> void gather(std::vector<T*>& vec_local, const size_t& root = 0);
 		#else
 		template <class T> void gather(std::vector<T*>& /*vec_local*/, const size_t& root=0) {(void)root;}
 		#endif
@@ -492,11 +458,15 @@ class MPIControl
 		void send(const int& value, const size_t& recipient, const int& tag=0);
 		void receive(int& value, const size_t& source, const int& tag=0);
 
+		void allreduce_sum(double* data, const size_t& nr_cells, const bool& keep_nodata);
+		void gatherColumns(mio::Grid2DObject& grid, const size_t& startx, const size_t& nx, const bool& to_all, const size_t& root);
+
 		static void checkSuccess(const int& ierr);
 
 		size_t rank_;          // the rank of this process
 		size_t size_;          // the number of all processes
 		std::string name_;  // the name of the node this process is running on
+		bool threads_allowed_; // can other threads than the main one run next to MPI?
 };
 
 #endif
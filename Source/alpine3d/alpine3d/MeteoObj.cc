@@ -16,6 +16,9 @@
     along with Alpine3D.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <alpine3d/MeteoObj.h>
+#include <alpine3d/AlpineMain.h>
+
+#include <algorithm>
 
 using namespace mio;
 using namespace std;
@@ -109,25 +112,56 @@ size_t SnGrids::getParameterIndex(const std::string& parname)
 /************************************************************
  * MeteoObj                                           *
  ************************************************************/
+MeteoObj::MeteoSet::MeteoSet(const mio::Date& i_date, const mio::DEMObject& i_dem)
+                   : date(i_date), vecMeteo(),
+                     ta(i_dem, IOUtils::nodata), tsg(i_dem, IOUtils::nodata), rh(i_dem, IOUtils::nodata), psum(i_dem, IOUtils::nodata),
+                     psum_ph(i_dem, IOUtils::nodata), vw(i_dem, IOUtils::nodata), vw_drift(i_dem, IOUtils::nodata), dw(i_dem, IOUtils::nodata), p(i_dem, IOUtils::nodata), ilwr(i_dem, IOUtils::nodata),
+                     error() {}
+
 MeteoObj::MeteoObj(const mio::Config& in_config, const mio::DEMObject& in_dem)
-                   : timer(), config(in_config), io(in_config), dem(in_dem),
-                     ta(in_dem, IOUtils::nodata), tsg(in_dem, IOUtils::nodata), rh(in_dem, IOUtils::nodata), psum(in_dem, IOUtils::nodata),
-                     psum_ph(in_dem, IOUtils::nodata), vw(in_dem, IOUtils::nodata), vw_drift(in_dem, IOUtils::nodata), dw(in_dem, IOUtils::nodata), p(in_dem, IOUtils::nodata), ilwr(in_dem, IOUtils::nodata),
+                   : timer(), config(in_config), io(in_config), dem(in_dem), current(Date(), in_dem),
                      sum_ta(), sum_rh(), sum_rh_psum(), sum_psum(), sum_psum_ph(), sum_vw(), sum_ilwr(),
-                     vecMeteo(), date(), glaciers(NULL), count_sums(0), count_precip(0), skipWind(false), soil_flux(true), enable_simple_snow_drift(false)
+                     prefetch_thread(), prefetch_mutex(), prefetch_cond(), prefetch_requests(), prefetch_ready(), prefetch_busy(), prefetch_next(),
+                     prefetch_depth(0), prefetch_stop(false),
+                     glaciers(NULL), count_sums(0), count_precip(0), skipWind(false), soil_flux(true), enable_simple_snow_drift(false)
 {
 	//check if simple snow drift is enabled
 	enable_simple_snow_drift = false;
 	in_config.getValue("SIMPLE_SNOW_DRIFT", "Alpine3D", enable_simple_snow_drift, IOUtils::nothrow);
 	in_config.getValue("SOIL_FLUX", "Snowpack", soil_flux, IOUtils::nothrow);
+
+	in_config.getValue("METEO_LOOKAHEAD", "Alpine3D", prefetch_depth, IOUtils::nothrow);
+	bool dem_with_hs = false;
+	in_config.getValue("ADD_HS_TO_DEM_FOR_METEO", "Input", dem_with_hs, IOUtils::nothrow);
+	if (prefetch_depth>0 && dem_with_hs) {
+		//the DEM changes at each time step, so the next time steps can not be prepared in advance
+		if (MPIControl::instance().master())
+			cout << "[W] METEO_LOOKAHEAD can not be used together with ADD_HS_TO_DEM_FOR_METEO, it will be ignored\n";
+		prefetch_depth = 0;
+	}
+	if (prefetch_depth>0 && !MPIControl::instance().threads_allowed()) {
+		//the background thread would run next to MPI, the meteo data is then read when needed
+		if (MPIControl::instance().master())
+			cout << "[W] METEO_LOOKAHEAD needs an MPI library providing MPI_THREAD_FUNNELED, it will be ignored\n";
+		prefetch_depth = 0;
+	}
 }
 
 MeteoObj::~MeteoObj()
 {
+	if (prefetch_thread.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(prefetch_mutex);
+			prefetch_stop = true;
+		}
+		prefetch_cond.notify_all();
+		prefetch_thread.join();
+	}
 	if (glaciers!=NULL) delete glaciers;
 }
 
 void MeteoObj::setSkipWind(const bool& i_skipWind) {
+	flushPrefetch(); //the time steps in preparation might have been computed with the previous setting
 	skipWind = i_skipWind;
 }
 
@@ -136,8 +170,119 @@ void MeteoObj::prepare(const mio::Date& in_date)
 	if (!MPIControl::instance().master())  // Only master reads data
 		return;
 
-	date = in_date;
-	getMeteo(date);
+	if (prefetch_depth>0) {
+		schedulePrefetch(in_date);
+		return;
+	}
+
+	current.date = in_date;
+	getMeteo(current.date);
+}
+
+/**
+ * @brief Make sure that the background thread prepares the time steps starting at in_date
+ * @details Up to prefetch_depth time steps (of dt_main) are requested. If there is a gap between the time steps
+ * that have already been requested and in_date, the time steps in preparation are discarded.
+ * @param in_date first time step that should be prepared
+ */
+void MeteoObj::schedulePrefetch(const mio::Date& in_date)
+{
+	const double timeStep = dt_main/86400.;
+	if (prefetch_next.isUndef() || in_date>prefetch_next) {
+		flushPrefetch();
+		prefetch_next = in_date;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(prefetch_mutex);
+		const Date last_date( in_date + static_cast<double>(prefetch_depth-1)*timeStep );
+		while (prefetch_next<=last_date) {
+			prefetch_requests.push_back( prefetch_next );
+			prefetch_next += timeStep;
+		}
+	}
+
+	if (!prefetch_thread.joinable())
+		prefetch_thread = std::thread(&MeteoObj::prefetchLoop, this);
+	prefetch_cond.notify_all();
+}
+
+/**
+ * @brief Move the data prepared by the background thread for in_date into the current time step
+ * @details If in_date is still being prepared, this waits for it.
+ * @param in_date time step to retrieve
+ * @return true if the data could be retrieved, false if in_date had not been requested
+ */
+bool MeteoObj::getPrefetched(const mio::Date& in_date)
+{
+	if (prefetch_depth==0) return false;
+
+	std::unique_lock<std::mutex> lock(prefetch_mutex);
+	while (true) {
+		while (!prefetch_ready.empty() && prefetch_ready.front().date<in_date) //these time steps have been skipped
+			prefetch_ready.pop_front();
+
+		if (!prefetch_ready.empty() && prefetch_ready.front().date==in_date) {
+			std::swap(current, prefetch_ready.front());
+			prefetch_ready.pop_front();
+			lock.unlock();
+			prefetch_cond.notify_all(); //there is room for the next time step
+
+			if (current.error) {
+				const std::exception_ptr error( current.error );
+				current.error = std::exception_ptr();
+				std::rethrow_exception( error );
+			}
+			return true;
+		}
+
+		const bool pending = (prefetch_busy==in_date || std::find(prefetch_requests.begin(), prefetch_requests.end(), in_date)!=prefetch_requests.end());
+		if (!pending) return false;
+		prefetch_cond.wait(lock);
+	}
+}
+
+/**
+ * @brief Discard all the time steps that have been requested or prepared by the background thread
+ * @details When returning, the background thread is idle so the IOManager can safely be used.
+ */
+void MeteoObj::flushPrefetch()
+{
+	if (!prefetch_thread.joinable()) return;
+
+	std::unique_lock<std::mutex> lock(prefetch_mutex);
+	prefetch_requests.clear();
+	while (!prefetch_busy.isUndef())
+		prefetch_cond.wait(lock);
+	prefetch_ready.clear();
+	prefetch_next.setUndef(true);
+}
+
+void MeteoObj::prefetchLoop()
+{
+	std::unique_lock<std::mutex> lock(prefetch_mutex);
+	while (true) {
+		while (!prefetch_stop && (prefetch_requests.empty() || prefetch_ready.size()>=prefetch_depth))
+			prefetch_cond.wait(lock);
+		if (prefetch_stop) return;
+
+		prefetch_busy = prefetch_requests.front();
+		prefetch_requests.pop_front();
+		lock.unlock();
+
+		MeteoSet set(prefetch_busy, dem);
+		try {
+			readMeteo(set.date, set);
+		} catch (...) {
+			set.error = std::current_exception(); //it will be rethrown by the main thread when requesting this time step
+		}
+
+		lock.lock();
+		prefetch_busy.setUndef(true);
+		prefetch_ready.push_back( MeteoSet() );
+		std::swap(prefetch_ready.back(), set);
+		prefetch_cond.notify_all();
+	}
 }
 
 void MeteoObj::get(const mio::Date& in_date, mio::Grid2DObject& out_ta, mio::Grid2DObject& out_tsg, mio::Grid2DObject& out_rh, mio::Grid2DObject& out_psum,
@@ -146,40 +291,41 @@ void MeteoObj::get(const mio::Date& in_date, mio::Grid2DObject& out_ta, mio::Gri
 	timer.restart(); //this method is called first, so we initiate the timing here
 
 	if (MPIControl::instance().master()) {
-		if (date.isUndef()) {
-			date = in_date;
-			getMeteo(date); //it will throw an exception if something goes wrong
-		}
-		if (in_date != date) {
-			cerr << "[w] Meteo data was prepared for " << date.toString(Date::ISO);
-			cerr << ", requested for " << in_date.toString(Date::ISO) << ", this is not optimal...\n";
-			date = in_date;
-			getMeteo(date); //it will throw an exception if something goes wrong
+		if (current.date.isUndef() || in_date != current.date) {
+			if (!getPrefetched(in_date)) {
+				flushPrefetch();
+				if (!current.date.isUndef()) {
+					cerr << "[w] Meteo data was prepared for " << current.date.toString(Date::ISO);
+					cerr << ", requested for " << in_date.toString(Date::ISO) << ", this is not optimal...\n";
+				}
+				current.date = in_date;
+				getMeteo(current.date); //it will throw an exception if something goes wrong
+			}
 		}
 	}
 
 	//this acts as a barrier and forces MPI synchronization
-	MPIControl::instance().broadcast(ta);
-	MPIControl::instance().broadcast(tsg);
-	MPIControl::instance().broadcast(rh);
-	MPIControl::instance().broadcast(psum);
-	MPIControl::instance().broadcast(psum_ph);
-	MPIControl::instance().broadcast(vw);
-	MPIControl::instance().broadcast(vw_drift);
-	MPIControl::instance().broadcast(dw);
-	MPIControl::instance().broadcast(p);
-	MPIControl::instance().broadcast(ilwr);
-
-	out_ta = ta;
-	out_tsg = tsg;
-	out_rh = rh;
-	out_psum = psum;
-	out_psum_ph = psum_ph;
-	out_vw = vw;
-	out_vw_drift = vw_drift;
-	out_dw = dw;
-	out_p = p;
-	out_ilwr = ilwr;
+	MPIControl::instance().broadcast(current.ta);
+	MPIControl::instance().broadcast(current.tsg);
+	MPIControl::instance().broadcast(current.rh);
+	MPIControl::instance().broadcast(current.psum);
+	MPIControl::instance().broadcast(current.psum_ph);
+	MPIControl::instance().broadcast(current.vw);
+	MPIControl::instance().broadcast(current.vw_drift);
+	MPIControl::instance().broadcast(current.dw);
+	MPIControl::instance().broadcast(current.p);
+	MPIControl::instance().broadcast(current.ilwr);
+
+	out_ta = current.ta;
+	out_tsg = current.tsg;
+	out_rh = current.rh;
+	out_psum = current.psum;
+	out_psum_ph = current.psum_ph;
+	out_vw = current.vw;
+	out_vw_drift = current.vw_drift;
+	out_dw = current.dw;
+	out_p = current.p;
+	out_ilwr = current.ilwr;
 	timer.stop();
 }
 
@@ -188,22 +334,23 @@ void MeteoObj::get(const mio::Date& in_date, std::vector<mio::MeteoData>& o_vecM
 	timer.start();
 
 	if (MPIControl::instance().master()) {
-		if (date.isUndef()) {
-			date = in_date;
-			getMeteo(date); //it will throw an exception if something goes wrong
-		}
-		if (in_date != date) {
-			cerr << "[w] Meteo data was prepared for " << date.toString(Date::ISO);
-			cerr << ", requested for " << in_date.toString(Date::ISO) << ", this is not optimal...\n";
-			date = in_date;
-			getMeteo(date); //it will throw an exception if something goes wrong
+		if (current.date.isUndef() || in_date != current.date) {
+			if (!getPrefetched(in_date)) {
+				flushPrefetch();
+				if (!current.date.isUndef()) {
+					cerr << "[w] Meteo data was prepared for " << current.date.toString(Date::ISO);
+					cerr << ", requested for " << in_date.toString(Date::ISO) << ", this is not optimal...\n";
+				}
+				current.date = in_date;
+				getMeteo(current.date); //it will throw an exception if something goes wrong
+			}
 		}
 	}
 
 	//this acts as a barrier and forces MPI synchronization
-	MPIControl::instance().broadcast(vecMeteo);
+	MPIControl::instance().broadcast(current.vecMeteo);
 
-	o_vecMeteo = vecMeteo;
+	o_vecMeteo = current.vecMeteo;
 	timer.stop();
 }
 
@@ -249,22 +396,22 @@ void MeteoObj::checkInputsRequirements(std::vector<MeteoData>& vecData, const bo
 	}
 }
 
-void MeteoObj::fillMeteoGrids(const Date& calcDate)
+void MeteoObj::fillMeteoGrids(const Date& calcDate, MeteoSet& set)
 {
 	//fill the meteo parameter grids (of the AlpineControl object) using the data from the stations
 	try {
-		io.getMeteoData(calcDate, dem, MeteoData::PSUM, psum);
-		io.getMeteoData(calcDate, dem, MeteoData::PSUM_PH, psum_ph);
-		io.getMeteoData(calcDate, dem, MeteoData::RH, rh);
-		io.getMeteoData(calcDate, dem, MeteoData::TA, ta);
-		if (!soil_flux) io.getMeteoData(calcDate, dem, MeteoData::TSG, tsg);
+		io.getMeteoData(calcDate, dem, MeteoData::PSUM, set.psum);
+		io.getMeteoData(calcDate, dem, MeteoData::PSUM_PH, set.psum_ph);
+		io.getMeteoData(calcDate, dem, MeteoData::RH, set.rh);
+		io.getMeteoData(calcDate, dem, MeteoData::TA, set.ta);
+		if (!soil_flux) io.getMeteoData(calcDate, dem, MeteoData::TSG, set.tsg);
 		if (!skipWind) {
-			io.getMeteoData(calcDate, dem, MeteoData::VW, vw);
-			if (enable_simple_snow_drift) io.getMeteoData(calcDate, dem, "VW_DRIFT", vw_drift);
-			io.getMeteoData(calcDate, dem, MeteoData::DW, dw);
+			io.getMeteoData(calcDate, dem, MeteoData::VW, set.vw);
+			if (enable_simple_snow_drift) io.getMeteoData(calcDate, dem, "VW_DRIFT", set.vw_drift);
+			io.getMeteoData(calcDate, dem, MeteoData::DW, set.dw);
 		}
-		io.getMeteoData(calcDate, dem, MeteoData::P, p);
-		io.getMeteoData(calcDate, dem, MeteoData::ILWR, ilwr);
+		io.getMeteoData(calcDate, dem, MeteoData::P, set.p);
+		io.getMeteoData(calcDate, dem, MeteoData::ILWR, set.ilwr);
 		cout << "[i] 2D Interpolations done for " << calcDate.toString(Date::ISO) << "\n";
 	} catch (long) {
 		cout << "[e] at " << calcDate.toString(Date::ISO) << " Could not fill 2D meteo grids" << endl;
@@ -279,12 +426,17 @@ void MeteoObj::getMeteo(const Date& calcDate)
 	//Note: in case of MPI simulation only master node is responsible for file I/O
 	if (!MPIControl::instance().master()) return;
 
+	readMeteo(calcDate, current);
+}
+
+void MeteoObj::readMeteo(const Date& calcDate, MeteoSet& set)
+{
 	// Collect the Meteo values at each stations
-	io.getMeteoData(calcDate, vecMeteo);
-	checkInputsRequirements(vecMeteo, soil_flux);
+	io.getMeteoData(calcDate, set.vecMeteo);
+	checkInputsRequirements(set.vecMeteo, soil_flux);
 
 	// Now fill the 2D Meteo Fields. Keep in mind that snowdrift might edit these fields
-	fillMeteoGrids(calcDate);
+	fillMeteoGrids(calcDate, set);
 
 	cout << "[i] Success reading/preparing meteo data for date: " << calcDate.toString(Date::ISO) << endl;
 }
@@ -348,6 +500,7 @@ void MeteoObj::setGlacierMask(const Grid2DObject& glacierMask)
 
 void MeteoObj::setDEM(const mio::DEMObject& in_dem)
 {
+	flushPrefetch(); //the time steps in preparation rely on the previous DEM
 	dem=in_dem;
 }
 
@@ -355,15 +508,17 @@ void MeteoObj::setDEM(const mio::DEMObject& in_dem)
 //most of the other modules have NOT been called.
 void MeteoObj::checkMeteoForcing(const mio::Date& calcDate)
 {
-	if (calcDate != date) {
-		cerr << "[w] Meteo data was prepared for " << date.toString(Date::ISO);
+	if (calcDate != current.date && !getPrefetched(calcDate)) {
+		cerr << "[w] Meteo data was prepared for " << current.date.toString(Date::ISO);
 		cerr << ", requested for " << calcDate.toString(Date::ISO) << ", this is not optimal...\n";
-		date = calcDate;
-		getMeteo(date); //it will throw an exception if something goes wrong
+		flushPrefetch();
+		current.date = calcDate;
+		getMeteo(current.date); //it will throw an exception if something goes wrong
 	}
+	flushPrefetch(); //the IOManager is used below, it must not be shared with the background thread
 
 	if (glaciers!=NULL) {
-		glaciers->correctTemperatures( ta );
+		glaciers->correctTemperatures( current.ta );
 	}
 
 	//produce monthly gridded sums
@@ -401,20 +556,20 @@ void MeteoObj::checkMeteoForcing(const mio::Date& calcDate)
 	}
 
 	count_sums++;
-	sum_ta += ta;
+	sum_ta += current.ta;
 	//sum_rh += rh;
-	sum_vw += vw;
-	sum_ilwr += ilwr;
-	if (psum.grid2D.getMin()>0.) { //there are some precip
-		sum_psum += psum;
-		sum_psum_ph += psum_ph;
-		sum_rh_psum += rh;
+	sum_vw += current.vw;
+	sum_ilwr += current.ilwr;
+	if (current.psum.grid2D.getMin()>0.) { //there are some precip
+		sum_psum += current.psum;
+		sum_psum_ph += current.psum_ph;
+		sum_rh_psum += current.rh;
 		count_precip++;
 	}
 
 	//check range in the grids
-	checkGridRange(calcDate, rh, MeteoData::RH);
-	checkGridRange(calcDate, vw, MeteoData::VW);
+	checkGridRange(calcDate, current.rh, MeteoData::RH);
+	checkGridRange(calcDate, current.vw, MeteoData::VW);
 
 	//now get and print the lapse rates
 	vector<MeteoData> vecMd;
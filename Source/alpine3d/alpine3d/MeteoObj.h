@@ -25,6 +25,11 @@
 #include <alpine3d/Glaciers.h>
 
 #include <iostream>
+#include <deque>
+#include <exception>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 class SnGrids {
 	public:
@@ -90,6 +95,16 @@ class SnGrids {
 		static bool initStaticData();///<initialize the static map meteoparamname
 };
 
+/**
+ * @class MeteoObj
+ * @brief Reads the meteorological forcing on the master process, interpolates it into grids and distributes
+ * these grids to all processes.
+ * By default, the data for the next time step is prepared while the modules wait for it. With the key
+ * METEO_LOOKAHEAD in the [Alpine3D] section set to N>0, a background thread on the master process prepares up to
+ * N time steps in advance while the current time step is computed (no more than N prepared time steps are kept in memory).
+ * This is disabled when the DEM is updated at each time step (ADD_HS_TO_DEM_FOR_METEO) or when the MPI library does not
+ * provide MPI_THREAD_FUNNELED.
+ */
 class MeteoObj
 {
 	public:
@@ -116,20 +131,46 @@ class MeteoObj
 		double getTiming() const;
 
 	private:
+		///all the meteo data that is prepared for one time step
+		typedef struct MeteoSet {
+			MeteoSet() : date(), vecMeteo(), ta(), tsg(), rh(), psum(), psum_ph(), vw(), vw_drift(), dw(), p(), ilwr(), error() {}
+			MeteoSet(const mio::Date& i_date, const mio::DEMObject& i_dem);
+
+			mio::Date date;
+			std::vector<mio::MeteoData> vecMeteo;
+			mio::Grid2DObject ta, tsg, rh, psum, psum_ph, vw, vw_drift, dw, p, ilwr;
+			std::exception_ptr error; ///< set if the data could not be prepared
+		} MeteoSet;
+
 		static void checkLapseRate(const std::vector<mio::MeteoData>& i_vecMeteo, const mio::MeteoData::Parameters& param);
 		static void checkGridRange(const mio::Date& calcDate, const mio::Grid2DObject& grid, const mio::MeteoData::Parameters& param);
 		static void checkInputsRequirements(std::vector<mio::MeteoData>& vecData, const bool& soil_flux);
-		void fillMeteoGrids(const mio::Date& calcDate);
+		void fillMeteoGrids(const mio::Date& calcDate, MeteoSet& set);
 		void getMeteo(const mio::Date& calcDate);
+		void readMeteo(const mio::Date& calcDate, MeteoSet& set);
+
+		void schedulePrefetch(const mio::Date& in_date);
+		bool getPrefetched(const mio::Date& in_date);
+		void flushPrefetch();
+		void prefetchLoop();
 
 		mio::Timer timer;
 		const mio::Config &config;
 		mio::IOManager io;
 		mio::DEMObject dem;
-		mio::Grid2DObject ta, tsg, rh, psum, psum_ph, vw, vw_drift, dw, p, ilwr;
+		MeteoSet current; ///< the data for the current time step
 		mio::Grid2DObject sum_ta, sum_rh, sum_rh_psum, sum_psum, sum_psum_ph, sum_vw, sum_ilwr;
-		std::vector<mio::MeteoData> vecMeteo;
-		mio::Date date;
+
+		std::thread prefetch_thread; ///< background thread preparing the next time steps (master only)
+		std::mutex prefetch_mutex;
+		std::condition_variable prefetch_cond;
+		std::deque<mio::Date> prefetch_requests; ///< time steps to prepare, in chronological order
+		std::deque<MeteoSet> prefetch_ready; ///< prepared time steps, at most prefetch_depth
+		mio::Date prefetch_busy; ///< time step being prepared by the background thread (undef if idle)
+		mio::Date prefetch_next; ///< next time step that should be scheduled
+		size_t prefetch_depth; ///< how many time steps are prepared in advance (0 for no background thread)
+		bool prefetch_stop;
+
 		Glaciers *glaciers;
 		unsigned int count_sums, count_precip;
 		bool skipWind; ///<should the grids be filled or only the data vectors returned?
@@ -437,10 +437,10 @@ void SnowpackInterface::writeOutput(const mio::Date& date)
 	const bool isMaster = mpicontrol.master();
 
 	if (do_grid_output(date)) {
-		//no OpenMP pragma here, otherwise multiple threads might call an MPI allreduce_sum()
+		//no OpenMP pragma here, otherwise multiple threads might call an MPI gather()
 		for (size_t ii=0; ii<output_grids.size(); ii++) {
 			const size_t SnGrids_idx = SnGrids::getParameterIndex( output_grids[ii] );
-			mio::Grid2DObject grid( getGrid( static_cast<SnGrids::Parameters>(SnGrids_idx)) );
+			mio::Grid2DObject grid( getGrid( static_cast<SnGrids::Parameters>(SnGrids_idx), true) );
 
 			if (isMaster) {
 				if (mask_glaciers) grid *= maskGlacier;
@@ -760,50 +760,129 @@ void SnowpackInterface::setRadiationComponents(const mio::Array2D<double>& short
 }
 
 /**
- * @brief Request specific grid by parameter type
+ * @brief Request specific grid by parameter type. This is a collective call: all processes must call it
+ * and all receive the full grid.
  * @param param parameter
  * @return 2D output grid (empty if the requested parameter was not available)
  */
 mio::Grid2DObject SnowpackInterface::getGrid(const SnGrids::Parameters& param) const
+{
+	return getGrid(param, false);
+}
+
+/**
+ * @brief Request the part of a specific grid that is computed by the calling process (columns
+ * mpi_offset to mpi_offset+mpi_nx-1). This does not require any communication between the processes.
+ * @param param parameter
+ * @return 2D output grid covering the columns of the calling process (empty if the requested parameter was not available)
+ */
+mio::Grid2DObject SnowpackInterface::getGridSlice(const SnGrids::Parameters& param) const
+{
+	mio::Grid2DObject grid;
+	if (getForcingGrid(param, grid))
+		return mio::Grid2DObject(grid, mpi_offset, 0, mpi_nx, dimy);
+
+	return getWorkersSlice(param);
+}
+
+/**
+ * @brief Request specific grid by parameter type. Each process only transmits the columns it has computed.
+ * @param param parameter
+ * @param master_only if true, only the master process receives the full grid (this saves the transfers
+ * when the grid is only written out), the other processes get a grid that only contains their own columns
+ * @return 2D output grid (empty if the requested parameter was not available)
+ */
+mio::Grid2DObject SnowpackInterface::getGrid(const SnGrids::Parameters& param, const bool& master_only) const
+{
+	mio::Grid2DObject o_grid2D;
+	if (getForcingGrid(param, o_grid2D)) return o_grid2D;
+
+	const mio::Grid2DObject slice( getWorkersSlice(param) );
+	o_grid2D.set(dem, mio::IOUtils::nodata);
+	if (!slice.empty()) o_grid2D.grid2D.fill(slice.grid2D, mpi_offset, 0, mpi_nx, dimy);
+
+	//all processes must take part in the exchange, even if their own slice is not available
+	if (master_only)
+		MPIControl::instance().gather(o_grid2D, mpi_offset, mpi_nx);
+	else
+		MPIControl::instance().allgather(o_grid2D, mpi_offset, mpi_nx);
+
+	if (slice.empty()) o_grid2D.clear(); //the requested parameter was not available
+	return o_grid2D;
+}
+
+/**
+ * @brief Get the meteo forcing grids and other grids that are only known by SnowpackInterface
+ * (these are available over the whole domain on all processes)
+ * @param param parameter
+ * @param grid grid to fill
+ * @return true if the parameter is such a grid
+ */
+bool SnowpackInterface::getForcingGrid(const SnGrids::Parameters& param, mio::Grid2DObject& grid) const
 {
 	//special case for the meteo forcing grids
 	switch (param) {
 		case SnGrids::TA:
-			return ta;
+			grid = ta;
+			return true;
 		case SnGrids::RH:
-			return rh;
+			grid = rh;
+			return true;
 		case SnGrids::VW:
-			return vw;
+			grid = vw;
+			return true;
 		case SnGrids::VW_DRIFT:
-			return vw_drift;
+			grid = vw_drift;
+			return true;
 		case SnGrids::DW:
-			return dw;
+			grid = dw;
+			return true;
 		case SnGrids::PSUM:
-			return psum;
+			grid = psum;
+			return true;
 		case SnGrids::PSUM_PH:
-			return psum_ph;
+			grid = psum_ph;
+			return true;
 		case SnGrids::PSUM_TECH:
-			return psum_tech;
+			grid = psum_tech;
+			return true;
 		case SnGrids::MNS:
-			return mns;
+			grid = mns;
+			return true;
 		case SnGrids::ISWR:
-			return shortwave;
+			grid = shortwave;
+			return true;
 		case SnGrids::ILWR:
-			return longwave;
+			grid = longwave;
+			return true;
     case SnGrids::ISWR_TERRAIN:
-      return terrain_shortwave;
+      grid = terrain_shortwave;
+      return true;
     case SnGrids::ILWR_TERRAIN:
-      return terrain_longwave;
+      grid = terrain_longwave;
+      return true;
     case SnGrids::ISWR_DIFF:
-		  return diffuse;
+		  grid = diffuse;
+		  return true;
 		case SnGrids::ISWR_DIR:
-			return shortwave-diffuse-terrain_shortwave;
+			grid = shortwave-diffuse-terrain_shortwave;
+			return true;
 		case SnGrids::WINDEROSIONDEPOSITION:
-			return winderosiondeposition;
+			grid = winderosiondeposition;
+			return true;
 		default: ; //so compilers do not complain about missing conditions
 	}
 
-	mio::Grid2DObject o_grid2D(dem, 0.); //so the allreduce_sum works
+	return false;
+}
+
+/**
+ * @brief Collect a grid from the workers of the calling process
+ * @param param parameter
+ * @return grid covering the columns of the calling process (empty if the requested parameter was not available)
+ */
+mio::Grid2DObject SnowpackInterface::getWorkersSlice(const SnGrids::Parameters& param) const
+{
 	size_t errCount = 0;
 	mio::Grid2DObject tmp_grid2D_(dem,mpi_offset, 0, mpi_nx, dimy);
 	mio::Grid2DObject tmp_grid2D(tmp_grid2D_,mio::IOUtils::nodata);
@@ -823,16 +902,12 @@ mio::Grid2DObject SnowpackInterface::getGrid(const SnGrids::Parameters& param) c
 			errCount++;
 		}
 	}
-	o_grid2D.grid2D.fill(tmp_grid2D.grid2D, mpi_offset, 0, mpi_nx, dimy);
-
-	MPIControl::instance().allreduce_sum(o_grid2D);
-	//with some MPI implementations, when transfering large amounts of data, the buffers might get full and lead to a crash
 
 	if (errCount>0) {
 		std::cerr << "[W] Requested " << SnGrids::getParameterName( param ) << " but this was not available in the workers\n";
-		o_grid2D.clear(); //the requested parameter was not available
+		tmp_grid2D.clear(); //the requested parameter was not available
 	}
-	return o_grid2D;
+	return tmp_grid2D;
 }
 
 /**
@@ -169,8 +169,12 @@ class Runoff; // forward declaration, cyclic header include
 		                            const mio::Date& timestamp);
 
 		mio::Grid2DObject getGrid(const SnGrids::Parameters& param) const;
+		mio::Grid2DObject getGridSlice(const SnGrids::Parameters& param) const;
 
 	private:
+		mio::Grid2DObject getGrid(const SnGrids::Parameters& param, const bool& master_only) const;
+		bool getForcingGrid(const SnGrids::Parameters& param, mio::Grid2DObject& grid) const;
+		mio::Grid2DObject getWorkersSlice(const SnGrids::Parameters& param) const;
     static const std::vector<std::string> grids_not_computed_in_worker;
 		std::string getGridsRequirements() const;
 		mio::Config readAndTweakConfig(const mio::Config& io_cfg,const bool have_pts);
@@ -132,12 +132,12 @@ SnowpackInterfaceWorker::SnowpackInterfaceWorker(const mio::Config& io_cfg,
                                                  const std::vector<std::pair<size_t,size_t> >& snow_stations_coord,
                                                  const size_t offset_in,
                                                  const std::vector<std::string>& grids_not_computed_in_worker)
- : sn_cfg(io_cfg), sn(sn_cfg), meteo(sn_cfg), stability(sn_cfg, false), sn_techsnow(sn_cfg), dem(dem_in),
+ : sn_cfg(io_cfg), sn(sn_cfg), meteo(sn_cfg), landuse_keys(N_LANDUSE_CLASSES), landuse_class(snow_stations.size(), LU_DEFAULT), stability(sn_cfg, false), sn_techsnow(sn_cfg), dem(dem_in),
    dimx(dem.getNx()), dimy(dem.getNy()),  offset(offset_in), SnowStations(snow_stations), SnowStationsCoord(snow_stations_coord),
    isSpecialPoint(snow_stations.size(), false), landuse(landuse_in), store(dem_in, 0.), erodedmass(dem_in, 0.), grids(), snow_pixel(), meteo_pixel(),
    surface_flux(), soil_temp_depths(), calculation_step_length(0.), height_of_wind_value(0.),
    snow_temp_depth(IOUtils::nodata), snow_avg_temp_depth(IOUtils::nodata), snow_avg_rho_depth(IOUtils::nodata),
-   enable_simple_snow_drift(false), useDrift(false), useEBalance(false), useCanopy(false)
+   exposed_glacier_albedo(IOUtils::nodata), enable_simple_snow_drift(false), useDrift(false), useEBalance(false), useCanopy(false)
 {
 
 	sn_cfg.getValue("CALCULATION_STEP_LENGTH", "Snowpack", calculation_step_length);
@@ -151,6 +151,13 @@ SnowpackInterfaceWorker::SnowpackInterfaceWorker(const mio::Config& io_cfg,
 	enable_simple_snow_drift = false;
 	sn_cfg.getValue("SIMPLE_SNOW_DRIFT", "Alpine3D", enable_simple_snow_drift, IOUtils::nothrow);
 
+	//albedo of exposed glaciers (when sw_mode != BOTH, the calculation internally relies on SnLaws and should not be overwritten)
+	const std::string sw_mode = sn_cfg.get("SW_MODE", "Snowpack");
+	if (sw_mode == "BOTH") {
+		const std::string variant = sn_cfg.get("VARIANT", "SnowpackAdvanced");
+		exposed_glacier_albedo = (variant == "POLAR" || variant == "ANTARCTICA") ? (Constants::blueice_albedo) : (Constants::glacier_albedo);
+	}
+
 	//create the vector of output grids
 	std::vector<std::string> params = sn_cfg.get("GRIDS_PARAMETERS", "output");
 	if (snow_temp_depth!=IOUtils::nodata) params.push_back("TSNOW");
@@ -187,7 +194,10 @@ SnowpackInterfaceWorker::SnowpackInterfaceWorker(const mio::Config& io_cfg,
 		if (!pts_in.empty()) { //is it a special point?
 			isSpecialPoint[ii] = is_special(pts_in, ix, iy);
 		}
+		landuse_class[ii] = getLanduseClass(landuse(ix,iy));
 	}
+
+	initLanduseKeys();
 }
 
 SnowpackInterfaceWorker::~SnowpackInterfaceWorker()
@@ -197,6 +207,63 @@ SnowpackInterfaceWorker::~SnowpackInterfaceWorker()
 		((SnowStations.back()!=NULL)? delete SnowStations.back() : (void)0) , SnowStations.pop_back();
 }
 
+/**
+ * @brief Landuse class of a pixel, that defines which Snowpack configuration applies to it
+ * @param landuse_val landuse code of the pixel
+ * @return landuse class
+ */
+SnowpackInterfaceWorker::LanduseClass SnowpackInterfaceWorker::getLanduseClass(const double& landuse_val)
+{
+	const int land = (round_landuse(landuse_val) - 10000) / 100;
+	if (land==13) return LU_FIRN;
+	if (land==14) return LU_GLACIER;
+	return LU_DEFAULT;
+}
+
+/**
+ * @brief Build the SnowpackAdvanced keys of each landuse class.
+ * For ice and firn pixels, the BUCKET model is used for water transport. For glacier pixels, the meteo height
+ * correction is also removed and the elements are merged. The default class restores the user's values.
+ * Since Snowpack and Meteo read some of these keys in their constructors, only the objects that are built while
+ * running a pixel (such as WaterTransport) see the values of its landuse class.
+ */
+void SnowpackInterfaceWorker::initLanduseKeys()
+{
+	static const char* keys[] = {"WATERTRANSPORTMODEL_SNOW", "WATERTRANSPORTMODEL_SOIL", "REDUCE_N_ELEMENTS", "ADJUST_HEIGHT_OF_METEO_VALUES", "ADJUST_HEIGHT_OF_WIND_VALUE"};
+	std::vector< std::pair<std::string, std::string> > &default_keys = landuse_keys[LU_DEFAULT];
+	for (size_t ii=0; ii<sizeof(keys)/sizeof(keys[0]); ii++) {
+		const std::string value = sn_cfg.get(keys[ii], "SnowpackAdvanced");
+		default_keys.push_back( std::make_pair(std::string(keys[ii]), value) );
+	}
+
+	std::vector< std::pair<std::string, std::string> > &firn_keys = landuse_keys[LU_FIRN];
+	firn_keys.push_back( std::make_pair(std::string("WATERTRANSPORTMODEL_SNOW"), std::string("BUCKET")) );
+	firn_keys.push_back( std::make_pair(std::string("WATERTRANSPORTMODEL_SOIL"), std::string("BUCKET")) );
+
+	std::vector< std::pair<std::string, std::string> > &glacier_keys = landuse_keys[LU_GLACIER];
+	glacier_keys = firn_keys;
+	glacier_keys.push_back( std::make_pair(std::string("REDUCE_N_ELEMENTS"), std::string("TRUE")) );
+	glacier_keys.push_back( std::make_pair(std::string("ADJUST_HEIGHT_OF_METEO_VALUES"), std::string("FALSE")) );
+	glacier_keys.push_back( std::make_pair(std::string("ADJUST_HEIGHT_OF_WIND_VALUE"), std::string("FALSE")) );
+}
+
+/**
+ * @brief Switch the Snowpack configuration to the keys of a given landuse class.
+ * The keys of the default class are set first, so the keys that a class does not override get the user's values.
+ * @param lu landuse class
+ */
+void SnowpackInterfaceWorker::setLanduseKeys(const LanduseClass& lu)
+{
+	const std::vector< std::pair<std::string, std::string> > &default_keys = landuse_keys[LU_DEFAULT];
+	for (size_t ii=0; ii<default_keys.size(); ii++)
+		sn_cfg.addKey(default_keys[ii].first, "SnowpackAdvanced", default_keys[ii].second);
+	if (lu==LU_DEFAULT) return;
+
+	const std::vector< std::pair<std::string, std::string> > &lu_keys = landuse_keys[lu];
+	for (size_t ii=0; ii<lu_keys.size(); ii++)
+		sn_cfg.addKey(lu_keys[ii].first, "SnowpackAdvanced", lu_keys[ii].second);
+}
+
 /******************************************************************************
  * Methods that have to do with output
  ******************************************************************************/
@@ -448,11 +515,7 @@ void SnowpackInterfaceWorker::runModel(const mio::Date &date,
                                        const double solarElevation)
 {
 	const Meteo::ATM_STABILITY USER_STABILITY = meteo.getStability();
-	const std::string bcu_watertransportmodel_snow = sn_cfg.get("WATERTRANSPORTMODEL_SNOW", "SnowpackAdvanced");
-	const std::string bcu_watertransportmodel_soil = sn_cfg.get("WATERTRANSPORTMODEL_SOIL", "SnowpackAdvanced");
-	const std::string bcu_reduce_n_elements = sn_cfg.get("REDUCE_N_ELEMENTS", "SnowpackAdvanced");
-	const std::string bcu_adjust_height_of_meteo= sn_cfg.get("ADJUST_HEIGHT_OF_METEO_VALUES", "SnowpackAdvanced");
-	const std::string bcu_adjust_height_of_wind = sn_cfg.get("ADJUST_HEIGHT_OF_WIND_VALUE", "SnowpackAdvanced");
+	LanduseClass current_lu = LU_DEFAULT; //landuse class the keys of sn_cfg are currently set for
 
 	CurrentMeteo meteoPixel(sn_cfg);
 	meteoPixel.date = date;
@@ -473,18 +536,12 @@ void SnowpackInterfaceWorker::runModel(const mio::Date &date,
 		SnowStation &snowPixel = *SnowStations[index_SnowStation];
 		const bool isGlacier = snowPixel.isGlacier(false);
 
-		//In case of ice and firn pixels, use BUCKET model for water transport:
-		const int land = (round_landuse(landuse(ix,iy)) - 10000) / 100;
-		if (land==13 || land==14) {
-			sn_cfg.addKey("WATERTRANSPORTMODEL_SNOW", "SnowpackAdvanced", "BUCKET");
-			sn_cfg.addKey("WATERTRANSPORTMODEL_SOIL", "SnowpackAdvanced", "BUCKET");
-		}
-		// In case of glacier pixel, remove meteo height correction and try to merge elemnts
-		if (land==14) {
-			sn_cfg.addKey("REDUCE_N_ELEMENTS", "SnowpackAdvanced", "TRUE");
-			sn_cfg.addKey("ADJUST_HEIGHT_OF_METEO_VALUES","SnowpackAdvanced","FALSE");
-			sn_cfg.addKey("ADJUST_HEIGHT_OF_WIND_VALUE","SnowpackAdvanced","FALSE");
+		//In case of ice and firn pixels, switch to their Snowpack keys (see initLanduseKeys())
+		if (landuse_class[index_SnowStation]!=current_lu) {
+			current_lu = landuse_class[index_SnowStation];
+			setLanduseKeys(current_lu);
 		}
+
 		// Set curent meteo variables from 2D fields to single pixel
 		const double previous_albedo = getGridPoint(SnGrids::TOP_ALB, ix, iy);
 		meteoPixel.rh = rh(ix,iy);
@@ -527,12 +584,8 @@ void SnowpackInterfaceWorker::runModel(const mio::Date &date,
 
 		// exposed glacier special case
 		if (isGlacier) {
-			const std::string tmp_sw_mode = sn_cfg.get("SW_MODE", "Snowpack");
-			if (tmp_sw_mode == "BOTH") {
-				//switch to glacier albedo (when sw_mode != BOTH, the calculation internally relies on SnLaws and should not be overwritten here!)
-				const std::string tmp_variant = sn_cfg.get("VARIANT", "SnowpackAdvanced");
-				snowPixel.Albedo = ((tmp_variant == "POLAR" || tmp_variant == "ANTARCTICA") ? (Constants::blueice_albedo) : (Constants::glacier_albedo));
-			}
+			//switch to glacier albedo
+			if (exposed_glacier_albedo != IOUtils::nodata) snowPixel.Albedo = exposed_glacier_albedo;
 			if (meteoPixel.ta>IOUtils::C_TO_K(5.)) {
 				//switch to STABLE atmosphere on glacier if TA>5°C
 				meteo.setStability(Meteo::MO_HOLTSLAG);
@@ -610,13 +663,8 @@ void SnowpackInterfaceWorker::runModel(const mio::Date &date,
 		//switch stability back to normal if it was changed
 		if (meteo.getStability()!=USER_STABILITY) meteo.setStability(USER_STABILITY);
 		//if the glacier is still exposed, force the albedo back to glacier albedo
-		if (isGlacier) {
-			const std::string tmp_sw_mode = sn_cfg.get("SW_MODE", "Snowpack");
-			if (tmp_sw_mode == "BOTH") {
-				//switch to glacier albedo (when sw_mode != BOTH, the calculation internally relies on SnLaws and should not be overwritten here!)
-				const std::string tmp_variant = sn_cfg.get("VARIANT", "SnowpackAdvanced");
-				surfaceFlux.pAlbedo = snowPixel.Albedo = ((tmp_variant == "POLAR" || tmp_variant == "ANTARCTICA") ? (Constants::blueice_albedo) : (Constants::glacier_albedo));
-			}
+		if (isGlacier && exposed_glacier_albedo != IOUtils::nodata) {
+			surfaceFlux.pAlbedo = snowPixel.Albedo = exposed_glacier_albedo;
 		}
 		if (!std::isfinite( getGridPoint(SnGrids::TOP_ALB, ix, iy) )) {
 			//if the albedo is nan, infinity, etc reset it to its previous
@@ -642,19 +690,10 @@ void SnowpackInterfaceWorker::runModel(const mio::Date &date,
 		// Output special points and grids
 		if (isSpecialPoint[index_SnowStation]) gatherSpecialPoints(meteoPixel, snowPixel, surfaceFlux);
 		fillGrids(ix, iy, meteoPixel, snowPixel, surfaceFlux);
-
-		//Restore original water transport scheme that has been changed for ice & firn
-		if (land==13 || land==14) {
-			sn_cfg.addKey("WATERTRANSPORTMODEL_SNOW", "SnowpackAdvanced", bcu_watertransportmodel_snow);
-			sn_cfg.addKey("WATERTRANSPORTMODEL_SOIL", "SnowpackAdvanced", bcu_watertransportmodel_soil);
-		}
-		//Restore original keys that were modified for glacier pixels
-		if (land==14) {
-			sn_cfg.addKey("REDUCE_N_ELEMENTS", "SnowpackAdvanced", bcu_reduce_n_elements);
-			sn_cfg.addKey("ADJUST_HEIGHT_OF_METEO_VALUES", "SnowpackAdvanced", bcu_adjust_height_of_meteo);
-			sn_cfg.addKey("ADJUST_HEIGHT_OF_WIND_VALUE", "SnowpackAdvanced", bcu_adjust_height_of_wind);
-		}
 	}
+
+	//Restore the original keys that were modified for ice & firn
+	if (current_lu!=LU_DEFAULT) setLanduseKeys(LU_DEFAULT);
 }
 
 void SnowpackInterfaceWorker::grooming(const mio::Date &current_date, const mio::Grid2DObject &grooming_map)
@@ -72,6 +72,17 @@ class SnowpackInterfaceWorker
 		void setLateralFlow(const std::vector<SnowStation*>& snow_station);
 
 	private:
+		typedef enum LANDUSE_CLASS {
+			LU_DEFAULT, ///< all landuse codes that do not need specific Snowpack keys
+			LU_FIRN, ///< firn pixels (landuse code 13)
+			LU_GLACIER, ///< glacier pixels (landuse code 14)
+			N_LANDUSE_CLASSES
+		} LanduseClass;
+
+		static LanduseClass getLanduseClass(const double& landuse_val);
+		void initLanduseKeys();
+		void setLanduseKeys(const LanduseClass& lu);
+
 		void initGrids(std::vector<std::string>& params, const std::vector<std::string>& grids_not_computed_in_worker);
 		void gatherSpecialPoints(const CurrentMeteo& meteoPixel, const SnowStation& snowPixel, const SurfaceFluxes& surfaceFlux);
 		void fillGrids(const size_t& ii, const size_t& jj, const CurrentMeteo& meteoPixel, const SnowStation& snowPixel, const SurfaceFluxes& surfaceFlux);
@@ -81,6 +92,8 @@ class SnowpackInterfaceWorker
 		SnowpackConfig sn_cfg; // created on element
 		Snowpack sn;
 		Meteo meteo;
+		std::vector< std::vector< std::pair<std::string, std::string> > > landuse_keys; // SnowpackAdvanced keys and values of each landuse class
+		std::vector<LanduseClass> landuse_class; // landuse class of each SnowStation
 		Stability stability;
 		TechSnow sn_techsnow;
 
@@ -104,6 +117,7 @@ class SnowpackInterfaceWorker
 		double calculation_step_length;
 		double height_of_wind_value;
 		double snow_temp_depth, snow_avg_temp_depth, snow_avg_rho_depth;
+		double exposed_glacier_albedo; // albedo to force on exposed glaciers, nodata if the albedo should not be forced
 		bool enable_simple_snow_drift;
 		bool useDrift, useEBalance, useCanopy;
 };
@@ -14,6 +14,7 @@
 #include <unistd.h>
 
 using namespace mio;
+using namespace Vector3D;
 
 
 SolarPanel::SolarPanel(const mio::Config& cfg, const mio::DEMObject &dem_in, const std::vector<std::vector<double> > &pv_pts):
@@ -134,7 +135,7 @@ void SolarPanel::setGridRadiation(const mio::Array2D<double>& in_albedo, const m
 				if (v_globalsun[2]>0 && VectorScalarProduct(TriangleNormal(ii,jj,1),v_globalsun)>0 && in_direct(ii,jj)!=0) // Criteria: 1) Day, 2) Self-shading, 3) horizon-shading
 				{
 					double proj_to_ray, proj_to_triangle;
-					std::vector<double> triangle_normal=TriangleNormal(ii,jj,1);
+					Vec3D triangle_normal=TriangleNormal(ii,jj,1);
 
 					proj_to_ray=1./VectorScalarProduct(v_globalsun, {0,0,1});
 					proj_to_triangle=VectorScalarProduct(v_globalsun, triangle_normal);
@@ -147,7 +148,7 @@ void SolarPanel::setGridRadiation(const mio::Array2D<double>& in_albedo, const m
 				if (v_globalsun[2]>0 && VectorScalarProduct(TriangleNormal(ii,jj,0),v_globalsun)>0 && in_direct(ii,jj)!=0)
 				{
 					double proj_to_ray, proj_to_triangle;
-					std::vector<double> triangle_normal=TriangleNormal(ii,jj,0);
+					Vec3D triangle_normal=TriangleNormal(ii,jj,0);
 
 					proj_to_ray=1./VectorScalarProduct(v_globalsun, {0,0,1});
 					proj_to_triangle=VectorScalarProduct(v_globalsun, triangle_normal);
@@ -250,7 +251,7 @@ void SolarPanel::getRadfield(){
 	for (size_t number_pvp = 0; number_pvp < ViewList_panel.size(); ++number_pvp)
 	{
 		double dir_horinzontal;
-		std::vector<double> PVP_normal;
+		Vec3D PVP_normal;
 		int ii_PVP =get_ii(number_pvp);
 		int jj_PVP =get_jj(number_pvp);
 
@@ -292,7 +293,7 @@ void SolarPanel::getRadfield(){
 		{
 
 			int ii_dem, jj_dem, which_triangle;
-			std::vector<double> normal_pixel,ray_out;
+			Vec3D normal_pixel,ray_out;
 			double diffuse_solidangle, direct_solidangle, skyview_solidangle;
 			double cth_i, cth_v, cphi,R;
 
@@ -558,12 +559,7 @@ void SolarPanel::initBasicSetRotated(){
 
 	double inclination_panel,azimuth_panel;
 
-	std::vector<std::vector<double> > SVector_temp;
-
-	for (size_t number_solidangle = 0; number_solidangle < S_panel; ++number_solidangle)
-	{
-		SVector_temp.push_back({0,0,0});
-	}
+	std::vector<Vec3D> SVector_temp(S_panel, {0,0,0});
 
 	for (size_t number_pvp = 0; number_pvp < pv_points.size(); ++number_pvp)
 	{
@@ -571,18 +567,16 @@ void SolarPanel::initBasicSetRotated(){
 		inclination_panel=pv_points[number_pvp][3]*Cst::to_rad;
 		azimuth_panel=pv_points[number_pvp][4]*Cst::to_rad;
 
+		const Vec3D normal_panel=RotationAnglesToNormalVector(azimuth_panel*Cst::to_deg, inclination_panel*Cst::to_deg);
+		Vec3D axis=VectorCrossProduct({0,0,1}, normal_panel); // [MT eq. 2.39]
+		if (NormOfVector(axis)==0) axis={1,0,0};							// [MT see text after eq. 2.41]
+		if ( ( ( (int)(inclination_panel*Cst::to_deg) % 360)+360) % 360 > 180) axis=VectorStretch(axis, -1); // prevent flip of axis
+		const Mat3D rotation=RotationMatrixN(axis, inclination_panel);		// [MT eq. 2.38]
+
 		#pragma omp parallel for
 		for (size_t number_solidangle = 0; number_solidangle < S_panel; ++number_solidangle)
 		{
-			std::vector<double> v_rotated=BasicSet_horizontal[number_solidangle];
-			std::vector<double> normal_panel=RotationAnglesToNormalVector(azimuth_panel*Cst::to_deg, inclination_panel*Cst::to_deg);
-			std::vector<double> axis=VectorCrossProduct({0,0,1}, normal_panel); // [MT eq. 2.39]
-			if (NormOfVector(axis)==0) axis={1,0,0};							// [MT see text after eq. 2.41]
-			if ( ( ( (int)(inclination_panel*Cst::to_deg) % 360)+360) % 360 > 180) axis=VectorStretch(axis, -1); // prevent flip of axis
-
-			v_rotated=RotN(axis, v_rotated, inclination_panel);					// [MT eq. 2.38]
-
-			SVector_temp[number_solidangle]=v_rotated;
+			SVector_temp[number_solidangle]=Rotate(rotation, BasicSet_horizontal[number_solidangle]);
 		}
 
 		BasicSet_rotated.push_back(SVector_temp);
@@ -619,7 +613,7 @@ void SolarPanel::initViewListPanel(){
 			double distance, minimal_distance=dem.cellsize*(dem.getNx()+dem.getNy());
 
 			size_t ii_dem=ii_PVP, jj_dem=jj_PVP, nb_cells=0;
-			std::vector<double> projected_ray=ProjectVectorToPlane(BasicSet_rotated[number_pvp][number_solidangle],{0,0,1});
+			Vec3D projected_ray=ProjectVectorToPlane(BasicSet_rotated[number_pvp][number_solidangle],{0,0,1});
 			if (NormOfVector(projected_ray) != 0 ) projected_ray=normalizeVector(projected_ray);
 			else projected_ray={1,0,0}; // if it goes straight up there will be sky (no caves for 2D DEM)
 			while ( !(ii_dem<1 || ii_dem>dem.getNx()-2 || jj_dem<1 || jj_dem>dem.getNy()-2) ) {
@@ -681,7 +675,7 @@ void SolarPanel::initViewListTerrain(){
 				ViewList_panel[number_pvp][number_solidangle].push_back(99999);
 			}
 			else{
-				std::vector<double> v_out=VectorStretch(BasicSet_rotated[number_pvp][number_solidangle], -1);
+				Vec3D v_out=VectorStretch(BasicSet_rotated[number_pvp][number_solidangle], -1);
 				size_t ii_source=ViewList_panel[number_pvp][number_solidangle][1];
 				size_t jj_source=ViewList_panel[number_pvp][number_solidangle][2];
 				size_t which_triangle_source=ViewList_panel[number_pvp][number_solidangle][3];
@@ -703,6 +697,21 @@ void SolarPanel::initViewListTerrain(){
 */
 void SolarPanel::initShadelist()
 {
+	// position, normal and edges of each panel, used by doesPanelShadowPixel() for every sun position and direction
+	panel_position.resize(pv_points.size());
+	panel_normal.resize(pv_points.size());
+	panel_e_x.resize(pv_points.size());
+	panel_e_y.resize(pv_points.size());
+	for (size_t pp = 0; pp < pv_points.size(); ++pp)
+	{
+		const double inclination_panel=pv_points[pp][3]*Cst::to_rad;
+		const double azimuth_panel=pv_points[pp][4]*Cst::to_rad;
+		panel_position[pp]={pv_points[pp][0],pv_points[pp][1], dem(get_ii(pp), get_jj(pp))+pv_points[pp][2]};
+		panel_normal[pp]=RotationAnglesToNormalVector(pv_points[pp][4], pv_points[pp][3]);
+		panel_e_x[pp]=RotZ(RotX({0,-1,0}, inclination_panel), -azimuth_panel);
+		panel_e_y[pp]=RotZ(RotX({1,0,0}, inclination_panel), -azimuth_panel);
+	}
+
 	Shadelist.resize(pv_points.size(), S_panel, S_panel, 0);
 
 	for (size_t number_pvp = 0; number_pvp < pv_points.size(); ++number_pvp) // loop over PVP
@@ -710,7 +719,7 @@ void SolarPanel::initShadelist()
 		#pragma omp parallel for
 		for (size_t  solidangle_sun = 0; solidangle_sun < S_panel; ++ solidangle_sun) // loop over solid angles
 		{
-			std::vector<double> v_sun=BasicSet_horizontal[solidangle_sun];
+			const Vec3D& v_sun=BasicSet_horizontal[solidangle_sun];
 
 			for (size_t  solidangle_out = 0; solidangle_out < S_panel; ++ solidangle_out) // loop over solid angles
 			{
@@ -821,7 +830,7 @@ void SolarPanel::readSumPVP(){
 * @param[out] SList_SumPVP ViewList for this one panel
 *
 */
-mio::Array2D<double> SolarPanel::initSListSumPVP(size_t ii, size_t jj, double height, std::vector<std::vector<double> > SVector_temp)
+mio::Array2D<double> SolarPanel::initSListSumPVP(size_t ii, size_t jj, double height, const std::vector<Vec3D>& SVector_temp)
 {
 	mio::Array2D<double> SList_SumPVP;
 	SList_SumPVP.resize(S_panel, 5, -999);
@@ -840,7 +849,7 @@ mio::Array2D<double> SolarPanel::initSListSumPVP(size_t ii, size_t jj, double he
 		double distance, minimal_distance=dem.cellsize*(dem.getNx()+dem.getNy());
 
 		size_t ii_dem=ii_PVP, jj_dem=jj_PVP, nb_cells=0;
-		std::vector<double> projected_ray=ProjectVectorToPlane(SVector_temp[number_solidangle],{0,0,1});
+		Vec3D projected_ray=ProjectVectorToPlane(SVector_temp[number_solidangle],{0,0,1});
 		if (NormOfVector(projected_ray) != 0 ) projected_ray=normalizeVector(projected_ray);
 		else projected_ray={1,0,0}; // if it goes straight up there will be sky (no caves for 2D DEM)
 		while ( !(ii_dem<1 || ii_dem>dem.getNx()-2 || jj_dem<1 || jj_dem>dem.getNy()-2) ) {
@@ -880,7 +889,7 @@ mio::Array2D<double> SolarPanel::initSListSumPVP(size_t ii, size_t jj, double he
 
 		if (minimal_distance==-999) solidangle_source=999;
 		else{
-			std::vector<double> v_out=VectorStretch(SVector_temp[number_solidangle], -1);
+			Vec3D v_out=VectorStretch(SVector_temp[number_solidangle], -1);
 			solidangle_source=vectorToSPixel(v_out, ii_temp, jj_temp, which_triangle_temp, M_epsilon_terrain, M_phi_terrain);
 		}
 
@@ -905,26 +914,20 @@ mio::Array2D<double> SolarPanel::initSListSumPVP(size_t ii, size_t jj, double he
 * @param[in] inclination of panel [deg]
 * @param[out] {direct_p,diffuse_p,terrain_p} Radiation components
 */
-std::vector<double> SolarPanel::projectSum(size_t ii, size_t jj, double height, double azimuth, double inclination)
+Vec3D SolarPanel::projectSum(size_t ii, size_t jj, double height, double azimuth, double inclination)
 {
 	// generate Hemispherical Vectors
-	std::vector<std::vector<double> > SVector_temp;
-	for (size_t number_solidangle = 0; number_solidangle < S_panel; ++number_solidangle)
-	{
-		SVector_temp.push_back({0,0,0});
-	}
+	std::vector<Vec3D> SVector_temp(S_panel, {0,0,0});
+	const Vec3D normal_panel=RotationAnglesToNormalVector(azimuth, inclination);
+	Vec3D axis=VectorCrossProduct({0,0,1}, normal_panel);
+	if (NormOfVector(axis)==0) axis={1,0,0};
+	if ( ( ( (int)(inclination) % 360)+360) % 360 > 180) axis=VectorStretch(axis, -1); // prevent flip of axis
+	const Mat3D rotation=RotationMatrixN(axis, inclination*Cst::to_rad);
+
 	#pragma omp parallel for
 	for (size_t number_solidangle = 0; number_solidangle < S_panel; ++number_solidangle)
 	{
-		std::vector<double> v_rotated=BasicSet_horizontal[number_solidangle];
-		std::vector<double> normal_panel=RotationAnglesToNormalVector(azimuth, inclination);
-		std::vector<double> axis=VectorCrossProduct({0,0,1}, normal_panel);
-		if (NormOfVector(axis)==0) axis={1,0,0};
-		if ( ( ( (int)(inclination) % 360)+360) % 360 > 180) axis=VectorStretch(axis, -1); // prevent flip of axis
-
-		v_rotated=RotN(axis, v_rotated, inclination*Cst::to_rad);
-
-		SVector_temp[number_solidangle]=v_rotated;
+		SVector_temp[number_solidangle]=Rotate(rotation, BasicSet_horizontal[number_solidangle]);
 	}
 
 	mio::Array2D<double> SList_SumPVP=initSListSumPVP(ii, jj, height, SVector_temp);
@@ -955,13 +958,13 @@ std::vector<double> SolarPanel::projectSum(size_t ii, size_t jj, double height,
 		terrain_p+=TList_sum(ii_source, jj_source, which_triangle_source, solidangle_source)/S_panel*Cst::PI;
 	}
 	// Direct
-	std::vector<double> PVP_normal=RotationAnglesToNormalVector(azimuth, inclination);
+	Vec3D PVP_normal=RotationAnglesToNormalVector(azimuth, inclination);
 
 	#pragma omp parallel for reduction(+:direct_p)
 	for (size_t number_solidangle = 0; number_solidangle < S_panel; ++number_solidangle)
 	{
 		if (Direct_sum(ii,jj, number_solidangle)==0) continue;
-		std::vector<double> v_sun=BasicSet_horizontal[number_solidangle];
+		const Vec3D& v_sun=BasicSet_horizontal[number_solidangle];
 
 		double cos_sun_panel= VectorScalarProduct(v_sun, PVP_normal );
 
@@ -986,27 +989,20 @@ std::vector<double> SolarPanel::projectSum(size_t ii, size_t jj, double height,
 * @param[in] inclination of panel [deg]
 * @param[out] {direct_p,diffuse_p,terrain_p} Radiation components
 */
-std::vector<double> SolarPanel::projectTracker(size_t ii, size_t jj, double height, double azimuth, double inclination){
+Vec3D SolarPanel::projectTracker(size_t ii, size_t jj, double height, double azimuth, double inclination){
 
 	// generate Hemispherical Vectors
-	std::vector<std::vector<double> > SVector_temp;
-	for (size_t number_solidangle = 0; number_solidangle < S_panel; ++number_solidangle)
-	{
-		SVector_temp.push_back({0,0,0});
-	}
+	std::vector<Vec3D> SVector_temp(S_panel, {0,0,0});
+	const Vec3D normal_panel=RotationAnglesToNormalVector(azimuth, inclination);
+	Vec3D axis=VectorCrossProduct({0,0,1}, normal_panel);
+	if (NormOfVector(axis)==0) axis={1,0,0};
+	if ( ( ( (int)(inclination) % 360)+360) % 360 > 180) axis=VectorStretch(axis, -1); // prevent flip of axis
+	const Mat3D rotation=RotationMatrixN(axis, inclination*Cst::to_rad);
 
 	#pragma omp parallel for
 	for (size_t number_solidangle = 0; number_solidangle < S_panel; ++number_solidangle)
 	{
-		std::vector<double> v_rotated=BasicSet_horizontal[number_solidangle];
-		std::vector<double> normal_panel=RotationAnglesToNormalVector(azimuth, inclination);
-		std::vector<double> axis=VectorCrossProduct({0,0,1}, normal_panel);
-		if (NormOfVector(axis)==0) axis={1,0,0};
-		if ( ( ( (int)(inclination) % 360)+360) % 360 > 180) axis=VectorStretch(axis, -1); // prevent flip of axis
-
-		v_rotated=RotN(axis, v_rotated, inclination*Cst::to_rad);
-
-		SVector_temp[number_solidangle]=v_rotated;
+		SVector_temp[number_solidangle]=Rotate(rotation, BasicSet_horizontal[number_solidangle]);
 	}
 
 
@@ -1042,7 +1038,7 @@ std::vector<double> SolarPanel::projectTracker(size_t ii, size_t jj, double heig
 	// Direct
 	size_t solidangle_sun;
 	double cos_sun_panel, cos_sun_horizontal;
-	std::vector<double> PVP_normal=RotationAnglesToNormalVector(azimuth, inclination);
+	Vec3D PVP_normal=RotationAnglesToNormalVector(azimuth, inclination);
 
 	cos_sun_panel= VectorScalarProduct(v_globalsun, PVP_normal);
 	cos_sun_horizontal=VectorScalarProduct(v_globalsun, {0,0,1});
@@ -1063,6 +1059,22 @@ std::vector<double> SolarPanel::projectTracker(size_t ii, size_t jj, double heig
 }
 
 
+//operations on the vertices of the simplex used by optimize()
+static SolarPanel::SimplexVertex SimplexSum(const SolarPanel::SimplexVertex& x1, const SolarPanel::SimplexVertex& x2)
+{
+	return {x1[0] + x2[0], x1[1] + x2[1]};
+}
+
+static SolarPanel::SimplexVertex SimplexDifference(const SolarPanel::SimplexVertex& x1, const SolarPanel::SimplexVertex& x2)
+{
+	return {x1[0] - x2[0], x1[1] - x2[1]};
+}
+
+static SolarPanel::SimplexVertex SimplexStretch(const SolarPanel::SimplexVertex& x1, const double& factor)
+{
+	return {x1[0]*factor, x1[1]*factor};
+}
+
 /**
 * @brief  Nelder-Mead blackbox optimisation algorithm, can be given different functions to minimize
 * @param[in] ii grid coordinate (East)
@@ -1072,16 +1084,16 @@ std::vector<double> SolarPanel::projectTracker(size_t ii, size_t jj, double heig
 * @param[in] f_min function to minimize
 * @param[out] {f[k_min], x[k_min][0], x[k_min][1]} min of f_min [W/m^2], optimal inclination [deg], optimal azimuth [deg]
 */
-std::vector<double> SolarPanel::optimize(size_t ii, size_t jj, double height, size_t rounds, minfun f_min){
+Vec3D SolarPanel::optimize(size_t ii, size_t jj, double height, size_t rounds, minfun f_min){
 	const double a=1.0, b=1.0, g=0.5, h=0.5, tolerance=1;
 	bool shrink=false;
 
-	std::vector<double> f={0,0,0};
-	std::vector<double> center_old, center_new, x_r, x_e, x_c;
+	Vec3D f={0,0,0};
+	SimplexVertex center_old, center_new, x_r, x_e, x_c;
 	center_new={99,99}; center_old=center_new;
 	double f_r, f_e, f_c;
 
-	std::vector<std::vector<double>> x; // [inclination, azimuth]
+	std::vector<SimplexVertex> x;
 	size_t k_min, k_max, k_n;
 
 	x.push_back({10,0});
@@ -1127,7 +1139,7 @@ std::vector<double> SolarPanel::optimize(size_t ii, size_t jj, double height, si
 		}
 
 		// centroid & termination
-		center_new=VectorStretch(VectorSum(x[k_n],x[k_min]),0.5);
+		center_new=SimplexStretch(SimplexSum(x[k_n],x[k_min]),0.5);
 
 
 		double simplex_area=fabs(0.5*((x[1][0]-x[0][0])*(x[2][1]-x[0][1])-(x[2][0]-x[0][0])*(x[1][1]-x[0][1])));
@@ -1137,14 +1149,14 @@ std::vector<double> SolarPanel::optimize(size_t ii, size_t jj, double height, si
 			for (size_t i = 0; i < x.size(); ++i)
 			{
 				if(i==k_min) continue;
-				x[i]=VectorSum(VectorStretch(x[i], 1.2), {10*(double)rand()/RAND_MAX-5,10*(double)rand()/RAND_MAX-5});
+				x[i]=SimplexSum(SimplexStretch(x[i], 1.2), {10*(double)rand()/RAND_MAX-5,10*(double)rand()/RAND_MAX-5});
 			}
 			continue;
 		}
 
 
 		// Reflection
-		x_r=VectorSum(center_new, VectorStretch(VectorDifference(center_new,x[k_max]),a));
+		x_r=SimplexSum(center_new, SimplexStretch(SimplexDifference(center_new,x[k_max]),a));
 		f_r=(this->*f_min)(ii, jj, height, x_r);
 		if (f_r>f[k_min] && f_r<f[k_n])
 		{
@@ -1155,7 +1167,7 @@ std::vector<double> SolarPanel::optimize(size_t ii, size_t jj, double height, si
 		// Expansion
 		if (f_r<f[k_min])
 		{
-			x_e=VectorSum(center_new, VectorStretch(VectorDifference(x_r,center_new),b));
+			x_e=SimplexSum(center_new, SimplexStretch(SimplexDifference(x_r,center_new),b));
 			f_e=(this->*f_min)(ii, jj, height, x_e);
 			if(f_e < f_r){
 				x[k_max]=x_e;
@@ -1167,7 +1179,7 @@ std::vector<double> SolarPanel::optimize(size_t ii, size_t jj, double height, si
 		}
 
 		// Contraction
-		x_c=VectorSum(center_new,VectorStretch(VectorDifference(x[k_max],center_new),g));
+		x_c=SimplexSum(center_new,SimplexStretch(SimplexDifference(x[k_max],center_new),g));
 		f_c=(this->*f_min)(ii, jj, height, x_c);
 
 		if (f_c<f[k_max])
@@ -1180,7 +1192,7 @@ std::vector<double> SolarPanel::optimize(size_t ii, size_t jj, double height, si
 		for (size_t i = 0; i < x.size(); ++i)
 		{
 			if(i==k_min) continue;
-			x[i]=VectorSum(x[k_min],VectorStretch(VectorDifference(x[i],x[k_min]),h));
+			x[i]=SimplexSum(x[k_min],SimplexStretch(SimplexDifference(x[i],x[k_min]),h));
 		}
 		shrink=1;
 	}
@@ -1194,12 +1206,12 @@ std::vector<double> SolarPanel::optimize(size_t ii, size_t jj, double height, si
 * @param[in] ii grid coordinate (East)
 * @param[in] jj grid coordinate (North)
 * @param[in] height offset over terrain surface [m]
-* @param[in] x Vector defining point on hemnisphere
+* @param[in] x {inclination, azimuth} of the panel [deg]
 * @param[out] total radiation [W/m^2]
 */
-double SolarPanel::minfun_MonoTracker(size_t ii, size_t jj, double height, std::vector<double> x){
+double SolarPanel::minfun_MonoTracker(size_t ii, size_t jj, double height, const SimplexVertex& x){
 
-	std::vector<double> rad=projectTracker(ii, jj, height, x[1], x[0]);
+	Vec3D rad=projectTracker(ii, jj, height, x[1], x[0]);
 	return -(rad[0]+rad[1]+rad[2]);
 }
 
@@ -1209,12 +1221,12 @@ double SolarPanel::minfun_MonoTracker(size_t ii, size_t jj, double height, std::
 * @param[in] ii grid coordinate (East)
 * @param[in] jj grid coordinate (North)
 * @param[in] height offset over terrain surface [m]
-* @param[in] x Vector defining point on hemnisphere
+* @param[in] x {inclination, azimuth} of the panel [deg]
 * @param[out] total radiation [W/m^2]
 */
-double SolarPanel::minfun_MonoStatic(size_t ii, size_t jj, double height, std::vector<double> x){
+double SolarPanel::minfun_MonoStatic(size_t ii, size_t jj, double height, const SimplexVertex& x){
 
-	std::vector<double> rad=projectSum(ii, jj, height, x[1], x[0]);
+	Vec3D rad=projectSum(ii, jj, height, x[1], x[0]);
 	return -(rad[0]+rad[1]+rad[2]);
 }
 
@@ -1236,10 +1248,10 @@ double SolarPanel::minfun_MonoStatic(size_t ii, size_t jj, double height, std::v
 * @param[in] which_triangle triangle A (1) or B (0)
 * @param[out] distance to intersection [m] (-999 if no intersection)
 */
-double SolarPanel::IntersectionRayTriangle(std::vector<double> ray, size_t ii_PVP, size_t jj_PVP, double offset_PVP, size_t ii_dem, size_t jj_dem, int which_triangle)
+double SolarPanel::IntersectionRayTriangle(const Vec3D& ray, size_t ii_PVP, size_t jj_PVP, double offset_PVP, size_t ii_dem, size_t jj_dem, int which_triangle)
 {
-	std::vector<double> aufpunkt_ray, balance_point_par, intersection;
-	std::vector<double> e_x,e_y,e_xT,e_yT,n;
+	Vec3D aufpunkt_ray, balance_point_par, intersection;
+	Vec3D e_x,e_y,e_xT,e_yT,n;
 
 
 	double cellsize=dem.cellsize;
@@ -1293,16 +1305,16 @@ double SolarPanel::IntersectionRayTriangle(std::vector<double> ray, size_t ii_PV
 * @param[in] azimuth [deg]
 * @param[out] list_index
 */
-size_t SolarPanel::vectorToSPixel(std::vector<double> vec_in, double inclination, double azimuth, size_t N, size_t M){
+size_t SolarPanel::vectorToSPixel(const Vec3D& vec_in, double inclination, double azimuth, size_t N, size_t M){
 
 	double azimuth_flat;
 	double delta, phi_temp=0, phi;
 	int m,n=-1;
 	size_t list_index;
 
-	std::vector<double> vec_horizontal, vec_projected_xy;
-	std::vector<double> normal_panel=RotationAnglesToNormalVector(azimuth, inclination);
-	std::vector<double> axis=VectorCrossProduct({0,0,1}, normal_panel);
+	Vec3D vec_horizontal, vec_projected_xy;
+	Vec3D normal_panel=RotationAnglesToNormalVector(azimuth, inclination);
+	Vec3D axis=VectorCrossProduct({0,0,1}, normal_panel);
 
 	if (NormOfVector(axis)==0) axis={1,0,0};
 	if ( ( ( (int)(inclination) % 360)+360) % 360 > 180) axis=VectorStretch(axis, -1); // prevent flip of axis
@@ -1355,10 +1367,10 @@ size_t SolarPanel::vectorToSPixel(std::vector<double> vec_in, double inclination
 * @param[in] which_triangle triangle A (1) or B (0)
 * @param[out] list_index
 */
-size_t SolarPanel::vectorToSPixel(std::vector<double> vec_in, size_t ii_dem, size_t jj_dem, size_t which_triangle, size_t N, size_t M){
+size_t SolarPanel::vectorToSPixel(const Vec3D& vec_in, size_t ii_dem, size_t jj_dem, size_t which_triangle, size_t N, size_t M){
 
-	std::vector<double> triangle_normal=TriangleNormal(ii_dem, jj_dem, which_triangle);
-	std::vector<double> angles=NormalVectorToRotationAngles(triangle_normal);
+	Vec3D triangle_normal=TriangleNormal(ii_dem, jj_dem, which_triangle);
+	const std::array<double, 2> angles=NormalVectorToRotationAngles(triangle_normal);
 
 	double azimuth=angles[0];
 	double inclination=angles[1];
@@ -1373,7 +1385,7 @@ size_t SolarPanel::vectorToSPixel(std::vector<double> vec_in, size_t ii_dem, siz
 * @param[in] number_pvp
 * @param[out] list_index
 */
-size_t SolarPanel::vectorToSPixel(std::vector<double> vec_in, size_t number_pvp, size_t N, size_t M){
+size_t SolarPanel::vectorToSPixel(const Vec3D& vec_in, size_t number_pvp, size_t N, size_t M){
 
 	double inclination_panel, azimuth_panel;
 
@@ -1389,7 +1401,7 @@ size_t SolarPanel::vectorToSPixel(std::vector<double> vec_in, size_t number_pvp,
 * @param[in] vec_in normalized vector
 * @param[out] list_index
 */
-size_t SolarPanel::vectorToSPixel(std::vector<double> vec_in,size_t N, size_t M){
+size_t SolarPanel::vectorToSPixel(const Vec3D& vec_in,size_t N, size_t M){
 
 	return vectorToSPixel(vec_in,0,0, N, M);
 }
@@ -1402,40 +1414,31 @@ size_t SolarPanel::vectorToSPixel(std::vector<double> vec_in,size_t N, size_t M)
 * @param[in] number_solidangle index of BasicSet
 * @param[out] yes/no intersection
 */
-bool SolarPanel::doesPanelShadowPixel(std::vector<double> v_sun, size_t number_pvp, size_t number_solidangle)
+bool SolarPanel::doesPanelShadowPixel(const Vec3D& v_sun, size_t number_pvp, size_t number_solidangle)
 {
 
-	std::vector<double> ray=BasicSet_rotated[number_pvp][number_solidangle];
-	double distance=ViewList_panel[number_pvp][number_solidangle][0];
-	std::vector<double> r_0={pv_points[number_pvp][0],pv_points[number_pvp][1], dem(get_ii(number_pvp), get_jj(number_pvp))+pv_points[number_pvp][2]};
+	const Vec3D& ray=BasicSet_rotated[number_pvp][number_solidangle];
+	const double distance=ViewList_panel[number_pvp][number_solidangle][0];
+	const Vec3D& r_0=panel_position[number_pvp];
 
 	for (size_t pp = 0; pp < pv_points.size(); ++pp)
 	{
 
 		//if (pp==number_pvp) continue;
 		double d_intersect, intersection_x,intersection_y;
-		double panel_height=pv_points[pp][5];
-		double panel_width=pv_points[pp][6];
-		double inclination_panel=pv_points[pp][3]*Cst::to_rad;
-		double azimuth_panel=pv_points[pp][4]*Cst::to_rad;
+		const double panel_height=pv_points[pp][5];
+		const double panel_width=pv_points[pp][6];
 
-		std::vector<double> normal_pp=RotationAnglesToNormalVector(pv_points[pp][4], pv_points[pp][3]);
-		std::vector<double> r_pp={pv_points[pp][0],pv_points[pp][1], dem(get_ii(pp), get_jj(pp))+pv_points[pp][2]};
-		std::vector<double> delta_r=VectorDifference(r_pp, r_0);
-		std::vector<double> e_x,e_y,n, intersection;
+		const Vec3D& normal_pp=panel_normal[pp];
+		const Vec3D delta_r=VectorDifference(panel_position[pp], r_0);
 
 		d_intersect=(VectorScalarProduct(delta_r, normal_pp) -distance*VectorScalarProduct(ray, normal_pp))/VectorScalarProduct(v_sun, normal_pp);
 		if (d_intersect<0) return false;
 
-		intersection=VectorDifference(VectorSum(VectorStretch(ray,distance),VectorStretch(v_sun,d_intersect)), delta_r);
+		const Vec3D intersection=VectorDifference(VectorSum(VectorStretch(ray,distance),VectorStretch(v_sun,d_intersect)), delta_r);
 
-		e_x=RotX({0,-1,0}, inclination_panel);
-		e_x=RotZ(e_x, -azimuth_panel);
-		e_y=RotX({1,0,0}, inclination_panel);
-		e_y=RotZ(e_y, -azimuth_panel);
-
-		intersection_x=VectorScalarProduct(intersection, e_x);
-		intersection_y=VectorScalarProduct(intersection, e_y);
+		intersection_x=VectorScalarProduct(intersection, panel_e_x[pp]);
+		intersection_y=VectorScalarProduct(intersection, panel_e_y[pp]);
 
 		if (fabs(intersection_x)<=panel_height/2 && fabs(intersection_y)<=panel_width/2) return true;
 	}
@@ -1451,7 +1454,7 @@ bool SolarPanel::doesPanelShadowPixel(std::vector<double> v_sun, size_t number_p
 */
 double SolarPanel::getLandViewFactor(size_t name_pvp)
 {
-	std::vector<std::vector<double> > SList=ViewList_panel[name_pvp];
+	const std::vector<std::vector<double> >& SList=ViewList_panel[name_pvp];
 	double sum=0;
 	double factor;
 
@@ -1486,9 +1489,9 @@ double SolarPanel::getSkyViewFactor(size_t name_pvp)
 * @param[in] which_triangle triangle A (1) or B (0)
 * @param[out] Surface-normal
 */
-std::vector<double> SolarPanel::TriangleNormal(size_t ii_dem, size_t jj_dem, int which_triangle)
+Vec3D SolarPanel::TriangleNormal(size_t ii_dem, size_t jj_dem, int which_triangle)
 {
-	std::vector<double> e_x,e_y,n;
+	Vec3D e_x,e_y,n;
 	double cellsize=dem.cellsize;
 
 	if (which_triangle==1)
@@ -1557,10 +1560,10 @@ std::vector<double> SolarPanel::listindexToAngles(size_t index)
 * @param[in] normal normalized normal vector
 * @param[out] {azimuth, phi} in [deg]
 */
-std::vector<double> SolarPanel::NormalVectorToRotationAngles(std::vector<double> normal)
+std::array<double, 2> SolarPanel::NormalVectorToRotationAngles(const Vec3D& normal)
 {
 	double azimuth, phi;
-	std::vector<double> n_projected={normal[0],normal[1],0};
+	Vec3D n_projected={normal[0],normal[1],0};
 
 	phi=acos( VectorScalarProduct(normal,{0,0,1})/NormOfVector(normal) );
 
@@ -1580,9 +1583,9 @@ std::vector<double> SolarPanel::NormalVectorToRotationAngles(std::vector<double>
 * @param[in] phi (inclination) angle in[deg]
 * @param[out] v_out normalized vector
 */
-std::vector<double> SolarPanel::RotationAnglesToNormalVector(double azimuth, double phi)
+Vec3D SolarPanel::RotationAnglesToNormalVector(double azimuth, double phi)
 {
-	std::vector<double> v_out={0,0,0};
+	Vec3D v_out={0,0,0};
 	v_out[0]=-sin(phi*Cst::to_rad)*sin(azimuth*Cst::to_rad);
 	v_out[1]=-sin(phi*Cst::to_rad)*cos(azimuth*Cst::to_rad);
 	v_out[2]=cos(phi*Cst::to_rad);
@@ -1614,9 +1617,9 @@ int SolarPanel::get_jj(int number_pvp){
 			return coord_temp.getGridJ();
 }
 
-std::vector<double> SolarPanel::getVectorSun(const double solarAzimuth, const double solarElevation)
+Vec3D SolarPanel::getVectorSun(const double solarAzimuth, const double solarElevation)
 {
-	std::vector<double> v_out={0,0,0};
+	Vec3D v_out={0,0,0};
 	v_out[0]=cos(solarElevation*Cst::to_rad)*sin(solarAzimuth*Cst::to_rad);
 	v_out[1]=cos(solarElevation*Cst::to_rad)*cos(solarAzimuth*Cst::to_rad);
 	v_out[2]=sin(solarElevation*Cst::to_rad);
@@ -1631,171 +1634,7 @@ std::vector<double> SolarPanel::getVectorSun(const double solarAzimuth, const do
 //                                               ELEMENTARY FUNCTIONS
 //########################################################################################################################
 
-double SolarPanel::AngleBetween2Vectors(std::vector<double> vec1, std::vector<double> vec2)
-{
-	double sum=0;
-	double angle=0;
-	double norm1,norm2;
-	if(vec1.size()!=vec2.size()) return -999;
-
-	for (size_t i = 0; i < vec1.size(); ++i)
-	{
-		sum+=vec1[i]*vec2[i];
-	}
-	norm1=NormOfVector(vec1);
-	norm2=NormOfVector(vec2);
-
-	double val=sum/norm1/norm2;
-	if(val>1) val=1;
-	if(val<-1) val=-1;
-
-	angle=acos(val);
-	return angle;
-}
-
-double SolarPanel::NormOfVector(std::vector<double> vec1)
-{
-	return sqrt(VectorScalarProduct(vec1,vec1));
-}
-
-std::vector<double> SolarPanel::normalizeVector(std::vector<double> vec1)
-{
-	double norm=NormOfVector(vec1);
-	if (norm==0){
-		std::cout<<"Exception in SolarPanel::normalizeVector : norm is zero\n";
-		return vec1;
-	}
-
-	for (size_t i = 0; i < vec1.size(); ++i)
-	{
-		vec1[i]=vec1[i]/norm;
-	}
-
-	return vec1;
-
-}
-
-
-std::vector<double> SolarPanel::ProjectVectorToPlane(std::vector<double> vec1, std::vector<double> plane_normal)
-{
-	std::vector<double> normal=plane_normal, v_out=vec1;
-	normal=normalizeVector(normal);
-	double proj=VectorScalarProduct(normal, vec1);
-
-	for (size_t i = 0; i < vec1.size(); ++i)
-	{
-		v_out[i]=vec1[i]-proj*normal[i];
-	}
-
-	return v_out;
-}
-
-double SolarPanel::VectorScalarProduct(std::vector<double> vec1, std::vector<double> vec2)
-{
-	double sum=0;
-
-	for (size_t i = 0; i < vec1.size(); ++i)
-	{
-		sum+=vec1[i]*vec2[i];
-	}
-
-	return sum;
-}
-
-std::vector<double> SolarPanel::VectorCrossProduct(std::vector<double> vec1, std::vector<double> vec2)
-{
-	std::vector<double> v_out;
-	v_out={0,0,0};
-
-	v_out[0]=vec1[1]*vec2[2]-vec1[2]*vec2[1];
-	v_out[1]=vec1[2]*vec2[0]-vec1[0]*vec2[2];
-	v_out[2]=vec1[0]*vec2[1]-vec1[1]*vec2[0];
-
-	return v_out;
-}
-
-std::vector<double> SolarPanel::VectorSum(std::vector<double> vec1, std::vector<double> vec2)
-{
-	std::vector<double> v_out;
-
-	for (size_t i = 0; i < vec1.size(); ++i)
-	{
-		v_out.push_back(vec1[i]+vec2[i]);
-	}
-
-	return v_out;
-}
-
-std::vector<double> SolarPanel::VectorDifference(std::vector<double> vec1, std::vector<double> vec2)
-{
-	std::vector<double> v_out;
-
-	for (size_t i = 0; i < vec1.size(); ++i)
-	{
-		v_out.push_back(vec1[i]-vec2[i]);
-	}
-
-	return v_out;
-}
-
-std::vector<double> SolarPanel::VectorStretch(std::vector<double> vec1, double factor)
-{
-	std::vector<double> v_out;
-
-	for (size_t i = 0; i < vec1.size(); ++i)
-	{
-		v_out.push_back(vec1[i]*factor);
-	}
-
-	return v_out;
-}
-
-std::vector<double> SolarPanel::RotX(std::vector<double> vec_in, double rad)
-{
-	std::vector<double> vec_out(3);
-	vec_out[0]=vec_in[0];
-	vec_out[1]=cos(rad)*vec_in[1]-sin(rad)*vec_in[2];
-	vec_out[2]= sin(rad)*vec_in[1]+cos(rad)*vec_in[2];
-
-	return vec_out;
-}
-
-std::vector<double> SolarPanel::RotY(std::vector<double> vec_in, double rad)
-{
-	std::vector<double> vec_out(3);
-	vec_out[0]=cos(rad)*vec_in[0]+sin(rad)*vec_in[2];
-	vec_out[1]=vec_in[1];
-	vec_out[2]= -sin(rad)*vec_in[0]+cos(rad)*vec_in[2];
-
-	return vec_out;
-}
-
-std::vector<double> SolarPanel::RotZ(std::vector<double> vec_in, double rad)
-{
-	std::vector<double> vec_out(3);
-	vec_out[0]=cos(rad)*vec_in[0]-sin(rad)*vec_in[1];
-	vec_out[1]=sin(rad)*vec_in[0]+cos(rad)*vec_in[1];
-	vec_out[2]= vec_in[2];
-
-	return vec_out;
-}
-
-std::vector<double> SolarPanel::RotN(std::vector<double> axis, std::vector<double> vec_in, double rad)
-{
-	std::vector<double> vec_out(3);
-	double c=cos(rad);
-	double s=sin(rad);
-
-	double n1=axis[0]/NormOfVector(axis);
-	double n2=axis[1]/NormOfVector(axis);
-	double n3=axis[2]/NormOfVector(axis);
-
-	vec_out[0]=(n1*n1*(1-c)+c)*vec_in[0]+(n1*n2*(1-c)-n3*s)*vec_in[1]+(n1*n3*(1-c)+n2*s)*vec_in[2];
-	vec_out[1]=(n2*n1*(1-c)+n3*s)*vec_in[0]+(n2*n2*(1-c)+c)*vec_in[1]+(n2*n3*(1-c)-n1*s)*vec_in[2];
-	vec_out[2]=(n3*n1*(1-c)-n2*s)*vec_in[0]+(n3*n2*(1-c)+n1*s)*vec_in[1]+(n3*n3*(1-c)+c)*vec_in[2];
-
-	return vec_out;
-}
+// see alpine3d/ebalance/Vector3D.h
 
 
 //########################################################################################################################
@@ -1804,7 +1643,7 @@ std::vector<double> SolarPanel::RotN(std::vector<double> axis, std::vector<doubl
 
 
 
-void SolarPanel::PrintVector(std::vector<double> vec1)
+void SolarPanel::PrintVector(const Vec3D& vec1)
 {
 	for (size_t i = 0; i < vec1.size()-1; ++i)
 	{
@@ -1833,7 +1672,7 @@ void SolarPanel::RadiationMap(size_t ii, size_t jj, double elevation){
 		angles[1]=90-angles[1]*Cst::to_deg; // to rotation default (inclination))
 
 
-		std::vector<double> radiation=projectSum(ii, jj, elevation, angles[0],angles[1]);
+		Vec3D radiation=projectSum(ii, jj, elevation, angles[0],angles[1]);
 		double radiation_tot=radiation[0]+radiation[1]+radiation[2];
 
 		Rad_List(solidangle,0)=angles[0];
@@ -1871,7 +1710,7 @@ void SolarPanel::GridRadiationMap(double offset){
 		#pragma omp parallel for
 		for (size_t jj = 1; jj < dimy-1; jj+=1)
 		{
-			std::vector<double> radiation=optimize(ii, jj, offset, 40, &SolarPanel::minfun_MonoStatic);
+			Vec3D radiation=optimize(ii, jj, offset, 40, &SolarPanel::minfun_MonoStatic);
 
 			Rad_List(ii,jj,0)=radiation[0];
 			Rad_List(ii,jj,1)=radiation[1];
@@ -1902,7 +1741,7 @@ void SolarPanel::WriteOptimumTrackerRadiation(size_t number_pvp, std::string fil
 
 	double height=3;
 
-	std::vector<double> optimum_tracker, radiation_tracker;
+	Vec3D optimum_tracker, radiation_tracker;
 	if (v_globalsun[2]>0)
 	{
 		optimum_tracker=optimize(get_ii(number_pvp),get_jj(number_pvp),height, 20, &SolarPanel::minfun_MonoTracker);
@@ -1926,9 +1765,9 @@ void SolarPanel::WriteSunTrackerRadiation(size_t number_pvp, std::string filenam
 	if (Terrain_complex_mode!=true) throw std::invalid_argument( "[E] SolarPanel::WriteSunTrackerRadiation only runs in TerrainRadiationComplex-mode \n");
 
 	double height=3;
-	std::vector<double> angles=NormalVectorToRotationAngles(v_globalsun);
+	const std::array<double, 2> angles=NormalVectorToRotationAngles(v_globalsun);
 
-	std::vector<double> optimum_tracker, radiation_tracker;
+	Vec3D optimum_tracker, radiation_tracker;
 	if (v_globalsun[2]>0)
 	{
 		radiation_tracker=projectTracker(get_ii(number_pvp),get_jj(number_pvp),height, angles[0], angles[1]);
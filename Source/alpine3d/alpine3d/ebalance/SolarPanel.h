@@ -7,10 +7,13 @@
 #include <meteoio/dataClasses/Grid2DObject.h>
 
 #include <alpine3d/ebalance/SnowBRDF.h>
+#include <alpine3d/ebalance/Vector3D.h>
 
 class SolarPanel{
 
 	public:
+		typedef std::array<double, 2> SimplexVertex; ///< {inclination, azimuth} [deg] of a panel, as optimized by optimize()
+
 		SolarPanel(){};
 
 		SolarPanel(const mio::Config& cfg, const mio::DEMObject &dem_in, const std::vector<std::vector<double> > &pv_pts);
@@ -25,7 +28,7 @@ class SolarPanel{
 		void writeSP(const unsigned int max_steps);
 
 	private:
-		typedef double (SolarPanel::*minfun)(size_t, size_t, double, std::vector<double>);
+		typedef double (SolarPanel::*minfun)(size_t, size_t, double, const SimplexVertex&);
 
 
 		// Initialisation Functions Functions
@@ -40,13 +43,13 @@ class SolarPanel{
 
 
 		// Essential Functions
-		size_t vectorToSPixel(std::vector<double> vec_in, size_t N, size_t M);
-		size_t vectorToSPixel(std::vector<double> vec_in, size_t number_pvp, size_t N, size_t M);
-		size_t vectorToSPixel(std::vector<double> vec_in, double inclination_panel, double azimuth_panel, size_t N, size_t M);
-		size_t vectorToSPixel(std::vector<double> vec_in, size_t ii_dem, size_t jj_dem, size_t which_triangle, size_t N, size_t M);
+		size_t vectorToSPixel(const Vec3D& vec_in, size_t N, size_t M);
+		size_t vectorToSPixel(const Vec3D& vec_in, size_t number_pvp, size_t N, size_t M);
+		size_t vectorToSPixel(const Vec3D& vec_in, double inclination_panel, double azimuth_panel, size_t N, size_t M);
+		size_t vectorToSPixel(const Vec3D& vec_in, size_t ii_dem, size_t jj_dem, size_t which_triangle, size_t N, size_t M);
 
-		double IntersectionRayTriangle(std::vector<double> ray, size_t ii_PVP, size_t jj_PVP, double offset_PVP, size_t ii_dem, size_t jj_dem, int which_triangle);
-		bool doesPanelShadowPixel(std::vector<double> v_sun, size_t number_pvp, size_t number_solidangle);
+		double IntersectionRayTriangle(const Vec3D& ray, size_t ii_PVP, size_t jj_PVP, double offset_PVP, size_t ii_dem, size_t jj_dem, int which_triangle);
+		bool doesPanelShadowPixel(const Vec3D& v_sun, size_t number_pvp, size_t number_solidangle);
 		double getLandViewFactor(size_t name_pvp);
 		double getSkyViewFactor(size_t name_pvp);
 
@@ -54,47 +57,32 @@ class SolarPanel{
 		// Sum & Tracker Functions
 		void initSumPVP();
 		void readSumPVP();
-		mio::Array2D<double> initSListSumPVP(size_t ii, size_t jj, double height, std::vector<std::vector<double> > SVector_temp);
+		mio::Array2D<double> initSListSumPVP(size_t ii, size_t jj, double height, const std::vector<Vec3D>& SVector_temp);
 
-		std::vector<double> projectSum(size_t ii, size_t jj, double height, double azimuth, double inclination);
+		Vec3D projectSum(size_t ii, size_t jj, double height, double azimuth, double inclination);
 
-		std::vector<double> projectTracker(size_t ii, size_t jj, double height, double azimuth, double inclination);
+		Vec3D projectTracker(size_t ii, size_t jj, double height, double azimuth, double inclination);
 
-		std::vector<double> optimize(size_t ii, size_t jj, double height, size_t rounds, minfun f_min);
-		double minfun_MonoTracker(size_t ii, size_t jj, double height, std::vector<double> x);
-		double minfun_MonoStatic(size_t ii, size_t jj, double height, std::vector<double> x);
+		Vec3D optimize(size_t ii, size_t jj, double height, size_t rounds, minfun f_min);
+		double minfun_MonoTracker(size_t ii, size_t jj, double height, const SimplexVertex& x);
+		double minfun_MonoStatic(size_t ii, size_t jj, double height, const SimplexVertex& x);
 
 
 		// auxiliary functions
 		std::vector<double> listindexToAngles(size_t index);
-		std::vector<double> NormalVectorToRotationAngles(std::vector<double> normal);
-		std::vector<double> RotationAnglesToNormalVector(double azimuth, double phi);
+		std::array<double, 2> NormalVectorToRotationAngles(const Vec3D& normal);
+		Vec3D RotationAnglesToNormalVector(double azimuth, double phi);
 		int get_ii(int number_pvp);
 		int get_jj(int number_pvp);
-		std::vector<double> TriangleNormal(size_t ii_dem, size_t jj_dem, int which_triangle);
-		std::vector<double> getVectorSun(const double solarAzimuth, const double solarElevation);
-
-
-		// Elementary functions
-		double AngleBetween2Vectors(std::vector<double> vec1, std::vector<double> vec2);
-		double NormOfVector(std::vector<double> vec1);
-		std::vector<double> normalizeVector(std::vector<double> vec1);
-		std::vector<double> ProjectVectorToPlane(std::vector<double> vec1, std::vector<double> plane_normal);
-		double VectorScalarProduct(std::vector<double> vec1, std::vector<double> vec2);
-		std::vector<double> VectorCrossProduct(std::vector<double> vec1, std::vector<double> vec2);
+		Vec3D TriangleNormal(size_t ii_dem, size_t jj_dem, int which_triangle);
+		Vec3D getVectorSun(const double solarAzimuth, const double solarElevation);
 
-		std::vector<double> VectorSum(std::vector<double> vec1, std::vector<double> vec2);
-		std::vector<double> VectorDifference(std::vector<double> vec1, std::vector<double> vec2);
-		std::vector<double> VectorStretch(std::vector<double> vec1, double factor);
 
-		std::vector<double> RotX(std::vector<double> vec_in, double rad);
-		std::vector<double> RotY(std::vector<double> vec_in, double rad);
-		std::vector<double> RotZ(std::vector<double> vec_in, double rad);
-		std::vector<double> RotN(std::vector<double> axis, std::vector<double> vec_in, double rad);
+		// Elementary functions: see Vector3D.h
 
 
 		// Output functions for testing
-		void PrintVector(std::vector<double> vec1);
+		void PrintVector(const Vec3D& vec1);
 		void RadiationMap(size_t ii, size_t jj, double elevation);
 		void GridRadiationMap(double offset);
 		void WriteOptimumTrackerRadiation(size_t number_pvp, std::string filename, const mio::Date timestamp);
@@ -107,19 +95,20 @@ class SolarPanel{
 		size_t M_epsilon_terrain, M_phi_terrain;
 		size_t S_terrain;
 		bool Terrain_complex_mode=false;
-		std::vector<double> v_globalsun;
+		Vec3D v_globalsun;
 
 		mio::DEMObject dem;
 		std::vector<std::vector<double> > pv_points;
 		SnowBRDF BRDFobject;
 		mio::Timer timer;
 		mio::Array3D<size_t> Shadelist;
+		std::vector<Vec3D> panel_position, panel_normal, panel_e_x, panel_e_y; //geometry of each PVP, for the shading
 		bool generate_PVP_sum;
 		bool sun_tracker;
 		bool optimal_tracker;
 
-		std::vector<std::vector<double> > BasicSet_horizontal; //Spherical-pixel vectors horizontal case
-		std::vector<std::vector<std::vector<double> > > BasicSet_rotated; //For each PVP a set of Spherical-pixel vectors according to inclination and azimuth of Pannel
+		std::vector<Vec3D> BasicSet_horizontal; //Spherical-pixel vectors horizontal case
+		std::vector<std::vector<Vec3D> > BasicSet_rotated; //For each PVP a set of Spherical-pixel vectors according to inclination and azimuth of Pannel
 		std::vector<std::vector<std::vector<double> > > ViewList_panel; //For each Spherical-pixel (and for all PVP's), the ii.jj of the DEM-grid are assigned as well as the distance
 
 
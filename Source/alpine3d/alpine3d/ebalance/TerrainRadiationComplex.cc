@@ -25,13 +25,51 @@
 #include <algorithm>
 #include <limits>
 #include <cmath>
+#include <cstdio>
+
+#if (defined _WIN32 || defined __MINGW32__) && ! defined __CYGWIN__
+	#define VIEWLIST_NO_MMAP
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+#endif
 
 using namespace mio;
 
+namespace {
+	// Header of the binary ViewList file, followed by the ViewList entries, the start of each triangle
+	// in the SortList (one more element than triangles) and the SortList itself
+	struct ViewListHeader {
+		char magic[8];
+		uint32_t version;
+		uint32_t byte_order;      // detects files written on machines of a different endianness
+		uint64_t dimx, dimy;
+		uint64_t M_epsilon, M_phi;
+		double cellsize, easting, northing;
+		uint64_t dem_hash;
+		uint64_t sort_list_size;  // number of elements in the SortList
+	};
+
+	const char viewlist_magic[8] = {'A', '3', 'D', 'V', 'I', 'E', 'W', 'L'};
+	const uint32_t viewlist_version = 1;
+	const uint32_t viewlist_byte_order = 0x01020304;
+
+	// Converts an index read from a SMET ViewList file, which must be an integer in [0, max_value[
+	uint32_t viewListIndex(const double value, const size_t max_value, const std::string &field, const std::string &filename)
+	{
+		if (value == IOUtils::nodata || !(value >= 0.) || value >= static_cast<double>(max_value) || value != std::floor(value))
+			throw InvalidFormatException("Invalid " + field + " index " + IOUtils::toString(value) + " in ViewList file " + filename, AT);
+		return static_cast<uint32_t>(value);
+	}
+}
+
 TerrainRadiationComplex::TerrainRadiationComplex(const mio::Config &cfg_in, const mio::DEMObject &dem_in,
                                                  const std::string &method)
   : TerrainRadiationAlgorithm(method), dimx(dem_in.getNx()), dimy(dem_in.getNy()), startx(0), endx(dimx),
     dem(dem_in), cfg(cfg_in), BRDFobject(cfg_in), pv_points(),
+    view_list(NULL), sort_start(NULL), sort_list(NULL), view_list_data(), sort_start_data(), sort_list_data(),
+    mapped_file(NULL), mapped_size(0),
     albedo_grid(dem_in.getNx(), dem_in.getNy(), IOUtils::nodata),
     sky_vf(2, mio::Array2D<double>(dimx, dimy, IOUtils::nodata)), sky_vf_mean(dimx, dimy, IOUtils::nodata)
 {
@@ -136,9 +174,11 @@ TerrainRadiationComplex::TerrainRadiationComplex(const mio::Config &cfg_in, cons
 	// Initialise Speed-up
 	initRList();
 	std::cout << "[i] Initialized RList" << std::endl;
-	initSortList();
+	const bool sort_list_from_file = (sort_start != NULL); // binary ViewList files also contain the SortList
+	if (!sort_list_from_file)
+		initSortList();
 	initSkyViewFactor();
-	if (if_write_view_list)
+	if (if_write_view_list && !sort_list_from_file)
 		WriteViewList(); // Write ViewList to file
 
 	if (_hasSP)
@@ -146,7 +186,10 @@ TerrainRadiationComplex::TerrainRadiationComplex(const mio::Config &cfg_in, cons
 
 }
 
-TerrainRadiationComplex::~TerrainRadiationComplex() {}
+TerrainRadiationComplex::~TerrainRadiationComplex()
+{
+	UnmapViewList();
+}
 
 //########################################################################################################################
 //                                             INITIALISATION FUNCTIONS
@@ -221,16 +264,10 @@ void TerrainRadiationComplex::initBasicSetRotated()
 					axis[2] = 0;
 				}
 
+				const Mat3D rotation = Vector3D::RotationMatrixN(axis, inclination); // same rotation for the whole Basic Set
 				for (size_t solidangle = 0; solidangle < S; ++solidangle)
 				{
-					Vec3D rotated;
-					const auto &solid_angle = BasicSet_Horizontal[solidangle];
-					RotN(axis, solid_angle, inclination, rotated); // [MT eq. 2.38]
-					auto &to_rotate = BasicSet_rotated(ii, jj, which_triangle, solidangle);
-					for (auto i = 0; i < rotated.size(); ++i)
-					{
-						to_rotate[i] = rotated[i];
-					}
+					BasicSet_rotated(ii, jj, which_triangle, solidangle) = Vector3D::Rotate(rotation, BasicSet_Horizontal[solidangle]); // [MT eq. 2.38]
 				}
 			}
 		}
@@ -248,7 +285,8 @@ void TerrainRadiationComplex::initViewList()
 
 	std::cout << "[i] Initialize Terrain Radiation Complex\n";
 
-	ViewList.resize(dimx, dimy, 2, S, {0, 0, 0, 0, 0});
+	view_list_data.assign(dimx * dimy * 2 * S, {0, 0, 0, 0, 0});
+	view_list = &view_list_data[0];
 
 	int counter = 0; // For output bar
 //loop over all triangles of surface
@@ -332,7 +370,7 @@ void TerrainRadiationComplex::initViewList()
 						VectorStretch(ray, -1, ray_stretched);
 						solidangle_temp = vectorToSPixel(ray_stretched, ii_temp, jj_temp, which_triangle_temp);
 					}
-					ViewList(ii, jj, which_triangle, solidangle) = {(double)ii_temp, (double)jj_temp, (double)which_triangle_temp, minimal_distance, (double)solidangle_temp}; // [MT eq. 2.47]
+					view_list_data[TriangleIndex(ii, jj, which_triangle) * S + solidangle] = {minimal_distance, (uint32_t)ii_temp, (uint32_t)jj_temp, (uint32_t)which_triangle_temp, (uint32_t)solidangle_temp}; // [MT eq. 2.47]
 				}
 				counter++;
 				if (counter % 10 == 0)
@@ -383,16 +421,18 @@ void TerrainRadiationComplex::initRList()
 /**
 * @brief +SPEEDUP+: For most terrain a large part of the basicSet points in the sky. SortList Stores land-pointing vectors only.
 * Only these need a iterative radiation computation. [not discussed in MT and somewhat confusing syntax in MT eq. 2.95, sorry. Better Look @ Paper ????]
+* The SortList is stored as one flat, sorted list of directions: the directions of a triangle are found between sort_start[triangle] and
+* sort_start[triangle+1].
 * @param[in] -
 * @param[out] -
 *
 */
 void TerrainRadiationComplex::initSortList()
 {
+	const size_t nr_triangles = dimx * dimy * 2;
+	std::vector<bool> is_used(nr_triangles * S, false);
 
-	SortList.resize(dimx, dimy, 2);
-
-	// Store for every triangle, the actually used Vectors (by othe triangles). Different triangles may use same vector, therefore redundancy produced
+	// Flag for every triangle the actually used Vectors (by othe triangles). Different triangles may use same vector, the flags get rid of the redundancy
 	for (size_t ii = 1; ii < dimx - 1; ++ii)
 	{
 		for (size_t jj = 1; jj < dimy - 1; ++jj)
@@ -401,90 +441,111 @@ void TerrainRadiationComplex::initSortList()
 			{
 				for (size_t solidangle = 0; solidangle < S; ++solidangle)
 				{
-
-					double distance = ViewList(ii, jj, which_triangle, solidangle)[3];
-					if (distance == -999)
+					const ViewListEntry &entry = ViewList(ii, jj, which_triangle, solidangle);
+					if (entry.distance == -999)
 						continue;
 
-					size_t ii_source = ViewList(ii, jj, which_triangle, solidangle)[0];
-					size_t jj_source = ViewList(ii, jj, which_triangle, solidangle)[1];
-					size_t which_triangle_source = ViewList(ii, jj, which_triangle, solidangle)[2];
-					size_t solidangle_source = ViewList(ii, jj, which_triangle, solidangle)[4];
-
-					SortList(ii_source, jj_source, which_triangle_source).push_back(solidangle_source);
+					is_used[TriangleIndex(entry.ii, entry.jj, entry.which_triangle) * S + entry.solidangle] = true;
 				}
 			}
 		}
 	}
 
-	// get rid of redundancy / Delete doubles
-	for (size_t ii = 1; ii < dimx - 1; ++ii)
+	// collect the flagged Vectors, they come out sorted for each triangle
+	sort_start_data.assign(nr_triangles + 1, 0);
+	sort_list_data.clear();
+	for (size_t triangle = 0; triangle < nr_triangles; ++triangle)
 	{
-		for (size_t jj = 1; jj < dimy - 1; ++jj)
+		for (size_t solidangle = 0; solidangle < S; ++solidangle)
 		{
-			for (size_t which_triangle = 0; which_triangle < 2; ++which_triangle) // Triangles: A=1, B=0  [MT Figure 2.2]
-			{
-				sort(SortList(ii, jj, which_triangle).begin(), SortList(ii, jj, which_triangle).end());
-				SortList(ii, jj, which_triangle).erase(unique(SortList(ii, jj, which_triangle).begin(), SortList(ii, jj, which_triangle).end()), SortList(ii, jj, which_triangle).end());
-			}
+			if (is_used[triangle * S + solidangle])
+				sort_list_data.push_back(static_cast<uint32_t>(solidangle));
 		}
+		sort_start_data[triangle + 1] = sort_list_data.size();
 	}
+	sort_start = &sort_start_data[0];
+	sort_list = (sort_list_data.empty()) ? NULL : &sort_list_data[0];
 }
 
 /**
-* @brief Writes Viewlist to file, use SMET format only
+* @brief Hash of the DEM (dimensions, position and altitudes), used to check that a ViewList file belongs to the current DEM
+* @return 64 bits FNV-1a hash
+*
+*/
+uint64_t TerrainRadiationComplex::DEMHash() const
+{
+	std::vector<double> values;
+	values.reserve(dem.size() + 5);
+	values.push_back(static_cast<double>(dimx));
+	values.push_back(static_cast<double>(dimy));
+	values.push_back(dem.cellsize);
+	values.push_back(dem.llcorner.getEasting());
+	values.push_back(dem.llcorner.getNorthing());
+	for (size_t ii = 0; ii < dem.size(); ++ii)
+		values.push_back(dem(ii));
+
+	return FileUtils::hashBytes(reinterpret_cast<const char *>(&values[0]), values.size() * sizeof(double));
+}
+
+/**
+* @brief Writes the ViewList and the SortList to a binary file. The file is first written under a temporary name that is
+* unique to this process and then renamed (see FileUtils::replaceFile()), so other processes never see a partially written file.
 * @param[in] -
 * @param[out] -
 *
 */
 void TerrainRadiationComplex::WriteViewList()
 {
-	std::ofstream GL_file;
-	const std::string filename = cfg.get("Complex_ViewListFile", "Ebalance");
-	GL_file.open(filename);
-	GL_file.precision(std::numeric_limits<double>::digits10);
-	GL_file << "SMET 1.1 ASCII\n[HEADER]\n";
-	GL_file << "ncols =\t" << dimx << "\n";
-	GL_file << "nrows =\t" << dimy << "\n";
-	GL_file << "cellsize =\t" << dem.cellsize << "\n";
-	GL_file << "easting =\t" << dem.llcorner.getEasting() << "\n";
-	GL_file << "northing =\t" << dem.llcorner.getNorthing() << "\n";
-	GL_file << "Elevation Points =\t" << M_epsilon << "\n";
-	GL_file << "Azimuth Points =\t" << M_phi << "\n";
-
-	GL_file << "epsg\t= 0\nnodata\t= -999\naltitude\t=0\nstation_id\t= ViewList\nstation_name\t= TerrainList\n";
-	GL_file << "fields =\t ii\t jj\t which_triangle\t solidangle\t ii_seen\t jj_seen\t which_triangle_seen\t distance\t soldiangle_seen\n";
-
-	GL_file << "[DATA]\n";
+	if (!MPIControl::instance().master()) // all processes hold the same ViewList
+		return;
 
-	for (size_t ii = 1; ii < dimx - 1; ++ii)
+	const std::string filename = cfg.get("Complex_ViewListFile", "Ebalance");
+	const std::string tmp_filename = FileUtils::getTempFilename(filename);
+	const size_t nr_triangles = dimx * dimy * 2;
+
+	ViewListHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, viewlist_magic, sizeof(header.magic));
+	header.version = viewlist_version;
+	header.byte_order = viewlist_byte_order;
+	header.dimx = dimx;
+	header.dimy = dimy;
+	header.M_epsilon = M_epsilon;
+	header.M_phi = M_phi;
+	header.cellsize = dem.cellsize;
+	header.easting = dem.llcorner.getEasting();
+	header.northing = dem.llcorner.getNorthing();
+	header.dem_hash = DEMHash();
+	header.sort_list_size = sort_start[nr_triangles];
+
+	std::ofstream GL_file(tmp_filename.c_str(), std::ios::binary);
+	if (GL_file.fail())
+		throw AccessException(tmp_filename, AT);
+	GL_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	GL_file.write(reinterpret_cast<const char *>(view_list), nr_triangles * S * sizeof(ViewListEntry));
+	GL_file.write(reinterpret_cast<const char *>(sort_start), (nr_triangles + 1) * sizeof(uint64_t));
+	if (header.sort_list_size > 0)
+		GL_file.write(reinterpret_cast<const char *>(sort_list), header.sort_list_size * sizeof(uint32_t));
+	GL_file.close();
+	if (GL_file.fail())
 	{
-		for (size_t jj = 1; jj < dimy - 1; ++jj)
-		{
-			for (size_t which_triangle = 0; which_triangle < 2; ++which_triangle) // Triangles: A=1, B=0  [MT Figure 2.2]
-			{
-				for (size_t solidangle = 0; solidangle < S; ++solidangle)
-				{
-					size_t ii_source = ViewList(ii, jj, which_triangle, solidangle)[0];
-					size_t jj_source = ViewList(ii, jj, which_triangle, solidangle)[1];
-					size_t which_triangle_source = ViewList(ii, jj, which_triangle, solidangle)[2];
-					double distance = ViewList(ii, jj, which_triangle, solidangle)[3];
-					size_t solidangle_source = ViewList(ii, jj, which_triangle, solidangle)[4];
-
-					GL_file << ii << "\t" << jj << "\t" << which_triangle << "\t" << solidangle << "\t" << ii_source << "\t" << jj_source << "\t" << which_triangle_source << "\t" << distance << "\t" << solidangle_source << "\n";
-				}
-			}
-		}
+		std::remove(tmp_filename.c_str());
+		throw IOException("Could not write ViewList file " + tmp_filename, AT);
 	}
 
-	GL_file.close();
+	if (!FileUtils::replaceFile(tmp_filename, filename))
+	{
+		std::remove(tmp_filename.c_str());
+		throw AccessException("Could not rename " + tmp_filename + " to " + filename, AT);
+	}
 	std::cout << "[i] ViewList written to file.\n";
 }
 
 /**
-* @brief Reads ViewList from file, use SMET format only
+* @brief Reads ViewList from file, either in the binary format or in the former SMET format
 * @param[in] -
 * @param[out] -
+* @return false if the file does not match the current simulation
 *
 */
 bool TerrainRadiationComplex::ReadViewList()
@@ -492,11 +553,132 @@ bool TerrainRadiationComplex::ReadViewList()
 	const std::string filename = cfg.get("Complex_ViewListFile", "Ebalance");
 
 	if (!FileUtils::fileExists(filename))
-	{
 		throw NotFoundException(filename, AT);
+
+	char signature[4] = {0, 0, 0, 0};
+	std::ifstream fin(filename.c_str(), std::ios::binary);
+	fin.read(signature, sizeof(signature));
+	fin.close();
+	if (strncmp(signature, "SMET", sizeof(signature)) == 0)
+		return ReadViewListSMET(filename);
+
+	return MapViewList(filename);
+}
+
+/**
+* @brief Maps a binary ViewList file in memory (read-only, so it is shared by all the processes of a node). Where
+* memory mapping is not available, the file is read instead.
+* @param[in] filename ViewList file
+* @param[out] -
+* @return false if the file does not match the current simulation
+*
+*/
+bool TerrainRadiationComplex::MapViewList(const std::string &filename)
+{
+	std::ifstream fin(filename.c_str(), std::ios::binary);
+	if (fin.fail())
+		throw AccessException(filename, AT);
+
+	ViewListHeader header;
+	fin.read(reinterpret_cast<char *>(&header), sizeof(header));
+	if (fin.gcount() != sizeof(header) || memcmp(header.magic, viewlist_magic, sizeof(header.magic)) != 0 || header.byte_order != viewlist_byte_order)
+	{
+		std::cout << "[E] in TerrainRadiationComplex::ReadViewList: " << filename << " is not a ViewList file of this platform\n";
+		return false;
+	}
+	if (header.version != viewlist_version)
+	{
+		std::cout << "[E] in TerrainRadiationComplex::ReadViewList: unsupported ViewList file version " << header.version << "\n";
+		return false;
+	}
+	if (header.M_epsilon != M_epsilon || header.M_phi != M_phi)
+	{
+		std::cout << "[E] in TerrainRadiationComplex::ReadViewList: Basic Set does not agree with TerrainList (got: " << header.M_epsilon << "x" << header.M_phi << ", expected: " << M_epsilon << "x" << M_phi << ")\n";
+		return false;
+	}
+	if (header.dimx != dimx || header.dimy != dimy || header.cellsize != dem.cellsize
+	    || header.easting != dem.llcorner.getEasting() || header.northing != dem.llcorner.getNorthing() || header.dem_hash != DEMHash())
+	{
+		std::cout << "[E] in TerrainRadiationComplex::ReadViewList: DEM does not agree with TerrainList\n";
 		return false;
 	}
 
+	const size_t nr_triangles = dimx * dimy * 2;
+	const size_t view_list_bytes = nr_triangles * S * sizeof(ViewListEntry);
+	const size_t sort_start_bytes = (nr_triangles + 1) * sizeof(uint64_t);
+	const size_t sort_list_bytes = header.sort_list_size * sizeof(uint32_t);
+	const size_t file_size = sizeof(header) + view_list_bytes + sort_start_bytes + sort_list_bytes;
+	fin.seekg(0, std::ios::end);
+	if (static_cast<size_t>(fin.tellg()) != file_size)
+	{
+		std::cout << "[E] in TerrainRadiationComplex::ReadViewList: " << filename << " is truncated\n";
+		return false;
+	}
+
+#ifdef VIEWLIST_NO_MMAP
+	view_list_data.resize(nr_triangles * S);
+	sort_start_data.resize(nr_triangles + 1);
+	sort_list_data.resize(header.sort_list_size);
+	fin.seekg(sizeof(header), std::ios::beg);
+	fin.read(reinterpret_cast<char *>(&view_list_data[0]), view_list_bytes);
+	fin.read(reinterpret_cast<char *>(&sort_start_data[0]), sort_start_bytes);
+	if (sort_list_bytes > 0)
+		fin.read(reinterpret_cast<char *>(&sort_list_data[0]), sort_list_bytes);
+	if (fin.fail())
+		throw IOException("Could not read ViewList file " + filename, AT);
+	view_list = &view_list_data[0];
+	sort_start = &sort_start_data[0];
+	sort_list = (sort_list_data.empty()) ? NULL : &sort_list_data[0];
+#else
+	fin.close();
+	const int fd = open(filename.c_str(), O_RDONLY);
+	if (fd == -1)
+		throw AccessException(filename, AT);
+	void *addr = mmap(NULL, file_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd); // the mapping remains valid
+	if (addr == MAP_FAILED)
+		throw IOException("Could not memory map ViewList file " + filename, AT);
+
+	mapped_file = addr;
+	mapped_size = file_size;
+	const char *data = static_cast<const char *>(addr) + sizeof(header);
+	view_list = reinterpret_cast<const ViewListEntry *>(data);
+	sort_start = reinterpret_cast<const uint64_t *>(data + view_list_bytes);
+	sort_list = reinterpret_cast<const uint32_t *>(data + view_list_bytes + sort_start_bytes);
+#endif
+	std::cout << "[i] TerrainRadiationComplex: Initialized " << M_epsilon << "x" << M_phi << " ViewList from file\n";
+
+	return true;
+}
+
+/**
+* @brief Releases the memory-mapped ViewList file, if any
+* @param[in] -
+* @param[out] -
+*
+*/
+void TerrainRadiationComplex::UnmapViewList()
+{
+#ifndef VIEWLIST_NO_MMAP
+	if (mapped_file != NULL)
+		munmap(mapped_file, mapped_size);
+#endif
+	mapped_file = NULL;
+	mapped_size = 0;
+	view_list = NULL;
+	sort_start = NULL;
+	sort_list = NULL;
+}
+
+/**
+* @brief Reads ViewList from a file in the former SMET format
+* @param[in] filename ViewList file
+* @param[out] -
+* @return false if the file does not match the current simulation
+*
+*/
+bool TerrainRadiationComplex::ReadViewListSMET(const std::string &filename)
+{
 	smet::SMETReader myreader(filename);
 	std::vector<double> vec_data;
 	myreader.read(vec_data);
@@ -515,40 +697,42 @@ bool TerrainRadiationComplex::ReadViewList()
 
 	if (dimx_file != dimx)
 	{
-		std::cout << "[E] in TerrainRadiationComplex::ReadViewList: DEM does not agree with TerrainList for field: dimx\n";
+		std::cout << "[E] in TerrainRadiationComplex::ReadViewListSMET: DEM does not agree with TerrainList for field: dimx\n";
 		return false;
 	}
 	if (dimy_file != dimy)
 	{
-		std::cout << "[E] in TerrainRadiationComplex::ReadViewList: DEM does not agree with TerrainList for field: dimy\n";
+		std::cout << "[E] in TerrainRadiationComplex::ReadViewListSMET: DEM does not agree with TerrainList for field: dimy\n";
 		return false;
 	}
 	if (std::fabs(cellsize_file - dem.cellsize) >= std::numeric_limits<double>::epsilon())
 	{
 		std::cout.precision(std::numeric_limits<double>::digits10);
-		std::cout << "[E] in TerrainRadiationComplex::ReadViewList: DEM does not agree with TerrainList for field: cellsize (got: " << cellsize_file << ", expected: " << dem.cellsize << ")\n";
+		std::cout << "[E] in TerrainRadiationComplex::ReadViewListSMET: DEM does not agree with TerrainList for field: cellsize (got: " << cellsize_file << ", expected: " << dem.cellsize << ")\n";
 		return false;
 	}
 	if (dimx_file != dimx)
 	{
-		std::cout << "[E] in TerrainRadiationComplex::ReadViewList: DEM does not agree with TerrainList for field: dimx\n";
+		std::cout << "[E] in TerrainRadiationComplex::ReadViewListSMET: DEM does not agree with TerrainList for field: dimx\n";
 		return false;
 	}
 	if (std::fabs(llx - dem.llcorner.getEasting()) >= std::numeric_limits<double>::epsilon())
 	{
 		std::cout.precision(std::numeric_limits<double>::digits10);
-		std::cout << "[E] in TerrainRadiationComplex::ReadViewList: DEM does not agree with TerrainList for field: llx (got: " << llx << ", expected: " << dem.llcorner.getEasting() << ")\n";
+		std::cout << "[E] in TerrainRadiationComplex::ReadViewListSMET: DEM does not agree with TerrainList for field: llx (got: " << llx << ", expected: " << dem.llcorner.getEasting() << ")\n";
 		return false;
 	}
 	if (std::fabs(lly - dem.llcorner.getNorthing()) >= std::numeric_limits<double>::epsilon())
 	{
 		std::cout.precision(std::numeric_limits<double>::digits10);
-		std::cout << "[E] in TerrainRadiationComplex::ReadViewList: DEM does not agree with TerrainList for field: lly (got: " << lly << ", expected: " << dem.llcorner.getNorthing() << ")\n";
+		std::cout << "[E] in TerrainRadiationComplex::ReadViewListSMET: DEM does not agree with TerrainList for field: lly (got: " << lly << ", expected: " << dem.llcorner.getNorthing() << ")\n";
 		return false;
 	}
 
-	ViewList.resize(dimx, dimy, 2, S, {0, 0, 0, 0, 0});
-	size_t ii_fd, jj_fd, which_triangle_fd, solidangle_fd, ii_seen_fd, jj_seen_fd, which_triangle_seen_fd, distance_fd, soldiangle_seen_fd;
+	view_list_data.assign(dimx * dimy * 2 * S, {0, 0, 0, 0, 0});
+	view_list = &view_list_data[0];
+	size_t ii_fd = IOUtils::npos, jj_fd = IOUtils::npos, which_triangle_fd = IOUtils::npos, solidangle_fd = IOUtils::npos, ii_seen_fd = IOUtils::npos;
+	size_t jj_seen_fd = IOUtils::npos, which_triangle_seen_fd = IOUtils::npos, distance_fd = IOUtils::npos, soldiangle_seen_fd = IOUtils::npos;
 
 	for (size_t kk = 0; kk < nr_fields; kk++)
 	{
@@ -572,10 +756,19 @@ bool TerrainRadiationComplex::ReadViewList()
 		if (tmp == "soldiangle_seen")
 			soldiangle_seen_fd = kk;
 	}
+	if (ii_fd == IOUtils::npos || jj_fd == IOUtils::npos || which_triangle_fd == IOUtils::npos || solidangle_fd == IOUtils::npos || ii_seen_fd == IOUtils::npos
+	    || jj_seen_fd == IOUtils::npos || which_triangle_seen_fd == IOUtils::npos || distance_fd == IOUtils::npos || soldiangle_seen_fd == IOUtils::npos)
+		throw InvalidFormatException("ViewList file " + filename + " does not contain all the necessary fields", AT);
+
 	for (size_t ii = 0; ii < vec_data.size(); ii += nr_fields)
 	{
-
-		ViewList(vec_data[ii + ii_fd], vec_data[ii + jj_fd], vec_data[ii + which_triangle_fd], vec_data[ii + solidangle_fd]) = {(double)vec_data[ii + ii_seen_fd], (double)vec_data[ii + jj_seen_fd], (double)vec_data[ii + which_triangle_seen_fd], vec_data[ii + distance_fd], (double)vec_data[ii + soldiangle_seen_fd]};
+		const size_t index = TriangleIndex(viewListIndex(vec_data[ii + ii_fd], dimx, "ii", filename), viewListIndex(vec_data[ii + jj_fd], dimy, "jj", filename),
+		                                   viewListIndex(vec_data[ii + which_triangle_fd], 2, "which_triangle", filename)) * S
+		                     + viewListIndex(vec_data[ii + solidangle_fd], S, "solidangle", filename);
+		view_list_data[index] = {vec_data[ii + distance_fd], viewListIndex(vec_data[ii + ii_seen_fd], dimx, "ii_seen", filename),
+		                         viewListIndex(vec_data[ii + jj_seen_fd], dimy, "jj_seen", filename),
+		                         viewListIndex(vec_data[ii + which_triangle_seen_fd], 2, "which_triangle_seen", filename),
+		                         viewListIndex(vec_data[ii + soldiangle_seen_fd], S, "soldiangle_seen", filename)};
 	}
 
 	std::cout << "[i] TerrainRadiationComplex: Initialized " << M_epsilon << "x" << M_phi << " ViewList from file\n";
@@ -649,7 +842,7 @@ void TerrainRadiationComplex::getRadiation(mio::Array2D<double>& direct, mio::Ar
 				direct_A(ii, jj) = direct_unshaded_horizontal(ii, jj) * proj_to_ray * proj_to_triangle;
 
 				solidangle_sun = vectorToSPixel(a_sun, ii, jj, 1);
-				distance_closest_triangle = ViewList(ii, jj, 1, solidangle_sun)[3];
+				distance_closest_triangle = ViewList(ii, jj, 1, solidangle_sun).distance;
 
 				if (distance_closest_triangle != -999)
 					direct_A(ii, jj) = 0;
@@ -669,7 +862,7 @@ void TerrainRadiationComplex::getRadiation(mio::Array2D<double>& direct, mio::Ar
 				direct_B(ii, jj) = direct_unshaded_horizontal(ii, jj) * proj_to_ray * proj_to_triangle;
 
 				solidangle_sun = vectorToSPixel(a_sun, ii, jj, 0);
-				distance_closest_triangle = ViewList(ii, jj, 0, solidangle_sun)[3];
+				distance_closest_triangle = ViewList(ii, jj, 0, solidangle_sun).distance;
 
 				if (distance_closest_triangle != -999)
 					direct_B(ii, jj) = 0;
@@ -765,14 +958,14 @@ void TerrainRadiationComplex::getRadiation(mio::Array2D<double>& direct, mio::Ar
 					for (size_t solidangle_in = 0; solidangle_in < S; ++solidangle_in)
 					{
 						double Rad_solidangle;
-						double distance_closest_triangle = ViewList(ii, jj, which_triangle, solidangle_in)[3];
+						double distance_closest_triangle = ViewList(ii, jj, which_triangle, solidangle_in).distance;
 						if (distance_closest_triangle == -999)
 							continue;
 
-						size_t ii_source = ViewList(ii, jj, which_triangle, solidangle_in)[0];
-						size_t jj_source = ViewList(ii, jj, which_triangle, solidangle_in)[1];
-						size_t which_triangle_source = ViewList(ii, jj, which_triangle, solidangle_in)[2];
-						size_t solidangle_source = ViewList(ii, jj, which_triangle, solidangle_in)[4];
+						size_t ii_source = ViewList(ii, jj, which_triangle, solidangle_in).ii;
+						size_t jj_source = ViewList(ii, jj, which_triangle, solidangle_in).jj;
+						size_t which_triangle_source = ViewList(ii, jj, which_triangle, solidangle_in).which_triangle;
+						size_t solidangle_source = ViewList(ii, jj, which_triangle, solidangle_in).solidangle;
 
 						Rad_solidangle = TList_ms_old(ii_source, jj_source, which_triangle_source, solidangle_source);
 						terrain_flux_new(ii, jj, which_triangle) += Rad_solidangle / S * Cst::PI;
@@ -780,20 +973,21 @@ void TerrainRadiationComplex::getRadiation(mio::Array2D<double>& direct, mio::Ar
 						Rad_solidangle = Rad_solidangle * albedo_temp / S;
 
 						size_t solidangle_out = 0;
+						const size_t triangle = TriangleIndex(ii, jj, which_triangle);
 						// These are the most expensive loops... core of [MT eq. 2.97]
 						if (albedo_temp < 0.5 || !if_anisotropy)
 						{
-							for (size_t kk = 0; kk < SortList(ii, jj, which_triangle).size(); ++kk)
+							for (uint64_t kk = sort_start[triangle]; kk < sort_start[triangle + 1]; ++kk)
 							{
-								solidangle_out = SortList(ii, jj, which_triangle)[kk];
+								solidangle_out = sort_list[kk];
 								TList_ms_new(ii, jj, which_triangle, solidangle_out) += Rad_solidangle;
 							}
 						}
 						else
 						{
-							for (size_t kk = 0; kk < SortList(ii, jj, which_triangle).size(); ++kk)
+							for (uint64_t kk = sort_start[triangle]; kk < sort_start[triangle + 1]; ++kk)
 							{
-								solidangle_out = SortList(ii, jj, which_triangle)[kk];
+								solidangle_out = sort_list[kk];
 								TList_ms_new(ii, jj, which_triangle, solidangle_out) += Rad_solidangle * RList(solidangle_in, solidangle_out);
 							}
 						}
@@ -832,14 +1026,14 @@ void TerrainRadiationComplex::getRadiation(mio::Array2D<double>& direct, mio::Ar
 					for (size_t solidangle_in = 0; solidangle_in < S; ++solidangle_in)
 					{
 						double Rad_solidangle;
-						double distance_closest_triangle = ViewList(ii, jj, which_triangle, solidangle_in)[3];
+						double distance_closest_triangle = ViewList(ii, jj, which_triangle, solidangle_in).distance;
 						if (distance_closest_triangle == -999)
 							continue;
 
-						size_t ii_source = ViewList(ii, jj, which_triangle, solidangle_in)[0];
-						size_t jj_source = ViewList(ii, jj, which_triangle, solidangle_in)[1];
-						size_t which_triangle_source = ViewList(ii, jj, which_triangle, solidangle_in)[2];
-						size_t solidangle_source = ViewList(ii, jj, which_triangle, solidangle_in)[4];
+						size_t ii_source = ViewList(ii, jj, which_triangle, solidangle_in).ii;
+						size_t jj_source = ViewList(ii, jj, which_triangle, solidangle_in).jj;
+						size_t which_triangle_source = ViewList(ii, jj, which_triangle, solidangle_in).which_triangle;
+						size_t solidangle_source = ViewList(ii, jj, which_triangle, solidangle_in).solidangle;
 
 						Rad_solidangle = TList_ms_old(ii_source, jj_source, which_triangle_source, solidangle_source);
 						terrain_flux_new(ii, jj, which_triangle) += Rad_solidangle / S * Cst::PI;
@@ -1114,7 +1308,7 @@ double TerrainRadiationComplex::computeSkyViewFactor(size_t ii_dem, size_t jj_de
 
 	for (size_t l = 0; l < S; ++l) // [MT eq. 2.60]
 	{
-		if (ViewList(ii_dem, jj_dem, which_triangle, l)[3] == -999) // [MT eq. 2.61]
+		if (ViewList(ii_dem, jj_dem, which_triangle, l).distance == -999) // [MT eq. 2.61]
 		{
 			sum++;
 		}
@@ -1181,7 +1375,7 @@ double TerrainRadiationComplex::TerrainBiggestDifference(const mio::Array3D<doub
 */
 double TerrainRadiationComplex::NormOfVector(const Vec3D &vec1)
 {
-	return sqrt(VectorScalarProduct(vec1, vec1));
+	return Vector3D::NormOfVector(vec1);
 }
 
 /**
@@ -1196,10 +1390,7 @@ void TerrainRadiationComplex::normalizeVector(const Vec3D &vec1, Vec3D &v_out)
 		return;
 	}
 
-	for (size_t i = 0; i < v_out.size(); ++i)
-	{
-		v_out[i] = vec1[i] / norm;
-	}
+	v_out = Vector3D::normalizeVector(vec1);
 }
 
 /**
@@ -1207,14 +1398,7 @@ void TerrainRadiationComplex::normalizeVector(const Vec3D &vec1, Vec3D &v_out)
 */
 double TerrainRadiationComplex::VectorScalarProduct(const Vec3D &vec1, const Vec3D &vec2)
 {
-	double sum = 0;
-
-	for (size_t i = 0; i < vec1.size(); ++i)
-	{
-		sum += vec1[i] * vec2[i];
-	}
-
-	return sum;
+	return Vector3D::VectorScalarProduct(vec1, vec2);
 }
 
 /**
@@ -1222,10 +1406,7 @@ double TerrainRadiationComplex::VectorScalarProduct(const Vec3D &vec1, const Vec
 */
 void TerrainRadiationComplex::VectorCrossProduct(const Vec3D &vec1, const Vec3D &vec2, Vec3D &v_out)
 {
-
-	v_out[0] = vec1[1] * vec2[2] - vec1[2] * vec2[1];
-	v_out[1] = vec1[2] * vec2[0] - vec1[0] * vec2[2];
-	v_out[2] = vec1[0] * vec2[1] - vec1[1] * vec2[0];
+	v_out = Vector3D::VectorCrossProduct(vec1, vec2);
 }
 
 /**
@@ -1233,10 +1414,7 @@ void TerrainRadiationComplex::VectorCrossProduct(const Vec3D &vec1, const Vec3D
 */
 void TerrainRadiationComplex::VectorSum(const Vec3D &vec1, const Vec3D &vec2, Vec3D &v_out)
 {
-	for (size_t i = 0; i < vec1.size(); ++i)
-	{
-		v_out[i] = vec1[i] + vec2[i];
-	}
+	v_out = Vector3D::VectorSum(vec1, vec2);
 }
 
 /**
@@ -1244,9 +1422,7 @@ void TerrainRadiationComplex::VectorSum(const Vec3D &vec1, const Vec3D &vec2, Ve
 */
 void TerrainRadiationComplex::VectorDifference(const Vec3D &vec1, const Vec3D &vec2, Vec3D &v_out)
 {
-	Vec3D v_stretched;
-	VectorStretch(vec2, -1, v_stretched);
-	VectorSum(vec1, v_stretched, v_out);
+	v_out = Vector3D::VectorDifference(vec1, vec2);
 }
 
 /**
@@ -1254,10 +1430,7 @@ void TerrainRadiationComplex::VectorDifference(const Vec3D &vec1, const Vec3D &v
 */
 void TerrainRadiationComplex::VectorStretch(const Vec3D &vec1, double factor, Vec3D &v_out)
 {
-	for (size_t i = 0; i < vec1.size(); ++i)
-	{
-		v_out[i] = vec1[i] * factor;
-	}
+	v_out = Vector3D::VectorStretch(vec1, factor);
 }
 
 /**
@@ -1265,16 +1438,7 @@ void TerrainRadiationComplex::VectorStretch(const Vec3D &vec1, double factor, Ve
 */
 void TerrainRadiationComplex::RotN(const Vec3D &axis, const Vec3D &vec_in, double rad, Vec3D &v_out)
 {
-	double c = cos(rad);
-	double s = sin(rad);
-
-	double n1 = axis[0] / NormOfVector(axis);
-	double n2 = axis[1] / NormOfVector(axis);
-	double n3 = axis[2] / NormOfVector(axis);
-
-	v_out[0] = (n1 * n1 * (1 - c) + c) * vec_in[0] + (n1 * n2 * (1 - c) - n3 * s) * vec_in[1] + (n1 * n3 * (1 - c) + n2 * s) * vec_in[2];
-	v_out[1] = (n2 * n1 * (1 - c) + n3 * s) * vec_in[0] + (n2 * n2 * (1 - c) + c) * vec_in[1] + (n2 * n3 * (1 - c) - n1 * s) * vec_in[2];
-	v_out[2] = (n3 * n1 * (1 - c) - n2 * s) * vec_in[0] + (n3 * n2 * (1 - c) + n1 * s) * vec_in[1] + (n3 * n3 * (1 - c) + c) * vec_in[2];
+	v_out = Vector3D::RotN(axis, vec_in, rad);
 }
 
 /**
@@ -1282,14 +1446,7 @@ void TerrainRadiationComplex::RotN(const Vec3D &axis, const Vec3D &vec_in, doubl
 */
 void TerrainRadiationComplex::ProjectVectorToPlane(const Vec3D &vec1, const Vec3D &plane_normal, Vec3D &v_out)
 {
-	//std::vector<double> normal = plane_normal, v_out = vec1;
-	Vec3D normal;
-	normalizeVector(plane_normal, normal);
-	double proj = VectorScalarProduct(normal, vec1);
-	for (size_t i = 0; i < vec1.size(); ++i)
-	{
-		v_out[i] = vec1[i] - proj * normal[i];
-	}
+	v_out = Vector3D::ProjectVectorToPlane(vec1, plane_normal);
 }
 
 /**
@@ -1297,25 +1454,7 @@ void TerrainRadiationComplex::ProjectVectorToPlane(const Vec3D &vec1, const Vec3
 */
 double TerrainRadiationComplex::AngleBetween2Vectors(const Vec3D &vec1, const Vec3D &vec2)
 {
-	double sum = 0;
-	double angle = 0;
-	double norm1, norm2;
-
-	for (size_t i = 0; i < vec1.size(); ++i)
-	{
-		sum += vec1[i] * vec2[i];
-	}
-	norm1 = NormOfVector(vec1);
-	norm2 = NormOfVector(vec2);
-
-	sum = sum / norm1 / norm2;
-	if (sum > 1)
-		sum = 1; // Had some issues with floating point
-	if (sum < -1)
-		sum = -1;
-
-	angle = acos(sum);
-	return angle;
+	return Vector3D::AngleBetween2Vectors(vec1, vec2);
 }
 
 
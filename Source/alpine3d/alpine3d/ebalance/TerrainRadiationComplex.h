@@ -24,7 +24,8 @@
 #include <alpine3d/ebalance/RadiationField.h>
 #include <alpine3d/ebalance/SolarPanel.h>
 #include <alpine3d/ebalance/SnowBRDF.h>
-#include <array>
+#include <alpine3d/ebalance/Vector3D.h>
+#include <cstdint>
 
 /**
  * @page TerrainRadiationComplex
@@ -46,7 +47,11 @@
  * COMPLEX_READ_VIEWLIST [true or false]	: Whether an existing initialization file should be read in; bypassing the initialization.
  * COMPLEX_VIEWLISTFILE [<path>/<filename>]	: Path to the ViewList file if existing. (e.g ../input/surface-grids/ViewList_Totalp_30x30.rad)
  *
- *
+ * The ViewList file is written in a binary format that contains the ViewList and the SortList as flat arrays. Its header contains a hash of
+ * the DEM and the discretization of the Basic Set, so a file that does not match the current simulation is ignored (and the ViewList is
+ * computed again). On POSIX systems, the file is memory-mapped read-only, so all the threads and all the MPI processes of a node share the
+ * same copy. ViewList files written in the former SMET format can still be read (they are then rewritten in the binary format if
+ * COMPLEX_WRITE_VIEWLIST is set).
  *
  * @code
  * [EBalance]
@@ -67,6 +72,7 @@ class TerrainRadiationComplex : public TerrainRadiationAlgorithm
 
 public:
 	TerrainRadiationComplex(const mio::Config &cfg, const mio::DEMObject &dem_in, const std::string &method);
+	TerrainRadiationComplex(const TerrainRadiationComplex&) = delete;
 	~TerrainRadiationComplex();
 
 	virtual void getRadiation(mio::Array2D<double>& direct, mio::Array2D<double>& diffuse,
@@ -80,7 +86,13 @@ public:
 	void writeSP(const unsigned int max_steps);
 
 private:
-	typedef std::array<double, 3> Vec3D;
+	// One element of the ViewList: the triangle that is seen from a triangle of the DEM in a given direction of the Basic Set
+	struct ViewListEntry {
+		double distance;         // distance to the seen triangle, -999 if the sky is seen
+		uint32_t ii, jj;         // DEM cell of the seen triangle
+		uint32_t which_triangle; // seen triangle within this cell
+		uint32_t solidangle;     // direction of the Basic Set of the seen triangle that points back to the viewing triangle
+	};
 
 	// Initialisation Functions
 	void initBasicSetHorizontal();
@@ -90,6 +102,14 @@ private:
 	void initSortList();
 	void WriteViewList();
 	bool ReadViewList();
+	bool ReadViewListSMET(const std::string& filename);
+	bool MapViewList(const std::string& filename);
+	void UnmapViewList();
+	uint64_t DEMHash() const;
+
+	// flat ViewList and SortList accessors
+	size_t TriangleIndex(size_t ii, size_t jj, size_t which_triangle) const { return (ii * dimy + jj) * 2 + which_triangle; }
+	const ViewListEntry &ViewList(size_t ii, size_t jj, size_t which_triangle, size_t solidangle) const { return view_list[TriangleIndex(ii, jj, which_triangle) * S + solidangle]; }
 
 	// auxiliary functions
 	void TriangleNormal(size_t ii_dem, size_t jj_dem, int which_triangle, Vec3D &v_out);
@@ -102,7 +122,7 @@ private:
 	void getVectorSun(double solarAzimuth, double solarElevation, Vec3D &v_out);
 	double TerrainBiggestDifference(const mio::Array3D<double> &terrain_old, const mio::Array3D<double> &terrain_new);
 
-	// Standard Vector operations
+	// Standard Vector operations (see Vector3D.h)
 	double NormOfVector(const Vec3D &vec1);
 	void normalizeVector(const Vec3D &vec1, Vec3D &v_out);
 	double VectorScalarProduct(const Vec3D &vec1, const Vec3D &vec2);
@@ -131,10 +151,17 @@ private:
 	SolarPanel SP;
 	std::vector<std::vector<double> > pv_points;
 
-	mio::Array3D<std::vector<double>> SortList;			  // Used for speedup in Terrain Iterations
+	// The ViewList and the SortList point either to the vectors below or to a memory-mapped ViewList file
+	const ViewListEntry *view_list;			  // Stores all information of network between pixels [MT 2.1.3 View List, eq. 2.47], S elements per triangle
+	const uint64_t *sort_start;				  // For each triangle, start of its directions in sort_list (one more element than triangles)
+	const uint32_t *sort_list;				  // Used for speedup in Terrain Iterations: directions of each triangle that are seen by other triangles
+	std::vector<ViewListEntry> view_list_data;
+	std::vector<uint64_t> sort_start_data;
+	std::vector<uint32_t> sort_list_data;
+	void *mapped_file;						  // memory-mapped ViewList file, if any
+	size_t mapped_size;
 	std::vector<Vec3D> BasicSet_Horizontal; // Horizontal Basic Set [MT 2.1.1 Basic Set]
 	mio::Array4D<Vec3D> BasicSet_rotated;	  // Basic Set rotated in Triangular Pixel Plane [MT 2.1.3 View List, eq. 2.38]
-	mio::Array4D<std::vector<double>> ViewList;			  // Stores all information of network between pixels [MT 2.1.3 View List, eq. 2.47]
 	mio::Array2D<double> RList;							  // List pre-storage of BRDF values
 	mio::Array2D<double> albedo_grid;					  // Albedo value for each square Pixel
 
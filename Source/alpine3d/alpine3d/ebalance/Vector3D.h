@@ -0,0 +1,133 @@
+/***********************************************************************************/
+/*  Copyright 2026 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of Alpine3D.
+    Alpine3D is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Alpine3D is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Alpine3D.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef VECTOR3D_H
+#define VECTOR3D_H
+
+#include <array>
+#include <cmath>
+
+typedef std::array<double, 3> Vec3D; ///< 3D vector {x, y, z}
+typedef std::array<Vec3D, 3> Mat3D;  ///< 3x3 matrix, stored row by row
+
+/**
+ * @brief Vector operations on fixed size 3D vectors, as used by the radiation geometry (SolarPanel, TerrainRadiationComplex).
+ * The vectors and matrices are plain values, so these operations never allocate memory and can be used in the inner loops.
+ * When the same rotation is applied to many vectors, its matrix should be built once with one of the RotationMatrix functions
+ * and then applied with Rotate().
+ */
+namespace Vector3D {
+
+	inline double VectorScalarProduct(const Vec3D& vec1, const Vec3D& vec2)
+	{
+		return vec1[0]*vec2[0] + vec1[1]*vec2[1] + vec1[2]*vec2[2];
+	}
+
+	inline Vec3D VectorCrossProduct(const Vec3D& vec1, const Vec3D& vec2)
+	{
+		return {vec1[1]*vec2[2] - vec1[2]*vec2[1], vec1[2]*vec2[0] - vec1[0]*vec2[2], vec1[0]*vec2[1] - vec1[1]*vec2[0]};
+	}
+
+	inline double NormOfVector(const Vec3D& vec1)
+	{
+		return sqrt(VectorScalarProduct(vec1, vec1));
+	}
+
+	/** @brief Normalized vector (a vector of norm zero is returned unchanged) */
+	inline Vec3D normalizeVector(const Vec3D& vec1)
+	{
+		const double norm = NormOfVector(vec1);
+		if (norm==0) return vec1;
+		return {vec1[0]/norm, vec1[1]/norm, vec1[2]/norm};
+	}
+
+	inline Vec3D VectorSum(const Vec3D& vec1, const Vec3D& vec2)
+	{
+		return {vec1[0] + vec2[0], vec1[1] + vec2[1], vec1[2] + vec2[2]};
+	}
+
+	inline Vec3D VectorDifference(const Vec3D& vec1, const Vec3D& vec2)
+	{
+		return {vec1[0] - vec2[0], vec1[1] - vec2[1], vec1[2] - vec2[2]};
+	}
+
+	inline Vec3D VectorStretch(const Vec3D& vec1, const double& factor)
+	{
+		return {vec1[0]*factor, vec1[1]*factor, vec1[2]*factor};
+	}
+
+	/** @brief Projection of vec1 on the plane defined by its normal vector */
+	inline Vec3D ProjectVectorToPlane(const Vec3D& vec1, const Vec3D& plane_normal)
+	{
+		const Vec3D normal( normalizeVector(plane_normal) );
+		const double proj = VectorScalarProduct(normal, vec1);
+		return {vec1[0] - proj*normal[0], vec1[1] - proj*normal[1], vec1[2] - proj*normal[2]};
+	}
+
+	/** @brief Angle between two vectors [rad] */
+	inline double AngleBetween2Vectors(const Vec3D& vec1, const Vec3D& vec2)
+	{
+		double val = VectorScalarProduct(vec1, vec2) / NormOfVector(vec1) / NormOfVector(vec2);
+		if (val>1) val = 1; //rounding errors
+		if (val<-1) val = -1;
+		return acos(val);
+	}
+
+	inline Vec3D Rotate(const Mat3D& rot, const Vec3D& vec_in)
+	{
+		return {rot[0][0]*vec_in[0] + rot[0][1]*vec_in[1] + rot[0][2]*vec_in[2],
+		        rot[1][0]*vec_in[0] + rot[1][1]*vec_in[1] + rot[1][2]*vec_in[2],
+		        rot[2][0]*vec_in[0] + rot[2][1]*vec_in[1] + rot[2][2]*vec_in[2]};
+	}
+
+	inline Mat3D RotationMatrixX(const double& rad)
+	{
+		const double c = cos(rad), s = sin(rad);
+		return {{ {{1., 0., 0.}}, {{0., c, -s}}, {{0., s, c}} }};
+	}
+
+	inline Mat3D RotationMatrixY(const double& rad)
+	{
+		const double c = cos(rad), s = sin(rad);
+		return {{ {{c, 0., s}}, {{0., 1., 0.}}, {{-s, 0., c}} }};
+	}
+
+	inline Mat3D RotationMatrixZ(const double& rad)
+	{
+		const double c = cos(rad), s = sin(rad);
+		return {{ {{c, -s, 0.}}, {{s, c, 0.}}, {{0., 0., 1.}} }};
+	}
+
+	/** @brief Rotation around a given axis (that does not need to be normalized) [MT eq. 2.41] */
+	inline Mat3D RotationMatrixN(const Vec3D& axis, const double& rad)
+	{
+		const double c = cos(rad), s = sin(rad);
+		const double norm = NormOfVector(axis);
+		const double n1 = axis[0]/norm, n2 = axis[1]/norm, n3 = axis[2]/norm;
+		return {{ {{n1*n1*(1-c)+c, n1*n2*(1-c)-n3*s, n1*n3*(1-c)+n2*s}},
+		          {{n2*n1*(1-c)+n3*s, n2*n2*(1-c)+c, n2*n3*(1-c)-n1*s}},
+		          {{n3*n1*(1-c)-n2*s, n3*n2*(1-c)+n1*s, n3*n3*(1-c)+c}} }};
+	}
+
+	inline Vec3D RotX(const Vec3D& vec_in, const double& rad) { return Rotate(RotationMatrixX(rad), vec_in); }
+	inline Vec3D RotY(const Vec3D& vec_in, const double& rad) { return Rotate(RotationMatrixY(rad), vec_in); }
+	inline Vec3D RotZ(const Vec3D& vec_in, const double& rad) { return Rotate(RotationMatrixZ(rad), vec_in); }
+	inline Vec3D RotN(const Vec3D& axis, const Vec3D& vec_in, const double& rad) { return Rotate(RotationMatrixN(axis, rad), vec_in); }
+
+} //end namespace Vector3D
+
+#endif
@@ -36,7 +36,8 @@ Runoff::Runoff(const mio::Config& in_cfg, const mio::DEMObject& in_dem, const do
 		is_glacier_mask_dynamic(getIsGlacierDynamic(in_cfg)),
 		is_glacier_mask_set(false), total_runoff(), glacier_mask(),
 		extra_meteo_variables(getExtraMeteoVariables(in_cfg)),
-		n_extra_meteo_variables(extra_meteo_variables.size()), catchment_masks(),
+		n_extra_meteo_variables(extra_meteo_variables.size()), catchment_ids(),
+		catchment_start(), catchment_cells(), catchment_weights(), catchment_nr_cells(),
 		use_external_iomanager_for_grids(false)
 {
 	in_cfg.getValue("WRITE_RUNOFF_GRIDS", "OUTPUT", output_grids, mio::IOUtils::nothrow);
@@ -92,13 +93,13 @@ Runoff::Runoff(const mio::Config& in_cfg, const mio::DEMObject& in_dem, const do
 		io->read2DGrid(catchmentGrid, catchmentInFile);
 		resampling_cell_size = getResamplingCellSize(in_dem, catchmentGrid);
 		grid_size_factor = in_dem.cellsize/resampling_cell_size;
-		constructCatchmentMasks(catchmentGrid);
+		constructCatchmentIndex(catchmentGrid, in_dem);
 		initializeOutputFiles(in_dem);
 		glacier_mask.set(in_dem, mio::IOUtils::nodata);
 	}
 	if (MPIControl::instance().master()) {
 		std::cout << "[i] Runoff initialised";
-		if (output_sums) std::cout << " - Number of catchments: " << catchment_masks.size() << "\n";
+		if (output_sums) std::cout << " - Number of catchments: " << catchment_ids.size() << "\n";
 		else std::cout << "\n";
 	}
 }
@@ -121,7 +122,10 @@ Runoff::Runoff(const Runoff& copy) :
 		total_runoff(copy.total_runoff), glacier_mask(copy.glacier_mask),
 		extra_meteo_variables(copy.extra_meteo_variables),
 		n_extra_meteo_variables(copy.n_extra_meteo_variables),
-		catchment_masks(copy.catchment_masks)
+		catchment_ids(copy.catchment_ids), catchment_start(copy.catchment_start),
+		catchment_cells(copy.catchment_cells), catchment_weights(copy.catchment_weights),
+		catchment_nr_cells(copy.catchment_nr_cells),
+		use_external_iomanager_for_grids(copy.use_external_iomanager_for_grids)
 {}
 
 std::string Runoff::getGridsRequirements() const
@@ -182,30 +186,27 @@ void Runoff::output(const mio::Date& i_date, const mio::Grid2DObject& psum,
 
 
 		if(MPIControl::instance().master()) {
-		//Resample runoff grids to match the cell size of the catchment masks
-			if (fabs(grid_size_factor - 1.0) > 1e-5) {
-				totalRunoff   = mio::LibResampling2D::Nearest(totalRunoff, grid_size_factor);
-				precipRunoff  = mio::LibResampling2D::Nearest(precipRunoff, grid_size_factor);
-				snowRunoff    = mio::LibResampling2D::Nearest(snowRunoff, grid_size_factor);
-				glacierRunoff = mio::LibResampling2D::Nearest(glacierRunoff, grid_size_factor);
-				for (size_t iVar(0); iVar < n_extra_meteo_variables; ++iVar)
-					extraGrids[iVar] = mio::LibResampling2D::Nearest(extraGrids[iVar], grid_size_factor);
-			}
-
-			//Sum the runoffs over each mask and write them in the output files
-			double currTotalRunoff, currPrecipRunoff, currSnowRunoff, currGlacierRunoff;
+			//Sum the runoffs over each catchment (the catchment index already accounts for the resampling)
+			std::vector<const mio::Grid2DObject*> grids;
+			grids.push_back(&totalRunoff);
+			grids.push_back(&precipRunoff);
+			grids.push_back(&snowRunoff);
+			grids.push_back(&glacierRunoff);
+			for (size_t iVar(0); iVar < n_extra_meteo_variables; ++iVar)
+				grids.push_back(&extraGrids[iVar]);
+
+			std::vector< std::vector<double> > sums;
+			sumOverCatchments(grids, sums);
+
+			//and write them in the output files
 			std::vector<double> currMeteoVars(n_extra_meteo_variables);
-			std::map<size_t, mio::Grid2DObject>::const_iterator itMask;
-			for (itMask = catchment_masks.begin(); itMask != catchment_masks.end(); ++itMask) {
-				currTotalRunoff   = sumOverMask(totalRunoff,   itMask->second);
-				currPrecipRunoff  = sumOverMask(precipRunoff,  itMask->second);
-				currSnowRunoff    = sumOverMask(snowRunoff,    itMask->second);
-				currGlacierRunoff = sumOverMask(glacierRunoff, itMask->second);
+			for (size_t iCatch = 0; iCatch < catchment_ids.size(); ++iCatch) {
+				const std::vector<double>& currSums = sums[iCatch];
 				for (size_t iVar(0); iVar < n_extra_meteo_variables; ++iVar)
-					currMeteoVars[iVar] = averageOverMask(extraGrids[iVar], itMask->second);
+					currMeteoVars[iVar] = currSums[4+iVar] / catchment_nr_cells[iCatch];
 
-				updateOutputFile(itMask->first, i_date, currTotalRunoff,
-						currPrecipRunoff, currSnowRunoff, currGlacierRunoff,
+				updateOutputFile(catchment_ids[iCatch], i_date, currSums[0],
+						currSums[1], currSums[2], currSums[3],
 						currMeteoVars);
 			}
 		}
@@ -224,49 +225,112 @@ Runoff::~Runoff()
 
 
 /**
- * @brief Initializes private attribute catchment_masks
+ * @brief Initializes the catchments index
+ * For each catchment, the DEM cells that it covers are listed together with the number of
+ * catchment cells (at the resampling cell size) that fall within each of them. The runoff sums can
+ * then be computed directly on the DEM grids, without resampling them.
  * @param catchmentGrid grid defining the catchments. The catchment numbering
  * scheme must be specified in the ini file using the key CATCHMENT_NUMBERING
  * in section INPUT. This scheme can be either ALPINE3D_OLD (for catchments
  * numbered with powers of 2), or TAUDEM (for standard numbering).
+ * @param dem DEM used by Alpine3D
  */
-void Runoff::constructCatchmentMasks(mio::Grid2DObject catchmentGrid)
+void Runoff::constructCatchmentIndex(mio::Grid2DObject catchmentGrid, const mio::DEMObject& dem)
 {
 	const double factor = catchmentGrid.cellsize/resampling_cell_size;
 	if (fabs(factor - 1.0) > 1e-5) {
 		catchmentGrid = mio::LibResampling2D::Nearest(catchmentGrid, factor);
 	}
-	mio::Grid2DObject emptyGrid(catchmentGrid, mio::IOUtils::nodata);
 
-	std::vector<size_t> currIndices;
-	for (size_t iCell = 0; iCell < catchmentGrid.size(); ++iCell) {
-		if (catchmentGrid(iCell) == mio::IOUtils::nodata) continue;
-		const longuint currValue = static_cast<longuint>( round(catchmentGrid(iCell)) );
+	//grid of the DEM cells indices, resampled the same way as the runoff grids used to be
+	mio::Grid2DObject cellIndex(dem, mio::IOUtils::nodata);
+	for (size_t iCell = 0; iCell < cellIndex.size(); ++iCell)
+		cellIndex(iCell) = static_cast<double>(iCell);
+	if (fabs(grid_size_factor - 1.0) > 1e-5) {
+		cellIndex = mio::LibResampling2D::Nearest(cellIndex, grid_size_factor);
+	}
 
-		if (catchment_numbering == Alpine3DOld) {
-			currIndices = factorizeCatchmentNumber(currValue);
-		} else {
-			if (currValue > std::numeric_limits<size_t>::max()) {
-				std::ostringstream os;
-				os << "The ID numbers of some of the subwatersheds defined in "
-				   << "the catchment file exceed the maximum index value ("
-				   << std::fixed << std::numeric_limits<size_t>::max() << ")."
-				   << " Did you forget to add \"CATCHMENT_NUMBERING = ALPINE3D_OLD\""
-				   << " in section [INPUT] of your configuration file?";
-				throw mio::IndexOutOfBoundsException(os.str(), AT);
+	//position of the catchment grid within the resampled DEM grid
+	mio::Coords llcorner(catchmentGrid.llcorner);
+	llcorner.copyProj(cellIndex.llcorner);
+	const long offsetI = static_cast<long>( floor((llcorner.getEasting() - cellIndex.llcorner.getEasting() + DISTANCE_ABSOLUTE_PRECISION) / cellIndex.cellsize) );
+	const long offsetJ = static_cast<long>( floor((llcorner.getNorthing() - cellIndex.llcorner.getNorthing() + DISTANCE_ABSOLUTE_PRECISION) / cellIndex.cellsize) );
+	const long nx = static_cast<long>(cellIndex.getNx()), ny = static_cast<long>(cellIndex.getNy());
+
+	std::map<size_t, std::vector<size_t> > demCells; //DEM cell of each catchment cell, per catchment
+	std::vector<size_t> currIndices;
+	for (size_t iy = 0; iy < catchmentGrid.getNy(); ++iy) {
+		for (size_t ix = 0; ix < catchmentGrid.getNx(); ++ix) {
+			if (catchmentGrid(ix,iy) == mio::IOUtils::nodata) continue;
+			const longuint currValue = static_cast<longuint>( round(catchmentGrid(ix,iy)) );
+
+			if (catchment_numbering == Alpine3DOld) {
+				currIndices = factorizeCatchmentNumber(currValue);
+			} else {
+				if (currValue > std::numeric_limits<size_t>::max()) {
+					std::ostringstream os;
+					os << "The ID numbers of some of the subwatersheds defined in "
+					   << "the catchment file exceed the maximum index value ("
+					   << std::fixed << std::numeric_limits<size_t>::max() << ")."
+					   << " Did you forget to add \"CATCHMENT_NUMBERING = ALPINE3D_OLD\""
+					   << " in section [INPUT] of your configuration file?";
+					throw mio::IndexOutOfBoundsException(os.str(), AT);
+				}
+				currIndices.assign(1, static_cast<size_t>( currValue ));
 			}
-			currIndices.assign(1, static_cast<size_t>( currValue ));
+
+			const long ii = offsetI + static_cast<long>(ix), jj = offsetJ + static_cast<long>(iy);
+			if (ii < 0 || ii >= nx || jj < 0 || jj >= ny)
+				throw mio::InvalidFormatException("Catchment mask extends beyond the DEM boundaries", AT);
+			const size_t demCell = static_cast<size_t>( cellIndex(static_cast<size_t>(ii), static_cast<size_t>(jj)) );
+
+			for (std::vector<size_t>::const_iterator it = currIndices.begin(); it != currIndices.end(); ++it)
+				demCells[*it].push_back(demCell);
 		}
+	}
 
-		for (std::vector<size_t>::const_iterator it = currIndices.begin(); it != currIndices.end(); ++it) {
-			if (catchment_masks.find(*it) == catchment_masks.end())
-				catchment_masks[*it] = emptyGrid;
-			catchment_masks[*it](iCell) = 1.0;
+	//compress the lists of cells into (DEM cell, number of catchment cells) pairs
+	catchment_start.push_back(0);
+	for (std::map<size_t, std::vector<size_t> >::iterator it = demCells.begin(); it != demCells.end(); ++it) {
+		std::vector<size_t>& cells = it->second;
+		std::sort(cells.begin(), cells.end());
+		for (size_t ii = 0; ii < cells.size(); ++ii) {
+			if (ii > 0 && cells[ii] == cells[ii-1]) {
+				catchment_weights.back() += 1.;
+			} else {
+				catchment_cells.push_back(cells[ii]);
+				catchment_weights.push_back(1.);
+			}
 		}
+		catchment_ids.push_back(it->first);
+		catchment_start.push_back(catchment_cells.size());
+		catchment_nr_cells.push_back(static_cast<double>(cells.size()));
+		std::vector<size_t>().swap(cells);
 	}
+}
+
 
-	for (std::map<size_t, mio::Grid2DObject>::iterator it = catchment_masks.begin(); it != catchment_masks.end(); ++it) {
-		cropMask(it->second);
+/**
+ * @brief Sums the values of some grids over each catchment, in one pass over the catchments index
+ * @param grids grids (with the geometry of the DEM) whose cell values have to be summed. Nodata cells are skipped.
+ * @param[out] sums for each catchment, the sum of each grid
+ */
+void Runoff::sumOverCatchments(const std::vector<const mio::Grid2DObject*>& grids, std::vector< std::vector<double> >& sums) const
+{
+	const size_t nGrids = grids.size();
+	const size_t nCatchments = catchment_ids.size();
+	sums.assign(nCatchments, std::vector<double>(nGrids, 0.));
+
+	#pragma omp parallel for schedule(dynamic)
+	for (size_t iCatch = 0; iCatch < nCatchments; ++iCatch) {
+		std::vector<double>& currSums = sums[iCatch];
+		for (size_t ii = catchment_start[iCatch]; ii < catchment_start[iCatch+1]; ++ii) {
+			const size_t iCell = catchment_cells[ii];
+			for (size_t iGrid = 0; iGrid < nGrids; ++iGrid) {
+				const double value = (*grids[iGrid])(iCell);
+				if (value != mio::IOUtils::nodata) currSums[iGrid] += catchment_weights[ii]*value;
+			}
+		}
 	}
 }
 
@@ -376,14 +440,13 @@ void Runoff::getExtraMeteoGrids(std::vector<mio::Grid2DObject>& grids) const {
 void Runoff::initializeOutputFiles(const mio::Grid2DObject& dem) const
 {
 	std::stringstream ss;
-	const double cellArea = pow(catchment_masks.begin()->second.cellsize, 2); // in m^2
+	const double cellArea = resampling_cell_size*resampling_cell_size; // in m^2
 	double catchArea;
 
-	for (std::map<size_t, mio::Grid2DObject>::const_iterator itMask = catchment_masks.begin();
-			itMask != catchment_masks.end(); ++itMask, ss.str(""), ss.clear()) {
-		catchArea = double(itMask->second.grid2D.getCount())*cellArea*1e-6; //< in km^2
+	for (size_t iCatch = 0; iCatch < catchment_ids.size(); ++iCatch, ss.str(""), ss.clear()) {
+		catchArea = catchment_nr_cells[iCatch]*cellArea*1e-6; //< in km^2
 
-		ss << "catch" << std::setfill('0') << std::setw(2) << itMask->first;
+		ss << "catch" << std::setfill('0') << std::setw(2) << catchment_ids[iCatch];
 		const std::string id = ss.str();
 
 		const std::string filename = catchment_out_path + "/" + id + ".smet";
@@ -651,68 +714,6 @@ std::vector<size_t> Runoff::factorizeCatchmentNumber(longuint value)
 }
 
 
-/**
- * @brief Crops the mask so as to remove as many nodata cells as possible
- * (note: this method possibly changes the georeferencing of the mask by
- * changing its lower-left corner as well as its number of rows or columns)
- */
-void Runoff::cropMask(mio::Grid2DObject& mask)
-{
-	size_t min_ix(mask.getNx()-1), max_ix(0), min_iy(mask.getNy()-1), max_iy(0);
-	for (size_t iy = 0; iy < mask.getNy(); ++iy) {
-		for (size_t ix = 0; ix < mask.getNx(); ++ix) {
-			if (mask(ix,iy) != mio::IOUtils::nodata) {
-				if (ix < min_ix) min_ix = ix;
-				if (ix > max_ix) max_ix = ix;
-				if (iy < min_iy) min_iy = iy;
-				if (iy > max_iy) max_iy = iy;
-			}
-		}
-	}
-	mio::Grid2DObject tmp(mask, min_ix, min_iy, max_ix-min_ix+1, max_iy-min_iy+1);
-	mask = tmp;
-}
-
-
-/**
- * @brief Sums the values of the grid cells which are located over the mask
- * @param grid grid whose cell values have to be summed
- * @param mask mask over which the grid cell values have to be summed
- * @return Sum of the masked grid cell values
- */
-double Runoff::sumOverMask(const mio::Grid2DObject& grid, const mio::Grid2DObject& mask)
-{
-	mio::Coords llCorner(mask.llcorner);
-	grid.gridify(llCorner);
-	mio::Grid2DObject subgrid;
-	try {
-		mio::Grid2DObject tmp(grid, llCorner.getGridI(), llCorner.getGridJ(),
-		                      mask.getNx(), mask.getNy());
-		subgrid = tmp;
-	} catch (...) {
-		throw mio::InvalidFormatException("Catchment mask extends beyond the DEM boundaries", AT);
-	}
-
-	double sum(0.0);
-	for (size_t iCell = 0; iCell < mask.getNx()*mask.getNy(); ++iCell) {
-		if (mask(iCell) != mio::IOUtils::nodata && subgrid(iCell) != mio::IOUtils::nodata)
-			sum += subgrid(iCell);
-	}
-	return sum;
-}
-
-
-/**
- * @brief Averages the values of the grid cells which are located over the mask
- * @param grid grid whose cell values have to be averaged
- * @param mask mask over which the grid cell values have to be averaged
- * @return Average of the masked grid cell values
- */
-double Runoff::averageOverMask(const mio::Grid2DObject& grid, const mio::Grid2DObject& mask)
-{
-	return sumOverMask(grid, mask)/double(mask.grid2D.getCount());
-}
-
 double Runoff::getTiming() const
 {
 	return timer.getElapsed();
@@ -21,6 +21,7 @@
 #include <iostream>
 #include <vector>
 #include <map>
+#include <algorithm>
 #include <limits>
 #include <sstream>
 #include <meteoio/MeteoIO.h>
@@ -117,13 +118,18 @@ class Runoff
 		mio::Grid2DObject total_runoff, glacier_mask;
 		std::vector<SnGrids::Parameters> extra_meteo_variables;
 		size_t n_extra_meteo_variables;
-		std::map<size_t, mio::Grid2DObject> catchment_masks;
+		std::vector<size_t> catchment_ids; //< catchments numbers, in increasing order
+		std::vector<size_t> catchment_start; //< for each catchment, index of its first cell in catchment_cells (one more element than catchment_ids)
+		std::vector<size_t> catchment_cells; //< DEM cells covered by each catchment
+		std::vector<double> catchment_weights; //< number of resampled catchment cells falling within each of these DEM cells
+		std::vector<double> catchment_nr_cells; //< total number of resampled cells of each catchment
 		bool use_external_iomanager_for_grids; // To know if the same io manager than for the other grids must be used
 		                                       // (to avoid having multiple netcdf files open)
 		static const double MIN_CELL_SIZE; //< [m] two points closer to each other than this value will be assumed to overlap
 		static const double DISTANCE_ABSOLUTE_PRECISION; //< [m] minimum size of a grid cell
 
-		virtual void constructCatchmentMasks(mio::Grid2DObject catchmentGrid);
+		virtual void constructCatchmentIndex(mio::Grid2DObject catchmentGrid, const mio::DEMObject& dem);
+		virtual void sumOverCatchments(const std::vector<const mio::Grid2DObject*>& grids, std::vector< std::vector<double> >& sums) const;
 		virtual void updateTotalRunoffGrid();
 		virtual void updateGlacierMask();
 		virtual mio::Grid2DObject computePrecipRunoff(const mio::Grid2DObject& psum, const mio::Grid2DObject& ta) const;
@@ -143,9 +149,6 @@ class Runoff
 		static bool isMultiple(const double& a, const double& b);
 		static double estimateResamplingCellSize(const double& llOffset, const double& currSizeEstimate);
 		static std::vector<size_t> factorizeCatchmentNumber(longuint value);
-		static void cropMask(mio::Grid2DObject& mask);
-		static double sumOverMask(const mio::Grid2DObject& grid, const mio::Grid2DObject& mask);
-		static double averageOverMask(const mio::Grid2DObject& grid, const mio::Grid2DObject& mask);
 
 	private:
 		Runoff& operator=(const Runoff&) {return *this;} //< private in order to avoid being used and suppress compiler warning
@@ -50,11 +50,20 @@ const bool SnowDriftA3D::thresh_snow = true;//Flag to determine whether ustar_th
 SnowDriftA3D::SnowDriftA3D(const DEMObject& dem, const mio::Config& cfg) 
                         : saltation_obj(cfg), auxLayerHeight(0.02), io(cfg), snowpack(NULL), eb(NULL), 
                         cH(dem, IOUtils::nodata), sp(dem, IOUtils::nodata), rg(dem, IOUtils::nodata), N3(dem, IOUtils::nodata), rb(dem, IOUtils::nodata),
-                        nx(0), ny(0), nz(0), vw(dem, IOUtils::nodata), rh(dem, IOUtils::nodata), ta(dem, IOUtils::nodata), p(dem, IOUtils::nodata), 
+                        nx(0), ny(0), nz(0), precond_kind(PRECOND_JACOBI), warm_start(false), ilu_valid(false), vw(dem, IOUtils::nodata), rh(dem, IOUtils::nodata), ta(dem, IOUtils::nodata), p(dem, IOUtils::nodata), 
                         psum(dem, IOUtils::nodata), psum_ph(dem, IOUtils::nodata), STATIONARY(true)
 {
 	const string wind_field_string = cfg.get("WINDFIELDS", "Input");
 
+	string precond_string( "JACOBI" );
+	cfg.getValue("SNOWDRIFT_PRECONDITIONER", "Alpine3D", precond_string, IOUtils::nothrow);
+	IOUtils::toUpper(precond_string);
+	if (precond_string=="NONE") precond_kind = PRECOND_NONE;
+	else if (precond_string=="JACOBI") precond_kind = PRECOND_JACOBI;
+	else if (precond_string=="ILU0") precond_kind = PRECOND_ILU0;
+	else throw InvalidArgumentException("Unknown SNOWDRIFT_PRECONDITIONER '"+precond_string+"', please use NONE, JACOBI or ILU0", AT);
+	cfg.getValue("SNOWDRIFT_WARM_START", "Alpine3D", warm_start, IOUtils::nothrow);
+
 	vector<string> TA_interpol;
 	cfg.getValues("TA::algorithms", "Interpolations2D", TA_interpol);
 	if (TA_interpol.empty())
@@ -55,6 +55,7 @@ class EnergyBalance;
 typedef enum DRIFT_OUTPUT_ENUM {OUT_CONC, OUT_SUBL} DRIFT_OUTPUT;
 typedef enum PARAM_TYPES {CON,HUM,SUB,TEM,SUB2} param_type;
 typedef enum ASPECT_TYPES {OTHER,BOTTOM} aspect_type;
+typedef enum PRECOND_TYPES {PRECOND_NONE,PRECOND_JACOBI,PRECOND_ILU0} precond_type;
 
 struct WIND_FIELD {unsigned int start_step;std::string wind;};
 
@@ -74,6 +75,12 @@ struct WIND_FIELD {unsigned int start_step;std::string wind;};
  * WINDFIELDS = sw3.asc 1 nw3.asc 3 ww0.asc 2 nw9.asc 5 nw6.asc 10 ww0.asc 5 sw3.asc 6 nw3.asc 1
  * @endcode
  *
+ * The linear systems of the suspension and sublimation are solved with a preconditioned BiCGStab. The following keys of the
+ * [Alpine3D] section control the solver:
+ * - SNOWDRIFT_PRECONDITIONER: either NONE, JACOBI (the diagonal of the system matrix) or ILU0 (incomplete LU
+ * factorization without fill-in, more expensive to build but it usually needs far fewer iterations); default: JACOBI;
+ * - SNOWDRIFT_WARM_START: if set to true, each solve starts from the previous solution for the same variable instead of
+ * zero (for example between the iterations of the sublimation feedbacks or between time steps); default: false.
  */
 class SnowDriftA3D {
 	public:
@@ -101,6 +108,12 @@ class SnowDriftA3D {
 		
 		std::string getGridsRequirements() const;
 
+		/**
+		 * @brief Residuals of the last linear solve
+		 * @return relative residual after each BiCGStab iteration of the last call to bicgStab()
+		 */
+		const std::vector<double>& getConvergenceHistory() const {return residual_history;}
+
 	protected:
 		void Initialize();
 		void ConstructElements();
@@ -145,7 +158,10 @@ class SnowDriftA3D {
 		virtual void matmult(CDoubleArray& res, const CDoubleArray& x, const CDoubleArray& sA, const CIntArray& colA, CIntArray& rowA);
 		virtual void transmult(CDoubleArray& res, const CDoubleArray& x,double* sm, int* ijm);
 		virtual void SolveEquation(int timeStep, int maxTimeStep, const param_type param );
+		CDoubleArray& previousSolution(const param_type param);
 		virtual void bicgStab(CDoubleArray& result, CDoubleArray& rhs, const CDoubleArray& sA, const CIntArray& colA, CIntArray& rowA, const int nmax, const double tol, double& testres);
+		bool factorizeILU0(const CDoubleArray& sA, const CIntArray& colA, const CIntArray& rowA);
+		void applyPreconditioner(CDoubleArray& z, const CDoubleArray& r, const CIntArray& colA, const CIntArray& rowA) const;
 
 
 		//---------------------------------------------------------------------
@@ -255,6 +271,16 @@ class SnowDriftA3D {
 
 		//vector which contains boundary and initial conditions
 		CDoubleArray precond;
+
+		//linear solver settings and workspaces, allocated once in InitializeFEData
+		precond_type precond_kind;
+		bool warm_start;
+		CDoubleArray bicg_r0, bicg_r, bicg_p, bicg_v, bicg_s, bicg_t, bicg_phat, bicg_shat, bicg_best;
+		CDoubleArray c_prev, q_prev, T_prev; //last solutions, only used as initial guesses if warm_start is set
+		CDoubleArray ilu; //ILU(0) factors, stored with the same sparsity pattern as sA
+		CIntArray ilu_diag, ilu_pos; //position of the diagonal in each row of ilu, column to position map of the current row
+		bool ilu_valid;
+		std::vector<double> residual_history;
 		//mio::Grid3DObject newElements_precond;
 		//LH_BC
 		CDoubleArray gNeumann;
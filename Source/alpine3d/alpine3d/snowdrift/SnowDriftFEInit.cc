@@ -79,6 +79,25 @@ void SnowDriftA3D::InitializeFEData( void )
 
 	rhs.resize( nDOF );
 	precond.resize( nDOF );
+	bicg_r0.resize( nDOF );
+	bicg_r.resize( nDOF );
+	bicg_p.resize( nDOF );
+	bicg_v.resize( nDOF );
+	bicg_s.resize( nDOF );
+	bicg_t.resize( nDOF );
+	bicg_phat.resize( nDOF );
+	bicg_shat.resize( nDOF );
+	bicg_best.resize( nDOF );
+	if (warm_start) {
+		c_prev.resize( nDOF, 0. );
+		q_prev.resize( nDOF, 0. );
+		T_prev.resize( nDOF, 0. );
+	}
+	if (precond_kind==PRECOND_ILU0) {
+		ilu.resize( nNZ );
+		ilu_diag.resize( nDOF );
+		ilu_pos.resize( nDOF, -1 );
+	}
 	f.resize( nDOF );
 	c00.resize( nNodes );
 
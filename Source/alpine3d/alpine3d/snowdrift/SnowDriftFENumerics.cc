@@ -517,11 +517,13 @@ void SnowDriftA3D::matmult(CDoubleArray& y_loc,
 {
 	const size_t dim = rowPtr.getNx() - 1;
 
+	#pragma omp parallel for
 	for (size_t i = 0; i < dim; i++) {
-		y_loc[i] = 0;
+		double sum = 0.;
 		for (int j = rowPtr[i]; j < rowPtr[i+1] ; j++) {
-			y_loc[i] += sA_loc[ j ] * x_loc[ colInd[j] ];
+			sum += sA_loc[ j ] * x_loc[ colInd[j] ];
 		}
+		y_loc[i] = sum;
 	}
 }
 
@@ -551,15 +553,96 @@ void SnowDriftA3D::transmult(CDoubleArray& res, const CDoubleArray& x_loc, doubl
   }
 }
 
+/**
+ * @brief ILU(0) factorization of a sparse matrix of CSR format
+ * The incomplete factors keep the sparsity pattern of the matrix: the strictly lower part of ilu contains L (with an
+ * implicit unit diagonal) and the rest contains U. The column indices of each row must be sorted, which is the case
+ * for the matrices built by prepareSparseMatrix().
+ * @param sA matrix to factorize
+ * @param colInd column index
+ * @param rowPtr row index
+ * @return false if the factorization is not possible (missing or zero pivot)
+ */
+bool SnowDriftA3D::factorizeILU0(const CDoubleArray& sA_loc, const CIntArray& colInd, const CIntArray& rowPtr)
+{
+	const size_t n = rowPtr.getNx() - 1;
+
+	#pragma omp parallel for
+	for (size_t i = 0; i < n; i++) {
+		ilu_diag[i] = -1;
+		for (int k = rowPtr[i]; k < rowPtr[i+1]; k++) {
+			ilu[k] = sA_loc[k];
+			if (colInd[k] == static_cast<int>(i)) ilu_diag[i] = k;
+		}
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		if (ilu_diag[i] == -1) return false;
+		for (int k = rowPtr[i]; k < rowPtr[i+1]; k++) ilu_pos[ colInd[k] ] = k;
+
+		//eliminate the entries left of the diagonal with the rows that have already been factorized
+		for (int k = rowPtr[i]; k < ilu_diag[i]; k++) {
+			const int row = colInd[k];
+			const double pivot = ilu[ ilu_diag[row] ];
+			if (pivot == 0.) return false;
+			ilu[k] /= pivot;
+			for (int j = ilu_diag[row]+1; j < rowPtr[row+1]; j++) {
+				const int pos = ilu_pos[ colInd[j] ];
+				if (pos != -1) ilu[pos] -= ilu[k] * ilu[j]; //no fill-in outside of the sparsity pattern
+			}
+		}
+
+		for (int k = rowPtr[i]; k < rowPtr[i+1]; k++) ilu_pos[ colInd[k] ] = -1;
+		if (ilu[ ilu_diag[i] ] == 0.) return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Apply the preconditioner
+ * computes z = M^-1 r where M is the preconditioner selected by SNOWDRIFT_PRECONDITIONER
+ * @param z result
+ * @param r vector to precondition
+ * @param colInd column index
+ * @param rowPtr row index
+ */
+void SnowDriftA3D::applyPreconditioner(CDoubleArray& z, const CDoubleArray& r, const CIntArray& colInd, const CIntArray& rowPtr) const
+{
+	const size_t n = rowPtr.getNx() - 1;
+
+	if (precond_kind==PRECOND_ILU0 && ilu_valid) {
+		//forward substitution with L, then backward substitution with U
+		for (size_t i = 0; i < n; i++) {
+			double sum = r[i];
+			for (int k = rowPtr[i]; k < ilu_diag[i]; k++) sum -= ilu[k] * z[ colInd[k] ];
+			z[i] = sum;
+		}
+		for (size_t i = n; i-- > 0; ) {
+			double sum = z[i];
+			for (int k = ilu_diag[i]+1; k < rowPtr[i+1]; k++) sum -= ilu[k] * z[ colInd[k] ];
+			z[i] = sum / ilu[ ilu_diag[i] ];
+		}
+	} else if (precond_kind==PRECOND_NONE) {
+		#pragma omp parallel for
+		for (size_t i = 0; i < n; i++) z[i] = r[i];
+	} else {
+		#pragma omp parallel for
+		for (size_t i = 0; i < n; i++) z[i] = r[i] / precond[i];
+	}
+}
+
 /**
  * @brief bicgStab  iterative equation solver
- * iterative equation solver
+ * iterative equation solver, right preconditioned by applyPreconditioner(). The work vectors are
+ * allocated once in InitializeFEData() and the relative residual after each iteration is kept in
+ * residual_history (see getConvergenceHistory()).
  * Tests : Tested by the followin procedure: given a sparse matrix A
  * (CRS-format) characterized by colA and rowA and an arbitrary, or
  * rather: a few nontrivial examples of a vector x. For each x
  * matmult(y,x,sA,rowA,colA) and bicgStab(result,y,sA,colA,rowA,...)
  * have been computed and then verified that result=x
- * @param res result
+ * @param res result, also used as initial guess if SNOWDRIFT_WARM_START is set
  * @param rhs
  * @param sA
  * @param colA
@@ -576,36 +659,18 @@ void SnowDriftA3D::bicgStab(CDoubleArray& result,
 			 const double tol,
 			 double& testres)
 {
-
   //dimension of the system
   const size_t  n = rowA_loc.getNx() - 1;
 
-  CDoubleArray res1;
-  res1.resize( n);
-
-  CDoubleArray r_0;
-  r_0.resize( n );
-
-  CDoubleArray r;
-  r.resize( n );
-
-  CDoubleArray p_loc;
-  p_loc.resize( n );
-
-  CDoubleArray v;
-  v.resize( n );
-
-  CDoubleArray aux1;
-  aux1.resize( n );
-
-  CDoubleArray auxhat;
-  auxhat.resize( n );
-
-  CDoubleArray phat;
-  phat.resize( n );
-
-  CDoubleArray aux2;
-  aux2.resize( n );
+  //aliases on the workspaces
+  CDoubleArray& r_0 = bicg_r0;
+  CDoubleArray& r = bicg_r;
+  CDoubleArray& p_loc = bicg_p;
+  CDoubleArray& v = bicg_v;
+  CDoubleArray& aux1 = bicg_s;
+  CDoubleArray& aux2 = bicg_t;
+  CDoubleArray& phat = bicg_phat;
+  CDoubleArray& auxhat = bicg_shat;
 
   double rho_old = 1;
   double rho_new = 1;
@@ -614,71 +679,74 @@ void SnowDriftA3D::bicgStab(CDoubleArray& result,
   double alpha = 1;
   double beta = 0;
 
-  double residual,norm1,norm2;
+  double residual,norm1=0.,norm2=0.;
   double res4,res5;
   double tmp_res=1;
   int iterations=0;
 
-  CDoubleArray res_ok_state;
+  residual_history.clear();
 
+  if (precond_kind==PRECOND_ILU0) {
+      ilu_valid = factorizeILU0(sA_loc, colA_loc, rowA_loc);
+      if (!ilu_valid) printf("-------> ILU(0) factorization failed, using a Jacobi preconditioner\n");
+  }
 
-  srand(static_cast<unsigned>(time(NULL)));
   //intitialization
-  for (size_t i=0;i<n;i++) {
-      result[i]=0;//(rand()%RAND_MAX)/(1.0*RAND_MAX);
-      v[i] = 0;
-      p_loc[i] = 0;
+  if (!warm_start) {
+      #pragma omp parallel for
+      for (size_t i=0;i<n;i++) result[i]=0;
   }
+  matmult(aux1,result,sA_loc,colA_loc,rowA_loc);  // multiply Bx and store it into the dummy aux1
 
-  matmult(res1,result,sA_loc,colA_loc,rowA_loc);  // multiply Bx and store it into the dummy res1
-
-  norm1 = 0;
-  norm2 = 0;
+  #pragma omp parallel for reduction(+:norm1,norm2)
   for ( size_t i = 0; i < n; i++ )  {
-      r_0[i] = rhs_loc[i]-res1[i];
-	//cout<<"r_0="<<r_0[i]<<" rhs= "<<rhs[i]<<" res1="<<res1[i]<<"at i"<<i<<endl;
-
-      r[i] = rhs_loc[i]-res1[i];
+      r_0[i] = rhs_loc[i]-aux1[i];
+      r[i] = r_0[i];
+      v[i] = 0;
+      p_loc[i] = 0;
       norm1 += rhs_loc[i] * rhs_loc[i];
       norm2 += r_0[i] * r_0[i];
   }
-
-  if ( rho_new == 0 ){
-    printf("Iteration fails\n");  //in this case, can't take x=0 as initial guess
-	}
+  const double rhs_norm = sqrt(norm1);
+  if (rhs_norm==0.) { //the solution is zero, whatever the initial guess
+      #pragma omp parallel for
+      for (size_t i=0;i<n;i++) result[i]=0;
+      norm2 = 0.;
+  }
 
   int k = 0;
   double mark = 0;  //as soon as mark==1 you can stop the iteration, good approximatin is attained
 
-  residual = sqrt(norm2);
+  //starting from zero, the absolute residual is checked
+  residual = (warm_start && rhs_norm>0.)? sqrt(norm2)/rhs_norm : sqrt(norm2);
 
   if ( residual < tol) {		//stopping criterion
       mark=1;
       printf("-------> Lucky failure within %d steps with residual: %f\n", k, residual);
-
   }
 
   //main loop
   while ( (k<=nmax) && (mark==0) ) {
 
       rho_new = 0;
+      #pragma omp parallel for reduction(+:rho_new)
       for (size_t i=0;i<n;i++)	{
 	  		rho_new += r_0[i]*r[i];
 			}
 
       beta = rho_new / rho_old * alpha / omega;
 
+      #pragma omp parallel for
       for (size_t i=0;i<n;i++) {
 	 			p_loc[i] *= beta;
 	  		p_loc[i] += (r[i] - beta * omega *v[i] );
-
-	  		//precond
-	  		phat[i] = p_loc[i]/precond[i];
 			}
+      applyPreconditioner(phat, p_loc, colA_loc, rowA_loc);
 
       matmult(v,phat,sA_loc,colA_loc,rowA_loc);		// put B*p into v
 
       res4 = 0;
+      #pragma omp parallel for reduction(+:res4)
       for ( size_t i = 0; i < n ; i++ )	{
 	  		res4 += v[i] * r_0[i];
 			}
@@ -692,38 +760,45 @@ void SnowDriftA3D::bicgStab(CDoubleArray& result,
 			}
       alpha = rho_new / res4;
 
+      #pragma omp parallel for
       for ( size_t i = 0; i < n; i++ ) {
 	  		aux1[i] = r[i] - alpha * v[i];
-	  		//precond
-	  		auxhat[i] = aux1[i]/precond[i];
       }
+      applyPreconditioner(auxhat, aux1, colA_loc, rowA_loc);
 
       matmult(aux2,auxhat,sA_loc,colA_loc,rowA_loc);
 
       res4 = 0;
       res5 = 0;
+      #pragma omp parallel for reduction(+:res4,res5)
       for ( size_t i = 0; i < n; i++ ) {
 	 			 res4 += ( aux2[i] * aux1[i] );
 	 			 res5 += ( aux2[i] * aux2[i] );
       }
 
-      omega = res4 / res5;
+      omega = (res5>0.)? res4 / res5 : 0.;
 
+      norm2 = 0;
+      #pragma omp parallel for reduction(+:norm2)
       for ( size_t i = 0; i < n; i++ ) {
 	  		result[i] += ( alpha * phat[i] + omega * auxhat[i] );
 	 			r[i] = aux1[i] - omega * aux2[i];
+	 			norm2 += r[i] * r[i];
       }
 
-      matmult(res1,result,sA_loc,colA_loc,rowA_loc);
-
-      norm1=0;
-      norm2=0;
-      for ( size_t i = 0; i < n; i++ ) {
-	  		norm1 += ( rhs_loc[i] * rhs_loc[i] );
-			norm2 +=((rhs_loc[i]-res1[i])*(rhs_loc[i]-res1[i])) ; //norm2 += pow( rhs[i] - res1[i], 2 );
+      //the updated residual r is checked first, the true residual then confirms the convergence
+      residual = sqrt(norm2) / rhs_norm;
+      if ( residual <= tol) {
+	  matmult(aux1,result,sA_loc,colA_loc,rowA_loc);
+	  norm2 = 0;
+	  #pragma omp parallel for reduction(+:norm2)
+	  for ( size_t i = 0; i < n; i++ ) {
+	      r[i] = rhs_loc[i] - aux1[i];
+	      norm2 += r[i] * r[i];
+	  }
+	  residual = sqrt(norm2) / rhs_norm;
       }
-
-      residual = sqrt(norm2) / sqrt(norm1);
+      residual_history.push_back( residual );
 
       if ( residual <= tol)	{		//stopping criteria!
 	 			 mark=1;
@@ -739,22 +814,12 @@ void SnowDriftA3D::bicgStab(CDoubleArray& result,
 
       if ( residual < tmp_res){
 	  //copy this state temporarily
-	  res_ok_state=result;
+	  bicg_best=result;
 	  tmp_res=residual;
 	  iterations=k;
       }
 
       rho_old = rho_new;
-//       //LH-CHANGES BEGIN
-// //       1) comment out the following line
-// 	  cout<<" this is k: "<<k<< " and the residual: "<< residual<<endl;
-// //       2) redirect output to logfile
-//         FILE *logfile;
-//  	string fname=string("../results/numerics-tests/residual.dat");
-//         logfile = fopen(fname.c_str(), "a");
-//         fprintf(logfile, "%d %.15lf\n", k, residual);
-//         fclose (logfile);
-//        //LH-CHANGES END
       k++;
   }
   if (mark==0) {
@@ -762,7 +827,7 @@ void SnowDriftA3D::bicgStab(CDoubleArray& result,
 	if (residual > 1e7*tol && tmp_res<1.){
 	    printf("Use a previous step with residual = %f, #iterations= %d)\n", tmp_res, iterations);
 	    //copy previous result and residual
-	    result=res_ok_state;
+	    result=bicg_best;
 	    residual=tmp_res;
       }
   }
@@ -122,6 +122,8 @@ void SnowDriftA3D::Suspension()
  */
 void SnowDriftA3D::SolveEquation(int timeStep, int maxTimeStep,const param_type param)
 {
+	CDoubleArray& var = (param==HUM)? q : (param==CON)? c : T;
+
 	// Solve equation
 	if ( !(STATIONARY) ) {
 
@@ -151,7 +153,8 @@ void SnowDriftA3D::SolveEquation(int timeStep, int maxTimeStep,const param_type
 			rhs[i] += ( -Psi[i] );
 		}
 
-		//solve system
+		//solve system, var is only the initial guess from here on so the rhs does not depend on the warm start
+		if (warm_start) var = previousSolution(param);
 		double test;
 		if (param==HUM){
 			bicgStab(q,rhs,sA,colA,rowA,900,1e-5, test);
@@ -160,6 +163,7 @@ void SnowDriftA3D::SolveEquation(int timeStep, int maxTimeStep,const param_type
 		} else if (param==TEM){
 			bicgStab(T,rhs,sA,colA,rowA,900,1e-5, test);
 		}
+		if (warm_start) previousSolution(param) = var;
 		//update time
 		timeStep++;
 	    }
@@ -176,6 +180,7 @@ void SnowDriftA3D::SolveEquation(int timeStep, int maxTimeStep,const param_type
 		double testres=10.;
 		CDoubleArray saveRhs=rhs;
 		CIntArray saveRowA=rowA;
+		if (warm_start) var = previousSolution(param);
 		if (param==HUM){
 		    std::cout<<"Solving equation for q with rhs=" <<rhs[18]<<std::endl;
 		    bicgStab(q,rhs,sA,colA,rowA,3000,1e-11,testres);//call the biconjgrad method,ori 1e-10
@@ -188,9 +193,22 @@ void SnowDriftA3D::SolveEquation(int timeStep, int maxTimeStep,const param_type
 		    std::cout<<"Solving equation for T with rhs=" <<rhs[18]<<std::endl;
 		    bicgStab(T,rhs,sA,colA,rowA,3000,1e-11,testres);
 		}
+		if (warm_start) previousSolution(param) = var;
 	}
 }
 
+/**
+ * @brief Last solution of a variable, used as initial guess of its next solve if SNOWDRIFT_WARM_START is set
+ * @param param variable (Humidity, Concentration or Temperature)
+ * @return buffer holding the last solution of this variable
+ */
+CDoubleArray& SnowDriftA3D::previousSolution(const param_type param)
+{
+	if (param==HUM) return q_prev;
+	if (param==CON) return c_prev;
+	return T_prev;
+}
+
 /**
 @brief
 Calculate the steady state sublimation in several steps.
@@ -0,0 +1,185 @@
+/* Micro-benchmark of the MPI transport of MPIControl: it compares the legacy transport (one message pair
+ * per object, grids serialized as a whole) with the batched binary buffers and the typed grid transfers.
+ * compile with something like:
+ * mpicxx mpi_bench.cc -O2 -DENABLE_MPI -I ~/usr/include/ -o mpi_bench -lalpine3d -lsnowpack -lmeteoio -L ~/usr/lib/
+ * and run it on (at least) two processes:
+ * mpirun -np 2 ./mpi_bench [nr_stations] [nr_elements] [grid_size]
+ */
+
+#include <meteoio/MeteoIO.h>
+#include <snowpack/libsnowpack.h>
+#include <alpine3d/MPIControl.h>
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+using namespace mio;
+
+//this is how vectors of objects were transmitted before: a length and a string for each object
+template <class T> size_t legacy_send(const std::vector<T*>& vec, const int& dest)
+{
+	int v_size = static_cast<int>( vec.size() );
+	MPI_Send(&v_size, 1, MPI_INT, dest, 0, MPI_COMM_WORLD);
+	size_t bytes = sizeof(v_size);
+
+	for (size_t ii=0; ii<vec.size(); ii++) {
+		std::stringstream objs_stream;
+		objs_stream << *(vec[ii]);
+		std::string obj_string( objs_stream.str() );
+		unsigned int msg_len = static_cast<unsigned int>( obj_string.size() );
+		MPI_Send(&msg_len, 1, MPI_UNSIGNED, dest, 0, MPI_COMM_WORLD);
+		MPI_Send(const_cast<char*>(obj_string.c_str()), static_cast<int>(msg_len), MPI_CHAR, dest, 0, MPI_COMM_WORLD);
+		bytes += sizeof(msg_len) + msg_len;
+	}
+	return bytes;
+}
+
+template <class T> void legacy_receive(std::vector<T*>& vec, const int& source)
+{
+	int v_size;
+	MPI_Recv(&v_size, 1, MPI_INT, source, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+	vec.resize(static_cast<size_t>(v_size));
+
+	T obj;
+	for (size_t ii=0; ii<vec.size(); ii++) {
+		unsigned int msg_len;
+		MPI_Recv(&msg_len, 1, MPI_UNSIGNED, source, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+		std::string obj_string(msg_len, '\0');
+		MPI_Recv(&obj_string[0], static_cast<int>(msg_len), MPI_CHAR, source, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+		std::stringstream objs_stream;
+		objs_stream << obj_string;
+		objs_stream >> obj;
+		vec[ii] = new T(obj);
+	}
+}
+
+//bytes that the batched transport puts on the wire for the same objects
+template <class T> size_t batched_bytes(const std::vector<T*>& vec)
+{
+	size_t bytes = sizeof(unsigned long long) + 2*sizeof(unsigned short) + sizeof(unsigned long long);
+	for (size_t ii=0; ii<vec.size(); ii++) {
+		std::ostringstream os;
+		os << *(vec[ii]);
+		bytes += sizeof(unsigned long long) + os.str().size();
+	}
+	return bytes;
+}
+
+template <class T> void freeVector(std::vector<T*>& vec)
+{
+	for (size_t ii=0; ii<vec.size(); ii++) delete vec[ii];
+	vec.clear();
+}
+
+void printResult(const std::string& what, const size_t& legacy_bytes, const double& legacy_time, const size_t& new_bytes, const double& new_time)
+{
+	cout << setw(24) << left << what << right << fixed << setprecision(3);
+	cout << setw(14) << legacy_bytes << " B " << setw(9) << legacy_time << " s   -> ";
+	cout << setw(14) << new_bytes << " B " << setw(9) << new_time << " s   (x" << setprecision(1) << legacy_time/new_time << ")\n";
+}
+
+template <class T> void benchVector(const std::string& what, std::vector<T*>& vec)
+{
+	MPIControl& mpi = MPIControl::instance();
+	std::vector<T*> received;
+
+	mpi.barrier();
+	double t0 = MPI_Wtime();
+	size_t legacy_bytes = 0;
+	if (mpi.rank()==1) legacy_bytes = legacy_send(vec, 0);
+	else if (mpi.rank()==0) legacy_receive(received, 1);
+	mpi.barrier();
+	const double legacy_time = MPI_Wtime() - t0;
+	const size_t legacy_count = received.size();
+	freeVector(received);
+
+	t0 = MPI_Wtime();
+	if (mpi.rank()==1) mpi.send(vec, 0);
+	else if (mpi.rank()==0) mpi.receive(received, 1);
+	mpi.barrier();
+	const double new_time = MPI_Wtime() - t0;
+
+	if (mpi.rank()==0 && received.size()!=legacy_count)
+		throw IOException("Wrong number of objects received", AT);
+	freeVector(received);
+
+	if (mpi.rank()==1) printResult(what, legacy_bytes, legacy_time, batched_bytes(vec), new_time);
+}
+
+void benchGrid(const size_t& grid_size)
+{
+	MPIControl& mpi = MPIControl::instance();
+	Grid2DObject grid(grid_size, grid_size, 100., Coords(), 0.);
+	for (size_t ii=0; ii<grid.size(); ii++) grid(ii) = static_cast<double>(ii % 997);
+	const Grid2DObject ref(grid);
+	const size_t cells_bytes = grid.size()*sizeof(double);
+	std::ostringstream os;
+	os << grid;
+	const size_t legacy_bytes = os.str().size();
+
+	mpi.barrier();
+	double t0 = MPI_Wtime();
+	mpi.broadcast<Grid2DObject>(grid, 0); //explicit template argument: generic serialization path
+	mpi.barrier();
+	const double legacy_bcast = MPI_Wtime() - t0;
+
+	t0 = MPI_Wtime();
+	mpi.broadcast(grid, 0);
+	mpi.barrier();
+	const double new_bcast = MPI_Wtime() - t0;
+	if (grid!=ref) throw IOException("Broadcasted grid differs from the original", AT);
+
+	t0 = MPI_Wtime();
+	mpi.allreduce_sum<Grid2DObject>(grid); //explicit template argument: generic serialization path
+	mpi.barrier();
+	const double legacy_sum = MPI_Wtime() - t0;
+
+	grid = ref;
+	t0 = MPI_Wtime();
+	mpi.allreduce_sum(grid);
+	mpi.barrier();
+	const double new_sum = MPI_Wtime() - t0;
+	if (grid(grid.size()-1) != static_cast<double>(mpi.size())*ref(ref.size()-1)) throw IOException("Wrong grid sum", AT);
+
+	if (mpi.master()) {
+		printResult("Grid2DObject broadcast", legacy_bytes, legacy_bcast, cells_bytes, new_bcast);
+		printResult("Grid2DObject allreduce", legacy_bytes, legacy_sum, cells_bytes, new_sum);
+	}
+}
+
+int main(int argc, char** argv) {
+	MPIControl& mpi = MPIControl::instance();
+	if (mpi.size() < 2) {
+		cerr << "Please run this benchmark on at least two MPI processes\n";
+		return 1;
+	}
+	const size_t nr_stations = (argc>1)? static_cast<size_t>( atoi(argv[1]) ) : 10000;
+	const size_t nr_elements = (argc>2)? static_cast<size_t>( atoi(argv[2]) ) : 50;
+	const size_t grid_size = (argc>3)? static_cast<size_t>( atoi(argv[3]) ) : 1000;
+
+	std::vector<SnowStation*> stations;
+	std::vector<CurrentMeteo*> meteo;
+	std::vector<SurfaceFluxes*> fluxes;
+	if (mpi.rank()==1) {
+		for (size_t ii=0; ii<nr_stations; ii++) {
+			SnowStation *station = new SnowStation(false, false);
+			station->resize(nr_elements);
+			stations.push_back(station);
+			meteo.push_back(new CurrentMeteo);
+			fluxes.push_back(new SurfaceFluxes);
+		}
+		cout << "Transmitting " << nr_stations << " cells of " << nr_elements << " elements and a " << grid_size << "x" << grid_size << " grid\n";
+		cout << setw(24) << left << "" << right << setw(35) << "legacy" << setw(37) << "batched / typed" << "\n";
+	}
+
+	benchVector("SnowStation", stations);
+	benchVector("CurrentMeteo", meteo);
+	benchVector("SurfaceFluxes", fluxes);
+	benchGrid(grid_size);
+
+	freeVector(stations);
+	freeVector(meteo);
+	freeVector(fluxes);
+	return 0;
+}
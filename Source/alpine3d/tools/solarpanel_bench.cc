@@ -0,0 +1,76 @@
+/* Benchmark of the SolarPanel geometry: embedding of the panels in the terrain (rotated Basic Sets, ViewLists and
+ * panel shading lists) and computation of the irradiance on the panels on a real DEM.
+ * compile with something like:
+ * g++ solarpanel_bench.cc -O2 -fopenmp -I ~/usr/include/ -o solarpanel_bench -lalpine3d -lsnowpack -lmeteoio -L ~/usr/lib/
+ * and run it from the setup directory of the radiation_complex example (the irradiances are written in ../output/PVP):
+ * ./solarpanel_bench [nr_panels] [nr_steps]
+ */
+
+#include <meteoio/MeteoIO.h>
+#include <alpine3d/ebalance/SolarPanel.h>
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+using namespace mio;
+
+//panels spread over the inner part of the DEM, with various orientations (easting, northing, height over ground, inclination, azimuth, height, width)
+std::vector< std::vector<double> > generatePanels(const DEMObject& dem, const size_t& nr_panels)
+{
+	std::vector< std::vector<double> > pv_points;
+	const double x0 = dem.llcorner.getEasting() + 0.3*dem.cellsize*static_cast<double>(dem.getNx());
+	const double y0 = dem.llcorner.getNorthing() + 0.3*dem.cellsize*static_cast<double>(dem.getNy());
+	for (size_t ii=0; ii<nr_panels; ii++) {
+		const double easting = x0 + 3.3*dem.cellsize*static_cast<double>(ii % 12);
+		const double northing = y0 + 2.1*dem.cellsize*static_cast<double>(ii / 12);
+		const double inclination = static_cast<double>((ii*20) % 100);
+		const double azimuth = static_cast<double>((ii*45) % 360) - 180.;
+		const double panel_points[] = {easting, northing, 2.+static_cast<double>(ii%3), inclination, azimuth, 6., 3.};
+		pv_points.push_back( std::vector<double>(panel_points, panel_points+7) );
+	}
+	return pv_points;
+}
+
+int main(int argc, char** argv) {
+	const size_t nr_panels = (argc>1)? static_cast<size_t>( atoi(argv[1]) ) : 24;
+	const size_t nr_steps = (argc>2)? static_cast<size_t>( atoi(argv[2]) ) : 12;
+
+	Config cfg;
+	cfg.addKey("DEM", "Input", "ARC");
+	cfg.addKey("DEMFILE", "Input", "../input/surface-grids/totalp.dem");
+	cfg.addKey("COORDSYS", "Input", "CH1903");
+	cfg.addKey("TERRAIN_RADIATION_METHOD", "EBalance", "SIMPLE");
+	cfg.addKey("BRDFPATH", "EBalance", "../input/brdf-files");
+	cfg.addKey("PV_SHADOWING", "EBalance", "TRUE");
+
+	IOManager io(cfg);
+	DEMObject dem;
+	io.readDEM(dem);
+
+	Timer timer;
+	timer.start();
+	SolarPanel panels(cfg, dem, generatePanels(dem, nr_panels));
+	timer.stop();
+	const double init_time = timer.getElapsed();
+
+	//constant radiation fields, the sun moving from east to west
+	const Array2D<double> albedo(dem.getNx(), dem.getNy(), 0.6);
+	const Array2D<double> direct(dem.getNx(), dem.getNy(), 600.);
+	const Array2D<double> diffuse(dem.getNx(), dem.getNy(), 120.);
+	const Date start(2017, 6, 21, 6, 0, 1.);
+	timer.reset();
+	timer.start();
+	for (size_t step=0; step<nr_steps; step++) {
+		const double azimuth = 90. + 180.*static_cast<double>(step)/static_cast<double>(nr_steps);
+		const double elevation = 10. + 50.*sin(Cst::PI*static_cast<double>(step)/static_cast<double>(nr_steps));
+		panels.setGridRadiation(albedo, direct, diffuse, direct, azimuth, elevation);
+		panels.setSP(start+static_cast<double>(step)/24., azimuth, elevation);
+	}
+	timer.stop();
+
+	cout << "\n" << nr_panels << " panels on a " << dem.getNx() << "x" << dem.getNy() << " DEM\n";
+	cout << "Panels embedding (ViewLists and shading):\t" << init_time << " s\n";
+	cout << "Irradiance for " << nr_steps << " time steps:\t\t" << timer.getElapsed() << " s\n";
+	return 0;
+}
@@ -19,8 +19,11 @@
 
 #include <algorithm>
 #include <iostream>
+#include <iomanip>
 #include <cstdio>
 #include <fstream>
+#include <functional>
+#include <thread>
 
 #if defined _WIN32 || defined __MINGW32__
 	#ifndef NOMINMAX
@@ -28,6 +31,10 @@
 	#endif
 	#include <windows.h>
 	#include "Shlwapi.h"
+	#include <sys/types.h>
+	#include <sys/stat.h>
+	#include <process.h>
+	#include <cstring>
 #else
 	#include <dirent.h>
 	#include <sys/stat.h>
@@ -399,6 +406,38 @@ std::map<std::string,std::string> readKeyValueHeader(std::istream& fin, const si
 	return headermap;
 }
 
+uint64_t hashBytes(const char* bytes, const size_t& len, uint64_t hash)
+{
+	static const uint64_t fnv_prime = 1099511628211ULL;
+	for (size_t ii=0; ii<len; ii++)
+		hash = (hash ^ static_cast<unsigned char>(bytes[ii])) * fnv_prime;
+	return hash;
+}
+
+std::string getTempFilename(const std::string& filename)
+{
+#if defined _WIN32 || defined __MINGW32__
+	const int pid = _getpid();
+#else
+	const int pid = static_cast<int>( getpid() );
+#endif
+	const size_t thread_hash = std::hash<std::thread::id>()( std::this_thread::get_id() );
+	std::ostringstream os;
+	os << filename << "." << pid << "_" << std::hex << thread_hash << ".tmp";
+	return os.str();
+}
+
+bool replaceFile(const std::string& src, const std::string& dest)
+{
+	if (std::rename(src.c_str(), dest.c_str())==0) return true;
+#if defined _WIN32 || defined __MINGW32__
+	//on Windows, rename() does not replace an existing file
+	std::remove(dest.c_str());
+	return (std::rename(src.c_str(), dest.c_str())==0);
+#else
+	return false;
+#endif
+}
 
 //below, the file indexer implementation
 void FileIndexer::setIndex(const Date& i_date, const std::streampos& i_pos)
@@ -408,6 +447,7 @@ void FileIndexer::setIndex(const Date& i_date, const std::streampos& i_pos)
 	//check if we can simply append the new index
 	if (vecIndex.empty() || elem>vecIndex.back()) {
 		vecIndex.push_back(elem);
+		modified = true;
 		return;
 	}
 
@@ -415,6 +455,7 @@ void FileIndexer::setIndex(const Date& i_date, const std::streampos& i_pos)
 	const std::vector< struct file_index >::iterator it = std::upper_bound(vecIndex.begin(), vecIndex.end(), elem);
 	if (it>vecIndex.begin() && (it-1)->date!=elem.date) { //check that we don't try to insert a duplicate
 		vecIndex.insert(it, elem); //insertion is at the proper place -> remains ordered
+		modified = true;
 		return;
 	}
 }
@@ -465,6 +506,126 @@ size_t FileIndexer::binarySearch(const Date& soughtdate) const
 	else return static_cast<size_t>(-1);
 }
 
+//the index files start with this header: format version, context hash, data file size, data file modification time,
+//hash of the first block of the data file, hash of the last block of the data file, number of entries
+static const uint64_t index_file_version = 1;
+static const size_t index_header_size = 7;
+static const uint64_t index_hash_block = 65536; //size of the blocks of the data file that are hashed
+
+static bool getFileStats(const std::string& filename, uint64_t& size, uint64_t& mtime)
+{
+#if defined _WIN32 || defined __MINGW32__
+	struct __stat64 buffer;
+	if (_stat64(filename.c_str(), &buffer)!=0) return false;
+#else
+	struct stat buffer;
+	if (stat(filename.c_str(), &buffer)!=0) return false;
+#endif
+	size = static_cast<uint64_t>(buffer.st_size);
+	mtime = static_cast<uint64_t>(buffer.st_mtime);
+	return true;
+}
+
+//hash the first and the last blocks of the first size bytes of the data file
+bool FileIndexer::getSignature(const std::string& data_filename, const uint64_t& size, uint64_t& head_hash, uint64_t& tail_hash)
+{
+	std::ifstream fin(data_filename.c_str(), std::ios::binary);
+	if (fin.fail()) return false;
+
+	const uint64_t head_len = std::min(size, index_hash_block);
+	const uint64_t tail_start = size - head_len;
+	std::vector<char> buffer(static_cast<size_t>(head_len));
+	if (head_len==0) {
+		head_hash = tail_hash = hashBytes(nullptr, 0);
+		return true;
+	}
+
+	fin.read(&buffer[0], static_cast<std::streamsize>(head_len));
+	if (!fin) return false;
+	head_hash = hashBytes(&buffer[0], buffer.size());
+
+	fin.seekg(static_cast<std::streamoff>(tail_start));
+	fin.read(&buffer[0], static_cast<std::streamsize>(head_len));
+	if (!fin) return false;
+	tail_hash = hashBytes(&buffer[0], buffer.size());
+	return true;
+}
+
+bool FileIndexer::read(const std::string& index_filename, const std::string& data_filename, const std::string& context)
+{
+	std::ifstream fin(index_filename.c_str(), std::ios::binary);
+	if (fin.fail()) return false;
+
+	uint64_t header[index_header_size];
+	fin.read(reinterpret_cast<char*>(header), sizeof(header));
+	if (!fin || header[0]!=index_file_version || header[1]!=hashBytes(context.c_str(), context.size())) return false;
+
+	//the data file must be unchanged, or data must have only been appended to it
+	uint64_t size, mtime;
+	if (!getFileStats(data_filename, size, mtime)) return false;
+	const uint64_t indexed_size = header[2];
+	if (size<indexed_size || (size==indexed_size && mtime!=header[3])) return false;
+	uint64_t head_hash, tail_hash;
+	if (!getSignature(data_filename, indexed_size, head_hash, tail_hash) || head_hash!=header[4] || tail_hash!=header[5]) return false;
+
+	//each entry is stored as the gmt julian date and the stream position
+	const size_t nr_entries = static_cast<size_t>( header[6] );
+	std::vector<uint64_t> entries(2*nr_entries);
+	if (nr_entries>0) fin.read(reinterpret_cast<char*>(&entries[0]), static_cast<std::streamsize>(entries.size()*sizeof(uint64_t)));
+	if (!fin) return false;
+
+	for (size_t ii=0; ii<nr_entries; ii++) {
+		double julian;
+		memcpy(&julian, &entries[2*ii], sizeof(julian));
+		setIndex(Date(julian, 0.), static_cast<std::streamoff>(entries[2*ii+1]));
+	}
+	modified = (size!=indexed_size); //when data has been appended, the signature has to be updated
+	return true;
+}
+
+void FileIndexer::write(const std::string& index_filename, const std::string& data_filename, const std::string& context)
+{
+	uint64_t size, mtime, head_hash, tail_hash;
+	if (!getFileStats(data_filename, size, mtime) || !getSignature(data_filename, size, head_hash, tail_hash)) {
+		std::cerr << "[W] Could not compute the signature of '" << data_filename << "', its index is not written\n";
+		return;
+	}
+
+	const uint64_t header[index_header_size] = {index_file_version, hashBytes(context.c_str(), context.size()), size, mtime, head_hash, tail_hash, vecIndex.size()};
+	std::vector<uint64_t> entries(2*vecIndex.size());
+	for (size_t ii=0; ii<vecIndex.size(); ii++) {
+		const double julian = vecIndex[ii].date.getJulian(true);
+		memcpy(&entries[2*ii], &julian, sizeof(julian));
+		entries[2*ii+1] = static_cast<uint64_t>( static_cast<std::streamoff>(vecIndex[ii].pos) );
+	}
+
+	const std::string tmp_filename( getTempFilename(index_filename) );
+	std::ofstream fout(tmp_filename.c_str(), std::ios::binary);
+	if (fout.fail()) {
+		std::cerr << "[W] Could not write the index of '" << data_filename << "' to '" << index_filename << "'\n";
+		return;
+	}
+	fout.write(reinterpret_cast<const char*>(header), sizeof(header));
+	if (!entries.empty()) fout.write(reinterpret_cast<const char*>(&entries[0]), static_cast<std::streamsize>(entries.size()*sizeof(uint64_t)));
+	fout.close();
+
+	if (fout.fail() || !replaceFile(tmp_filename, index_filename)) {
+		std::cerr << "[W] Could not write the index of '" << data_filename << "' to '" << index_filename << "'\n";
+		std::remove(tmp_filename.c_str());
+		return;
+	}
+	modified = false;
+}
+
+std::string FileIndexer::getIndexFilename(const std::string& index_path, const std::string& data_filename)
+{
+	const std::string full_path( cleanPath(data_filename, true) );
+	std::ostringstream os;
+	os << index_path << "/" << removeExtension( getFilename(data_filename) ) << "_";
+	os << std::hex << std::setw(16) << std::setfill('0') << hashBytes(full_path.c_str(), full_path.size()) << ".idx";
+	return os.str();
+}
+
 const std::string FileIndexer::toString() const
 {
 	std::ostringstream os;
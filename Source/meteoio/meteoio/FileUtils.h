@@ -23,6 +23,7 @@
 #include <map>
 #include <vector>
 #include <list>
+#include <stdint.h>
 
 #include <meteoio/dataClasses/Date.h>
 
@@ -121,10 +122,41 @@ namespace FileUtils {
 	                        const size_t& linecount=1,
 	                        const std::string& delimiter="=", const bool& keep_case=false);
 
+	/**
+	* @brief FNV-1a hash of some bytes
+	* @param bytes bytes to hash
+	* @param len number of bytes to hash
+	* @param hash previous hash to continue from, so several buffers can be hashed as if they were contiguous
+	* @return 64 bits hash
+	*/
+	uint64_t hashBytes(const char* bytes, const size_t& len, uint64_t hash=14695981039346656037ULL);
+
+	/**
+	* @brief Name of a temporary file to write before renaming it to a given file name (see replaceFile())
+	* @details The name contains the process id and a hash of the thread id, so that several processes or several
+	* threads writing the same file at the same time each write their own temporary file.
+	* @param filename file name the temporary file will be renamed to
+	* @return temporary file name, in the same directory
+	*/
+	std::string getTempFilename(const std::string& filename);
+
+	/**
+	* @brief Rename a file, replacing the destination file if it already exists
+	* @details On POSIX systems, the destination is atomically replaced so readers either see the previous file or
+	* the new one. On Windows, rename() does not replace an existing file so the destination is first removed: a
+	* reader might then briefly find no file at all.
+	* @param src file to rename
+	* @param dest new name of the file
+	* @return true if the file could be renamed
+	*/
+	bool replaceFile(const std::string& src, const std::string& dest);
+
 	/**
 	* @class file_indexer
 	* @brief helps building an index of stream positions
 	* to quickly jump closer to the proper position in a file
+	* @details The index can be persisted in a sidecar file (see write()), so that the next runs can directly
+	* seek to the requested dates instead of scanning the data file from its beginning.
 	*
 	* @ingroup plugins
 	* @author Mathias Bavay
@@ -132,7 +164,7 @@ namespace FileUtils {
 	*/
 	class FileIndexer {
 		public:
-			FileIndexer() : vecIndex() {}
+			FileIndexer() : vecIndex(), modified(false) {}
 
 			/**
 			* @brief Add a new position to the index
@@ -153,6 +185,47 @@ namespace FileUtils {
 			std::streampos getIndex(const std::string& i_date) const;
 			std::streampos getIndex(const double& i_date) const;
 
+			/**
+			* @brief Read the index from a sidecar file written by write() for the same data file
+			* @details The index is only used if the data file has not been modified since it has been written (same
+			* size, modification time and content of its first and last blocks) or if data has only been appended
+			* to it. The entries that are read are merged into the current index.
+			* @param[in] index_filename sidecar file containing the index
+			* @param[in] data_filename data file the index has been built for
+			* @param[in] context description of anything else the dates of the index depend on (time zone, date format, etc),
+			* the index is only used if it has been written with the same context
+			* @return true if the index could be used, false otherwise (the index is then left unchanged)
+			*/
+			bool read(const std::string& index_filename, const std::string& data_filename, const std::string& context="");
+
+			/**
+			* @brief Write the index to a sidecar file, together with the signature of the data file
+			* @details The index is written to a temporary file private to the calling process and thread, that is
+			* then renamed (see replaceFile()). On POSIX systems, concurrent readers therefore never read a partial index;
+			* on Windows they might briefly find none and rebuild it. Failures are reported as warnings, since the index
+			* can always be rebuilt.
+			* @param[in] index_filename sidecar file to write the index to
+			* @param[in] data_filename data file the index has been built for
+			* @param[in] context description of anything else the dates of the index depend on (see read())
+			*/
+			void write(const std::string& index_filename, const std::string& data_filename, const std::string& context="");
+
+			/**
+			* @brief Has the index been modified since it has last been read or written?
+			* @return true if it should be written again to its sidecar file
+			*/
+			bool isModified() const {return modified;}
+
+			/**
+			* @brief Name of the sidecar file for the index of a given data file
+			* @details The name is built from the name of the data file and a hash of its full path, so data files with
+			* the same name in different directories get different sidecar files.
+			* @param[in] index_path directory containing the sidecar files
+			* @param[in] data_filename data file (with its path)
+			* @return sidecar file name (with its path)
+			*/
+			static std::string getIndexFilename(const std::string& index_path, const std::string& data_filename);
+
 			const std::string toString() const;
 
 		private:
@@ -168,8 +241,10 @@ namespace FileUtils {
 				std::streampos pos;
 			};
 			size_t binarySearch(const Date& soughtdate) const;
+			static bool getSignature(const std::string& data_filename, const uint64_t& size, uint64_t& head_hash, uint64_t& tail_hash);
 
 			std::vector< struct file_index > vecIndex;
+			bool modified; ///< has an entry been added since the last read() or write()?
 	};
 
 } //end namespace FileUtils
@@ -339,14 +339,61 @@ std::vector<METEO_SET> GridsManager::getVirtualStationsFromGrid(const DEMObject&
 	if (it==grids2d_list.end()) return std::vector<METEO_SET>();
 	if (it!=grids2d_list.begin() && it->first!=dateStart) --it; //we want to ensure the range contains the start date (for interpolations)
 
-	//now, we read the data for each available timestep
+	//now, we collect the available timesteps and create the stations without measurements
+	std::vector<Date> dates;
 	for (; it!=grids2d_list.end(); ++it) {
-		const METEO_SET vecMeteo( getVirtualStationsFromGrid(dem, v_params, v_stations, it->first) ); //the number of stations can not change
-		for (size_t ii=0; ii<nrStations; ii++)
-			vecvecMeteo[ii].push_back( vecMeteo[ii] );
-
+		dates.push_back( it->first );
 		if (it->first>=dateEnd) break;
 	}
+	const size_t nrDates = dates.size();
+
+	std::vector< std::pair<size_t, size_t> > Pts( nrStations );
+	for (size_t ii=0; ii<nrStations; ii++) {
+		Pts[ii] = std::make_pair(v_stations[ii].position.getGridI(), v_stations[ii].position.getGridJ()); //this should work since invalid stations have been removed in init
+		vecvecMeteo[ii].reserve( nrDates );
+		for (size_t jj=0; jj<nrDates; jj++)
+			vecvecMeteo[ii].push_back( MeteoData(dates[jj], v_stations[ii]) );
+	}
+
+	std::vector< std::pair<MeteoGrids::Parameters, size_t> > full_grids_params; //parameters that require reading the full grids
+	for (size_t param=0; param<v_params.size(); param++) { //loop over required parameters
+		const MeteoGrids::Parameters grid_param = static_cast<MeteoGrids::Parameters>( v_params[param] );
+		const size_t meteo_param = MeteoData().getParameterIndex( MeteoGrids::getParameterName(grid_param) ); //is this name also a meteoparameter?
+		if (meteo_param==IOUtils::npos) continue;
+
+		//if the plugin can read the points directly from the files, only one grid has to be read to check the geolocalization
+		bool raw_available = true;
+		for (size_t jj=0; jj<nrDates && raw_available; jj++)
+			raw_available = (grids2d_list[ dates[jj] ].count( grid_param ) > 0);
+		if (raw_available) {
+			const Grid2DObject grid( getGrid(grid_param, dates.front(), false) ); //keep lat/lon grids if they are so
+			if (!grid.isSameGeolocalization(dem))
+				throw InvalidArgumentException("In GRID_EXTRACT, the DEM and the source grid don't match for '"+MeteoGrids::getParameterName(grid_param)+"' on "+dates.front().toString(Date::ISO), AT);
+
+			std::vector< std::vector<double> > data;
+			if (iohandler.read2DGridPoints(data, grid_param, dates, Pts)) {
+				for (size_t ii=0; ii<nrStations; ii++) {
+					for (size_t jj=0; jj<nrDates; jj++)
+						vecvecMeteo[ii][jj]( static_cast<MeteoData::Parameters>(meteo_param) ) = data[ii][jj];
+				}
+				continue;
+			}
+		}
+		full_grids_params.push_back( std::make_pair(grid_param, meteo_param) );
+	}
+
+	//otherwise, read (and buffer) the full grids and extract the points, one timestep after another so generated grids can reuse the buffered ones
+	for (size_t jj=0; jj<nrDates && !full_grids_params.empty(); jj++) {
+		for (size_t param=0; param<full_grids_params.size(); param++) {
+			const MeteoGrids::Parameters grid_param = full_grids_params[param].first;
+			const Grid2DObject grid( getGrid(grid_param, dates[jj], false) ); //keep lat/lon grids if they are so
+			if (!grid.isSameGeolocalization(dem))
+				throw InvalidArgumentException("In GRID_EXTRACT, the DEM and the source grid don't match for '"+MeteoGrids::getParameterName(grid_param)+"' on "+dates[jj].toString(Date::ISO), AT);
+
+			for (size_t ii=0; ii<nrStations; ii++) //loop over all virtual stations
+				vecvecMeteo[ii][jj]( static_cast<MeteoData::Parameters>(full_grids_params[param].second) ) = grid(Pts[ii].first, Pts[ii].second);
+		}
+	}
 
 	return vecvecMeteo;
 }
@@ -354,6 +354,12 @@ void IOHandler::read2DGrid(Grid2DObject& grid_out, const MeteoGrids::Parameters&
 	plugin->read2DGrid(grid_out, parameter, date);
 }
 
+bool IOHandler::read2DGridPoints(std::vector< std::vector<double> >& data, const MeteoGrids::Parameters& parameter, const std::vector<Date>& dates, const std::vector< std::pair<size_t, size_t> >& Pts)
+{
+	IOInterface *plugin = getPlugin("GRID2D", "Input");
+	return plugin->read2DGridPoints(data, parameter, dates, Pts);
+}
+
 void IOHandler::read3DGrid(Grid3DObject& grid_out, const std::string& i_filename)
 {
 	IOInterface *plugin = getPlugin("GRID3D", "Input");
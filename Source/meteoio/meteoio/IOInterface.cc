@@ -83,6 +83,11 @@ void IOInterface::read2DGrid(Grid2DObject& /*grid_out*/, const MeteoGrids::Param
 	throw IOException("Nothing implemented here", AT);
 }
 
+bool IOInterface::read2DGridPoints(std::vector< std::vector<double> >& /*data*/, const MeteoGrids::Parameters& /*parameter*/, const std::vector<Date>& /*dates*/, const std::vector< std::pair<size_t, size_t> >& /*Pts*/)
+{
+	return false;
+}
+
 void IOInterface::read3DGrid(Grid3DObject& /*grid_out*/, const std::string& /*parameter=""*/)
 {
 	throw IOException("Nothing implemented here", AT);
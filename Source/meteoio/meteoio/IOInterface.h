@@ -74,6 +74,18 @@ class IOInterface {
 		*/
 		virtual void read2DGrid(Grid2DObject& grid_out, const MeteoGrids::Parameters& parameter, const Date& date);
 
+		/**
+		* @brief Read the time series of the given meteo parameter at some points of the 2D grids.
+		* This allows to extract a few points (for example virtual stations) over a whole time range without reading
+		* the full grids. Plugins that can not do better than reading the whole grids don't need to implement it.
+		* @param data values read at each point for each date, as data[point][date]
+		* @param parameter The meteo parameter grid type to read (ie: air temperature, wind component, etc)
+		* @param dates the timestamps to read (they must all be available for this parameter)
+		* @param Pts the (i,j) indices of the points within the grids
+		* @return true if the plugin could provide the data, false if this is not supported (then the full grids must be read)
+		*/
+		virtual bool read2DGridPoints(std::vector< std::vector<double> >& data, const MeteoGrids::Parameters& parameter, const std::vector<Date>& dates, const std::vector< std::pair<size_t, size_t> >& Pts);
+
 		/**
 		* @brief A generic function for parsing 3D grids into a Grid3DObject. The string parameter shall be used for addressing the
 		* specific 3D grid to be parsed into the Grid3DObject, relative to GRID3DPATH for most plugins.
@@ -478,6 +478,35 @@ template<> bool convertString<bool>(bool& t, std::string str, std::ios_base& (*f
 	return true;
 }
 
+bool convertDecimal(const char* start, const char* end, double& value)
+{
+	static const double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+	static const int max_digits = 15;
+
+	const char* pos = start;
+	const bool negative = (pos<end && *pos=='-');
+	if (pos<end && (*pos=='-' || *pos=='+')) pos++;
+	unsigned long long mantissa = 0;
+	int nr_digits = 0, nr_decimals = 0;
+	while (pos<end && *pos>='0' && *pos<='9' && nr_digits<=max_digits) {
+		mantissa = mantissa*10 + static_cast<unsigned long long>(*pos++ - '0');
+		nr_digits++;
+	}
+	if (pos<end && *pos=='.') {
+		pos++;
+		while (pos<end && *pos>='0' && *pos<='9' && nr_digits<=max_digits) {
+			mantissa = mantissa*10 + static_cast<unsigned long long>(*pos++ - '0');
+			nr_digits++;
+			nr_decimals++;
+		}
+	}
+	if (pos!=end || nr_digits==0 || nr_digits>max_digits) return false;
+
+	value = static_cast<double>(mantissa) / pow10[nr_decimals];
+	if (negative) value = -value;
+	return true;
+}
+
 template<> bool convertString<double>(double& t, std::string str, std::ios_base& (*f)(std::ios_base&))
 {
 	if (f == std::dec) {
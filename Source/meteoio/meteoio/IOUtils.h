@@ -326,6 +326,19 @@ namespace IOUtils {
 
 	bool convertString(Date& t, std::string str, const double& time_zone, std::ios_base& (*f)(std::ios_base&) = std::dec);
 
+	/**
+	* @brief Fast conversion of a plain decimal number (such as "-12.345") to double
+	* @details Plain decimal numbers of at most 15 digits are converted directly: their mantissa and the power of ten
+	* are then both exact, so their division is correctly rounded and gives exactly the same result as strtod.
+	* Any other form (white spaces, exponent, comments, too many digits, invalid characters...) is rejected, so
+	* the caller can fall back to its usual conversion.
+	* @param start first character to convert
+	* @param end character after the last one to convert
+	* @param value converted value (only set if the conversion succeeded)
+	* @return true if the characters in [start, end) are a plain decimal number that has been converted
+	*/
+	bool convertDecimal(const char* start, const char* end, double& value);
+
 	/**
 	* @brief Returns, with the requested type, the value associated to a key (template function).
 	* @tparam T   [in] The type wanted for the return value (template type parameter).
@@ -27,7 +27,8 @@ using namespace std;
 namespace mio {
 
 Meteo1DInterpolator::Meteo1DInterpolator(const Config& in_cfg, const char& rank, const IOUtils::OperationMode &mode)
-                     : mapAlgorithms(), cfg(in_cfg), window_size(86400.), enable_resampling(true), data_qa_logs(false)
+                     : mapAlgorithms(), vecAlgorithms(MeteoData::nrOfParameters, nullptr), stations(), station_hashes(),
+                       cfg(in_cfg), window_size(86400.), enable_resampling(true), data_qa_logs(false)
 {
 	cfg.getValue("DATA_QA_LOGS", "GENERAL", data_qa_logs, IOUtils::nothrow);
 	
@@ -53,6 +54,7 @@ Meteo1DInterpolator::Meteo1DInterpolator(const Config& in_cfg, const char& rank,
 			const std::vector< std::pair<std::string, std::string> > vecArgs( getArgumentsForAlgorithm(parname, algo_name) );
 			mapAlgorithms[parname] = ResamplingAlgorithmsFactory::getAlgorithm(algo_name, parname, window_size, vecArgs);
 		}
+		vecAlgorithms[ii] = mapAlgorithms[parname];
 	}
 }
 
@@ -71,13 +73,92 @@ void Meteo1DInterpolator::getWindowSize(ProcessingProperties& o_properties) cons
 	o_properties.time_after    = Duration(window_size, 0.);
 }
 
-bool Meteo1DInterpolator::resampleData(const Date& date, const std::string& stationHash, const std::vector<MeteoData>& vecM, MeteoData& md)
+void Meteo1DInterpolator::setStations(const std::vector< std::vector<MeteoData> >& vecVecM)
+{
+	std::vector<std::string> hashes( vecVecM.size() );
+	for (size_t ii=0; ii<vecVecM.size(); ii++) {
+		if (!vecVecM[ii].empty()) hashes[ii] = vecVecM[ii].front().meta.getHash();
+	}
+
+	if (hashes != station_hashes) {
+		std::map< std::string, ResamplingAlgorithms* >::iterator it;
+		for (it=mapAlgorithms.begin(); it!=mapAlgorithms.end(); ++it)
+			it->second->resetStations();
+		station_hashes.swap( hashes );
+	}
+
+	//the parameters and the indices might have changed, everything will be resolved again on the next request
+	stations.assign( vecVecM.size(), station_state() );
+}
+
+/**
+ * @brief Same as IOUtils::seek(date, vecM, false) but starting from the index found by the previous search,
+ * since the requested dates are usually moving forward by small steps.
+ * @param[in] date date to look for
+ * @param[in] vecM timeseries
+ * @param[in,out] last_index index returned by the previous search (or IOUtils::npos), updated with the new result
+ * @return index of the first element at or after the given date, IOUtils::npos if the date is not within the timeseries
+ */
+size_t Meteo1DInterpolator::seekIndex(const Date& date, const std::vector<MeteoData>& vecM, size_t& last_index)
+{
+	if (date < vecM.front().date || date > vecM.back().date) return IOUtils::npos;
+
+	static const size_t max_steps = 4; //beyond that, a full search is cheaper
+	size_t index = last_index;
+	if (index < vecM.size() && (index==0 || vecM[index-1].date < date)) {
+		for (size_t ii=0; ii<max_steps && vecM[index].date<date; ii++) index++; //the date is within the timeseries, so index remains valid
+		if (vecM[index].date >= date) {
+			last_index = index;
+			return index;
+		}
+	}
+
+	last_index = IOUtils::seek(date, vecM, false);
+	return last_index;
+}
+
+/**
+ * @brief Resolve the resampling algorithm of each parameter of the given MeteoData
+ * @param[in] md MeteoData object that defines the parameters
+ * @param[out] algorithms algorithm to use for each parameter index
+ */
+void Meteo1DInterpolator::resolveAlgorithms(const MeteoData& md, std::vector<ResamplingAlgorithms*>& algorithms)
+{
+	const size_t nrOfParameters = md.getNrOfParameters();
+	algorithms.resize( nrOfParameters );
+	for (size_t ii=0; ii<nrOfParameters; ii++) {
+		algorithms[ii] = (ii<MeteoData::nrOfParameters)? vecAlgorithms[ii] : getAlgorithm( md.getNameForParameter(ii) );
+	}
+}
+
+/**
+ * @brief Get the resampling algorithm of a given parameter, creating it if necessary (for extra parameters)
+ * @param[in] parname parameter name
+ * @return resampling algorithm
+ */
+ResamplingAlgorithms* Meteo1DInterpolator::getAlgorithm(const std::string& parname)
+{
+	const std::map< std::string, ResamplingAlgorithms* >::const_iterator it = mapAlgorithms.find(parname);
+	if (it!=mapAlgorithms.end()) return it->second;
+
+	//we are dealing with an extra parameter, we need to add it to the map first, so it will exist next time...
+	const std::string algo_name( getAlgorithmsForParameter(parname) );
+	const std::vector< std::pair<std::string, std::string> > vecArgs( getArgumentsForAlgorithm(parname, algo_name) );
+	ResamplingAlgorithms* algorithm = ResamplingAlgorithmsFactory::getAlgorithm(algo_name, parname, window_size, vecArgs);
+	mapAlgorithms[parname] = algorithm;
+	return algorithm;
+}
+
+bool Meteo1DInterpolator::resampleData(const Date& date, const size_t& stationIdx, const std::vector<MeteoData>& vecM, MeteoData& md)
 {
 	if (vecM.empty()) //Deal with case of the empty vector
 		return false; //nothing left to do
 
+	if (stationIdx>=stations.size()) stations.resize(stationIdx+1);
+	station_state &state = stations[stationIdx];
+
 	//Find element in the vector or the next index
-	size_t index = IOUtils::seek(date, vecM, false);
+	size_t index = seekIndex(date, vecM, state.index);
 
 	//Three cases
 	bool isResampled = true;
@@ -110,28 +191,26 @@ bool Meteo1DInterpolator::resampleData(const Date& date, const std::string& stat
 	md.setDate(date);
 	md.setResampled( isResampled );
 
+	//make sure the resolved algorithms still match the parameters of this station (the extra parameters might differ)
+	const size_t nrOfParameters = md.getNrOfParameters();
+	bool resolved = (state.algorithms.size()==nrOfParameters);
+	for (size_t ii=MeteoData::nrOfParameters; resolved && ii<nrOfParameters; ii++) {
+		resolved = (state.algorithms[ii]->getParameterName()==md.getNameForParameter(ii));
+	}
+	if (!resolved) resolveAlgorithms(md, state.algorithms);
+
 	//now, perform the resampling
-	for (size_t ii=0; ii<md.getNrOfParameters(); ii++) {
-		const std::string parname( md.getNameForParameter(ii) ); //Current parameter name
-		const std::map< std::string, ResamplingAlgorithms* >::const_iterator it = mapAlgorithms.find(parname);
-		if (it!=mapAlgorithms.end()) { //the parameter has been found
-			it->second->resample(stationHash, index, elementpos, ii, vecM, md);
-		} else { //we are dealing with an extra parameter, we need to add it to the map first, so it will exist next time...
-			const std::string algo_name( getAlgorithmsForParameter(parname) );
-			const std::vector< std::pair<std::string, std::string> > vecArgs( getArgumentsForAlgorithm(parname, algo_name) );
-			mapAlgorithms[parname] = ResamplingAlgorithmsFactory::getAlgorithm(algo_name, parname, window_size, vecArgs);;
-			mapAlgorithms[parname]->resample(stationHash, index, elementpos, ii, vecM, md);
-		}
+	for (size_t ii=0; ii<nrOfParameters; ii++) {
+		ResamplingAlgorithms* algorithm = state.algorithms[ii];
+		algorithm->resample(stationIdx, index, elementpos, ii, vecM, md);
 
 		if ((index != IOUtils::npos) && vecM[index](ii)!=md(ii)) {
 			md.setResampledParam(ii);
 			if (data_qa_logs) {
-				const std::map< std::string, ResamplingAlgorithms* >::const_iterator it2 = mapAlgorithms.find(parname); //we have to re-find it in order to handle extra parameters
 				const std::string statName( md.meta.getStationName() );
 				const std::string statID( md.meta.getStationID() );
 				const std::string stat = (!statID.empty())? statID : statName;
-				const std::string algo_name( it2->second->getAlgo() );
-				cout << "[DATA_QA] Resampling " << stat << "::" << parname << "::" << algo_name << " " << md.date.toString(Date::ISO_TZ) << " [" << md.date.toString(Date::ISO_WEEK) << "]\n";
+				cout << "[DATA_QA] Resampling " << stat << "::" << md.getNameForParameter(ii) << "::" << algorithm->getAlgo() << " " << md.date.toString(Date::ISO_TZ) << " [" << md.date.toString(Date::ISO_WEEK) << "]\n";
 			}
 		}
 	} //endfor ii
@@ -181,6 +260,9 @@ Meteo1DInterpolator& Meteo1DInterpolator::operator=(const Meteo1DInterpolator& s
 	if (this != &source) {
 		window_size = source.window_size;
 		mapAlgorithms= source.mapAlgorithms;
+		vecAlgorithms = source.vecAlgorithms;
+		stations = source.stations;
+		station_hashes = source.station_hashes;
 	}
 	return *this;
 }
@@ -43,7 +43,9 @@ namespace mio {
  * TimeSeriesManager calls the MeteoProcessor and requests a temporal interpolation. The request is forwarded to a Meteo1DInterpolator
  * that computes what should be the index of the element just after the one that needs to be computed as well as some flags to
  * know if is the first or the last element in the timeseries. Then the Meteo1DInterpolator calls for each meteorological parameters the
- * algorithm that is responsible for temporally interpolating this parameter with the above computed information. Depending on the
+ * algorithm that is responsible for temporally interpolating this parameter with the above computed information. Each timeseries
+ * is identified by its station index (its position in the vector of stations), so the algorithms can keep some per station data
+ * in vectors. When the stations behind these indices change, ResamplingAlgorithms::resetStations() is called. Depending on the
  * user configuration for the algorithm (that is parsed and setup in the constructor of the algorithm), the requested point is computed
  * (or the algorithm simply returns if it can not compute a value). Some helper functions are defined in the ResamplingAlgorithms
  * class that is inherited by every algorithm.
@@ -55,7 +57,7 @@ namespace mio {
  *  - declare your class in meteoio/meteoResampling/ResamplingAlgorithms.cc (both as \#include and in the object factory
  * ResamplingAlgorithmsFactory::getAlgorithm);
  *  - implement your arguments parsing in your constructor;
- *  - implement the temporal interpolation in the resample() method. You receive the full vector of data, the index at or right after where
+ *  - implement the temporal interpolation in the resample() method. You receive the station index, the full vector of data, the index at or right after where
  * you should compute the interpolation, a hint about some specifics of this location and a single MeteoData object where you should fill
  * the value for the parameter given by paramindex;
  *  - implement an informative toString() method that could help for debugging.
@@ -105,12 +107,21 @@ class Meteo1DInterpolator {
 		/**
 		 * @brief A function that executes all the resampling algorithms that have been setup in the constructor
 		 * @param[in] date The requested date for a MeteoData object (to be resampled if not present)
-		 * @param[in] stationHash A unique identifier for each timeseries (that could be used as an index for caching)
+		 * @param[in] stationIdx A unique identifier for each timeseries, its index in the set of stations (it is used as an index for caching)
 		 * @param[in] vecM A vector of MeteoData where the new object will be inserted if not present
 		 * @param[in] md new MeteoData element, filled with the resampled values
 		 * @return true if successfull, false if no resampling was possible (no element created)
 		 */
-		bool resampleData(const Date& date, const std::string& stationHash, const std::vector<MeteoData>& vecM, MeteoData& md);
+		bool resampleData(const Date& date, const size_t& stationIdx, const std::vector<MeteoData>& vecM, MeteoData& md);
+
+		/**
+		 * @brief Declare the set of stations that will be resampled, one timeseries per station index.
+		 * @details This must be called whenever the timeseries might have changed (for example after a rebuffer): the
+		 * resolved algorithms and search positions are then rebuilt on the next request and if the stations
+		 * behind the indices are not the same anymore, the per station data cached by the algorithms is discarded.
+		 * @param[in] vecVecM The timeseries of all stations
+		 */
+		void setStations(const std::vector< std::vector<MeteoData> >& vecVecM);
 		
 		/**
 		 * @brief Call each ResamplingAlgorithms to reset its cached data (as might be needed after a rebuffer)
@@ -123,10 +134,26 @@ class Meteo1DInterpolator {
 		const std::string toString() const;
 
  	private:
+		/**
+		 * @brief Per station resampling state, so a request does not need any parameter name lookup and the
+		 * search for the requested date can start from the previous request.
+		 */
+		typedef struct STATION_STATE {
+			STATION_STATE() : algorithms(), index(IOUtils::npos) {}
+			std::vector<ResamplingAlgorithms*> algorithms; ///< resampling algorithm for each parameter index
+			size_t index; ///< index returned by the last search, used as starting point for the next one
+		} station_state;
+
 		std::vector< std::pair<std::string, std::string> > getArgumentsForAlgorithm(const std::string& parname, const std::string& algorithm) const;
 		std::string getAlgorithmsForParameter(const std::string& parname) const;
+		ResamplingAlgorithms* getAlgorithm(const std::string& parname);
+		void resolveAlgorithms(const MeteoData& md, std::vector<ResamplingAlgorithms*>& algorithms);
+		static size_t seekIndex(const Date& date, const std::vector<MeteoData>& vecM, size_t& last_index);
 
 		std::map< std::string, ResamplingAlgorithms* > mapAlgorithms; //per parameter interpolation algorithms
+		std::vector<ResamplingAlgorithms*> vecAlgorithms; ///< algorithms of the MeteoData::Parameters, by parameter index
+		std::vector<station_state> stations; ///< per station index resampling state
+		std::vector<std::string> station_hashes; ///< hash of the station behind each station index
 		const Config& cfg;
 		double window_size; ///< In seconds
 		bool enable_resampling, data_qa_logs; ///< easy way to turn resampling off
@@ -18,6 +18,7 @@
 */
 
 #include <meteoio/Meteo2DInterpolator.h>
+#include <meteoio/meteoStats/libinterpol2D.h>
 #include <meteoio/Timer.h>
 
 using namespace std;
@@ -27,11 +28,14 @@ namespace mio {
 Meteo2DInterpolator::Meteo2DInterpolator(const Config& i_cfg, TimeSeriesManager& i_tsmanager, GridsManager& i_gridsmanager)
                     : cfg(i_cfg), tsmanager(&i_tsmanager), gridsmanager(&i_gridsmanager),
                       grid_buffer(0), mapAlgorithms(),
-                      algorithms_ready(false), use_full_dem(false)
+                      algorithms_ready(false), use_full_dem(false), nb_threads(1)
 {
 	size_t max_grids = 10; //default number of grids to keep in buffer
 	cfg.getValue("BUFF_GRIDS", "Interpolations2D", max_grids, IOUtils::nothrow);
 	grid_buffer.setMaxGrids(max_grids);
+
+	cfg.getValue("NB_THREADS", "Interpolations2D", nb_threads, IOUtils::nothrow); //by default, the spatial interpolations are sequential
+	if (nb_threads==0) nb_threads = 1;
 	
 	setAlgorithms();
 }
@@ -39,7 +43,7 @@ Meteo2DInterpolator::Meteo2DInterpolator(const Config& i_cfg, TimeSeriesManager&
 Meteo2DInterpolator::Meteo2DInterpolator(const Meteo2DInterpolator& source)
            : cfg(source.cfg), tsmanager(source.tsmanager), gridsmanager(source.gridsmanager),
                       grid_buffer(source.grid_buffer), mapAlgorithms(source.mapAlgorithms),
-                      algorithms_ready(source.algorithms_ready), use_full_dem(source.use_full_dem)
+                      algorithms_ready(source.algorithms_ready), use_full_dem(source.use_full_dem), nb_threads(source.nb_threads)
 {}
 
 Meteo2DInterpolator& Meteo2DInterpolator::operator=(const Meteo2DInterpolator& source) {
@@ -51,6 +55,7 @@ Meteo2DInterpolator& Meteo2DInterpolator::operator=(const Meteo2DInterpolator& s
 		mapAlgorithms = source.mapAlgorithms;
 		algorithms_ready = source.algorithms_ready;
 		use_full_dem = source.use_full_dem;
+		nb_threads = source.nb_threads;
 	}
 	return *this;
 }
@@ -138,6 +138,12 @@ class Meteo2DInterpolator {
 		std::vector< std::pair<std::string, std::string> > getArgumentsForAlgorithm(const std::string& parname,
 		                                const std::string& algorithm, const std::string& section) const;
 
+		/**
+		 * @brief Number of threads that the interpolation algorithms can use to fill a grid
+		 * @return NB_THREADS key of the [Interpolations2D] section (default: 1)
+		 */
+		unsigned int getNbThreads() const {return nb_threads;}
+
 		const std::string toString() const;
 
 	private:
@@ -157,6 +163,7 @@ class Meteo2DInterpolator {
 		
 		bool algorithms_ready; ///< Have the algorithms objects been constructed?
 		bool use_full_dem; ///< use full dem for point-wise spatial interpolations
+		unsigned int nb_threads; ///< number of threads for filling the grids (only if compiled with OpenMP)
 };
 
 } //end namespace
@@ -84,6 +84,7 @@
 #include <meteoio/meteoStats/libinterpol2D.h>
 #include <meteoio/meteoStats/libresampling2D.h>
 #include <meteoio/meteoStats/RandomNumberGenerator.h>
+#include <meteoio/meteoStats/SortedWindow.h>
 
 //skip all plugins' implementations header files
 #include <meteoio/plugins/libsmet.h>
@@ -19,18 +19,28 @@
 #include <meteoio/MeteoProcessor.h>
 #include <meteoio/meteoFilters/TimeFilters.h>
 #include <algorithm>
+#include <exception>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
 
 using namespace std;
 
 namespace mio {
 
-MeteoProcessor::MeteoProcessor(const Config& cfg, const char& rank, const IOUtils::OperationMode &mode) : mi1d(cfg, rank, mode), processing_stack()
+MeteoProcessor::MeteoProcessor(const Config& cfg, const char& rank, const IOUtils::OperationMode &mode) : mi1d(cfg, rank, mode), processing_stack(), nb_threads(1)
 {
+#ifdef _OPENMP
+	cfg.getValue("NB_THREADS", "Filters", nb_threads, IOUtils::nothrow); //by default, the stations are filtered sequentially
+	if (nb_threads==0) nb_threads = 1;
+#endif
+
 	//Parse [Filters] section, create processing stack for each configured parameter
 	const std::set<std::string> set_of_used_parameters( getParameters(cfg) );
 
 	for (std::set<std::string>::const_iterator it = set_of_used_parameters.begin(); it != set_of_used_parameters.end(); ++it) {
-		ProcessingStack* tmp = new ProcessingStack(cfg, *it);
+		ProcessingStack* tmp = new ProcessingStack(cfg, *it, nb_threads);
 		processing_stack[*it] = tmp;
 	}
 }
@@ -96,10 +106,49 @@ void MeteoProcessor::process(std::vector< std::vector<MeteoData> >& ivec,
 	std::swap(ivec, ovec);
 	if (processing_stack.empty()) return;
 	
-	for (std::map<std::string, ProcessingStack*>::const_iterator it=processing_stack.begin(); it != processing_stack.end(); ++it) {
-		std::swap(ovec, ivec);
-		(*(it->second)).process(ivec, ovec, second_pass);
+	//the stations are independent: each station goes through all the processing stacks (in the order of the map), in place.
+	//The stations are shared among the threads, each thread using its own filters instances and buffer
+	std::vector<ProcessingStack*> stacks;
+	for (std::map<std::string, ProcessingStack*>::const_iterator it=processing_stack.begin(); it != processing_stack.end(); ++it)
+		stacks.push_back( it->second );
+	const size_t nr_stacks = stacks.size();
+	const size_t nr_stations = ovec.size();
+	std::vector< std::vector<std::string> > qa_logs(nr_stacks, std::vector<std::string>(nr_stations)); //printed in the serial order afterwards
+	
+	std::exception_ptr error; //exceptions must not leave the parallel region, they are rethrown afterwards
+	std::pair<size_t, size_t> error_pos(nr_stacks, nr_stations); //(stack, station) that failed
+	#pragma omp parallel num_threads(nb_threads)
+	{
+#ifdef _OPENMP
+		const size_t thread = static_cast<size_t>( omp_get_thread_num() );
+#else
+		const size_t thread = 0;
+#endif
+		std::vector<MeteoData> buffer; //per thread scratch buffer for the filters
+		
+		#pragma omp for schedule(dynamic)
+		for (size_t ii=0; ii<nr_stations; ii++) {
+			if (ovec[ii].empty()) continue; //no data, nothing to do!
+			size_t jj = 0;
+			try {
+				for (; jj<nr_stacks; jj++)
+					stacks[jj]->filterStation(ovec[ii], buffer, second_pass, thread, qa_logs[jj][ii]);
+			} catch (...) {
+				#pragma omp critical(meteoprocessor_error)
+				{
+					if (std::make_pair(jj, ii) < error_pos) { //keep the exception that a serial run would have thrown
+						error = std::current_exception();
+						error_pos = std::make_pair(jj, ii);
+					}
+				}
+			}
+		}
 	}
+	if (error) std::rethrow_exception(error);
+	
+	for (size_t jj=0; jj<nr_stacks; jj++)
+		for (size_t ii=0; ii<nr_stations; ii++)
+			if (!qa_logs[jj][ii].empty()) std::cout << qa_logs[jj][ii];
 }
 
 std::set<std::string> MeteoProcessor::initStationSet(const std::vector< std::pair<std::string, std::string> >& vecArgs, const std::string& keyword)
@@ -56,15 +56,18 @@ class MeteoProcessor {
 
 		/**
 		 * @brief A function that executes all the filters for all meteo parameters
-		 *        configuered by the user
-		 * @param[in] ivec The raw sequence of MeteoData objects for all stations
+		 *        configuered by the user. The stations are processed in parallel if NB_THREADS
+		 *        has been set in the [Filters] section, with the same results as a sequential run.
+		 * @param[in] ivec The raw sequence of MeteoData objects for all stations (its content is undefined on return)
 		 * @param[in] ovec The filtered output of MeteoData object for all stations
 		 * @param[in] second_pass Whether this is the second pass (check only filters)
 		 */
 		void process(std::vector< std::vector<MeteoData> >& ivec,
 		             std::vector< std::vector<MeteoData> >& ovec, const bool& second_pass=false);
 
-		bool resample(const Date& date, const std::string& stationHash, const std::vector<MeteoData>& ivec, MeteoData& md) {return mi1d.resampleData(date, stationHash, ivec, md);}
+		bool resample(const Date& date, const size_t& stationIdx, const std::vector<MeteoData>& ivec, MeteoData& md) {return mi1d.resampleData(date, stationIdx, ivec, md);}
+
+		void setResamplingStations(const std::vector< std::vector<MeteoData> >& ivec) {mi1d.setStations(ivec);}
 		
 		void resetResampling() {mi1d.resetResampling();}
 
@@ -96,6 +99,7 @@ class MeteoProcessor {
 
 		Meteo1DInterpolator mi1d;
 		std::map<std::string, ProcessingStack*> processing_stack;
+		size_t nb_threads; ///< number of threads to filter the stations (only if compiled with OpenMP)
 };
 
 /** 
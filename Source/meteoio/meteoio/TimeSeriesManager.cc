@@ -33,7 +33,7 @@ TimeSeriesManager::TimeSeriesManager(IOHandler& in_iohandler, const Config& in_c
                                             meteoprocessor(in_cfg, rank, mode), dataGenerator(in_cfg),
                                             proc_properties(), point_cache(), raw_buffer(), filtered_cache(),
                                             raw_requested_start(), raw_requested_end(), chunk_size(), buff_before(),
-                                            processing_level(IOUtils::raw | IOUtils::filtered | IOUtils::resampled | IOUtils::generated)
+                                            processing_level(IOUtils::raw | IOUtils::filtered | IOUtils::resampled | IOUtils::generated), stations_changed(true)
 {
 	meteoprocessor.getWindowSize(proc_properties);
 	setDfltBufferProperties();
@@ -105,15 +105,17 @@ void TimeSeriesManager::setProcessingLevel(const unsigned int& i_level)
 		throw InvalidArgumentException("The processing level is invalid", AT);
 
 	processing_level = i_level;
+	stations_changed = true;
 }
 
 double TimeSeriesManager::getAvgSamplingRate() const
 {
-	const double raw_rate = raw_buffer.getAvgSamplingRate();
-	if (raw_rate!=IOUtils::nodata)
-		return raw_rate;
+	//the raw buffer only keeps a trailing window once the data has been filtered
+	const double filtered_rate = filtered_cache.getAvgSamplingRate();
+	if (filtered_rate!=IOUtils::nodata)
+		return filtered_rate;
 	else
-		return filtered_cache.getAvgSamplingRate();
+		return raw_buffer.getAvgSamplingRate();
 }
 
 Date TimeSeriesManager::getBufferStart(const cache_types& cache) const
@@ -185,12 +187,14 @@ void TimeSeriesManager::push_meteo_data(const IOUtils::ProcessingLevel& level, c
 		filtered_cache.push(date_start, date_end, vecMeteo);
 	} else if (level == IOUtils::raw) {
 		filtered_cache.clear();
+		if (!raw_buffer.empty() && (date_start>raw_buffer.getBufferEnd() || date_end<raw_buffer.getBufferStart())) raw_buffer.clear(); //the buffer must remain contiguous
 		raw_buffer.push(date_start, date_end, vecMeteo);
 	} else {
 		throw InvalidArgumentException("The processing level is invalid (should be raw OR filtered)", AT);
 	}
 
 	point_cache.clear(); //clear point cache, so that we don't return resampled values of deprecated data
+	stations_changed = true;
 }
 
 void TimeSeriesManager::push_meteo_data(const IOUtils::ProcessingLevel& level, const Date& date_start, const Date& date_end,
@@ -206,12 +210,14 @@ void TimeSeriesManager::push_meteo_data(const IOUtils::ProcessingLevel& level, c
 		filtered_cache.push(date_start, date_end, vecMeteo);
 	} else if (level == IOUtils::raw) {
 		filtered_cache.clear();
+		if (!raw_buffer.empty() && (date_start>raw_buffer.getBufferEnd() || date_end<raw_buffer.getBufferStart())) raw_buffer.clear(); //the buffer must remain contiguous
 		raw_buffer.push(date_start, date_end, vecMeteo);
 	} else {
 		throw InvalidArgumentException("The processing level is invalid (should be raw OR filtered)", AT);
 	}
 
 	if (invalidate_cache) point_cache.clear(); //clear point cache, so that we don't return resampled values of deprecated data
+	stations_changed = true;
 }
 
 //should we implement a cache for stationData?
@@ -304,16 +310,20 @@ size_t TimeSeriesManager::getMeteoData(const Date& i_date, METEO_SET& vecMeteo)
 		}
 		data = &filtered_cache.getBuffer();
 	} else { //data to be resampled should be IOUtils::raw
-		if ((IOUtils::raw & processing_level) == IOUtils::raw) fillRawBuffer(buffer_start, buffer_end);
+		const bool rebuffer_raw = raw_buffer.empty() || (raw_buffer.getBufferStart() > buffer_start) || (raw_buffer.getBufferEnd() < buffer_end);
+		if (rebuffer_raw && (IOUtils::raw & processing_level) == IOUtils::raw) fillRawBuffer(buffer_start, buffer_end);
 		data = &raw_buffer.getBuffer();
 	}
 
 	if ((IOUtils::resampled & processing_level) == IOUtils::resampled) { //resampling required
+		if (stations_changed) { //the stations are only checked again after the buffers have been modified
+			meteoprocessor.setResamplingStations( *data );
+			stations_changed = false;
+		}
 		for (size_t ii=0; ii<(*data).size(); ii++) { //for every station
 			if ((*data)[ii].empty()) continue;
-			const std::string stationHash( IOUtils::toString(ii)+"-"+(*data)[ii].front().meta.getHash() );
 			MeteoData md;
-			const bool success = meteoprocessor.resample(i_date, stationHash, (*data)[ii], md);
+			const bool success = meteoprocessor.resample(i_date, ii, (*data)[ii], md);
 			if (success) vecMeteo.push_back( md );
 		}
 	} else { //no resampling required
@@ -338,38 +348,78 @@ void TimeSeriesManager::writeMeteoData(const std::vector< METEO_SET >& vecMeteo,
 }
 
 /**
- * @brief Filter the whole raw meteo data buffer
+ * @brief Bring the filtered cache up to date with the raw meteo data buffer
+ * @details When the raw buffer has only been extended forward (which is the case when a model steps through time),
+ * the points that are already in the filtered cache are kept: only the trailing points that could be influenced by
+ * the new data (ie within the filters' time_after window) are filtered again, together with the new data. The
+ * filters are fed with a warm-up span of raw data before these points, covering the filters' time_before window
+ * plus the buffer centering, so the filters see at least as much history as when filtering the whole buffer.
+ * Otherwise, the whole raw buffer is filtered. Afterwards, the raw buffer is reduced to the trailing window that
+ * would be required for the next incremental filtering.
  */
 void TimeSeriesManager::fill_filtered_cache()
 {
-	if ((IOUtils::filtered & processing_level) == IOUtils::filtered) {
-		filtered_cache.clear(); //HACK until we get true ringbuffers, to prevent eating up all memory
-		
-		const Date filtered_start( raw_buffer.getBufferStart() );
-		const Date filtered_end( raw_buffer.getBufferEnd() );
-		std::vector< std::vector<MeteoData> > ivec;
-		std::swap(ivec, raw_buffer.getBuffer()); //avoid one more copy of the whole dataset
-		raw_buffer.clear(); //invalidate the raw data buffer since it has been swapped with the temporary ivec for filtering
-		
-		
-		meteoprocessor.process(ivec, filtered_cache.getBuffer());
-		filtered_cache.setBufferStart( filtered_start );
-		filtered_cache.setBufferEnd( filtered_end );
+	if ((IOUtils::filtered & processing_level) != IOUtils::filtered) return;
+	stations_changed = true;
+	if (raw_buffer.empty()) {
+		filtered_cache.clear();
+		return;
+	}
+
+	const Date raw_start( raw_buffer.getBufferStart() );
+	const Date raw_end( raw_buffer.getBufferEnd() );
+
+	if (filtered_cache.empty() || filtered_cache.getBufferStart()>raw_start) {
+		filter_raw_buffer(raw_start, raw_end);
+	} else if (filtered_cache.getBufferEnd()<raw_end) {
+		const Date refilter_start( filtered_cache.getBufferEnd() - proc_properties.time_after );
+		const Date warmup_start( refilter_start - proc_properties.time_before - buff_before );
+		if (warmup_start>=raw_start && refilter_start>filtered_cache.getBufferStart()) {
+			std::vector< METEO_SET > ivec, ovec;
+			raw_buffer.get(warmup_start, raw_end, ivec);
+			meteoprocessor.process(ivec, ovec);
+
+			//only keep the points that are newer than what remains valid in the filtered cache
+			for (size_t ii=0; ii<ovec.size(); ii++) {
+				const std::vector<MeteoData>::iterator it = std::upper_bound(ovec[ii].begin(), ovec[ii].end(), refilter_start, dateLess);
+				ovec[ii].erase(ovec[ii].begin(), it);
+			}
+			filtered_cache.discardAfter( refilter_start );
+			filtered_cache.push(refilter_start, raw_end, ovec);
+			filtered_cache.discardBefore( raw_start );
+		} else { //not enough raw data left for the filters' windows
+			filter_raw_buffer(raw_start, raw_end);
+		}
 	}
+
+	raw_buffer.discardBefore( raw_end - (buff_before + proc_properties.time_before + proc_properties.time_after) );
+}
+
+/**
+ * @brief Filter the whole raw meteo data buffer, replacing the content of the filtered cache
+ * @param[in] raw_start start of the raw buffer
+ * @param[in] raw_end end of the raw buffer
+ */
+void TimeSeriesManager::filter_raw_buffer(const Date& raw_start, const Date& raw_end)
+{
+	filtered_cache.clear();
+	std::vector< METEO_SET > ivec( raw_buffer.getBuffer() ); //the filters might modify their input
+	meteoprocessor.process(ivec, filtered_cache.getBuffer());
+	filtered_cache.setBufferStart( raw_start );
+	filtered_cache.setBufferEnd( raw_end );
 }
 
 void TimeSeriesManager::add_to_points_cache(const Date& i_date, const METEO_SET& vecMeteo)
 {
 	//Check cache size, delete oldest elements if necessary
-	if (point_cache.size() > 2000) {
-		point_cache.clear(); //HACK: implement a true ring buffer!
-	}
+	while (point_cache.size() >= 2000) point_cache.erase( point_cache.begin() );
 
 	point_cache[i_date] = vecMeteo;
 }
 
 void TimeSeriesManager::clear_cache(const cache_types& cache)
 {
+	stations_changed = true;
 	switch(cache) {
 		case RAW: 
 			raw_buffer.clear(); 
@@ -395,8 +445,10 @@ void TimeSeriesManager::fillRawBuffer(const Date& date_start, const Date& date_e
 	//computing the start and end date of the raw data request
 	const Date new_start( date_start-buff_before ); //taking centering into account
 	const Date new_end( max(date_start + chunk_size, date_end) );
-	
-	raw_buffer.clear(); //HACK until we have a proper ring buffer to avoid eating up all memory...
+	stations_changed = true;
+
+	//drop the data that is too old to be needed by the filters anymore
+	raw_buffer.discardBefore( new_start - (buff_before + proc_properties.time_before + proc_properties.time_after) );
 
 	if (raw_buffer.empty()) {
 		std::vector< METEO_SET > vecMeteo;
@@ -408,6 +460,7 @@ void TimeSeriesManager::fillRawBuffer(const Date& date_start, const Date& date_e
 	const Date buffer_start( raw_buffer.getBufferStart() );
 	const Date buffer_end( raw_buffer.getBufferEnd() );
 	if (new_start>buffer_end || new_end<buffer_start) { //easy: full rebuffer
+		raw_buffer.clear();
 		std::vector< METEO_SET > vecMeteo;
 		iohandler.readMeteoData(new_start, new_end, vecMeteo);
 		raw_buffer.push(new_start, new_end, vecMeteo);
@@ -420,7 +473,7 @@ void TimeSeriesManager::fillRawBuffer(const Date& date_start, const Date& date_e
 		raw_buffer.push(new_start, buffer_start, vecMeteo);
 	}
 
-	if (new_end>buffer_end) { //some data must be inserted after. Keep in mind both before and after could happen simultaneously!
+	if (new_end>buffer_end) { //some data must be inserted after, only the new span is read. Keep in mind both before and after could happen simultaneously!
 		std::vector< METEO_SET > vecMeteo;
 		iohandler.readMeteoData(buffer_end, new_end, vecMeteo);
 		raw_buffer.push(buffer_end, new_end, vecMeteo);
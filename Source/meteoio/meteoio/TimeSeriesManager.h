@@ -222,8 +222,10 @@ class TimeSeriesManager {
 		
 	private:
 		static bool compare(std::pair<Date, METEO_SET> p1, std::pair<Date, METEO_SET> p2);
+		static bool dateLess(const Date& date, const MeteoData& md) {return date<md.date;}
 		void setDfltBufferProperties();
 		void fill_filtered_cache();
+		void filter_raw_buffer(const Date& raw_start, const Date& raw_end);
 		void fillRawBuffer(const Date& date_start, const Date& date_end);
 
 		const Config& cfg;
@@ -240,6 +242,7 @@ class TimeSeriesManager {
 		Duration chunk_size; ///< How much data to read at once
 		Duration buff_before; ///< How much data to read before the requested date in buffer
 		unsigned int processing_level;
+		bool stations_changed; ///< the buffers have been modified since the stations have last been given to the resampling
 };
 } //end namespace
 #endif
@@ -85,6 +85,44 @@ void MeteoBuffer::clear()
 	ts_end.setUndef(true);
 }
 
+void MeteoBuffer::discardBefore(const Date& date)
+{
+	if (empty() || date<=ts_start) return;
+	if (date>ts_end) {
+		clear();
+		return;
+	}
+
+	for (size_t ii=0; ii<ts_buffer.size(); ii++) { //loop over stations
+		if (ts_buffer[ii].empty() || ts_buffer[ii].front().date>=date) continue;
+		size_t pos = IOUtils::seek(date, ts_buffer[ii], false); //returns the first date >=
+		if (pos==IOUtils::npos) pos = ts_buffer[ii].size();
+		ts_buffer[ii].erase(ts_buffer[ii].begin(), ts_buffer[ii].begin()+pos);
+	}
+	ts_start = date;
+}
+
+void MeteoBuffer::discardAfter(const Date& date)
+{
+	if (empty() || date>=ts_end) return;
+	if (date<ts_start) {
+		clear();
+		return;
+	}
+
+	for (size_t ii=0; ii<ts_buffer.size(); ii++) { //loop over stations
+		if (ts_buffer[ii].empty() || ts_buffer[ii].back().date<=date) continue;
+		if (ts_buffer[ii].front().date>date) {
+			ts_buffer[ii].clear();
+			continue;
+		}
+		size_t pos = IOUtils::seek(date, ts_buffer[ii], false); //returns the first date >=
+		if (ts_buffer[ii][pos].date==date) pos++; //the date itself is kept
+		ts_buffer[ii].erase(ts_buffer[ii].begin()+pos, ts_buffer[ii].end());
+	}
+	ts_end = date;
+}
+
 void MeteoBuffer::push(const Date& date_start, const Date& date_end, const std::vector<MeteoData>& vecMeteo)
 {
 	const size_t nrStationsPush = vecMeteo.size();
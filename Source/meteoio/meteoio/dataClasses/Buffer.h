@@ -29,8 +29,9 @@ namespace mio {
 /**
  * @class MeteoBuffer
  * @brief A class to buffer meteorological data.
- * This class buffers MeteoData objects. It is currently NOT a proper ring buffer, this should come
- * in a later implementation.
+ * This class buffers MeteoData objects. It is used as a sliding window over the time series: new data
+ * is appended at the end while the data that is not needed anymore is discarded from the beginning
+ * (see discardBefore()), so the memory footprint remains bounded by the window size.
  *
  * @ingroup data_str
  * @author Mathias Bavay
@@ -115,6 +116,18 @@ class MeteoBuffer {
 		*/
 		void clear();
 
+		/**
+		* @brief Remove all data before a given date; the buffer then starts at this date (if it was starting earlier)
+		* @param date        A Date object representing the new beginning of the buffer (this date is kept)
+		*/
+		void discardBefore(const Date& date);
+
+		/**
+		* @brief Remove all data after a given date; the buffer then ends at this date (if it was ending later)
+		* @param date        A Date object representing the new end of the buffer (this date is kept)
+		*/
+		void discardAfter(const Date& date);
+
 		/**
 		 * @brief Add data representing the available data between two dates.
 		 * @param date_start      A Date object representing the beginning of an interval (inclusive)
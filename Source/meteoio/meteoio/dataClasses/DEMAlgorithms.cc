@@ -19,11 +19,17 @@
 #include <cmath>
 #include <limits.h>
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
 
 #include <meteoio/dataClasses/DEMAlgorithms.h>
 #include <meteoio/dataClasses/DEMObject.h>
 #include <meteoio/MathOptim.h>
 #include <meteoio/IOUtils.h>
+#include <meteoio/FileUtils.h>
 #include <meteoio/meteoLaws/Meteoconst.h> //for math constants
 
 /**
@@ -230,5 +236,178 @@ double DEMAlgorithms::getTanMaxSlope(const DEMObject& dem, const double& dmax, c
 	return max_tan_slope;
 }
 
+const double HorizonTable::sector_width = 5.;
+
+HorizonTable::HorizonTable()
+             : horizons(), cache_path(), dem_hash(0), nx(0), ny(0),
+               nr_sectors( static_cast<size_t>( Optim::round(360. / sector_width) ) ), nb_threads(1)
+{}
+
+/**
+* @brief Set the number of threads used to build the table
+* This has no effect if MeteoIO has not been compiled with OpenMP support.
+* @param i_nb_threads number of threads (0 is considered as 1)
+*/
+void HorizonTable::setNbThreads(const unsigned int& i_nb_threads)
+{
+	nb_threads = (i_nb_threads>0)? i_nb_threads : 1;
+}
+
+/**
+* @brief Set the directory where the tables are persisted
+* @param i_cache_path directory for the table files (empty to disable the persistence)
+*/
+void HorizonTable::setCachePath(const std::string& i_cache_path)
+{
+	cache_path = i_cache_path;
+}
+
+void HorizonTable::clear()
+{
+	horizons.clear();
+	dem_hash = 0;
+	nx = ny = 0;
+}
+
+/**
+* @brief Make sure that the table matches the given DEM
+* If the DEM is not the one the table has been built for, the table is read from the cache path (if available)
+* or computed (and then written to the cache path).
+* @param dem DEM to work with
+*/
+void HorizonTable::setDEM(const DEMObject& dem)
+{
+	const uint64_t hash = getHash(dem);
+	if (!horizons.empty() && hash==dem_hash && dem.getNx()==nx && dem.getNy()==ny) return;
+
+	clear();
+	nx = dem.getNx();
+	ny = dem.getNy();
+	dem_hash = hash;
+
+	const std::string filename( getCacheFile() );
+	if (!filename.empty() && read(filename)) return;
+
+	compute(dem);
+	if (!filename.empty()) write(filename);
+}
+
+/**
+* @brief Returns the tangente of the horizon from a given cell looking toward a given bearing
+* For a bearing that is a multiple of sector_width, this is DEMAlgorithms::getHorizon() (stored as a float), otherwise
+* the horizons of the two surrounding sectors are linearly interpolated.
+* @param[in] ix x index of the cell
+* @param[in] iy y index of the cell
+* @param[in] bearing direction given by a compass bearing
+* @return tangente of angle above the horizontal
+*/
+double HorizonTable::getHorizon(const size_t& ix, const size_t& iy, const double& bearing) const
+{
+	if (horizons.empty())
+		throw InvalidArgumentException("The horizon table has not been built, please provide a DEM first", AT);
+
+	double norm_bearing = fmod(bearing, 360.);
+	if (norm_bearing<0.) norm_bearing += 360.;
+	const double pos = norm_bearing / sector_width;
+	const double lower = floor(pos);
+	const double weight = pos - lower;
+	const size_t idx1 = static_cast<size_t>(lower) % nr_sectors;
+	const size_t idx2 = (idx1+1) % nr_sectors;
+
+	const size_t ncells = nx*ny;
+	const size_t cell = iy*nx + ix;
+	const double tan1 = horizons[idx1*ncells + cell];
+	if (weight==0.) return tan1;
+	return (1.-weight)*tan1 + weight*horizons[idx2*ncells + cell];
+}
+
+void HorizonTable::compute(const DEMObject& dem)
+{
+	if (dem.min_altitude==IOUtils::nodata || dem.max_altitude==IOUtils::nodata)
+		throw InvalidArgumentException("DEM not properly initialized or only filled with nodata", AT);
+
+	const size_t ncells = nx*ny;
+	horizons.assign(nr_sectors*ncells, 0.f);
+
+	#pragma omp parallel for num_threads(nb_threads) schedule(dynamic, 1)
+	for (size_t jj=0; jj<ny; jj++) {
+		for (size_t ii=0; ii<nx; ii++) {
+			if (dem.grid2D(ii,jj)==IOUtils::nodata) continue;
+			const size_t cell = jj*nx + ii;
+			for (size_t sector=0; sector<nr_sectors; sector++) {
+				const double bearing = static_cast<double>(sector)*sector_width;
+				horizons[sector*ncells + cell] = static_cast<float>( DEMAlgorithms::getHorizon(dem, ii, jj, bearing) );
+			}
+		}
+	}
+}
+
+//the table files start with this header: format version, dem hash, nx, ny, nr_sectors
+static const uint64_t horizon_file_version = 1;
+static const size_t horizon_header_size = 5;
+
+std::string HorizonTable::getCacheFile() const
+{
+	if (cache_path.empty()) return std::string();
+
+	std::ostringstream os;
+	os << cache_path << "/horizons_" << std::hex << std::setw(16) << std::setfill('0') << dem_hash << ".bin";
+	return os.str();
+}
+
+bool HorizonTable::read(const std::string& filename)
+{
+	std::ifstream fin(filename.c_str(), std::ios::binary);
+	if (fin.fail()) return false;
+
+	uint64_t header[horizon_header_size];
+	fin.read(reinterpret_cast<char*>(header), sizeof(header));
+	if (!fin || header[0]!=horizon_file_version || header[1]!=dem_hash || header[2]!=nx || header[3]!=ny || header[4]!=nr_sectors)
+		return false;
+
+	horizons.resize(nr_sectors*nx*ny);
+	fin.read(reinterpret_cast<char*>(&horizons[0]), static_cast<std::streamsize>(horizons.size()*sizeof(float)));
+	if (!fin) {
+		horizons.clear();
+		return false;
+	}
+	return true;
+}
+
+//the table is written to a temporary file that is then renamed (see FileUtils::replaceFile())
+void HorizonTable::write(const std::string& filename) const
+{
+	const std::string tmp_filename( FileUtils::getTempFilename(filename) );
+	std::ofstream fout(tmp_filename.c_str(), std::ios::binary);
+	if (fout.fail()) {
+		std::cerr << "[W] Could not write the horizon table to '" << filename << "'\n";
+		return;
+	}
+
+	const uint64_t header[horizon_header_size] = {horizon_file_version, dem_hash, nx, ny, nr_sectors};
+	fout.write(reinterpret_cast<const char*>(header), sizeof(header));
+	fout.write(reinterpret_cast<const char*>(&horizons[0]), static_cast<std::streamsize>(horizons.size()*sizeof(float)));
+	fout.close();
+
+	if (fout.fail() || !FileUtils::replaceFile(tmp_filename, filename)) {
+		std::cerr << "[W] Could not write the horizon table to '" << filename << "'\n";
+		std::remove(tmp_filename.c_str());
+	}
+}
+
+//hash of the geolocalization and the elevations of the DEM
+uint64_t HorizonTable::getHash(const DEMObject& dem)
+{
+	const double header[] = {static_cast<double>(dem.getNx()), static_cast<double>(dem.getNy()), dem.cellsize,
+	                         dem.llcorner.getEasting(), dem.llcorner.getNorthing(), dem.min_altitude, dem.max_altitude, sector_width};
+	uint64_t hash = FileUtils::hashBytes(reinterpret_cast<const char*>(header), sizeof(header));
+	for (size_t ii=0; ii<dem.size(); ii++) {
+		const double value = dem.grid2D(ii);
+		hash = FileUtils::hashBytes(reinterpret_cast<const char*>(&value), sizeof(value), hash);
+	}
+
+	return hash;
+}
+
 
 } //end namespace
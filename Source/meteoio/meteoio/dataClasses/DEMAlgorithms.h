@@ -22,6 +22,10 @@
 #include <meteoio/dataClasses/DEMObject.h>
 #include <meteoio/dataClasses/Grid2DObject.h>
 
+#include <string>
+#include <vector>
+#include <stdint.h>
+
 namespace mio {
 
 /**
@@ -41,6 +45,46 @@ class DEMAlgorithms {
 		static double getSearchDistance(const DEMObject& dem);
         static double getTanMaxSlope(const DEMObject& dem, const double& dmax, const double& bearing, const size_t& i, const size_t& j);
 };
+
+/**
+ * @class HorizonTable
+ * @brief Precomputed horizons of all the cells of a DEM.
+ * @details For each cell, the tangent of the horizon (as returned by DEMAlgorithms::getHorizon()) is computed once for each
+ * sector of sector_width degrees. Looking up the horizon toward a given bearing then only interpolates between the two
+ * surrounding sectors instead of walking through the DEM, which makes topographic shading cheap for every time step.
+ *
+ * The table is built (in parallel if compiled with OpenMP) the first time a DEM is given and kept as long as the
+ * DEM does not change. If a cache path has been set, the table is also written to this directory in a binary file
+ * whose name contains a hash of the DEM, so it can be read back instead of recomputed by the next runs.
+ *
+ * @remarks The table takes 360/sector_width floats per cell (about 290 bytes per cell).
+ * @ingroup stats
+ */
+class HorizonTable {
+	public:
+		HorizonTable();
+
+		void setNbThreads(const unsigned int& i_nb_threads);
+		void setCachePath(const std::string& i_cache_path);
+		void setDEM(const DEMObject& dem);
+		double getHorizon(const size_t& ix, const size_t& iy, const double& bearing) const;
+		void clear();
+
+		static const double sector_width; ///< angular step between two precomputed bearings, in degrees
+
+	private:
+		void compute(const DEMObject& dem);
+		bool read(const std::string& filename);
+		void write(const std::string& filename) const;
+		std::string getCacheFile() const;
+		static uint64_t getHash(const DEMObject& dem);
+
+		std::vector<float> horizons; ///< tangent of the horizon, one DEM-sized block per sector
+		std::string cache_path; ///< where to persist the tables (empty for no persistence)
+		uint64_t dem_hash; ///< hash of the DEM the table has been computed for
+		size_t nx, ny, nr_sectors;
+		unsigned int nb_threads;
+};
 } //end namespace
 
 #endif
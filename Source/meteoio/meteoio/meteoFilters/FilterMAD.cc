@@ -17,7 +17,6 @@
     along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <meteoio/meteoFilters/FilterMAD.h>
-#include <meteoio/meteoStats/libinterpol1D.h>
 #include <cmath>
 #include <algorithm>
 
@@ -47,27 +46,29 @@ void FilterMAD::process(const unsigned int& param, const std::vector<MeteoData>&
                         std::vector<MeteoData>& ovec)
 {
 	ovec = ivec;
+	std::vector<double> data( ivec.size() );
+	for (size_t ii=0; ii<ivec.size(); ii++) data[ii] = ivec[ii](param);
+
+	SortedWindow window; //the window slides along the data, so only the points entering / leaving it are processed
 	for (size_t ii=0; ii<ovec.size(); ii++){ //for every element in ivec, get a window
 		double& value = ovec[ii](param);
 		if (value==IOUtils::nodata) continue;
 
 		size_t start, end;
 		if ( get_window_specs(ii, ivec, start, end) ) {
-			MAD_filter_point(ivec, param, start, end, value);
+			window.slide(data, start, end);
+			MAD_filter_point(window, value);
 		} else if (!is_soft) value = IOUtils::nodata;
 	}
 }
 
-void FilterMAD::MAD_filter_point(const std::vector<MeteoData>& ivec, const unsigned int& param, const size_t& start, const size_t& end, double &value) const
+void FilterMAD::MAD_filter_point(const SortedWindow& window, double &value) const
 {
 	static const double K = 1. / 0.6745;
 
-	std::vector<double> data( end-start+1 );
-	for (size_t ii=start; ii<=end; ii++) data[ii-start] = ivec[ii](param);
-
 	//Calculate MAD
-	const double median = Interpol1D::getMedian(data);
-	const double mad    = Interpol1D::getMedianAverageDeviation(data);
+	const double median = window.getMedian();
+	const double mad    = window.getMAD();
 
 	if ( median==IOUtils::nodata || mad==IOUtils::nodata ) return;
 
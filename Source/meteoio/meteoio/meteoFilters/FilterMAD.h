@@ -20,6 +20,7 @@
 #define FILTERMAD_H
 
 #include <meteoio/meteoFilters/WindowedFilter.h>
+#include <meteoio/meteoStats/SortedWindow.h>
 #include <vector>
 #include <string>
 
@@ -60,7 +61,7 @@ class FilterMAD : public WindowedFilter {
 		                     std::vector<MeteoData>& ovec);
 
 	private:
-		void MAD_filter_point(const std::vector<MeteoData>& ivec, const unsigned int& param, const size_t& start, const size_t& end, double &value) const;
+		void MAD_filter_point(const SortedWindow& window, double &value) const;
 
 		double min_sigma; //to avoid rejecting all points after a period of constant signal
 };
@@ -17,7 +17,6 @@
     along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <meteoio/meteoFilters/ProcAggregate.h>
-#include <meteoio/meteoStats/libinterpol1D.h>
 #include <meteoio/meteoLaws/Meteoconst.h>
 
 using namespace std;
@@ -46,6 +45,13 @@ void ProcAggregate::process(const unsigned int& param, const std::vector<MeteoDa
 		return;
 	}
 	
+	std::vector<double> data; //for the median, the window is kept sorted while sliding along the data
+	SortedWindow window;
+	if (type==median_agg) {
+		data.resize( ivec.size() );
+		for (size_t ii=0; ii<ivec.size(); ii++) data[ii] = ivec[ii](param);
+	}
+
 	for (size_t ii=0; ii<ovec.size(); ii++){ //for every element in ivec, get a window
 		double& value = ovec[ii](param);
 		size_t start, end;
@@ -58,7 +64,8 @@ void ProcAggregate::process(const unsigned int& param, const std::vector<MeteoDa
 				case mean_agg:
 					value = calc_mean(ivec, param, start, end); break;
 				case median_agg:
-					value = calc_median(ivec, param, start, end); break;
+					window.slide(data, start, end);
+					value = window.getMedian(); break;
 				case wind_avg_agg:
 					value = calc_wind_avg(ivec, param, start, end); break;
 				default:
@@ -128,19 +135,6 @@ double ProcAggregate::calc_mean(const std::vector<MeteoData>& ivec, const unsign
 	return (sum / (double)counter);
 }
 
-double ProcAggregate::calc_median(const std::vector<MeteoData>& ivec, const unsigned int& param, const size_t& start, const size_t& end)
-{
-	std::vector<double> vecTemp;
-	vecTemp.reserve( end-start+1 );
-	for (size_t ii=start; ii<=end; ii++){ //get rid of nodata elements
-		const double& value = ivec[ii](param);
-		if (value != IOUtils::nodata)
-			vecTemp.push_back(value);
-	}
-
-	return Interpol1D::getMedian(vecTemp, false);
-}
-
 double ProcAggregate::calc_wind_avg(const std::vector<MeteoData>& ivec, const unsigned int& param, const size_t& start, const size_t& end)
 {
 	//calculate ve and vn
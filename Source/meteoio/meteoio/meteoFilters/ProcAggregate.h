@@ -20,6 +20,7 @@
 #define PROCAGGREGATE_H
 
 #include <meteoio/meteoFilters/WindowedFilter.h>
+#include <meteoio/meteoStats/SortedWindow.h>
 #include <vector>
 #include <string>
 
@@ -79,7 +80,6 @@ class ProcAggregate : public WindowedFilter {
 		static double calc_min(const std::vector<MeteoData>& ivec, const unsigned int& param, const size_t& start, const size_t& end);
 		static double calc_max(const std::vector<MeteoData>& ivec, const unsigned int& param, const size_t& start, const size_t& end);
 		static double calc_mean(const std::vector<MeteoData>& ivec, const unsigned int& param, const size_t& start, const size_t& end);
-		static double calc_median(const std::vector<MeteoData>& ivec, const unsigned int& param, const size_t& start, const size_t& end);
 		static double calc_wind_avg(const std::vector<MeteoData>& ivec, const unsigned int& param, const size_t& start, const size_t& end);
 		
 		aggregate_type type;
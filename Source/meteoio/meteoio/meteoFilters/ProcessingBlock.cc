@@ -119,6 +119,10 @@ namespace mio {
  * DW::arg1::when = 2020-07-01 - 2020-07-10 , 2020-07-20T12:00 - 2020-08-01
  * @endcode
  *
+ * @note When MeteoIO has been compiled with OpenMP support (OPENMP cmake option), the stations can be filtered in parallel by setting the
+ * \b NB_THREADS key in the [Filters] section to the number of threads to use (default: 1). Each thread then uses its own instances of the filters
+ * and the results do not depend on the number of threads.
+ *
  * @section processing_available Available processing elements
  * New filters can easily be developed. The filters that are currently available are the following:
  * - NONE: this does nothing (this is useful in an \ref config_import "IMPORT" to overwrite previous filters);
@@ -27,23 +27,31 @@ const std::string ProcessingStack::filter_section( "FILTERS" );
 const std::string ProcessingStack::filter_pattern( "::FILTER" );
 const std::string ProcessingStack::arg_pattern( "::ARG" );
 
-ProcessingStack::ProcessingStack(const Config& cfg, const std::string& parname) : filter_stack(), param_name(parname), data_qa_logs(false)
+ProcessingStack::ProcessingStack(const Config& cfg, const std::string& parname, const size_t& nb_threads)
+               : filter_stacks(std::max(nb_threads, static_cast<size_t>(1))), param_name(parname), data_qa_logs(false)
 {
 	cfg.getValue("DATA_QA_LOGS", "GENERAL", data_qa_logs, IOUtils::nothrow);
 	
 	//extract each filter and its arguments, then build the filter stack
+	//(filters may keep some state, so each thread gets its own instances)
 	const std::vector< std::pair<std::string, std::string> > vecFilters( cfg.getValues(parname+filter_pattern, filter_section) );
-	filter_stack.reserve( vecFilters.size() );
 	for (size_t ii=0; ii<vecFilters.size(); ii++) {
 		const std::string block_name( IOUtils::strToUpper( vecFilters[ii].second ) );
 		if (block_name=="NONE") continue;
 		
 		const unsigned int cmd_nr = Config::getCommandNr(filter_section, parname+filter_pattern, vecFilters[ii].first);
 		const std::vector< std::pair<std::string, std::string> > vecArgs( cfg.parseArgs(filter_section, parname, cmd_nr, arg_pattern) );
-		filter_stack.push_back( BlockFactory::getBlock(block_name, vecArgs, cfg) );
+		for (size_t thread=0; thread<filter_stacks.size(); thread++)
+			filter_stacks[thread].push_back( BlockFactory::getBlock(block_name, vecArgs, cfg) );
 	}
 }
 
+ProcessingStack::~ProcessingStack()
+{
+	for (size_t thread=0; thread<filter_stacks.size(); thread++)
+		for (size_t ii=0; ii<filter_stacks[thread].size(); ii++) delete filter_stacks[thread][ii];
+}
+
 void ProcessingStack::getWindowSize(ProcessingProperties& o_properties) const
 {
 	o_properties.points_before = 0;
@@ -51,6 +59,7 @@ void ProcessingStack::getWindowSize(ProcessingProperties& o_properties) const
 	o_properties.time_after = Duration(0.0, 0.);
 	o_properties.time_before = Duration(0.0, 0.);
 
+	const std::vector<ProcessingBlock*>& filter_stack = filter_stacks.front();
 	for (size_t jj=0; jj<filter_stack.size(); jj++){
 		const ProcessingProperties properties( (*filter_stack[jj]).getProperties() );
 
@@ -65,17 +74,18 @@ void ProcessingStack::getWindowSize(ProcessingProperties& o_properties) const
 	}
 }
 
-bool ProcessingStack::applyFilter(const size_t& param, const size_t& jj, const std::vector<MeteoData>& ivec, std::vector<MeteoData> &ovec)
+bool ProcessingStack::applyFilter(const size_t& param, ProcessingBlock* filter, const std::vector<MeteoData>& ivec, std::vector<MeteoData> &ovec)
 {
-	const std::vector<DateRange> time_restrictions( filter_stack[jj]->getTimeRestrictions() );
+	const std::vector<DateRange> time_restrictions( filter->getTimeRestrictions() );
 	
 	if (time_restrictions.empty()) {
-		filter_stack[jj]->process(static_cast<unsigned int>(param), ivec, ovec);
+		filter->process(static_cast<unsigned int>(param), ivec, ovec);
 		return true;
 	} else {
 		//we know there is at least 1 element
 		const Date start( ivec.front().date ), end( ivec.back().date );
 		bool filterApplied = false;
+		ovec = ivec; //only the sub-ranges will be overwritten
 		
 		//filter for all time restrictions that fit into ivec
 		for (size_t ii=0; ii<time_restrictions.size(); ii++) {
@@ -97,7 +107,7 @@ bool ProcessingStack::applyFilter(const size_t& param, const size_t& jj, const s
 				tmp_ivec.push_back( ivec[kk] );
 			}
 			
-			filter_stack[jj]->process(static_cast<unsigned int>(param), tmp_ivec, tmp_ovec);
+			filter->process(static_cast<unsigned int>(param), tmp_ivec, tmp_ovec);
 			
 			//put back the sub-range filtered data into the full ovec
 			for (size_t kk=0; kk<tmp_ovec.size(); kk++) {
@@ -111,18 +121,29 @@ bool ProcessingStack::applyFilter(const size_t& param, const size_t& jj, const s
 	}
 }
 
-//ivec is passed by value, so it makes an efficient copy
-bool ProcessingStack::filterStation(std::vector<MeteoData> ivec,
-                              std::vector< std::vector<MeteoData> >& ovec, const bool& second_pass, const size_t& stat_idx)
+/**
+ * @brief Apply the whole filter stack on the data of one station, in place
+ * @details The filters write alternatively into the provided buffer and into the data vector (that are swapped after each filter),
+ * so the time series is never copied as a whole. Different threads can process different stations at the same time
+ * as long as each of them uses its own buffer and thread index.
+ * @param vecMeteo data of the station (not empty), replaced by the filtered data
+ * @param buffer scratch buffer, its content is undefined on return
+ * @param second_pass Whether this is the second pass (check only filters)
+ * @param thread index of the calling thread (between 0 and the nb_threads given to the constructor)
+ * @param qa_log the DATA_QA logs (if enabled) are appended to this string
+ * @return true if at least one filter has been applied
+ */
+bool ProcessingStack::filterStation(std::vector<MeteoData>& vecMeteo, std::vector<MeteoData>& buffer, const bool& second_pass, const size_t& thread, std::string& qa_log)
 {
 	bool filterApplied = false;
 	
 	//pick one element and check whether the param_name parameter exists
-	const size_t param = ivec.front().getParameterIndex(param_name);
+	const size_t param = vecMeteo.front().getParameterIndex(param_name);
 	if (param == IOUtils::npos) return filterApplied;
 	
+	const std::vector<ProcessingBlock*>& filter_stack = filter_stacks[thread];
 	const size_t nr_of_filters = filter_stack.size();
-	const std::string statID( ivec.front().meta.getStationID() ); //we know there is at least 1 element (we've already skipped empty vectors)
+	const std::string statID( vecMeteo.front().meta.getStationID() ); //we know there is at least 1 element (we've already skipped empty vectors)
 
 	//Now call the filters one after another for the current station and parameter
 	for (size_t jj=0; jj<nr_of_filters; jj++) {
@@ -136,35 +157,34 @@ bool ProcessingStack::filterStation(std::vector<MeteoData> ivec,
 			continue;
 
 		//if the filter has not been applied (ie time restriction), move to the next one directly
-		if (!applyFilter(param, jj, ivec, ovec[stat_idx])) continue;
+		if (!applyFilter(param, filter_stack[jj], vecMeteo, buffer)) continue;
 		
 		filterApplied = true; //at least one filter has been applied in the whole stack
-		const size_t output_size = ovec[stat_idx].size();
+		const size_t output_size = buffer.size();
 
-		if (ivec.size() != output_size) {
+		if (vecMeteo.size() != output_size) {
 			ostringstream ss;
-			ss << "The filter \"" << (*filter_stack[jj]).getName() << "\" received " << ivec.size();
+			ss << "The filter \"" << (*filter_stack[jj]).getName() << "\" received " << vecMeteo.size();
 			ss << " timestamps and returned " << output_size << " timestamps!";
 			throw IndexOutOfBoundsException(ss.str(), AT);
 		}
 
 		for (size_t kk=0; kk<output_size; kk++) {
-			const double orig = ivec[kk](param);
-			const double filtered = ovec[stat_idx][kk](param);
+			const double orig = vecMeteo[kk](param);
+			const double filtered = buffer[kk](param);
 			if (orig!=filtered) {
-				ovec[stat_idx][kk].setFiltered(param);
+				buffer[kk].setFiltered(param);
 				if (data_qa_logs) {
-					const std::string statName( ovec[stat_idx][kk].meta.getStationName() );
+					const std::string statName( buffer[kk].meta.getStationName() );
 					const std::string stat = (!statID.empty())? statID : statName;
 					const std::string filtername( (*filter_stack[jj]).getName() );
-					cout << "[DATA_QA] Filtering " << stat << "::" << param_name << "::" << filtername << " " << ivec[kk].date.toString(Date::ISO_TZ) << " [" << ivec[kk].date.toString(Date::ISO_WEEK) << "]\n";
+					qa_log += "[DATA_QA] Filtering " + stat + "::" + param_name + "::" + filtername + " " + vecMeteo[kk].date.toString(Date::ISO_TZ) + " [" + vecMeteo[kk].date.toString(Date::ISO_WEEK) + "]\n";
 				}
 			}
 		}
 
-		if ((jj+1) != nr_of_filters) {//not necessary after the last filter
-			ivec = ovec[stat_idx];
-		}
+		//the filtered data becomes the input of the next filter
+		std::swap(vecMeteo, buffer);
 	}
 
 	return filterApplied;
@@ -177,13 +197,18 @@ void ProcessingStack::process(const std::vector< std::vector<MeteoData> >& ivec,
 {
 	const size_t nr_stations = ivec.size();
 	ovec.resize( nr_stations );
+	std::vector<MeteoData> buffer;
+	std::string qa_log;
 
 	for (size_t ii=0; ii<nr_stations; ii++) { //for every station
 		if ( ivec[ii].empty() ) continue; //no data, nothing to do!
 		
-		const bool filterApplied = filterStation(ivec[ii], ovec, second_pass, ii);
-		//if not even a single filter was applied, just copy input to output
-		if (!filterApplied) ovec[ii] = ivec[ii];
+		ovec[ii] = ivec[ii];
+		filterStation(ovec[ii], buffer, second_pass, 0, qa_log);
+		if (!qa_log.empty()) {
+			cout << qa_log;
+			qa_log.clear();
+		}
 	}
 }
 
@@ -193,6 +218,7 @@ const std::string ProcessingStack::toString() const
 	//os << "<ProcessingStack>";
 	os << setw(10) << param_name << "::";
 
+	const std::vector<ProcessingBlock*>& filter_stack = filter_stacks.front();
 	for (size_t ii=0; ii<filter_stack.size(); ii++) {
 		os << setw(10) << filter_stack[ii]->toString();
 	}
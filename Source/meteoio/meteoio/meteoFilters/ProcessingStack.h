@@ -37,22 +37,25 @@ class ProcessingStack {
 	public:
 		/**
 		 * @brief Constructor parses cfg and builds up a filter stack for param_name
+		 * @param cfg Config object that holds the config of the filters in the [Filters] section
+		 * @param param_name parameter to build the filter stack for
+		 * @param nb_threads number of threads that will call filterStation(): each of them gets its own instances of the filters
 		 */
-		ProcessingStack(const Config& cfg, const std::string& param_name);
-		virtual ~ProcessingStack() {for (size_t ii=0; ii<filter_stack.size(); ii++) delete filter_stack[ii];}
+		ProcessingStack(const Config& cfg, const std::string& param_name, const size_t& nb_threads=1);
+		virtual ~ProcessingStack();
 
 		void process(const std::vector< std::vector<MeteoData> >& ivec,
 		             std::vector< std::vector<MeteoData> >& ovec, const bool& second_pass=false);
+		virtual bool filterStation(std::vector<MeteoData>& vecMeteo, std::vector<MeteoData>& buffer, const bool& second_pass, const size_t& thread, std::string& qa_log);
 		void getWindowSize(ProcessingProperties& o_properties) const;
 		const std::string toString() const;
 		
 		static const std::string filter_section, filter_pattern, arg_pattern;
 		
 	private:
-		virtual bool applyFilter(const size_t& param, const size_t& jj, const std::vector<MeteoData>& ivec, std::vector<MeteoData> &ovec);
-		virtual bool filterStation(std::vector<MeteoData> ivec, std::vector< std::vector<MeteoData> >& ovec, const bool& second_pass, const size_t& stat_idx);
+		virtual bool applyFilter(const size_t& param, ProcessingBlock* filter, const std::vector<MeteoData>& ivec, std::vector<MeteoData> &ovec);
 		
-		std::vector<ProcessingBlock*> filter_stack; //for now: strictly linear chain of processing blocks
+		std::vector< std::vector<ProcessingBlock*> > filter_stacks; //one per thread; for now: strictly linear chain of processing blocks
 		const std::string param_name;
 		bool data_qa_logs;
 };
@@ -150,29 +150,66 @@ void SunObject::getBeamPotential(const double& sun_elevation, const double& Ecce
 	}
 }
 
-void SunObject::getClearSky(const double& sun_elevation, const double& R_toa,
-                            const double& ta, const double& rh, const double& pressure, const double& ground_albedo,
-                            double& R_direct, double& R_diffuse) const
+//clear sky model parameters
+static const double olt = 0.32;   //ozone layer thickness (cm) U.S.standard = 0.34 cm
+static const double w0 = 0.9;     //fraction of energy scattered to total attenuation by aerosols (Bird and Hulstrom(1981))
+static const double fc = 0.84;    //fraction of forward scattering to total scattering (Bird and Hulstrom(1981))
+static const double alpha = 1.3;  //wavelength exponent (Iqbal(1983) p.118). Good average value: 1.3+/-0.5. Related to the size distribution of the particules
+static const double beta = 0.03;  //amount of particules index (Iqbal(1983) p.118). Between 0 & .5 and above.
+
+/**
+ * @brief Compute the terms of the clear sky model that only depend on the Sun's position
+ * @param[in] sun_elevation TRUE solar elevation (in degrees)
+ * @param[in] R_toa top of atmosphere radiation
+ * @param[in] elevation_threshold below this solar elevation, all the radiation is considered diffuse
+ * @return terms for getClearSky(const ClearSkyTerms&, ...)
+ */
+SunObject::ClearSkyTerms SunObject::getClearSkyTerms(const double& sun_elevation, const double& R_toa, const double& elevation_threshold)
 {
-	if (ta<0. || rh<0.) 
-		throw InvalidArgumentException("When calling SunObject::getClearSky(), TA and RH must be >0, currently TA="+IOUtils::toString(ta)+", RH="+IOUtils::toString(rh), AT);
-	
-	//these pow cost us a lot here, but replacing them by fastPow() has a large impact on accuracy (because of the exp())
-	static const double olt = 0.32;   //ozone layer thickness (cm) U.S.standard = 0.34 cm
-	static const double w0 = 0.9;     //fraction of energy scattered to total attenuation by aerosols (Bird and Hulstrom(1981))
-	static const double fc = 0.84;    //fraction of forward scattering to total scattering (Bird and Hulstrom(1981))
-	static const double alpha = 1.3;  //wavelength exponent (Iqbal(1983) p.118). Good average value: 1.3+/-0.5. Related to the size distribution of the particules
-	static const double beta = 0.03;  //amount of particules index (Iqbal(1983) p.118). Between 0 & .5 and above.
+	ClearSkyTerms terms;
+	terms.R_toa = R_toa;
+	terms.low_sun = ( sun_elevation < elevation_threshold );
+
 	const double zenith = 90. - sun_elevation; //this is the TRUE zenith because the elevation is the TRUE elevation
-	const double cos_zenith = cos(zenith*Cst::to_rad); //this uses true zenith angle
+	terms.cos_zenith = cos(zenith*Cst::to_rad); //this uses true zenith angle
+	const double cos_zenith = terms.cos_zenith;
 
 	// relative optical air mass Young (1994), see http://en.wikipedia.org/wiki/Airmass
 	//const double mr = 1. / (cos_zenith + 0.50572 * pow( 96.07995-zenith , -1.6364 )); //pbl: this should use apparent zenith angle, and we only get true zenith angle here...
 	// relative optical air mass, Young, A. T. 1994. Air mass and refraction. Applied Optics. 33:1108–1110.
-	const double mr = ( 1.002432*Optim::pow2(cos_zenith) + 0.148386*cos_zenith + 0.0096467) /
+	terms.mr = ( 1.002432*Optim::pow2(cos_zenith) + 0.148386*cos_zenith + 0.0096467) /
 	                  ( Optim::pow3(cos_zenith) + 0.149864*Optim::pow2(cos_zenith)
 	                  + 0.0102963*cos_zenith +0.000303978);
 
+	// broadband transmittance by ozone (Iqbal (1983), p.189)
+	const double u3 = olt * terms.mr; // ozone relative optical path length
+	const double alpha_oz = 0.1611 * u3 * pow(1. + 139.48 * u3, -0.3035) -
+	                        0.002715 * u3 / ( 1. + 0.044  * u3 + 0.0003 * Optim::pow2(u3) ); //ozone absorbance
+	terms.tauoz = 1. - alpha_oz;
+
+	return terms;
+}
+
+/**
+ * @brief Clear sky direct and diffuse radiation at one location, for the Sun's position given by the terms
+ * @param[in] terms clear sky model terms that only depend on the Sun's position (see getClearSkyTerms())
+ * @param[in] altitude altitude of the location (in m)
+ * @param[in] ta air temperature (in K)
+ * @param[in] rh relative humidity (between 0 and 1)
+ * @param[in] pressure air pressure (in Pa)
+ * @param[in] ground_albedo albedo of the ground
+ * @param[out] R_direct direct radiation (beam)
+ * @param[out] R_diffuse diffuse radiation (on the horizontal)
+ */
+inline void SunObject::getClearSky(const ClearSkyTerms& terms, const double& altitude,
+                                   const double& ta, const double& rh, const double& pressure, const double& ground_albedo,
+                                   double& R_direct, double& R_diffuse)
+{
+	//these pow cost us a lot here, but replacing them by fastPow() has a large impact on accuracy (because of the exp())
+	const double R_toa = terms.R_toa;
+	const double cos_zenith = terms.cos_zenith;
+	const double mr = terms.mr;
+
 	// actual air mass: because mr is applicable for standard pressure
 	// it is modified for other pressures (in Iqbal (1983), p.100)
 	// pressure in Pa
@@ -186,10 +223,7 @@ void SunObject::getClearSky(const double& sun_elevation, const double& R_toa,
 	const double taur = exp( -0.0903 * pow(ma,0.84) * (1. + ma - pow(ma,1.01)) );
 
 	// broadband transmittance by ozone (Iqbal (1983), p.189)
-	const double u3 = olt * mr; // ozone relative optical path length
-	const double alpha_oz = 0.1611 * u3 * pow(1. + 139.48 * u3, -0.3035) -
-	                        0.002715 * u3 / ( 1. + 0.044  * u3 + 0.0003 * Optim::pow2(u3) ); //ozone absorbance
-	const double tauoz = 1. - alpha_oz;
+	const double tauoz = terms.tauoz;
 
 	// broadband transmittance by uniformly mixed gases (Iqbal (1983), p.189)
 	const double taug = exp( -0.0127 * pow(ma, 0.26) );
@@ -259,7 +293,7 @@ void SunObject::getClearSky(const double& sun_elevation, const double& R_toa,
 	const double Idm = (Idr + Ida + R_direct) * ground_albedo * alb_sky / (1. - ground_albedo * alb_sky);
 	R_diffuse = (Idr + Ida + Idm)*cos_zenith; //Iqbal always "project" diffuse radiation on the horizontal
 
-	if ( sun_elevation < elevation_threshold ) {
+	if ( terms.low_sun ) {
 		//if the Sun is too low on the horizon, we put all the radiation as diffuse
 		//the splitting calculation that might take place later on will reflect this
 		//instead point radiation, it becomes the radiation of a horizontal sky above the domain
@@ -268,6 +302,77 @@ void SunObject::getClearSky(const double& sun_elevation, const double& R_toa,
 	}
 }
 
+void SunObject::getClearSky(const double& sun_elevation, const double& R_toa,
+                            const double& ta, const double& rh, const double& pressure, const double& ground_albedo,
+                            double& R_direct, double& R_diffuse) const
+{
+	if (ta<0. || rh<0.) 
+		throw InvalidArgumentException("When calling SunObject::getClearSky(), TA and RH must be >0, currently TA="+IOUtils::toString(ta)+", RH="+IOUtils::toString(rh), AT);
+
+	const ClearSkyTerms terms( getClearSkyTerms(sun_elevation, R_toa, elevation_threshold) );
+	getClearSky(terms, altitude, ta, rh, pressure, ground_albedo, R_direct, R_diffuse);
+}
+
+/**
+ * @brief Compute the clear sky radiation on the horizontal for many locations at once.
+ * @details This is equivalent to calling resetAltitude(), calculateRadiation(ta, rh, pressure, ground_albedo) and
+ * getHorizontalRadiation() for each location, but the terms that only depend on the date and the Sun's position (set with setDate() and
+ * setLatLon(), the latitude and longitude being used for all locations) are computed only once. The locations are then processed in
+ * a single loop over contiguous arrays, split between threads if compiled with OpenMP.
+ * @param[in] altitudes altitude of each location (in m)
+ * @param[in] ta air temperature at each location (in K)
+ * @param[in] rh relative humidity at each location (between 0 and 1)
+ * @param[in] pressure air pressure at each location (in Pa, if nodata the standard pressure at the location's altitude is used)
+ * @param[in] ground_albedo albedo of the ground, for all locations
+ * @param[out] R_direct direct radiation on the horizontal at each location (nodata if the inputs were nodata)
+ * @param[out] R_diffuse diffuse radiation on the horizontal at each location (nodata if the inputs were nodata)
+ * @param[in] nb_threads number of threads to use (default: 1)
+ */
+void SunObject::getHorizontalRadiation(const std::vector<double>& altitudes, const std::vector<double>& ta, const std::vector<double>& rh, const std::vector<double>& pressure,
+                                       const double& ground_albedo, std::vector<double>& R_direct, std::vector<double>& R_diffuse, const unsigned int& nb_threads) const
+{
+	const size_t nr_locations = altitudes.size();
+	if (ta.size()!=nr_locations || rh.size()!=nr_locations || pressure.size()!=nr_locations)
+		throw InvalidArgumentException("All the input vectors must have the same size", AT);
+
+	double azimuth, elevation, eccentricity;
+	position.getHorizontalCoordinates(azimuth, elevation, eccentricity);
+	const bool sun_below_horizon = (elevation<0.);
+
+	for (size_t ii=0; ii<nr_locations; ii++) { //we don't want to throw from the parallel loop
+		if (altitudes[ii]==IOUtils::nodata)
+			throw NoDataException("the altitude can not be nodata", AT);
+		if (sun_below_horizon || ta[ii]==IOUtils::nodata || rh[ii]==IOUtils::nodata || ground_albedo==IOUtils::nodata) continue; //as for a single location, the inputs are then not used
+		if (ta[ii]<0. || rh[ii]<0.)
+			throw InvalidArgumentException("When calling SunObject::getClearSky(), TA and RH must be >0, currently TA="+IOUtils::toString(ta[ii])+", RH="+IOUtils::toString(rh[ii]), AT);
+	}
+
+	R_direct.resize( nr_locations );
+	R_diffuse.resize( nr_locations );
+
+	const double R_toa = Cst::solcon * (1.+eccentricity);
+	const ClearSkyTerms terms( getClearSkyTerms(elevation, R_toa, elevation_threshold) );
+	const double cos_Z = cos( (90.-elevation)*Cst::to_rad ); //to project the beam radiation on the horizontal
+
+	#pragma omp parallel for num_threads((nb_threads>0)? nb_threads : 1) schedule(static)
+	for (size_t ii=0; ii<nr_locations; ii++) {
+		if (ta[ii]==IOUtils::nodata || rh[ii]==IOUtils::nodata || ground_albedo==IOUtils::nodata) {
+			R_direct[ii] = R_diffuse[ii] = IOUtils::nodata;
+			continue;
+		}
+		if (sun_below_horizon) { //the Sun is below the horizon, our formulas don't apply
+			R_direct[ii] = R_diffuse[ii] = 0.;
+			continue;
+		}
+
+		const double p = (pressure[ii]==IOUtils::nodata)? Atmosphere::stdAirPressure(altitudes[ii]) : pressure[ii];
+		double direct, diffuse;
+		getClearSky(terms, altitudes[ii], ta[ii], rh[ii], p, ground_albedo, direct, diffuse);
+		R_direct[ii] = direct * cos_Z;
+		R_diffuse[ii] = diffuse;
+	}
+}
+
 void SunObject::getBeamRadiation(double& R_toa, double& R_direct, double& R_diffuse) const
 {
 	R_toa = beam_toa;
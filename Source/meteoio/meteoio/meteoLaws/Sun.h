@@ -21,6 +21,8 @@
 
 #include <meteoio/meteoLaws/Suntrajectory.h>
 
+#include <vector>
+
 namespace mio {
 
 /**
@@ -54,6 +56,8 @@ class SunObject {
 		void calculateRadiation(const double& ta, const double& rh, const double& mean_albedo);
 		void getBeamRadiation(double& R_toa, double& R_direct, double& R_diffuse) const;
 		void getHorizontalRadiation(double& R_toa, double& R_direct, double& R_diffuse) const;
+		void getHorizontalRadiation(const std::vector<double>& altitudes, const std::vector<double>& ta, const std::vector<double>& rh, const std::vector<double>& pressure,
+		                            const double& ground_albedo, std::vector<double>& R_direct, std::vector<double>& R_diffuse, const unsigned int& nb_threads=1) const;
 		void getSlopeRadiation(const double& slope_azi, const double& slope_elev, double& R_toa, double& R_direct, double& R_diffuse) const;
 		double getElevationThresh() const {return elevation_threshold;}
 
@@ -71,6 +75,17 @@ class SunObject {
 		static const double elevation_dftlThreshold, rad_threshold;
 		
 	private:
+		/// terms of the clear sky model that only depend on the Sun's position
+		typedef struct CLEARSKY_TERMS {
+			CLEARSKY_TERMS() : R_toa(0.), cos_zenith(0.), mr(0.), tauoz(0.), low_sun(false) {}
+			double R_toa, cos_zenith, mr, tauoz;
+			bool low_sun; ///< is the Sun below the elevation threshold?
+		} ClearSkyTerms;
+
+		static ClearSkyTerms getClearSkyTerms(const double& sun_elevation, const double& R_toa, const double& elevation_threshold);
+		static void getClearSky(const ClearSkyTerms& terms, const double& altitude,
+		                        const double& ta, const double& rh, const double& pressure, const double& ground_albedo,
+		                        double& R_direct, double& R_diffuse);
 		void getBeamPotential(const double& sun_elevation, const double& Eccentricity_corr,
 		                      const double& ta, const double& rh, const double& pressure, const double& mean_albedo,
 		                      double& R_toa, double& R_direct, double& R_diffuse) const;
@@ -40,7 +40,7 @@ class Accumulate : public ResamplingAlgorithms {
 	public:
 		Accumulate(const std::string& i_algoname, const std::string& i_parname, const double& dflt_window_size, const std::vector< std::pair<std::string, std::string> >& vecArgs);
 
-		void resample(const std::string& stationHash, const size_t& index, const ResamplingPosition& position, const size_t& paramindex,
+		void resample(const size_t& stationIdx, const size_t& index, const ResamplingPosition& position, const size_t& paramindex,
 		              const std::vector<MeteoData>& vecM, MeteoData& md);
 		std::string toString() const;
 	private:
@@ -31,7 +31,7 @@ namespace mio {
 const size_t Daily_solar::samples_per_day = 24*3; //every 20 minutes
 
 Daily_solar::Daily_solar(const std::string& i_algoname, const std::string& i_parname, const double& dflt_window_size, const std::vector< std::pair<std::string, std::string> >& vecArgs)
-            : ResamplingAlgorithms(i_algoname, i_parname, dflt_window_size, vecArgs), radiation(), station_index(), dateStart(), dateEnd(), loss_factor()
+            : ResamplingAlgorithms(i_algoname, i_parname, dflt_window_size, vecArgs), radiation(), dateStart(), dateEnd(), loss_factor()
 {
 	const std::string where( "Interpolations1D::"+i_parname+"::"+i_algoname );
 	if (!vecArgs.empty()) {
@@ -86,27 +86,30 @@ double Daily_solar::getSolarInterpol(const Date& resampling_date, const size_t&
 	return Interpol1D::weightedMean(radiation[stat_idx][vec_index], radiation[stat_idx][vec_index+1], weight);
 }
 
-//a new, previously unknown station has been found, allocate the memory
-size_t Daily_solar::getStationIndex(const std::string& key)
+//a new, previously unknown station index has been found, allocate the memory
+void Daily_solar::initStation(const size_t& stat_idx)
 {
-	const size_t nr_stations = station_index.size();
-	for (size_t ii=0; ii<nr_stations; ++ii) {
-		if (station_index[ii]==key)
-			return ii;
-	}
+	if (stat_idx<radiation.size()) return;
 
-	radiation.push_back( std::vector<double>(samples_per_day, 0.) );
-	loss_factor.push_back( 0. );
+	const size_t nr_stations = stat_idx+1;
+	radiation.resize( nr_stations, std::vector<double>(samples_per_day, 0.) );
+	loss_factor.resize( nr_stations, 0. );
 
-	Date null_date(0., 0.);
-	dateStart.push_back( null_date );
-	dateEnd.push_back( null_date );
+	const Date null_date(0., 0.);
+	dateStart.resize( nr_stations, null_date );
+	dateEnd.resize( nr_stations, null_date );
+}
 
-	station_index.push_back( key );
-	return nr_stations; //the new index is the old nr_stations
+void Daily_solar::resetStations()
+{
+	ResamplingAlgorithms::resetStations();
+	radiation.clear();
+	loss_factor.clear();
+	dateStart.clear();
+	dateEnd.clear();
 }
 
-void Daily_solar::resample(const std::string& stationHash, const size_t& index, const ResamplingPosition& /*position*/, const size_t& paramindex,
+void Daily_solar::resample(const size_t& stationIdx, const size_t& index, const ResamplingPosition& /*position*/, const size_t& paramindex,
                            const std::vector<MeteoData>& vecM, MeteoData& md)
 {
 	if (index >= vecM.size())
@@ -118,36 +121,35 @@ void Daily_solar::resample(const std::string& stationHash, const size_t& index,
 	if (lat==IOUtils::nodata || lon==IOUtils::nodata || alt==IOUtils::nodata) return;
 	const double HS = md(MeteoData::HS);
 
-	//get station index
-	const size_t stat_idx = getStationIndex(stationHash);
+	initStation(stationIdx);
 
 	//has the radiation already been calculated for this day and station?
-	if (md.date<dateStart[stat_idx] || md.date>=dateEnd[stat_idx]) {
-		dateStart[stat_idx] = getDailyStart(md.date);
-		dateEnd[stat_idx] = dateStart[stat_idx]+1.;
-		//const size_t indexP = getNearestValidPt(vecM, paramindex, stat_idx, index);
-		const size_t indexP = getDailyValue(vecM, paramindex, index, dateStart[stat_idx], dateEnd[stat_idx]);
+	if (md.date<dateStart[stationIdx] || md.date>=dateEnd[stationIdx]) {
+		dateStart[stationIdx] = getDailyStart(md.date);
+		dateEnd[stationIdx] = dateStart[stationIdx]+1.;
+		//const size_t indexP = getNearestValidPt(vecM, paramindex, stationIdx, index);
+		const size_t indexP = getDailyValue(vecM, paramindex, index, dateStart[stationIdx], dateEnd[stationIdx]);
 		if (indexP==IOUtils::npos) { //no daily sum found for the current day
-			loss_factor[stat_idx] = IOUtils::nodata;
+			loss_factor[stationIdx] = IOUtils::nodata;
 			return;
 		}
 
-		const double daily_sum = compRadiation(lat, lon, alt, HS, stat_idx);
-		loss_factor[stat_idx] = (daily_sum>0)? vecM[indexP](paramindex) / daily_sum : 0.; //in case of polar night...
+		const double daily_sum = compRadiation(lat, lon, alt, HS, stationIdx);
+		loss_factor[stationIdx] = (daily_sum>0)? vecM[indexP](paramindex) / daily_sum : 0.; //in case of polar night...
 	}
 
-	if (loss_factor[stat_idx]==IOUtils::nodata) //the station could not be calculated for this day
+	if (loss_factor[stationIdx]==IOUtils::nodata) //the station could not be calculated for this day
 		return;
 
 	//interpolate radiation for this timestep and write it out
-	const double rad = getSolarInterpol(md.date, stat_idx);
+	const double rad = getSolarInterpol(md.date, stationIdx);
 	if (paramindex==MeteoData::ISWR) {
-		md(paramindex) = loss_factor[stat_idx] * rad;
+		md(paramindex) = loss_factor[stationIdx] * rad;
 	} else {
 		double albedo = 0.5;
 		if (HS!=IOUtils::nodata) //no big deal if we can not adapt the albedo
 			albedo = (HS>=snow_thresh)? snow_albedo : soil_albedo;
-		md(paramindex) = loss_factor[stat_idx] * rad * albedo;
+		md(paramindex) = loss_factor[stationIdx] * rad * albedo;
 	}
 
 	md.setResampled(true);
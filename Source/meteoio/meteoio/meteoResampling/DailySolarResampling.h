@@ -39,16 +39,16 @@ class Daily_solar : public ResamplingAlgorithms {
 	public:
 		Daily_solar(const std::string& i_algoname, const std::string& i_parname, const double& dflt_window_size, const std::vector< std::pair<std::string, std::string> >& vecArgs);
 
-		void resample(const std::string& stationHash, const size_t& index, const ResamplingPosition& position, const size_t& paramindex,
+		void resample(const size_t& stationIdx, const size_t& index, const ResamplingPosition& position, const size_t& paramindex,
 		              const std::vector<MeteoData>& vecM, MeteoData& md);
+		void resetStations();
 		std::string toString() const;
 	private:
 		double getSolarInterpol(const Date& resampling_date, const size_t& stat_idx) const;
 		double compRadiation(const double& lat, const double& lon, const double& alt, const double& HS, const size_t& stat_idx);
-		size_t getStationIndex(const std::string& key);
+		void initStation(const size_t& stat_idx);
 
-		std::vector< std::vector<double> > radiation;
-		std::vector<std::string> station_index;
+		std::vector< std::vector<double> > radiation; ///< per station index
 		std::vector<Date> dateStart, dateEnd;
 		std::vector<double> loss_factor;
 
@@ -238,7 +238,7 @@ size_t ResamplingAlgorithms::searchForward(gap_info &last_gap, const size_t& pos
 
 /**
  * @brief This function returns the last and next valid points around a given position
- * @param stationHash hash used to uniquely identify timeseries (so we can cache some data per timeseries)
+ * @param stationIdx index used to uniquely identify timeseries (so we can cache some data per timeseries)
  * @param pos current position (index)
  * @param paramindex meteo parameter to use
  * @param vecM vector of MeteoData
@@ -247,10 +247,11 @@ size_t ResamplingAlgorithms::searchForward(gap_info &last_gap, const size_t& pos
  * @param indexP1 index of point before the current position (IOUtils::npos if none could be found)
  * @param indexP2 index of point after the current position (IOUtils::npos if none could be found)
  */
-void ResamplingAlgorithms::getNearestValidPts(const std::string& stationHash, const size_t& pos, const size_t& paramindex, const std::vector<MeteoData>& vecM, const Date& resampling_date,
+void ResamplingAlgorithms::getNearestValidPts(const size_t& stationIdx, const size_t& pos, const size_t& paramindex, const std::vector<MeteoData>& vecM, const Date& resampling_date,
                                               const double& i_window_size, size_t& indexP1, size_t& indexP2)
 {
-	gap_info &last_gap = gaps[ stationHash ];
+	if (stationIdx>=gaps.size()) gaps.resize(stationIdx+1);
+	gap_info &last_gap = gaps[ stationIdx ];
 	indexP1 = searchBackward(last_gap, pos, paramindex, vecM, resampling_date, i_window_size);
 	indexP2 = searchForward(last_gap, pos, paramindex, vecM, resampling_date, i_window_size, indexP1);
 }
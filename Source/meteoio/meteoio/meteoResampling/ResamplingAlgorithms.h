@@ -57,11 +57,13 @@ class ResamplingAlgorithms {
 		virtual ~ResamplingAlgorithms() {}
 
 		const std::string getAlgo() const {return algo;}
+		const std::string& getParameterName() const {return parname;}
 
-		virtual void resample(const std::string& stationHash, const size_t& index, const ResamplingPosition& position, const size_t& paramindex,
+		virtual void resample(const size_t& stationIdx, const size_t& index, const ResamplingPosition& position, const size_t& paramindex,
 		              const std::vector<MeteoData>& vecM, MeteoData& md) = 0;
 		
 		void resetResampling() {gaps.clear();} //invalidate all gaps, usually after rebuffering
+		virtual void resetStations() {gaps.clear();} //invalidate all per station data, when the stations behind the station indices have changed
 
 		virtual std::string toString() const = 0;
 
@@ -70,7 +72,7 @@ class ResamplingAlgorithms {
 		                                      const size_t& pos, const Date& curr_date);
 		static double partialAccumulateAtRight(const std::vector<MeteoData>& vecM, const size_t& paramindex,
 		                                       const size_t& pos, const Date& curr_date);
-		void getNearestValidPts(const std::string& stationHash, const size_t& pos, const size_t& paramindex, const std::vector<MeteoData>& vecM, const Date& resampling_date,
+		void getNearestValidPts(const size_t& stationIdx, const size_t& pos, const size_t& paramindex, const std::vector<MeteoData>& vecM, const Date& resampling_date,
 		                               const double& i_window_size, size_t& indexP1, size_t& indexP2);
 		static double linearInterpolation(const double& x1, const double& y1,
 		                                  const double& x2, const double& y2, const double& x3);
@@ -95,7 +97,7 @@ class ResamplingAlgorithms {
                                               const double& i_window_size);
 		size_t searchForward(gap_info &last_gap, const size_t& pos, const size_t& paramindex, const std::vector<MeteoData>& vecM, const Date& resampling_date,
                                               const double& i_window_size, const size_t& indexP1);
-		std::map<std::string, gap_info> gaps;
+		std::vector<gap_info> gaps; ///< last known gap, per station index
 };
 
 class ResamplingAlgorithmsFactory {
@@ -83,11 +83,11 @@ double Solar::getPotentialH(const MeteoData& md)
 	return global_h;
 }
 
-bool Solar::computeLossFactor(const std::string& stationHash, const size_t& index, const size_t& paramindex,
+bool Solar::computeLossFactor(const size_t& stationIdx, const size_t& index, const size_t& paramindex,
                            const std::vector<MeteoData>& vecM, const Date& resampling_date, Points &pts)
 {
 	size_t indexP1=IOUtils::npos, indexP2=IOUtils::npos;
-	getNearestValidPts(stationHash, index, paramindex, vecM, resampling_date, window_size, indexP1, indexP2);
+	getNearestValidPts(stationIdx, index, paramindex, vecM, resampling_date, window_size, indexP1, indexP2);
 	const bool foundP1=(indexP1!=IOUtils::npos), foundP2=(indexP2!=IOUtils::npos);
 
 	if (!extrapolate && (!foundP1 || !foundP2)) return false;
@@ -122,7 +122,7 @@ double Solar::interpolateLossFactor(const double& resampling_jul, const Points &
 	return 1.;
 }
 
-void Solar::resample(const std::string& stationHash, const size_t& index, const ResamplingPosition& /*position*/, const size_t& paramindex,
+void Solar::resample(const size_t& stationIdx, const size_t& index, const ResamplingPosition& /*position*/, const size_t& paramindex,
                            const std::vector<MeteoData>& vecM, MeteoData& md)
 {
 	if (index >= vecM.size())
@@ -132,11 +132,12 @@ void Solar::resample(const std::string& stationHash, const size_t& index, const
 	if (pot_pt==IOUtils::nodata) return;
 
 	const double resampling_jul = md.date.getJulian();
-	Points pts( cache_losses[ stationHash ] );
+	if (stationIdx>=cache_losses.size()) cache_losses.resize(stationIdx+1);
+	Points pts( cache_losses[ stationIdx ] );
 	if (pts.jul1==0. || (resampling_jul<pts.jul1 || resampling_jul>pts.jul2)) {
-		const bool status = computeLossFactor(stationHash, index, paramindex, vecM, md.date, pts);
+		const bool status = computeLossFactor(stationIdx, index, paramindex, vecM, md.date, pts);
 		if (!status) return;
-		cache_losses[ stationHash ] = pts;
+		cache_losses[ stationIdx ] = pts;
 	}
 
 	const double loss = interpolateLossFactor(resampling_jul, pts);
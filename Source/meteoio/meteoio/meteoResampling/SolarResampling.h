@@ -22,7 +22,7 @@
 #include <meteoio/meteoResampling/ResamplingAlgorithms.h>
 #include <meteoio/IOUtils.h>
 
-#include <map>
+#include <vector>
 
 namespace mio {
 
@@ -52,8 +52,9 @@ class Solar : public ResamplingAlgorithms {
 	public:
 		Solar(const std::string& i_algoname, const std::string& i_parname, const double& dflt_window_size, const std::vector< std::pair<std::string, std::string> >& vecArgs);
 
-		void resample(const std::string& stationHash, const size_t& index, const ResamplingPosition& position, const size_t& paramindex,
+		void resample(const size_t& stationIdx, const size_t& index, const ResamplingPosition& position, const size_t& paramindex,
 		              const std::vector<MeteoData>& vecM, MeteoData& md);
+		void resetStations() {ResamplingAlgorithms::resetStations(); cache_losses.clear();}
 		std::string toString() const;
 	private:
 		typedef struct POINTS {
@@ -62,11 +63,11 @@ class Solar : public ResamplingAlgorithms {
 		} Points;
 
 		static double getPotentialH(const MeteoData& md);
-		bool computeLossFactor(const std::string& stationHash, const size_t& index, const size_t& paramindex,
+		bool computeLossFactor(const size_t& stationIdx, const size_t& index, const size_t& paramindex,
 		           const std::vector<MeteoData>& vecM, const Date& resampling_date, Points &pts);
 		static double interpolateLossFactor(const double& resampling_jul, const Points &pts);
 
-		std::map< std::string, Points > cache_losses;
+		std::vector<Points> cache_losses; ///< per station index
 		bool extrapolate;
 };
 
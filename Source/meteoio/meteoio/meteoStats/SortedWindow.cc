@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2026 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <meteoio/meteoStats/SortedWindow.h>
+#include <meteoio/meteoStats/libinterpol1D.h>
+#include <meteoio/IOUtils.h>
+
+#include <algorithm>
+
+namespace mio {
+
+void SortedWindow::slide(const std::vector<double>& data, const size_t& start, const size_t& end)
+{
+	if (!has_window || start>win_end || end<win_start) { //no overlap: fill the window from scratch
+		sorted.clear();
+		for (size_t ii=start; ii<=end; ii++) insert( data[ii] );
+	} else {
+		for (size_t ii=win_start; ii<start; ii++) remove( data[ii] );
+		for (size_t ii=start; ii<win_start; ii++) insert( data[ii] );
+		for (size_t ii=end+1; ii<=win_end; ii++) remove( data[ii] );
+		for (size_t ii=win_end+1; ii<=end; ii++) insert( data[ii] );
+	}
+
+	win_start = start;
+	win_end = end;
+	has_window = true;
+}
+
+void SortedWindow::insert(const double& value)
+{
+	if (value==IOUtils::nodata) return;
+	sorted.insert(std::upper_bound(sorted.begin(), sorted.end(), value), value);
+}
+
+void SortedWindow::remove(const double& value)
+{
+	if (value==IOUtils::nodata) return;
+	const std::vector<double>::iterator it = std::lower_bound(sorted.begin(), sorted.end(), value);
+	if (it!=sorted.end() && *it==value) sorted.erase(it);
+}
+
+void SortedWindow::clear()
+{
+	sorted.clear();
+	has_window = false;
+}
+
+double SortedWindow::getMedian() const
+{
+	const size_t n = sorted.size();
+	if (n==0) return IOUtils::nodata;
+
+	const size_t middle = n/2;
+	if ((n % 2) == 1) return sorted[middle];
+	return Interpol1D::weightedMean(sorted[middle-1], sorted[middle], 0.5);
+}
+
+double SortedWindow::getMAD() const
+{
+	const size_t n = sorted.size();
+	if (n==0) return IOUtils::nodata;
+
+	//the deviations of the values below the median grow towards the front, the others towards the back
+	const double median = getMedian();
+	const size_t pivot = static_cast<size_t>( std::lower_bound(sorted.begin(), sorted.end(), median) - sorted.begin() );
+
+	const size_t middle = n/2;
+	if ((n % 2) == 1) return getDeviation(middle, median, pivot);
+	return Interpol1D::weightedMean(getDeviation(middle-1, median, pivot), getDeviation(middle, median, pivot), 0.5);
+}
+
+/**
+ * @brief Find the k-th smallest absolute deviation from the median (starting at 0)
+ * @details The deviations form two sorted sequences: (median - sorted[pivot-1-i]) and (sorted[pivot+j] - median),
+ * the k-th element of their union is found with a binary search on the number of elements taken from the first one.
+ * @param k rank of the deviation to find
+ * @param median median of the values
+ * @param pivot index of the first value that is not smaller than the median
+ * @return k-th smallest deviation
+ */
+double SortedWindow::getDeviation(const size_t& k, const double& median, const size_t& pivot) const
+{
+	const size_t n_left = pivot, n_right = sorted.size() - pivot;
+	const size_t nr = k + 1; //number of deviations to take
+
+	size_t lo = (nr>n_right)? nr-n_right : 0;
+	size_t hi = std::min(nr, n_left);
+	while (lo<hi) {
+		const size_t i = (lo+hi) / 2; //deviations taken from the left
+		const size_t j = nr - i; //deviations taken from the right, always >0 since i<nr
+		const double left_dev = median - sorted[pivot-1-i];
+		const double right_dev = sorted[pivot+j-1] - median;
+		if (left_dev<right_dev) lo = i+1;
+		else hi = i;
+	}
+
+	const size_t i = lo, j = nr - lo;
+	if (i==0) return sorted[pivot+j-1] - median;
+	if (j==0) return median - sorted[pivot-i];
+	return std::max(median - sorted[pivot-i], sorted[pivot+j-1] - median);
+}
+
+double SortedWindow::getQuantile(const double& q) const
+{
+	const size_t n = sorted.size();
+	if (n==0) return IOUtils::nodata;
+	if (n==1 || q<=0.) return sorted.front();
+	if (q>=1.) return sorted.back();
+
+	const double pos = static_cast<double>(n - 1) * q;
+	const size_t ind = static_cast<size_t>(pos);
+	const double delta = pos - static_cast<double>(ind);
+	return sorted[ind] * (1.0 - delta) + sorted[ind+1] * delta;
+}
+
+} //namespace
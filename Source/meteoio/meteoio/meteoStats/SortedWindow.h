@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2026 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SORTEDWINDOW_H
+#define SORTEDWINDOW_H
+
+#include <vector>
+#include <cstddef>
+
+namespace mio {
+
+/**
+ * @class SortedWindow
+ * @brief Order statistics over a sliding window of data.
+ * @details The values of the window are kept sorted, so that when the window slides along a time series, only the
+ * values that enter and leave the window have to be processed instead of sorting the whole window again for each point.
+ * The median, the Median Absolute Deviation and the quantiles are then found by binary searches in the sorted values
+ * (nodata values are ignored). The window can grow and shrink on both sides, so it supports left / right / centered as
+ * well as time-based windows that contain a varying number of points.
+ *
+ * @code
+ * SortedWindow window;
+ * for (size_t ii=0; ii<data.size(); ii++) {
+ * 	window.slide(data, start[ii], end[ii]); //the window for point ii spans [start, end] (inclusive)
+ * 	const double median = window.getMedian();
+ * }
+ * @endcode
+ *
+ * @ingroup stats
+ * @date   2026-10-16
+ */
+class SortedWindow {
+	public:
+		SortedWindow() : sorted(), win_start(), win_end(), has_window(false) {}
+
+		/**
+		 * @brief Move the window to a new position within a data series.
+		 * @details Only the difference between the previous window and the new one is added / removed, so the same
+		 * data vector must be given for all calls (call clear() before processing another vector).
+		 * @param data data series (nodata values are ignored)
+		 * @param start index of the first element of the window
+		 * @param end index of the last element of the window (inclusive)
+		 */
+		void slide(const std::vector<double>& data, const size_t& start, const size_t& end);
+
+		/**
+		 * @brief Add a value to the window (nodata values are ignored)
+		 * @param value value to add
+		 */
+		void insert(const double& value);
+
+		/**
+		 * @brief Remove one occurrence of a value from the window (nodata values are ignored)
+		 * @param value value to remove
+		 */
+		void remove(const double& value);
+
+		/**
+		 * @brief Empty the window, the next call to slide() starts from scratch
+		 */
+		void clear();
+
+		size_t size() const {return sorted.size();}
+		bool empty() const {return sorted.empty();}
+
+		/**
+		 * @brief Median of the values in the window
+		 * @return median or IOUtils::nodata if the window is empty
+		 */
+		double getMedian() const;
+
+		/**
+		 * @brief Median Absolute Deviation of the values in the window
+		 * @details This is the median of the absolute deviations from the median, it gives the same result as
+		 * Interpol1D::getMedianAverageDeviation() but is found in O(log(n)).
+		 * @return MAD or IOUtils::nodata if the window is empty
+		 */
+		double getMAD() const;
+
+		/**
+		 * @brief Quantile of the values in the window, following the same definition as Interpol1D::quantiles()
+		 * @param q quantile, between 0 and 1
+		 * @return value of the quantile or IOUtils::nodata if the window is empty
+		 */
+		double getQuantile(const double& q) const;
+
+	private:
+		double getDeviation(const size_t& k, const double& median, const size_t& pivot) const;
+
+		std::vector<double> sorted; ///< values currently in the window, sorted in increasing order
+		size_t win_start, win_end; ///< current window within the data series
+		bool has_window;
+};
+
+} //end namespace
+
+#endif
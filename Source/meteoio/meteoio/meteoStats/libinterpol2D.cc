@@ -18,6 +18,7 @@
 */
 #include <cmath>
 #include <algorithm>
+#include <exception>
 
 #include <meteoio/meteoStats/libinterpol2D.h>
 #include <meteoio/meteoLaws/Atmosphere.h>
@@ -28,6 +29,8 @@ using namespace std;
 
 namespace mio {
 
+static const int tile_rows = 16; //number of grid rows that are processed together by one thread
+
 //Useful functions
 /**
  * @brief check if the points measurements are all at zero
@@ -95,30 +98,6 @@ inline double Interpol2D::HorizontalDistance(const DEMObject& dem, const int& i,
 	return sqrt( DX*DX + DY*DY );
 }
 
-/**
-* @brief Build the list of (distance to grid cell, stations index) ordered by their distance to a grid cell
-* @param x x coordinate of cell
-* @param y y coordinate of cell
-* @param list list of pairs (distance to grid cell, stations index)
-*/
-void Interpol2D::getNeighbors(const double& x, const double& y,
-                              const std::vector<StationData>& vecStations,
-                              std::vector< std::pair<double, size_t> >& list)
-{
-	list.resize(vecStations.size());
-
-	for (size_t i=0; i<vecStations.size(); i++) {
-		const Coords& position = vecStations[i].position;
-		const double DX = x-position.getEasting();
-		const double DY = y-position.getNorthing();
-		const double d2 = (DX*DX + DY*DY);
-		const std::pair <double, size_t> tmp(d2,i);
-		list[i] = tmp;
-	}
-
-	sort (list.begin(), list.end());
-}
-
 //convert a vector of stations into two vectors of eastings and northings
 void Interpol2D::buildPositionsVectors(const std::vector<StationData>& vecStations, std::vector<double>& vecEastings, std::vector<double>& vecNorthings)
 {
@@ -188,20 +167,32 @@ void Interpol2D::constant(const double& value, const DEMObject& dem, Grid2DObjec
 	}
 }
 
+//weights is a scratch buffer that must have as many elements as there are stations
 double Interpol2D::IDWCore(const double& x, const double& y, const std::vector<double>& vecData_in,
-                           const std::vector<double>& vecEastings, const std::vector<double>& vecNorthings, const double& scale, const double& alpha)
+                           const std::vector<double>& vecEastings, const std::vector<double>& vecNorthings,
+                           const double& scale, const double& alpha, std::vector<double>& weights)
 {
 	//The value at any given cell is the sum of the weighted contribution from each source
 	const size_t n_stations = vecEastings.size();
-	double parameter = 0., norm = 0.;
+	const double scale_sq = scale*scale;
+	const double *eastings = &vecEastings[0], *northings = &vecNorthings[0], *values = &vecData_in[0];
+	double *weight = &weights[0];
 
+	//the weights of the stations are independent of each other, so this loop can be vectorized
 	for (size_t ii=0; ii<n_stations; ii++) {
-		const double DX = x-vecEastings[ii];
-		const double DY = y-vecNorthings[ii];
-		const double dist = Optim::invSqrt( DX*DX + DY*DY + scale*scale ); //use the optimized 1/sqrt approximation
-		const double weight = (alpha==1.)? dist : Optim::fastPow(dist, alpha);
-		parameter += weight*vecData_in[ii];
-		norm += weight;
+		const double DX = x-eastings[ii];
+		const double DY = y-northings[ii];
+		weight[ii] = Optim::invSqrt( DX*DX + DY*DY + scale_sq ); //use the optimized 1/sqrt approximation
+	}
+	if (alpha!=1.) {
+		for (size_t ii=0; ii<n_stations; ii++) weight[ii] = Optim::fastPow(weight[ii], alpha);
+	}
+
+	//the sums are kept in the stations' order so the result does not depend on the vectorization
+	double parameter = 0., norm = 0.;
+	for (size_t ii=0; ii<n_stations; ii++) {
+		parameter += weight[ii]*values[ii];
+		norm += weight[ii];
 	}
 	return (parameter/norm); //normalization
 }
@@ -221,6 +212,88 @@ double Interpol2D::IDWCore(const std::vector<double>& vecData_in, const std::vec
 	return (parameter/norm); //normalization
 }
 
+namespace {
+/**
+ * @brief 2D tree of stations positions, to quickly find the nearest stations of a point.
+ * The nearest stations are sorted by (square distance, station index), exactly as a full sort of all the stations would do.
+ */
+class StationsTree {
+	public:
+		StationsTree(const std::vector<double>& i_eastings, const std::vector<double>& i_northings)
+		             : eastings(i_eastings), northings(i_northings), nodes(i_eastings.size()), split_x(i_eastings.size())
+		{
+			for (size_t ii=0; ii<nodes.size(); ii++) nodes[ii] = ii;
+			build(0, nodes.size(), true);
+		}
+
+		/**
+		 * @brief Get the k nearest stations of a point
+		 * @param[in] x easting of the point
+		 * @param[in] y northing of the point
+		 * @param[in] k number of stations to return (or all of them if there are fewer)
+		 * @param[out] neighbors (square distance, station index) sorted by increasing distance
+		 */
+		void getNearest(const double& x, const double& y, const size_t& k, std::vector< std::pair<double, size_t> >& neighbors) const
+		{
+			neighbors.clear();
+			search(0, nodes.size(), x, y, std::min(k, nodes.size()), neighbors);
+			std::sort_heap(neighbors.begin(), neighbors.end());
+		}
+
+	private:
+		//the median of each range is its node, the lower half is on its left and the upper half on its right
+		void build(const size_t& begin, const size_t& end, const bool& by_x)
+		{
+			if (end-begin<=1) {
+				if (end>begin) split_x[begin] = by_x;
+				return;
+			}
+			const size_t mid = begin + (end-begin)/2;
+			const std::vector<double>& coord = (by_x)? eastings : northings;
+			std::nth_element(nodes.begin()+begin, nodes.begin()+mid, nodes.begin()+end, CoordLess(coord));
+			split_x[mid] = by_x;
+			build(begin, mid, !by_x);
+			build(mid+1, end, !by_x);
+		}
+
+		//neighbors is kept as a max-heap of the k best candidates found so far
+		void search(const size_t& begin, const size_t& end, const double& x, const double& y, const size_t& k, std::vector< std::pair<double, size_t> >& neighbors) const
+		{
+			if (begin>=end) return;
+			const size_t mid = begin + (end-begin)/2;
+			const size_t st = nodes[mid];
+			const double DX = x-eastings[st];
+			const double DY = y-northings[st];
+			const std::pair<double, size_t> candidate(DX*DX + DY*DY, st);
+			if (neighbors.size()<k) {
+				neighbors.push_back( candidate );
+				std::push_heap(neighbors.begin(), neighbors.end());
+			} else if (candidate<neighbors.front()) {
+				std::pop_heap(neighbors.begin(), neighbors.end());
+				neighbors.back() = candidate;
+				std::push_heap(neighbors.begin(), neighbors.end());
+			}
+
+			const double delta = (split_x[mid])? DX : DY;
+			const bool left_first = (delta<0.);
+			search((left_first)? begin : mid+1, (left_first)? mid : end, x, y, k, neighbors);
+			//stations at the same distance as the current worst candidate could still win on their index
+			if (neighbors.size()<k || delta*delta<=neighbors.front().first)
+				search((left_first)? mid+1 : begin, (left_first)? end : mid, x, y, k, neighbors);
+		}
+
+		struct CoordLess {
+			explicit CoordLess(const std::vector<double>& i_coord) : coord(i_coord) {}
+			bool operator()(const size_t& a, const size_t& b) const {return coord[a]<coord[b];}
+			const std::vector<double>& coord;
+		};
+
+		const std::vector<double>& eastings, &northings;
+		std::vector<size_t> nodes; ///< stations indices, organized as an implicit balanced tree
+		std::vector<bool> split_x; ///< for each node, is the split done on the eastings (otherwise on the northings)?
+};
+} //end anonymous namespace
+
 /** @brief Grid filling function:
 * Similar to Interpol2D::LapseIDW but using a limited number of stations for each cell.
 * @param vecData_in input values to use for the IDW
@@ -230,61 +303,103 @@ double Interpol2D::IDWCore(const std::vector<double>& vecData_in, const std::vec
 * @param grid 2D array to fill
 * @param scale The scale factor is used to smooth the grid. It is added to the distance before applying the weights in order to come into the tail of "1/d".
 * @param alpha The weights are computed as 1/dist^alpha, so give alpha=1 for standards 1/dist weights.
+* @param nb_threads number of threads to fill the grid (only if compiled with OpenMP). The grid is split into tiles of rows, the results do not depend on it.
 */
 void Interpol2D::LocalLapseIDW(const std::vector<double>& vecData_in, const std::vector<StationData>& vecStations_in,
                                const DEMObject& dem, const size_t& nrOfNeighbors,
-                               Grid2DObject& grid, const double& scale, const double& alpha)
+                               Grid2DObject& grid, const double& scale, const double& alpha, const unsigned int& nb_threads)
 {
 	grid.set(dem, IOUtils::nodata);
 
+	//only the stations with both a value and an altitude can be used (in their original order, to keep the same ties)
+	std::vector<double> values, altitudes, eastings, northings;
+	for (size_t st=0; st<vecStations_in.size(); st++) {
+		const Coords& position = vecStations_in[st].position;
+		if (vecData_in[st]==IOUtils::nodata || position.getAltitude()==IOUtils::nodata) continue;
+		values.push_back( vecData_in[st] );
+		altitudes.push_back( position.getAltitude() );
+		eastings.push_back( position.getEasting() );
+		northings.push_back( position.getNorthing() );
+	}
+	if (values.empty()) return;
+	const StationsTree stations_tree(eastings, northings);
+	const size_t nr_neighbors = std::max(nrOfNeighbors, (size_t)1);
+
 	//run algorithm
-	for (size_t j=0; j<grid.getNy(); j++) {
-		for (size_t i=0; i<grid.getNx(); i++) {
-			//LL_IDW_pixel returns nodata when appropriate
-			grid(i,j) = LLIDW_pixel(i, j, vecData_in, vecStations_in, dem, nrOfNeighbors, scale, alpha);
+	const double xllcorner = dem.llcorner.getEasting();
+	const double yllcorner = dem.llcorner.getNorthing();
+	const double cellsize = dem.cellsize;
+	const size_t ncols = grid.getNx(), nrows = grid.getNy();
+	std::exception_ptr error; //exceptions must not leave the parallel region, they are rethrown afterwards
+	size_t error_row = nrows;
+	#pragma omp parallel num_threads(nb_threads)
+	{
+		//per thread: the neighbors of the current cell and the last computed trend
+		std::vector< std::pair<double, size_t> > neighbors;
+		std::vector<size_t> trend_stations;
+		std::vector<double> residuals;
+		Fit1D trend;
+
+		#pragma omp for schedule(dynamic, tile_rows)
+		for (size_t j=0; j<nrows; j++) {
+			try {
+				for (size_t i=0; i<ncols; i++) {
+					const double cell_altitude = dem(i,j);
+					if (cell_altitude==IOUtils::nodata) continue;
+					stations_tree.getNearest(xllcorner+static_cast<double>(i)*cellsize, yllcorner+static_cast<double>(j)*cellsize, nr_neighbors, neighbors);
+					grid(i,j) = LLIDW_pixel(cell_altitude, neighbors, values, altitudes, scale, alpha, trend_stations, trend, residuals);
+				}
+			} catch (...) {
+				#pragma omp critical(llidw_error)
+				{
+					if (j<error_row) { //keep the exception that a serial run would have thrown
+						error = std::current_exception();
+						error_row = j;
+					}
+				}
+			}
 		}
 	}
+	if (error) std::rethrow_exception(error);
 }
 
-//calculate a local pixel for LocalLapseIDW
-double Interpol2D::LLIDW_pixel(const size_t& i, const size_t& j,
-                               const std::vector<double>& vecData_in, const std::vector<StationData>& vecStations_in,
-                               const DEMObject& dem, const size_t& nrOfNeighbors, const double& scale, const double& alpha)
+//calculate a local pixel for LocalLapseIDW, neighbors being the (square distance, station index) of the nearest stations.
+//The trend is only recomputed when the neighbors differ from the previous cell (trend_stations and residuals are kept for this purpose)
+double Interpol2D::LLIDW_pixel(const double& cell_altitude, const std::vector< std::pair<double, size_t> >& neighbors,
+                               const std::vector<double>& vecData_in, const std::vector<double>& vecAltitudes,
+                               const double& scale, const double& alpha,
+                               std::vector<size_t>& trend_stations, Fit1D& trend, std::vector<double>& residuals)
 {
-	const double cell_altitude = dem(i,j);
-	if (cell_altitude==IOUtils::nodata)
-		return IOUtils::nodata;
-
-	//fill vectors with neighbors sorted by the square of their distance to (i,j)
-	const double x = dem.llcorner.getEasting()+static_cast<double>(i)*dem.cellsize;
-	const double y = dem.llcorner.getNorthing()+static_cast<double>(j)*dem.cellsize;
-	std::vector< std::pair<double, size_t> > sorted_neighbors;
-	getNeighbors(x, y, vecStations_in, sorted_neighbors);
-
-	//build the vectors of valid data, with max nrOfNeighbors
-	std::vector<double> altitudes, values, distances_sq;
-	for (size_t st=0; st<sorted_neighbors.size(); st++) {
-		const size_t st_index = sorted_neighbors[st].second;
-		const double value = vecData_in[st_index];
-		const double altitude = vecStations_in[st_index].position.getAltitude();
-		if ((value != IOUtils::nodata) && (altitude != IOUtils::nodata)) {
-			altitudes.push_back( altitude );
-			values.push_back( value );
-			distances_sq.push_back( sorted_neighbors[st].first );
-			if (altitudes.size()>=nrOfNeighbors) break;
-		}
+	const size_t nr_neighbors = neighbors.size();
+	if (nr_neighbors==0) return IOUtils::nodata;
 
+	bool same_stations = (trend_stations.size()==nr_neighbors);
+	for (size_t st=0; same_stations && st<nr_neighbors; st++) {
+		if (trend_stations[st]!=neighbors[st].second) same_stations = false;
 	}
 
 	//compute lapse rate and detrend the stations' data
-	if (altitudes.empty()) return IOUtils::nodata;
-	const Fit1D trend(Fit1D::NOISY_LINEAR, altitudes, values);
-	for (size_t ii=0; ii<altitudes.size(); ii++) {
-		values[ii] -= trend( altitudes[ii] );
+	if (!same_stations) {
+		trend_stations.clear(); //in case the fit fails
+		std::vector<double> altitudes( nr_neighbors );
+		residuals.resize( nr_neighbors );
+		for (size_t st=0; st<nr_neighbors; st++) {
+			altitudes[st] = vecAltitudes[ neighbors[st].second ];
+			residuals[st] = vecData_in[ neighbors[st].second ];
+		}
+		if (!trend.setModel(Fit1D::NOISY_LINEAR, altitudes, residuals))
+			throw NoDataException("The provided data was insufficient when constructing the regression model '"+trend.getName()+"'", AT);
+		for (size_t st=0; st<nr_neighbors; st++) {
+			residuals[st] -= trend( altitudes[st] );
+			trend_stations.push_back( neighbors[st].second );
+		}
 	}
 
+	std::vector<double> distances_sq( nr_neighbors );
+	for (size_t st=0; st<nr_neighbors; st++) distances_sq[st] = neighbors[st].first;
+
 	//compute the local pixel value, retrend
-	const double pixel_value = IDWCore(values, distances_sq, scale, alpha);
+	const double pixel_value = IDWCore(residuals, distances_sq, scale, alpha);
 	if (pixel_value!=IOUtils::nodata)
 		return pixel_value + trend(cell_altitude);
 	else
@@ -302,9 +417,10 @@ double Interpol2D::LLIDW_pixel(const size_t& i, const size_t& j,
 * @param grid 2D array to fill
 * @param scale The scale factor is used to smooth the grid. It is added to the distance before applying the weights in order to come into the tail of "1/d".
 * @param alpha The weights are computed as 1/dist^alpha, so give alpha=1 for standards 1/dist weights.
+* @param nb_threads number of threads to fill the grid (only if compiled with OpenMP). The grid is split into tiles of rows, the results do not depend on it.
 */
 void Interpol2D::IDW(const std::vector<double>& vecData_in, const std::vector<StationData>& vecStations_in,
-                     const DEMObject& dem, Grid2DObject& grid, const double& scale, const double& alpha)
+                     const DEMObject& dem, Grid2DObject& grid, const double& scale, const double& alpha, const unsigned int& nb_threads)
 {
 	if (allZeroes(vecData_in)) { //if all data points are zero, simply fill the grid with zeroes
 		constant(0., dem, grid);
@@ -323,11 +439,17 @@ void Interpol2D::IDW(const std::vector<double>& vecData_in, const std::vector<St
 	const double xllcorner = dem.llcorner.getEasting();
 	const double yllcorner = dem.llcorner.getNorthing();
 	const double cellsize = dem.cellsize;
-	for (size_t jj=0; jj<grid.getNy(); jj++) {
-		for (size_t ii=0; ii<grid.getNx(); ii++) {
-			if (dem(ii,jj)!=IOUtils::nodata) {
-				grid(ii,jj) = IDWCore((xllcorner+double(ii)*cellsize), (yllcorner+double(jj)*cellsize),
-				                           vecData_in, vecEastings, vecNorthings, scale, alpha);
+	const size_t ncols = grid.getNx(), nrows = grid.getNy();
+	#pragma omp parallel num_threads(nb_threads)
+	{
+		std::vector<double> weights( vecEastings.size() ); //one scratch buffer per thread
+		#pragma omp for schedule(dynamic, tile_rows)
+		for (size_t jj=0; jj<nrows; jj++) {
+			for (size_t ii=0; ii<ncols; ii++) {
+				if (dem(ii,jj)!=IOUtils::nodata) {
+					grid(ii,jj) = IDWCore((xllcorner+double(ii)*cellsize), (yllcorner+double(jj)*cellsize),
+					                           vecData_in, vecEastings, vecNorthings, scale, alpha, weights);
+				}
 			}
 		}
 	}
@@ -708,9 +830,10 @@ double Interpol2D::getTanMaxSlope(const Grid2DObject& dem, const double& dmin, c
 * @param dmax search radius
 * @param in_bearing wind direction to consider
 * @param grid 2D array of precipitation to fill
+* @param nb_threads number of threads to fill the grid (only if compiled with OpenMP). The grid is split into tiles of rows, the results do not depend on it.
 * @author Mathias Bavay
 */
-void Interpol2D::WinstralSX(const DEMObject& dem, const double& dmax, const double& in_bearing, Grid2DObject& grid)
+void Interpol2D::WinstralSX(const DEMObject& dem, const double& dmax, const double& in_bearing, Grid2DObject& grid, const unsigned int& nb_threads)
 {
 	grid.set(dem, IOUtils::nodata);
 
@@ -722,6 +845,7 @@ void Interpol2D::WinstralSX(const DEMObject& dem, const double& dmax, const doub
 	if (bearing1>bearing2) std::swap(bearing1, bearing2);
 
 	const size_t ncols = dem.getNx(), nrows = dem.getNy();
+	#pragma omp parallel for num_threads(nb_threads) schedule(dynamic, tile_rows)
 	for (size_t jj = 0; jj<nrows; jj++) {
 		for (size_t ii = 0; ii<ncols; ii++) {
 			if (dem(ii,jj)==IOUtils::nodata) continue;
@@ -737,7 +861,7 @@ void Interpol2D::WinstralSX(const DEMObject& dem, const double& dmax, const doub
 	}
 }
 
-void Interpol2D::WinstralSX(const DEMObject& dem, const double& dmax, const Grid2DObject& DW, Grid2DObject& grid)
+void Interpol2D::WinstralSX(const DEMObject& dem, const double& dmax, const Grid2DObject& DW, Grid2DObject& grid, const unsigned int& nb_threads)
 {
 	if (!DW.isSameGeolocalization(dem)){
 		throw IOException("Requested grid DW doesn't match the geolocalization of the DEM", AT);
@@ -750,6 +874,7 @@ void Interpol2D::WinstralSX(const DEMObject& dem, const double& dmax, const Grid
 	static const double bearing_width = 30.;
 
 	const size_t ncols = dem.getNx(), nrows = dem.getNy();
+	#pragma omp parallel for num_threads(nb_threads) schedule(dynamic, tile_rows)
 	for (size_t jj = 0; jj<nrows; jj++) {
 		for (size_t ii = 0; ii<ncols; ii++) {
 			if (dem(ii,jj)==IOUtils::nodata) continue;
@@ -785,14 +910,27 @@ void Interpol2D::WinstralSX(const DEMObject& dem, const double& dmax, const Grid
 * @param dmax search radius
 * @param in_bearing wind direction to consider
 * @param grid 2D array of precipitation to fill
+* @param nb_threads number of threads to compute the wind exposure (only if compiled with OpenMP)
 * @author Mathias Bavay
 */
-void Interpol2D::Winstral(const DEMObject& dem, const Grid2DObject& TA, const double& dmax, const double& in_bearing, Grid2DObject& grid)
+void Interpol2D::Winstral(const DEMObject& dem, const Grid2DObject& TA, const double& dmax, const double& in_bearing, Grid2DObject& grid, const unsigned int& nb_threads)
 {
 	//compute wind exposure factor
 	Grid2DObject Sx;
-	WinstralSX(dem, dmax, in_bearing, Sx);
-	
+	WinstralSX(dem, dmax, in_bearing, Sx, nb_threads);
+	Winstral(Sx, TA, grid);
+}
+
+/**
+* @brief Alter a precipitation field with a precomputed Winstral Sx exposure coefficient
+* This is the redistribution step of Winstral(const DEMObject&, const Grid2DObject&, const double&, const double&, Grid2DObject&),
+* for example when the Sx grid comes from a WinstralSxCache.
+* @param Sx wind exposure coefficient, the cells with liquid precipitation are set to nodata
+* @param TA air temperature grid (in order to discriminate between solid and liquid precipitation)
+* @param grid 2D array of precipitation to fill
+*/
+void Interpol2D::Winstral(Grid2DObject& Sx, const Grid2DObject& TA, Grid2DObject& grid)
+{
 	//don't change liquid precipitation
 	for (size_t ii=0; ii<Sx.size(); ii++) {
 		if (TA(ii)>Cst::t_water_freezing_pt) Sx(ii)=IOUtils::nodata;
@@ -834,13 +972,26 @@ void Interpol2D::Winstral(const DEMObject& dem, const Grid2DObject& TA, const do
 	}
 }
 
-void Interpol2D::Winstral(const DEMObject& dem, const Grid2DObject& TA, const Grid2DObject& DW, const Grid2DObject& VW, const double& dmax, Grid2DObject& grid)
+void Interpol2D::Winstral(const DEMObject& dem, const Grid2DObject& TA, const Grid2DObject& DW, const Grid2DObject& VW, const double& dmax, Grid2DObject& grid, const unsigned int& nb_threads)
 {
-	static const double vw_thresh = 5.; //m/s
 	//compute wind exposure factor
 	Grid2DObject Sx;
-	WinstralSX(dem, dmax, DW, Sx);
-	
+	WinstralSX(dem, dmax, DW, Sx, nb_threads);
+	Winstral(Sx, TA, VW, grid);
+}
+
+/**
+* @brief Alter a precipitation field with a precomputed Winstral Sx exposure coefficient and a wind speed field
+* Same as Winstral(Grid2DObject&, const Grid2DObject&, Grid2DObject&) but the cells with low wind speeds
+* don't contribute to the erosion.
+* @param Sx wind exposure coefficient, the cells with liquid precipitation are set to nodata
+* @param TA air temperature grid (in order to discriminate between solid and liquid precipitation)
+* @param VW wind speed grid
+* @param grid 2D array of precipitation to fill
+*/
+void Interpol2D::Winstral(Grid2DObject& Sx, const Grid2DObject& TA, const Grid2DObject& VW, Grid2DObject& grid)
+{
+	static const double vw_thresh = 5.; //m/s
 	//don't change liquid precipitation
 	for (size_t ii=0; ii<Sx.size(); ii++) {
 		if (TA(ii)>Cst::t_water_freezing_pt) Sx(ii)=IOUtils::nodata;
@@ -896,14 +1047,25 @@ void Interpol2D::Winstral(const DEMObject& dem, const Grid2DObject& TA, const Gr
 * @param VW wind speed grid
 * @param dmax search radius
 * @param grid 2D array of wind speed to fill
+* @param nb_threads number of threads to compute the wind exposure (only if compiled with OpenMP)
 * @author Nander Wever
 */
-void Interpol2D::WinstralDrift(const DEMObject& dem, const Grid2DObject& DW, const Grid2DObject& VW, const double& dmax, Grid2DObject& grid)
+void Interpol2D::WinstralDrift(const DEMObject& dem, const Grid2DObject& DW, const Grid2DObject& VW, const double& dmax, Grid2DObject& grid, const unsigned int& nb_threads)
 {
 	//compute wind exposure factor
 	Grid2DObject Sx;
-	WinstralSX(dem, dmax, DW, Sx);
+	WinstralSX(dem, dmax, DW, Sx, nb_threads);
+	WinstralDrift(Sx, VW, grid);
+}
 
+/**
+* @brief Create special wind speed field based on a precomputed Winstral Sx exposure coefficient
+* @param Sx wind exposure coefficient
+* @param VW wind speed grid
+* @param grid 2D array of wind speed to fill
+*/
+void Interpol2D::WinstralDrift(const Grid2DObject& Sx, const Grid2DObject& VW, Grid2DObject& grid)
+{
 	for (size_t ii=0; ii<Sx.size(); ii++) {
 		const double sx = Sx(ii);
 		double &val = grid(ii);
@@ -917,6 +1079,210 @@ void Interpol2D::WinstralDrift(const DEMObject& dem, const Grid2DObject& DW, con
 	}
 }
 
+const double WinstralSxCache::sector_width = 5.;
+const size_t WinstralSxCache::default_max_sectors = 24;
+
+WinstralSxCache::WinstralSxCache(const double& i_dmax)
+               : sectors(), computed(), last_used(), dem_ref(), dmax(i_dmax), max_sectors(default_max_sectors), nr_cached(0), use_counter(0)
+{
+	const size_t nr_sectors = static_cast<size_t>( Optim::round(360. / sector_width) );
+	sectors.resize( nr_sectors );
+	computed.resize( nr_sectors, false );
+	last_used.resize( nr_sectors, 0 );
+}
+
+void WinstralSxCache::setDmax(const double& i_dmax)
+{
+	if (i_dmax==dmax) return;
+	dmax = i_dmax;
+	clear();
+}
+
+/**
+* @brief Set how many sectors can be kept in memory at once
+* @param i_max_sectors maximum number of cached sectors (at least 2, so the two sectors around a bearing can be blended)
+*/
+void WinstralSxCache::setMaxSectors(const size_t& i_max_sectors)
+{
+	if (i_max_sectors<2) throw InvalidArgumentException("The Winstral Sx cache must be able to hold at least 2 sectors", AT);
+	max_sectors = i_max_sectors;
+	
+	while (nr_cached>max_sectors) dropOldestSector();
+}
+
+//drop the least recently used sector from the cache
+void WinstralSxCache::dropOldestSector()
+{
+	size_t oldest = IOUtils::npos;
+	for (size_t idx=0; idx<sectors.size(); idx++) {
+		if (computed[idx] && (oldest==IOUtils::npos || last_used[idx]<last_used[oldest])) oldest = idx;
+	}
+	if (oldest==IOUtils::npos) return;
+	
+	sectors[oldest].grid2D.clear();
+	computed[oldest] = false;
+	nr_cached--;
+}
+
+void WinstralSxCache::clear()
+{
+	for (size_t ii=0; ii<sectors.size(); ii++) {
+		sectors[ii].grid2D.clear();
+		computed[ii] = false;
+	}
+	nr_cached = 0;
+	dem_ref.grid2D.clear();
+}
+
+void WinstralSxCache::checkDEM(const DEMObject& dem)
+{
+	if (dem_ref.isSameGeolocalization(dem) && dem_ref.grid2D==dem.grid2D) return;
+
+	clear();
+	dem_ref = dem;
+}
+
+const Grid2DObject& WinstralSxCache::getSector(const DEMObject& dem, const size_t& idx, const unsigned int& nb_threads)
+{
+	last_used[idx] = ++use_counter;
+	if (computed[idx]) return sectors[idx];
+	
+	if (nr_cached>=max_sectors) dropOldestSector(); //make room for the new sector
+	
+	Interpol2D::WinstralSX(dem, dmax, static_cast<double>(idx)*sector_width, sectors[idx], nb_threads);
+	computed[idx] = true;
+	nr_cached++;
+	return sectors[idx];
+}
+
+/**
+* @brief Find the two cached sectors that surround a given bearing
+* @param bearing wind direction (in degrees)
+* @param idx1 index of the sector just before (or at) the bearing
+* @param idx2 index of the next sector
+* @param weight weight of the sector idx2 in the blend (0 if the bearing falls exactly on sector idx1)
+*/
+void WinstralSxCache::getSectors(const double& bearing, size_t& idx1, size_t& idx2, double& weight) const
+{
+	double norm_bearing = fmod(bearing, 360.);
+	if (norm_bearing<0.) norm_bearing += 360.;
+	const double pos = norm_bearing / sector_width;
+	const double lower = floor(pos);
+	weight = pos - lower;
+	idx1 = static_cast<size_t>(lower) % sectors.size();
+	idx2 = (idx1+1) % sectors.size();
+}
+
+/**
+* @brief Get the Sx wind exposure coefficient for one bearing
+* For a bearing that is a multiple of sector_width, this is identical to Interpol2D::WinstralSX, otherwise
+* the Sx grids of the two surrounding sectors are linearly blended.
+* @param dem digital elevation model
+* @param bearing wind direction to consider (if nodata, Sx is filled with nodata)
+* @param Sx wind exposure coefficient grid to fill
+* @param nb_threads number of threads to compute the missing sectors (only if compiled with OpenMP)
+*/
+void WinstralSxCache::getSx(const DEMObject& dem, const double& bearing, Grid2DObject& Sx, const unsigned int& nb_threads)
+{
+	checkDEM(dem);
+	if (bearing==IOUtils::nodata) {
+		Sx.set(dem, IOUtils::nodata);
+		return;
+	}
+
+	size_t idx1, idx2;
+	double weight;
+	getSectors(bearing, idx1, idx2, weight);
+	Sx = getSector(dem, idx1, nb_threads);
+	if (weight==0.) return;
+
+	const Grid2DObject& Sx2 = getSector(dem, idx2, nb_threads);
+	for (size_t ii=0; ii<Sx.size(); ii++) {
+		if (Sx(ii)==IOUtils::nodata) continue;
+		Sx(ii) = (1.-weight)*Sx(ii) + weight*Sx2(ii);
+	}
+}
+
+/**
+* @brief Get the Sx wind exposure coefficient for a wind direction field
+* Each cell gets the blend of the two sectors that surround its own wind direction. Only the sectors
+* that appear in DW are computed. If DW needs more sectors than the cache can hold, the sectors that are
+* not cached are computed one at a time and only kept while their cells are blended, so Sx does not
+* depend on the cache size.
+* @param dem digital elevation model
+* @param DW wind direction grid (the cells where it is nodata get a nodata Sx)
+* @param Sx wind exposure coefficient grid to fill
+* @param nb_threads number of threads to compute the missing sectors (only if compiled with OpenMP)
+*/
+void WinstralSxCache::getSx(const DEMObject& dem, const Grid2DObject& DW, Grid2DObject& Sx, const unsigned int& nb_threads)
+{
+	if (!DW.isSameGeolocalization(dem)){
+		throw IOException("Requested grid DW doesn't match the geolocalization of the DEM", AT);
+	}
+	checkDEM(dem);
+
+	//make sure that all the necessary sectors are available
+	std::vector<bool> needed(sectors.size(), false);
+	for (size_t ii=0; ii<DW.size(); ii++) {
+		if (DW(ii)==IOUtils::nodata || dem(ii)==IOUtils::nodata) continue;
+		size_t idx1, idx2;
+		double weight;
+		getSectors(DW(ii), idx1, idx2, weight);
+		needed[idx1] = true;
+		if (weight>0.) needed[idx2] = true;
+	}
+	const size_t nr_needed = static_cast<size_t>( std::count(needed.begin(), needed.end(), true) );
+	if (nr_needed>max_sectors) {
+		getSxTransient(dem, DW, needed, Sx, nb_threads);
+		return;
+	}
+	//the needed sectors that are already cached are marked as used first, so they are not dropped to make room for the others
+	for (size_t idx=0; idx<sectors.size(); idx++) {
+		if (needed[idx] && computed[idx]) last_used[idx] = ++use_counter;
+	}
+	for (size_t idx=0; idx<sectors.size(); idx++) {
+		if (needed[idx]) getSector(dem, idx, nb_threads);
+	}
+
+	Sx.set(dem, IOUtils::nodata);
+	for (size_t ii=0; ii<Sx.size(); ii++) {
+		if (DW(ii)==IOUtils::nodata || dem(ii)==IOUtils::nodata) continue;
+		size_t idx1, idx2;
+		double weight;
+		getSectors(DW(ii), idx1, idx2, weight);
+		const double sx1 = sectors[idx1](ii);
+		Sx(ii) = (weight==0.)? sx1 : (1.-weight)*sx1 + weight*sectors[idx2](ii);
+	}
+}
+
+//same blend as getSx() but without caching the sectors: each needed sector contributes its share to the cells
+//that use it, the sectors that are not in the cache are computed transiently
+void WinstralSxCache::getSxTransient(const DEMObject& dem, const Grid2DObject& DW, const std::vector<bool>& needed, Grid2DObject& Sx, const unsigned int& nb_threads) const
+{
+	Sx.set(dem, IOUtils::nodata);
+	std::vector<bool> has_share(Sx.size(), false);
+	Grid2DObject transient;
+	for (size_t idx=0; idx<sectors.size(); idx++) {
+		if (!needed[idx]) continue;
+		if (!computed[idx]) Interpol2D::WinstralSX(dem, dmax, static_cast<double>(idx)*sector_width, transient, nb_threads);
+		const Grid2DObject& sector = (computed[idx])? sectors[idx] : transient;
+
+		for (size_t ii=0; ii<Sx.size(); ii++) {
+			if (DW(ii)==IOUtils::nodata || dem(ii)==IOUtils::nodata) continue;
+			size_t idx1, idx2;
+			double weight;
+			getSectors(DW(ii), idx1, idx2, weight);
+			double share;
+			if (idx1==idx) share = (weight==0.)? sector(ii) : (1.-weight)*sector(ii);
+			else if (idx2==idx && weight>0.) share = weight*sector(ii);
+			else continue;
+
+			Sx(ii) = (has_share[ii])? Sx(ii) + share : share;
+			has_share[ii] = true;
+		}
+	}
+}
+
 /**
 * @brief Ordinary Kriging matrix formulation
 * This implements the matrix formulation of Ordinary Kriging, as shown (for example) in
@@ -969,14 +1335,19 @@ void Interpol2D::WinstralDrift(const DEMObject& dem, const Grid2DObject& DW, con
 * \f]
 * where \f$X_i\f$ is the value measured at station i.
 *
+* Since \f$\mathbf{\Gamma_0}\f$ is symmetric, this is also \f$\mathbf{X^*} = (\mathbf{\Gamma_0^{-1}} \cdot \mathbf{X}) \cdot \mathbf{\gamma^*}\f$ (with a zero
+* appended to \f$\mathbf{X}\f$ for the Lagrange multiplier): the linear system is solved only once per grid and each cell only requires
+* the evaluation of its covariances and a dot product.
+*
 * @param vecData vector containing the values as measured at the stations
 * @param vecStations vector of stations
 * @param dem digital elevation model
 * @param variogram variogram regression model
 * @param grid 2D array of precipitation to fill
+* @param nb_threads number of threads to fill the grid (only if compiled with OpenMP). The grid is split into tiles of rows, the results do not depend on it.
 * @author Mathias Bavay
 */
-void Interpol2D::ODKriging(const std::vector<double>& vecData, const std::vector<StationData>& vecStations, const DEMObject& dem, const Fit1D& variogram, Grid2DObject& grid)
+void Interpol2D::ODKriging(const std::vector<double>& vecData, const std::vector<StationData>& vecStations, const DEMObject& dem, const Fit1D& variogram, Grid2DObject& grid, const unsigned int& nb_threads)
 {
 	//if all data points are zero, simply fill the grid with zeroes
 	if (allZeroes(vecData)) {
@@ -995,9 +1366,9 @@ void Interpol2D::ODKriging(const std::vector<double>& vecData, const std::vector
 	const double llcorner_y = dem.llcorner.getNorthing();
 	const double cellsize = dem.cellsize;
 
-	Matrix Ginv(nrOfMeasurments+1, nrOfMeasurments+1);
+	Matrix G(nrOfMeasurments+1, nrOfMeasurments+1);
 
-	//fill the Ginv matrix
+	//fill the G matrix
 	for (size_t j=1; j<=nrOfMeasurments; j++) {
 		const Coords& st1 = vecStations[j-1].position;
 		const double x1 = st1.getEasting();
@@ -1009,52 +1380,61 @@ void Interpol2D::ODKriging(const std::vector<double>& vecData, const std::vector
 			const double DX = x1-st2.getEasting();
 			const double DY = y1-st2.getNorthing();
 			const double distance = Optim::fastSqrt_Q3(DX*DX + DY*DY);
-			Ginv(i,j) = variogram.f(distance);
+			G(i,j) = variogram.f(distance);
 		}
-		Ginv(j,j)=1.; //HACK diagonal should contain the nugget...
-		Ginv(nrOfMeasurments+1,j) = 1.; //last line filled with 1s
+		G(j,j)=1.; //HACK diagonal should contain the nugget...
+		G(nrOfMeasurments+1,j) = 1.; //last line filled with 1s
 	}
 	//fill the upper half (an exact copy of the lower half)
 	for (size_t j=1; j<=nrOfMeasurments; j++) {
 		for (size_t i=j+1; i<=nrOfMeasurments; i++) {
-			Ginv(i,j) = Ginv(j,i);
+			G(i,j) = G(j,i);
 		}
 	}
 	//add last column of 1's and a zero
-	for (size_t i=1; i<=nrOfMeasurments; i++) Ginv(i,nrOfMeasurments+1) = 1.;
-	Ginv(nrOfMeasurments+1,nrOfMeasurments+1) = 0.;
-	//invert the matrix
-	Ginv.inv();
+	for (size_t i=1; i<=nrOfMeasurments; i++) G(i,nrOfMeasurments+1) = 1.;
+	G(nrOfMeasurments+1,nrOfMeasurments+1) = 0.;
+
+	//Since G is symmetric, X* = X·lambda = X·(G^-1·gamma*) = (G^-1·X)·gamma*. So the system is solved once
+	//for the whole grid and each cell only needs the dot product of these weights with its own gamma*
+	Matrix B(nrOfMeasurments+1, (size_t)1);
+	for (size_t st=0; st<nrOfMeasurments; st++) B(st+1,1) = vecData[st]; //matrix starts at 1, not 0
+	B(nrOfMeasurments+1,1) = 0.;
+	Matrix W;
+	if (!Matrix::solve(G, B, W))
+		throw IOException("The kriging matrix can not be inverted", AT);
+
+	std::vector<double> weights(nrOfMeasurments), vecEastings, vecNorthings;
+	for (size_t st=0; st<nrOfMeasurments; st++) weights[st] = W(st+1,1);
+	const double weight_mu = W(nrOfMeasurments+1,1); //the last value of gamma* is always 1
+	buildPositionsVectors(vecStations, vecEastings, vecNorthings);
 
-	Matrix G0(nrOfMeasurments+1, (size_t)1);
 	//now, calculate each point
-	for (size_t j=0; j<grid.getNy(); j++) {
-		for (size_t i=0; i<grid.getNx(); i++) {
-			if (dem(i,j)==IOUtils::nodata) continue;
-				
-			const double x = llcorner_x+static_cast<double>(i)*cellsize;
-			const double y = llcorner_y+static_cast<double>(j)*cellsize;
-
-			//fill gamma
-			for (size_t st=0; st<nrOfMeasurments; st++) {
-				//compute distance between cell and each station
-				const Coords& position = vecStations[st].position;
-				const double DX = x-position.getEasting();
-				const double DY = y-position.getNorthing();
-				const double distance = Optim::fastSqrt_Q3(DX*DX + DY*DY);
-
-				G0(st+1,1) = variogram.f(distance); //matrix starts at 1, not 0
-			}
-			G0(nrOfMeasurments+1,1) = 1.; //last value is always 1
-
-			const Matrix lambda = Ginv*G0;
+	const size_t ncols = grid.getNx(), nrows = grid.getNy();
+	#pragma omp parallel num_threads(nb_threads)
+	{
+		std::vector<double> gamma(nrOfMeasurments); //one per thread, reused for all cells
+		#pragma omp for schedule(dynamic, tile_rows)
+		for (size_t j=0; j<nrows; j++) {
+			for (size_t i=0; i<ncols; i++) {
+				if (dem(i,j)==IOUtils::nodata) continue;
+
+				const double x = llcorner_x+static_cast<double>(i)*cellsize;
+				const double y = llcorner_y+static_cast<double>(j)*cellsize;
+
+				//compute distance between cell and each station, then the covariances
+				for (size_t st=0; st<nrOfMeasurments; st++) {
+					const double DX = x-vecEastings[st];
+					const double DY = y-vecNorthings[st];
+					gamma[st] = Optim::fastSqrt_Q3(DX*DX + DY*DY);
+				}
+				for (size_t st=0; st<nrOfMeasurments; st++) gamma[st] = variogram.f(gamma[st]);
 
-			//calculate local parameter interpolation
-			double p = 0.;
-			for (size_t st=0; st<nrOfMeasurments; st++) {
-				p += lambda(st+1,1) * vecData[st]; //matrix starts at 1, not 0
+				//calculate local parameter interpolation
+				double p = weight_mu;
+				for (size_t st=0; st<nrOfMeasurments; st++) p += weights[st] * gamma[st];
+				grid(i,j) = p;
 			}
-			grid(i,j) = p;
 		}
 	}
 }
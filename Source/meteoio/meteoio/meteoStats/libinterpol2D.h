@@ -53,23 +53,28 @@ class Interpol2D {
 		static void stdPressure(const DEMObject& dem, Grid2DObject& grid);
 		static void constant(const double& value, const DEMObject& dem, Grid2DObject& grid);
 		static void IDW(const std::vector<double>& vecData_in, const std::vector<StationData>& vecStations_in,
-                                const DEMObject& dem, Grid2DObject& grid, const double& scale, const double& alpha=1.);
+                                const DEMObject& dem, Grid2DObject& grid, const double& scale, const double& alpha=1., const unsigned int& nb_threads=1);
 		static void LocalLapseIDW(const std::vector<double>& vecData_in,
 		                          const std::vector<StationData>& vecStations_in,
 		                          const DEMObject& dem, const size_t& nrOfNeighbors,
-		                          Grid2DObject& grid, const double& scale, const double& alpha=1.);
+		                          Grid2DObject& grid, const double& scale, const double& alpha=1., const unsigned int& nb_threads=1);
 		static void ListonWind(const DEMObject& i_dem, Grid2DObject& VW, Grid2DObject& DW);
 		static void CurvatureCorrection(DEMObject& dem, const Grid2DObject& ta, Grid2DObject& grid);
 		static void SteepSlopeRedistribution(const DEMObject& dem, const Grid2DObject& ta, Grid2DObject& grid);
 		static void PrecipSnow(const DEMObject& dem, const Grid2DObject& ta, Grid2DObject& grid);
 		static void ODKriging(const std::vector<double>& vecData,
 		                      const std::vector<StationData>& vecStations,
-		                      const DEMObject& dem, const Fit1D& variogram, Grid2DObject& grid);
+		                      const DEMObject& dem, const Fit1D& variogram, Grid2DObject& grid, const unsigned int& nb_threads=1);
 
 		static void RyanWind(const DEMObject& dem, Grid2DObject& VW, Grid2DObject& DW);
-		static void Winstral(const DEMObject& dem, const Grid2DObject& TA, const double& dmax, const double& in_bearing, Grid2DObject& grid);
-		static void Winstral(const DEMObject& dem, const Grid2DObject& TA, const Grid2DObject& DW, const Grid2DObject& VW, const double& dmax, Grid2DObject& grid);
-		static void WinstralDrift(const DEMObject& dem, const Grid2DObject& DW, const Grid2DObject& VW, const double& dmax, Grid2DObject& grid);
+		static void Winstral(const DEMObject& dem, const Grid2DObject& TA, const double& dmax, const double& in_bearing, Grid2DObject& grid, const unsigned int& nb_threads=1);
+		static void Winstral(const DEMObject& dem, const Grid2DObject& TA, const Grid2DObject& DW, const Grid2DObject& VW, const double& dmax, Grid2DObject& grid, const unsigned int& nb_threads=1);
+		static void WinstralDrift(const DEMObject& dem, const Grid2DObject& DW, const Grid2DObject& VW, const double& dmax, Grid2DObject& grid, const unsigned int& nb_threads=1);
+		static void Winstral(Grid2DObject& Sx, const Grid2DObject& TA, Grid2DObject& grid);
+		static void Winstral(Grid2DObject& Sx, const Grid2DObject& TA, const Grid2DObject& VW, Grid2DObject& grid);
+		static void WinstralDrift(const Grid2DObject& Sx, const Grid2DObject& VW, Grid2DObject& grid);
+		static void WinstralSX(const DEMObject& dem, const double& dmax, const double& in_bearing, Grid2DObject& grid, const unsigned int& nb_threads=1);
+		static void WinstralSX(const DEMObject& dem, const double& dmax, const Grid2DObject& DW, Grid2DObject& grid, const unsigned int& nb_threads=1);
 
 		static bool allZeroes(const std::vector<double>& vecData);
 
@@ -80,27 +85,22 @@ class Interpol2D {
 		static double HorizontalDistance(const double& X1, const double& Y1, const double& X2, const double& Y2);
 		static double HorizontalDistance(const DEMObject& dem, const int& i, const int& j,
 		                                 const double& X2, const double& Y2);
-		static void getNeighbors(const double& x, const double& y,
-		                         const std::vector<StationData>& vecStations,
-		                         std::vector< std::pair<double, size_t> >& list);
 		static void buildPositionsVectors(const std::vector<StationData>& vecStations,
 		                                  std::vector<double>& vecEastings, std::vector<double>& vecNorthings);
 
 		//core methods
 		static double IDWCore(const double& x, const double& y,
 		                      const std::vector<double>& vecData_in,
-		                      const std::vector<double>& vecEastings, const std::vector<double>& vecNorthings, const double& scale, const double& alpha=1.);
+		                      const std::vector<double>& vecEastings, const std::vector<double>& vecNorthings,
+		                      const double& scale, const double& alpha, std::vector<double>& weights);
 		static double IDWCore(const std::vector<double>& vecData_in, const std::vector<double>& vecDistance_sq, const double& scale, const double& alpha=1.);
-		static double LLIDW_pixel(const size_t& i, const size_t& j,
-		                          const std::vector<double>& vecData_in,
-		                          const std::vector<StationData>& vecStations_in,
-		                          const DEMObject& dem, const size_t& nrOfNeighbors, const double& scale, const double& alpha=1.);
+		static double LLIDW_pixel(const double& cell_altitude, const std::vector< std::pair<double, size_t> >& neighbors,
+		                          const std::vector<double>& vecData_in, const std::vector<double>& vecAltitudes,
+		                          const double& scale, const double& alpha,
+		                          std::vector<size_t>& trend_stations, Fit1D& trend, std::vector<double>& residuals);
 
 		static void steepestDescentDisplacement(const DEMObject& dem, const Grid2DObject& grid, const size_t& ii, const size_t& jj, char &d_i_dest, char &d_j_dest);
 		static double depositAroundCell(const DEMObject& dem, const size_t& ii, const size_t& jj, const double& precip, Grid2DObject &grid);
-		
-		static void WinstralSX(const DEMObject& dem, const double& dmax, const double& in_bearing, Grid2DObject& grid);
-		static void WinstralSX(const DEMObject& dem, const double& dmax, const Grid2DObject& DW, Grid2DObject& grid);
 
 		//weighting methods
 		static double weightInvDist(const double& d2);
@@ -110,6 +110,48 @@ class Interpol2D {
 		double dist_pow; //power for the weighting method weightInvDistN
 };
 
+/**
+ * @class WinstralSxCache
+ * @brief Memoized Winstral Sx wind exposure grids for a given DEM and search radius.
+ * The Sx grid is computed (with Interpol2D::WinstralSX) once for each wind sector of sector_width degrees
+ * that is actually requested and then kept as long as the DEM does not change. A wind bearing that falls
+ * between two sectors gets the linear blend of the Sx grids of these two sectors, so the cost of a time step
+ * is proportional to the number of cells instead of the number of cells times the search radius.
+ *
+ * @remarks Each cached sector takes as much memory as the DEM itself, so at most max_sectors sectors are kept
+ * (the least recently used sectors are dropped first). If the DEM changes (for example because the snow height
+ * has been added to it), the cache is flushed. If a wind direction field needs more sectors than that, the missing
+ * sectors are computed again for this field only, which gives the same Sx but is slower.
+ * @ingroup stats
+ */
+class WinstralSxCache {
+	public:
+		WinstralSxCache(const double& i_dmax=300.);
+
+		void setDmax(const double& i_dmax);
+		void setMaxSectors(const size_t& i_max_sectors);
+		void getSx(const DEMObject& dem, const double& bearing, Grid2DObject& Sx, const unsigned int& nb_threads=1);
+		void getSx(const DEMObject& dem, const Grid2DObject& DW, Grid2DObject& Sx, const unsigned int& nb_threads=1);
+		void clear();
+
+		static const double sector_width; ///< angular step between two cached bearings, in degrees
+		static const size_t default_max_sectors; ///< default maximum number of cached sectors
+
+	private:
+		void checkDEM(const DEMObject& dem);
+		void dropOldestSector();
+		const Grid2DObject& getSector(const DEMObject& dem, const size_t& idx, const unsigned int& nb_threads);
+		void getSectors(const double& bearing, size_t& idx1, size_t& idx2, double& weight) const;
+		void getSxTransient(const DEMObject& dem, const Grid2DObject& DW, const std::vector<bool>& needed, Grid2DObject& Sx, const unsigned int& nb_threads) const;
+
+		std::vector<Grid2DObject> sectors;
+		std::vector<bool> computed;
+		std::vector<size_t> last_used; ///< for each sector, the value of use_counter when it was last used
+		Grid2DObject dem_ref; ///< the DEM that the cached sectors have been computed for
+		double dmax;
+		size_t max_sectors, nr_cached, use_counter;
+};
+
 } //end namespace
 
 #endif
@@ -19,7 +19,10 @@
 #include <meteoio/plugins/CsvIO.h>
 
 #include <algorithm>
+#include <cctype>
+#include <cmath>
 #include <fstream>
+#include <iomanip>
 #include <cstdio>
 #include <cstring>
 #include <utility>
@@ -57,6 +60,9 @@ namespace mio {
  * - CSV_FILE_EXTENSION: When scanning the whole directory, look for these files (default: .csv). Note that this matching isn't restricted to the end of the file name so if you had files stat1_jan.csv, stat1_feb.csv and stat2_jan.csv you could select January's data by putting "_jan" here;
  * - CSV_SILENT_ERRORS: if set to true, lines that can not be read will be silently ignored (default: false, has priority over CSV_ERRORS_TO_NODATA);
  * - CSV_ERRORS_TO_NODATA: if true, unparseable fields (like text fields) are set to nodata, but the rest of the line is kept (default: false).
+ * - CSV_INDEX_PATH: directory where to keep an index of the file positions of each input file, so that the next runs can directly jump to the
+ * requested dates instead of reading the files from their beginning. An index is only used as long as its file is unchanged (or has only been appended to)
+ * and is read with the same date/time parsing settings. This should not be the METEOPATH directory itself (default: empty, the indexes are then only kept in memory).
  * 
  * You can now describe the specific format for all files (prefixing the following keys by \em "CSV_") or for each particular file (prefixing the following 
  * keys by \em "CSV#_" where \em "#" represents the station index). Of course, you can mix keys that are defined for all files with some keys only defined for a 
@@ -318,6 +324,48 @@ CTION, WD; RELATIVE_HUMIDITY, RELATIVEHUMIDITY; WIND_VELOCITY, WS; PRESSURE, STA
 //helper function to sort the static keys used for specifying the date/time formats
 inline bool sort_dateKeys(const std::pair<size_t,size_t> &left, const std::pair<size_t,size_t> &right) { return left.first < right.first;}
 
+//split a line into the same fields as IOUtils::readLineToVec() (on the delimiter or on whitespaces), but reusing the strings
+//already present in vecFields, so no memory has to be allocated once the first lines have been read
+static size_t splitLine(const std::string& line, std::vector<std::string>& vecFields, const char& delim, const bool& delimIsNoWS)
+{
+	const char* pos = line.c_str();
+	const char* const end = pos + line.size();
+	size_t nr_fields = 0;
+	
+	while (pos<end) {
+		if (!delimIsNoWS) {
+			while (pos<end && isspace(static_cast<unsigned char>(*pos))) pos++;
+			if (pos==end) break;
+		}
+		const char* const field_start = pos;
+		if (delimIsNoWS) {
+			while (pos<end && *pos!=delim) pos++;
+		} else {
+			while (pos<end && !isspace(static_cast<unsigned char>(*pos))) pos++;
+		}
+		
+		if (nr_fields==vecFields.size()) vecFields.push_back( std::string() );
+		vecFields[nr_fields++].assign(field_start, pos);
+		if (delimIsNoWS && pos<end) {
+			pos++; //skip the delimiter
+			if (pos==end) { //a trailing delimiter leaves an empty field
+				if (nr_fields==vecFields.size()) vecFields.push_back( std::string() );
+				vecFields[nr_fields++].clear();
+			}
+		}
+	}
+	
+	vecFields.resize( nr_fields );
+	return nr_fields;
+}
+
+//same as IOUtils::convertString() for a double, with a fast path for plain decimal numbers
+static bool parseValue(const std::string& str, double& value)
+{
+	if (IOUtils::convertDecimal(str.c_str(), str.c_str()+str.size(), value)) return true;
+	return IOUtils::convertString(value, str);
+}
+
 void CsvDateTime::updateMaxCol() 
 {
 	if (decimal_date!=IOUtils::npos && decimal_date>max_dt_col) max_dt_col=decimal_date;
@@ -810,7 +858,7 @@ void CsvParameters::setFile(const std::string& i_file_and_path, const std::vecto
 				continue;
 			}
 			
-			const size_t nr_curr_data_fields = (delimIsNoWS)? IOUtils::readLineToVec(line, tmp_vec, csv_delim) : IOUtils::readLineToVec(line, tmp_vec);
+			const size_t nr_curr_data_fields = splitLine(line, tmp_vec, csv_delim, delimIsNoWS);
 			if (nr_curr_data_fields>date_cols.max_dt_col) {
 				const Date dt( parseDate(tmp_vec) );
 				if (dt.isUndef()) continue;
@@ -869,6 +917,61 @@ void CsvParameters::checkSpecString(const std::string& spec_string, const size_t
 		throw InvalidFormatException("Badly formatted date/time specification '"+spec_string+"': argument appearing twice or using '%%'", AT);
 }
 
+//compile a scanf() format built by setDateTimeSpec() or setTimeSpec(), so scanFormat() can use it
+//(an empty vector is returned for formats that must be left to scanf(), such as formats containing a time zone)
+std::vector<CsvParameters::format_item> CsvParameters::compileFormat(const std::string& format)
+{
+	std::vector<format_item> items;
+	for (size_t ii=0; ii<format.size(); ii++) {
+		if (format[ii]!='%') {
+			items.push_back( format_item(format[ii], 0) );
+			continue;
+		}
+		
+		size_t width = 0;
+		for (ii++; ii<format.size() && isdigit(static_cast<unsigned char>(format[ii])); ii++)
+			width = width*10 + static_cast<size_t>(format[ii]-'0');
+		if (ii==format.size() || format[ii]!='f') return std::vector<format_item>();
+		items.push_back( format_item('\0', (width>0)? width : IOUtils::npos) );
+	}
+	
+	return items;
+}
+
+//parse a date/time string with a compiled format, only handling the numerical fields that are plain integers
+//it returns false as soon as scanf() could behave differently (signs, decimals, exponents, etc) so scanf() can then be called
+bool CsvParameters::scanFormat(const std::string& str, const std::vector<format_item>& items, const std::vector<size_t>& idx, const size_t& offset, float *args)
+{
+	if (items.empty()) return false;
+	
+	const char* pos = str.c_str();
+	size_t field = 0;
+	for (size_t ii=0; ii<items.size(); ii++) {
+		if (items[ii].width==0) {
+			if (isspace(static_cast<unsigned char>(items[ii].literal))) { //as for scanf(), any number of whitespaces (including none)
+				while (isspace(static_cast<unsigned char>(*pos))) pos++;
+			} else {
+				if (*pos!=items[ii].literal) return false;
+				pos++;
+			}
+			continue;
+		}
+		
+		const char* const field_start = pos;
+		unsigned int value = 0;
+		while (*pos>='0' && *pos<='9' && static_cast<size_t>(pos-field_start)<items[ii].width) {
+			value = value*10 + static_cast<unsigned int>(*pos++ - '0');
+		}
+		const size_t nr_digits = static_cast<size_t>(pos - field_start);
+		if (nr_digits==0 || nr_digits>7) return false; //not a plain integer or too many digits to be exact as float
+		if (nr_digits<items[ii].width && (*pos=='.' || *pos=='e' || *pos=='E' || *pos=='x' || *pos=='X')) return false; //scanf() would read further
+		if (field>=idx.size()) return false;
+		args[ idx[field++]+offset ] = static_cast<float>(value);
+	}
+	
+	return (field==idx.size());
+}
+
 //from a SPEC string such as "DD.MM.YYYY HH24:MIN:SS", build the format string for scanf as well as the parameters indices
 //the indices are based on ISO timestamp, so year=0, month=1, ..., ss=5 while tz is handled separately
 void CsvParameters::setDateTimeSpec(const std::string& datetime_spec)
@@ -903,6 +1006,7 @@ void CsvParameters::setDateTimeSpec(const std::string& datetime_spec)
 	
 	const size_t nr_params_check = (has_tz)? datetime_idx.size()+1 : datetime_idx.size();
 	checkSpecString(datetime_format, nr_params_check);
+	datetime_items = compileFormat(datetime_format);
 }
 
 void CsvParameters::setTimeSpec(const std::string& time_spec)
@@ -935,6 +1039,7 @@ void CsvParameters::setTimeSpec(const std::string& time_spec)
 
 	const size_t nr_params_check = (has_tz)? time_idx.size()+1 : time_idx.size();
 	checkSpecString(time_format, nr_params_check);
+	time_items = compileFormat(time_format);
 }
 
 void CsvParameters::setDecimalDateType(std::string decimaldate_type)
@@ -980,8 +1085,9 @@ Date CsvParameters::parseDate(const std::string& date_str, const std::string& ti
 {
 	float args[6] = {0., 0., 0., 0., 0., 0.};
 	char rest[32] = "";
-	bool status = false;
-	switch( datetime_idx.size() ) {
+	//the compiled format handles plain numerical dates, scanf() is only called for the other cases
+	bool status = (datetime_idx.size()>=3 && scanFormat(date_str, datetime_items, datetime_idx, 0, args));
+	if (!status) switch( datetime_idx.size() ) {
 		case 6:
 			status = (sscanf(date_str.c_str(), datetime_format.c_str(), &args[ datetime_idx[0] ], &args[ datetime_idx[1] ], &args[ datetime_idx[2] ], &args[ datetime_idx[3] ], &args[ datetime_idx[4] ], &args[ datetime_idx[5] ], rest)>=6);
 			break;
@@ -1001,7 +1107,8 @@ Date CsvParameters::parseDate(const std::string& date_str, const std::string& ti
 
 	if (!time_idx.empty()) {
 		//there is a +3 offset because the first 3 positions are used by the date part
-		switch( time_idx.size() ) {
+		status = scanFormat(time_str, time_items, time_idx, 3, args);
+		if (!status) switch( time_idx.size() ) {
 			case 3:
 				status = (sscanf(time_str.c_str(), time_format.c_str(), &args[ time_idx[0]+3 ], &args[ time_idx[1]+3 ], &args[ time_idx[2]+3 ], rest)>=3);
 				break;
@@ -1035,8 +1142,8 @@ Date CsvParameters::parseJdnDate(const std::vector<std::string>& vecFields)
 		const std::string time_str( vecFields[ date_cols.time_str ] );
 		float args[3] = {0., 0., 0.};
 		char rest[32] = "";
-		bool status = false;
-		switch( time_idx.size() ) {
+		bool status = scanFormat(time_str, time_items, time_idx, 0, args);
+		if (!status) switch( time_idx.size() ) {
 			case 3:
 				status = (sscanf(time_str.c_str(), time_format.c_str(), &args[ time_idx[0] ], &args[ time_idx[1] ], &args[ time_idx[2] ], rest)>=3);
 				break;
@@ -1171,6 +1278,15 @@ Date CsvParameters::parseDate(const std::vector<std::string>& vecFields)
 	}
 }
 
+//everything that has an influence on the dates that are associated with the file positions in the file index
+std::string CsvParameters::getDateSpecs() const
+{
+	std::ostringstream os;
+	os << datetime_format << "|" << time_format << "|" << date_cols.toString() << "|" << date_cols.year_cst << "|" << date_cols.decimal_date_type;
+	os << "|" << std::setprecision(12) << csv_tz << "|" << csv_delim << "|" << comments_mk << "|" << purgeQuotes << "|" << filter_ID << "|" << ID_col;
+	return os.str();
+}
+
 StationData CsvParameters::getStation() const 
 {
 	StationData sd(location, id, name);
@@ -1185,11 +1301,11 @@ const size_t CsvIO::streampos_every_n_lines = 2000; //save streampos every 2000
 
 CsvIO::CsvIO(const std::string& configfile) 
       : cfg(configfile), indexer_map(), csvparam(), vecStations(),
-        coordin(), coordinparam(), silent_errors(false), errors_to_nodata(false) { parseInputOutputSection(); }
+        coordin(), coordinparam(), index_path(), silent_errors(false), errors_to_nodata(false) { parseInputOutputSection(); }
 
 CsvIO::CsvIO(const Config& cfgreader)
       : cfg(cfgreader), indexer_map(), csvparam(), vecStations(),
-        coordin(), coordinparam(), silent_errors(false), errors_to_nodata(false) { parseInputOutputSection(); }
+        coordin(), coordinparam(), index_path(), silent_errors(false), errors_to_nodata(false) { parseInputOutputSection(); }
 
 void CsvIO::parseInputOutputSection()
 {
@@ -1197,6 +1313,7 @@ void CsvIO::parseInputOutputSection()
 	
 	cfg.getValue("CSV_SILENT_ERRORS", "Input", silent_errors, IOUtils::nothrow);
 	cfg.getValue("CSV_ERRORS_TO_NODATA", "Input", errors_to_nodata, IOUtils::nothrow);
+	cfg.getValue("CSV_INDEX_PATH", "Input", index_path, IOUtils::nothrow);
 
 	const double in_TZ = cfg.get("TIME_ZONE", "Input");
 	const std::string meteopath = cfg.get("METEOPATH", "Input");
@@ -1444,10 +1561,21 @@ std::vector<MeteoData> CsvIO::readCSVFile(CsvParameters& params, const Date& dat
 		ss << " Please check file existence and permissions!";
 		throw AccessException(ss.str(), AT);
 	}
+	fin.seekg(0, std::ios::end);
+	const streampos file_size = fin.tellg();
+	fin.seekg(0, std::ios::beg);
 	
+	//the first time a file is read, try to reuse its persisted index
+	std::map<std::string, FileUtils::FileIndexer>::iterator indexer_it( indexer_map.find(filename) );
+	if (indexer_it==indexer_map.end()) {
+		indexer_it = indexer_map.insert( std::make_pair(filename, FileUtils::FileIndexer()) ).first;
+		if (!index_path.empty()) indexer_it->second.read(FileUtils::FileIndexer::getIndexFilename(index_path, filename), filename, params.getDateSpecs());
+	}
+	FileUtils::FileIndexer& indexer = indexer_it->second;
+
 	std::string line;
 	size_t linenr=0;
-	streampos fpointer = indexer_map[filename].getIndex(dateStart);
+	streampos fpointer = indexer.getIndex(dateStart);
 	if (fpointer!=static_cast<streampos>(-1) && params.asc_order) {
 		fin.seekg(fpointer); //a previous pointer was found, jump to it
 	} else {
@@ -1457,6 +1585,13 @@ std::vector<MeteoData> CsvIO::readCSVFile(CsvParameters& params, const Date& dat
 		linenr += skip_count;
 	}
 	
+	//compile the columns layout: index of each column in the MeteoData objects or npos if it must be skipped
+	std::vector<size_t> param_idx( params.csv_fields.size(), IOUtils::npos );
+	for (size_t ii=0; ii<param_idx.size(); ii++) {
+		if (params.skip_fields.count(ii)>0) continue; //the user has requested this field to be skipped or this is a special field
+		param_idx[ii] = template_md.getParameterIndex( params.csv_fields[ii] );
+	}
+	
 	//and now, read the data and fill the vector vecMeteo
 	std::vector<MeteoData> vecMeteo;
 	std::vector<std::string> tmp_vec;
@@ -1481,7 +1616,7 @@ std::vector<MeteoData> CsvIO::readCSVFile(CsvParameters& params, const Date& dat
 			continue;
 		}
 		
-		const size_t nr_curr_data_fields = (delimIsNoWS)? IOUtils::readLineToVec(line, tmp_vec, params.csv_delim) : IOUtils::readLineToVec(line, tmp_vec);
+		const size_t nr_curr_data_fields = splitLine(line, tmp_vec, params.csv_delim, delimIsNoWS);
 		if (nr_of_data_fields==0) nr_of_data_fields = nr_curr_data_fields;
 		
 		//filter on ID
@@ -1512,7 +1647,7 @@ std::vector<MeteoData> CsvIO::readCSVFile(CsvParameters& params, const Date& dat
 
 		if (linenr % streampos_every_n_lines == 0) {
 			fpointer = fin.tellg();
-			if (fpointer != static_cast<streampos>(-1)) indexer_map[filename].setIndex(dt, fpointer);
+			if (fpointer != static_cast<streampos>(-1)) indexer.setIndex(dt, fpointer);
 		}
 		if (params.asc_order) {
 			if (dt<dateStart) continue;
@@ -1526,17 +1661,17 @@ std::vector<MeteoData> CsvIO::readCSVFile(CsvParameters& params, const Date& dat
 		md.setDate(dt);
 		bool no_errors = true;
 		for (size_t ii=0; ii<tmp_vec.size(); ii++){
-			if (params.skip_fields.count(ii)>0) continue; //the user has requested this field to be skipped or this is a special field
+			if (param_idx[ii]==IOUtils::npos) continue; //the user has requested this field to be skipped or this is a special field
 			if (tmp_vec[ii].empty() || tmp_vec[ii]==nodata || tmp_vec[ii]==nodata_with_quotes || tmp_vec[ii]==nodata_with_single_quotes) //treat empty value as nodata, try nodata marker w/o quotes
 				continue;
 			
 			if (tmp_vec[ii]=="NAN" || tmp_vec[ii]=="NULL") {
-				md( params.csv_fields[ii] ) = IOUtils::nodata;
+				md( param_idx[ii] ) = IOUtils::nodata;
 				continue;
 			}
 			
 			double tmp;
-			if (!IOUtils::convertString(tmp, tmp_vec[ii])) {
+			if (!parseValue(tmp_vec[ii], tmp)) {
 				const std::string err_msg( "Could not parse field '"+tmp_vec[ii]+"' in file \'"+filename+"' at line "+IOUtils::toString(linenr) );
 				if (silent_errors) {
 					std::cerr << err_msg << "\n";
@@ -1548,12 +1683,29 @@ std::vector<MeteoData> CsvIO::readCSVFile(CsvParameters& params, const Date& dat
 			}
 			if (use_multiplier && tmp!=IOUtils::nodata) tmp *= params.units_multiplier[ii];
 			if (use_offset && tmp!=IOUtils::nodata) tmp += params.units_offset[ii];
-			md( params.csv_fields[ii] ) = tmp;
+			md( param_idx[ii] ) = tmp;
+		}
+		if (no_errors) {
+			vecMeteo.push_back( std::move(md) );
+			
+			//once the sampling rate is known, reserve what the requested period needs (but not more than what is left in the file)
+			//since growing the vector means copying all the MeteoData objects read so far
+			if (vecMeteo.size()==2) {
+				const double step = std::abs( vecMeteo[1].date.getJulian(true) - vecMeteo[0].date.getJulian(true) );
+				const streampos curr_pos = fin.tellg();
+				if (step>0. && curr_pos!=static_cast<streampos>(-1) && file_size!=static_cast<streampos>(-1)) {
+					const double nr_in_period = (dateEnd.getJulian(true) - dateStart.getJulian(true)) / step;
+					const double nr_in_file = static_cast<double>(file_size - curr_pos) / static_cast<double>(line.size()+1);
+					const double nr_remaining = std::min(nr_in_period, nr_in_file);
+					if (nr_remaining>0.) vecMeteo.reserve( vecMeteo.size() + static_cast<size_t>(nr_remaining) + 1 );
+				}
+			}
 		}
-		if (no_errors) vecMeteo.push_back( md );
 	}
 
 	if (!params.asc_order) std::reverse(vecMeteo.begin(), vecMeteo.end());
+	if (!index_path.empty() && indexer.isModified())
+		indexer.write(FileUtils::FileIndexer::getIndexFilename(index_path, filename), filename, params.getDateSpecs());
 	
 	return vecMeteo;
 }
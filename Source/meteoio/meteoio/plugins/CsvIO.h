@@ -60,7 +60,7 @@ class CsvDateTime {
 class CsvParameters {
 	public:
 		CsvParameters(const double& tz_in)
-		: csv_fields(), units_offset(), units_multiplier(), skip_fields(), nodata("NAN"), header_repeat_mk(), filter_ID(), ID_col(IOUtils::npos), header_lines(1), columns_headers(IOUtils::npos), units_headers(IOUtils::npos), single_param_idx(IOUtils::npos), csv_delim(','), header_delim(','), eoln('\n'), comments_mk('\n'), header_repeat_at_start(false), asc_order(true), purgeQuotes(false),  location(), datetime_idx(), time_idx(), file_and_path(), datetime_format(), time_format(), single_field(), name(), id(), date_cols(), slope(IOUtils::nodata), azi(IOUtils::nodata), csv_tz(tz_in), has_tz(false), dt_as_components(false), dt_as_year_and_jdn(false), dt_as_decimal(false) {}
+		: csv_fields(), units_offset(), units_multiplier(), skip_fields(), nodata("NAN"), header_repeat_mk(), filter_ID(), ID_col(IOUtils::npos), header_lines(1), columns_headers(IOUtils::npos), units_headers(IOUtils::npos), single_param_idx(IOUtils::npos), csv_delim(','), header_delim(','), eoln('\n'), comments_mk('\n'), header_repeat_at_start(false), asc_order(true), purgeQuotes(false),  location(), datetime_idx(), time_idx(), datetime_items(), time_items(), file_and_path(), datetime_format(), time_format(), single_field(), name(), id(), date_cols(), slope(IOUtils::nodata), azi(IOUtils::nodata), csv_tz(tz_in), has_tz(false), dt_as_components(false), dt_as_year_and_jdn(false), dt_as_decimal(false) {}
 		
 		void setPurgeQuotes(const bool& i_purgeQuotes) {purgeQuotes=i_purgeQuotes;}
 		void setHeaderRepeatMk(const std::string& marker) {header_repeat_mk=marker;}
@@ -77,6 +77,7 @@ class CsvParameters {
 		void setSlope(const double& i_slope, const double& i_azimuth) {slope=i_slope; azi=i_azimuth;}
 		Date parseDate(const std::vector<std::string>& vecFields);
 		std::string getFilename() const {return file_and_path;}
+		std::string getDateSpecs() const;
 		StationData getStation() const;
 		
 		std::vector<std::string> csv_fields;		///< the user provided list of field names
@@ -91,6 +92,13 @@ class CsvParameters {
 		char eoln, comments_mk;
 		bool header_repeat_at_start, asc_order, purgeQuotes;
 	private:
+		///one element of a scanf() date/time format, compiled once so the date/time strings can be parsed without scanf()
+		typedef struct FORMAT_ITEM {
+			FORMAT_ITEM(const char& i_literal, const size_t& i_width) : width(i_width), literal(i_literal) {}
+			size_t width; ///< maximum number of characters of a numerical field (npos if unlimited), 0 for a literal character
+			char literal; ///< the character to match for a literal
+		} format_item;
+		
 		static std::string identifyField(const std::string& fieldname);
 		void assignMetadataVariable(const std::string& field_type, const std::string& field_val, double &lat, double &lon, double &easting, double &northing);
 		void parseFileName(std::string filename, const std::string& filename_spec, double &lat, double &lon, double &easting, double &northing);
@@ -104,10 +112,13 @@ class CsvParameters {
 		Date parseDate(const std::string& date_str, const std::string& time_str) const;
 		Date parseDate(const std::string& value_str, const CsvDateTime::decimal_date_formats& format) const;
 		static void checkSpecString(const std::string& spec_string, const size_t& nr_params);
+		static std::vector<format_item> compileFormat(const std::string& format);
+		static bool scanFormat(const std::string& str, const std::vector<format_item>& items, const std::vector<size_t>& idx, const size_t& offset, float *args);
 		
 		Coords location;
 		std::vector<size_t> datetime_idx;		///< order of the datetime fields for use in parseDate: Year Month Day Hour Minutes Seconds
 		std::vector<size_t> time_idx;		///< order of the time fields for use in parseDate for split date / time
+		std::vector<format_item> datetime_items, time_items;		///< compiled datetime_format and time_format, empty if they must be parsed by scanf()
 		std::string file_and_path, datetime_format, time_format, single_field; 		///< the scanf() format string for use in parseDate, the parameter in case of a single value contained in the Csv file
 		std::string name, id;
 		CsvDateTime date_cols;		///< index of each column containing the a date/time component
@@ -152,6 +163,7 @@ class CsvIO : public IOInterface {
 		std::vector<CsvParameters> csvparam;
 		std::vector<StationData> vecStations;
 		std::string coordin, coordinparam; //projection parameters
+		std::string index_path; ///< where to persist the file indexes (empty to only keep them in memory)
 		static const size_t streampos_every_n_lines; //save current stream pos every n lines of data
 		bool silent_errors; ///< when reading a file, should errors throw or just be ignored?
 		bool errors_to_nodata;    //unparseable values are treated as nodata, but the dataset is kept
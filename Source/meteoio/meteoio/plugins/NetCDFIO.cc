@@ -474,6 +474,48 @@ void NetCDFIO::read2DGrid(Grid2DObject& grid_out, const MeteoGrids::Parameters&
 	}
 }
 
+bool NetCDFIO::read2DGridPoints(std::vector< std::vector<double> >& data, const MeteoGrids::Parameters& parameter, const std::vector<Date>& dates, const std::vector< std::pair<size_t, size_t> >& Pts)
+{
+	if (cache_grid_files.empty()) scanPath(in_grid2d_path, in_nc_ext, cache_grid_files);
+
+	if (cache_grid_files.empty()) {
+		const std::string filename = cfg.get("GRID2DFILE", "Input");
+		if (!FileUtils::fileExists(filename)) throw NotFoundException(filename, AT); //prevent invalid filenames
+		ncFiles file(filename, ncFiles::READ, cfg, in_schema, debug);
+		data = file.read2DGridPoints(parameter, dates, Pts);
+		return true;
+	}
+
+	//as in read2DGrid, each date is read from the first file that contains it
+	data.assign( Pts.size(), std::vector<double>(dates.size(), IOUtils::nodata) );
+	std::vector<bool> done( dates.size(), false );
+	size_t nr_done = 0;
+	for (size_t ii=0; ii<cache_grid_files.size() && nr_done<dates.size(); ii++) {
+		const Date file_start( cache_grid_files[ii].first.first );
+		const Date file_end( cache_grid_files[ii].first.second );
+		const std::set<size_t> params_set( cache_grid_files[ii].second.getParams() );
+		if (params_set.find(parameter) == params_set.end()) continue;
+
+		std::vector<size_t> dates_idx;
+		std::vector<Date> file_dates;
+		for (size_t jj=0; jj<dates.size(); jj++) {
+			if (done[jj] || dates[jj]<file_start || dates[jj]>file_end) continue;
+			dates_idx.push_back( jj );
+			file_dates.push_back( dates[jj] );
+		}
+		if (file_dates.empty()) continue;
+
+		const std::vector< std::vector<double> > file_data( cache_grid_files[ii].second.read2DGridPoints(parameter, file_dates, Pts) );
+		for (size_t kk=0; kk<dates_idx.size(); kk++) {
+			for (size_t pt=0; pt<Pts.size(); pt++) data[pt][ dates_idx[kk] ] = file_data[pt][kk];
+			done[ dates_idx[kk] ] = true;
+		}
+		nr_done += dates_idx.size();
+	}
+
+	return (nr_done==dates.size()); //otherwise, reading the full grids will report the missing data
+}
+
 void NetCDFIO::readDEM(DEMObject& dem_out)
 {
 	const std::string filename = cfg.get("DEMFILE", "Input");
@@ -857,6 +899,71 @@ Grid2DObject ncFiles::read2DGrid(const size_t& param, const Date& date)
 	return read2DGrid(it->second, time_pos, isPrecip);
 }
 
+/**
+* @brief Read the time series of a parameter at some cells of the grids, without reading the full grids
+* @details For each point, the whole time range spanned by the requested dates is read with one hyperslab request.
+* The values go through the same nodata, packing and units handling as in read2DGrid().
+* @param[in] param the parameter to read
+* @param[in] dates the timestamps to read, they must all be present in the file
+* @param[in] Pts (i,j) indices of the points within the grid
+* @return values as data[point][date]
+*/
+std::vector< std::vector<double> > ncFiles::read2DGridPoints(const size_t& param, const std::vector<Date>& dates, const std::vector< std::pair<size_t, size_t> >& Pts)
+{
+	const std::map <size_t, ncpp::nc_variable>::const_iterator it = vars.find( param );
+	if (it==vars.end() || it->second.varid==-1)
+		throw NoDataException("No "+MeteoGrids::getParameterName( param )+" grid in file "+file_and_path, AT);
+	const ncpp::nc_variable& var = it->second;
+
+	std::vector<size_t> time_pos( dates.size() );
+	for (size_t jj=0; jj<dates.size(); jj++) {
+		const std::vector< std::pair<Date,size_t> >::const_iterator low = std::lower_bound(vecTime.begin(), vecTime.end(), std::make_pair(dates[jj],(size_t)0));
+		if (low==vecTime.end() || low->first!=dates[jj])
+			throw NoDataException("No "+MeteoGrids::getParameterName( param )+" data at "+dates[jj].toString(Date::ISO)+" in file "+file_and_path, AT);
+		time_pos[jj] = low->second;
+	}
+	std::vector< std::vector<double> > data( Pts.size(), std::vector<double>(dates.size(), IOUtils::nodata) );
+	if (dates.empty()) return data;
+
+	const size_t pos_min = *std::min_element(time_pos.begin(), time_pos.end());
+	const size_t nr_pos = *std::max_element(time_pos.begin(), time_pos.end()) - pos_min + 1;
+	const size_t nx = vecX.size(), ny = vecY.size();
+	const bool normal_Xorder = (vecX.front()<=vecX.back()), normal_Yorder = (vecY.front()<=vecY.back());
+	const bool isPrecip = (param==MeteoGrids::PSUM || param==MeteoGrids::PSUM_L || param==MeteoGrids::PSUM_S);
+
+	std::vector<double> units_factor( dates.size() );
+	for (size_t jj=0; jj<dates.size(); jj++) units_factor[jj] = getUnitsFactor(var.attributes.units, time_pos[jj], isPrecip);
+
+	if (ncid==-1) {
+		ncpp::open_file(file_and_path, NC_NOWRITE, ncid);
+		nc_filename = file_and_path;
+	}
+	std::vector<double> buffer( nr_pos );
+	for (size_t pt=0; pt<Pts.size(); pt++) {
+		if (Pts[pt].first>=nx || Pts[pt].second>=ny)
+			throw IndexOutOfBoundsException("Point ("+IOUtils::toString(Pts[pt].first)+","+IOUtils::toString(Pts[pt].second)+") is outside the grids of file "+file_and_path, AT);
+		//same cells ordering as in ncpp::fill2DGrid
+		const size_t col = (normal_Xorder)? Pts[pt].first : (nx-1) - Pts[pt].first;
+		const size_t row = (normal_Yorder)? Pts[pt].second : (ny-1) - Pts[pt].second;
+		ncpp::read_timeseries(ncid, var, pos_min, nr_pos, row, col, &buffer[0]);
+
+		for (size_t jj=0; jj<dates.size(); jj++) {
+			double value = IOUtils::standardizeNodata(buffer[ time_pos[jj]-pos_min ], var.nodata);
+			if (value==IOUtils::nodata) continue;
+			if (var.scale!=1.) value *= var.scale;
+			if (var.offset!=0.) value += var.offset;
+			if (units_factor[jj]!=1.) value *= units_factor[jj];
+			data[pt][jj] = value;
+		}
+	}
+	if (!keep_input_files_open) {
+		ncpp::close_file(file_and_path, ncid);
+		ncid = -1;
+	}
+
+	return data;
+}
+
 Grid2DObject ncFiles::read2DGrid(const ncpp::nc_variable& var, const size_t& time_pos, const bool& m2mm)
 {
 	if (isLatLon && (!hasDimension(ncpp::LATITUDE) || !hasDimension(ncpp::LONGITUDE))) throw IOException("No latitude / longitude could be identified in file "+file_and_path, AT);
@@ -1739,17 +1846,31 @@ const std::vector<double> ncFiles::fillBufferForVar(const Grid2DObject& grid, nc
 //bring back known units to MKSA
 void ncFiles::applyUnits(Grid2DObject& grid, const std::string& units, const size_t& time_pos, const bool& m2mm) const
 {
-	if (units.empty()) return;
+	grid *= getUnitsFactor(units, time_pos, m2mm); //dividing a grid is multiplying it by the inverse
+}
+
+/**
+* @brief Multiplicative factor converting the values of a variable from the given units to MeteoIO's units
+* @param[in] units units of the variable in the file
+* @param[in] time_pos time index in the file (some conversions depend on the time step)
+* @param[in] m2mm should values in m be converted to mm (for precipitation)?
+* @return conversion factor (1 if no conversion is required)
+*/
+double ncFiles::getUnitsFactor(const std::string& units, const size_t& time_pos, const bool& m2mm) const
+{
+	if (units.empty()) return 1.;
 
-	if (units=="m2/s2" || units=="m**2 s**-2") grid /= Cst::gravity;
-	else if (units=="%") grid /= 100.;
+	if (units=="m2/s2" || units=="m**2 s**-2") return 1./Cst::gravity;
+	else if (units=="%") return 1./100.;
 	else if (units=="J/m2" || units=="J m**-2") {
 		if (vecTime.size()>1 && time_pos!=IOUtils::npos) {
 			const Date integration_period = (time_pos>0)? (vecTime[time_pos].first - vecTime[time_pos-1].first) : (vecTime[time_pos+1].first - vecTime[time_pos].first);
-			grid /= (integration_period.getJulian()*24.*3600.); //converting back to W/m2
+			return 1./(integration_period.getJulian()*24.*3600.); //converting back to W/m2
 		}
 	}
-	else if (m2mm && units=="m") grid *= 1000.;
+	else if (m2mm && units=="m") return 1000.;
+
+	return 1.;
 }
 
 void ncFiles::applyUnits(std::vector< std::vector<MeteoData> >& vecMeteo, const size_t& nrStations, const size_t& nrSteps, const std::string& units, const std::string& parname)
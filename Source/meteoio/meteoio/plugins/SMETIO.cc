@@ -51,6 +51,10 @@ namespace mio {
  * - STATION#: input filename (in METEOPATH). As many meteofiles as needed may be specified. If nothing is specified, the METEOPATH directory 
  * will be scanned for files ending in ".smet";
  * - METEOPATH_RECURSIVE: if set to true, the scanning of METEOPATH is performed recursively (default: false); [Input] section;
+ * - SMET_INDEX_PATH: directory where to keep an index of the file positions of each input file, so that the next runs can directly 
+ * jump to the requested dates instead of reading the files from their beginning. An index is only used as long as its file
+ * is unchanged or has only been appended to. This should not be the METEOPATH directory itself (default: empty, the indexes
+ * are then only kept in memory); [Input] section;
  * - SNOWPACK_SLOPES: if set to true and no slope information is found in the input files, 
  * the <a href="https://www.slf.ch/en/avalanche-bulletin-and-snow-situation/measured-values/description-of-automated-stations.html">IMIS/Snowpack</a>
  * naming scheme will be used to derive the slope information (default: false, [Input] section).
@@ -157,6 +161,8 @@ void SMETIO::parseInputOutputSection()
 	if (in_meteo == "SMET") { //keep it synchronized with IOHandler.cc for plugin mapping!!
 		cfg.getValue("SNOWPACK_SLOPES", "Input", snowpack_slopes, IOUtils::nothrow);
 		const std::string inpath = cfg.get("METEOPATH", "Input");
+		std::string index_path;
+		cfg.getValue("SMET_INDEX_PATH", "Input", index_path, IOUtils::nothrow);
 		std::vector<std::string> vecFilenames;
 		cfg.getValues("STATION", "INPUT", vecFilenames);
 		if (vecFilenames.empty()) { //no stations provided, then scan METEOPATH
@@ -177,6 +183,8 @@ void SMETIO::parseInputOutputSection()
 				throw InvalidNameException(file_and_path, AT);
 			vecFiles.push_back(file_and_path);
 			vec_smet_reader.push_back(smet::SMETReader(file_and_path));
+			if (!index_path.empty())
+				vec_smet_reader.back().set_index_file( FileUtils::FileIndexer::getIndexFilename(index_path, file_and_path) );
 		}
 	}
 
@@ -371,7 +379,7 @@ void SMETIO::read_meta_data(const smet::SMETReader& myreader, StationData& meta)
 * Meta data, whether in header or in data is also handled
 */
 void SMETIO::populateMeteo(const smet::SMETReader& myreader,
-                       const std::vector<std::string>& timestamps,
+                       const std::vector<smet::SMETTimestamp>& timestamps,
                        const std::vector<double>& mydata, std::vector<MeteoData>& vecMeteo)
 {
 	const std::string filename( myreader.get_filename() );
@@ -408,8 +416,13 @@ void SMETIO::populateMeteo(const smet::SMETReader& myreader,
 	for (size_t ii = 0; ii<nr_of_lines; ii++){
 		tmp_md.reset();
 
-		if (timestamp_present)
-			IOUtils::convertString(tmp_md.date, timestamps[ii], current_timezone);
+		if (timestamp_present) {
+			const smet::SMETTimestamp& timestamp = timestamps[ii];
+			if (timestamp.is_parsed) //already broken down while reading
+				tmp_md.date.setDate(timestamp.year, timestamp.month, timestamp.day, timestamp.hour, timestamp.minute, timestamp.second, current_timezone);
+			else
+				IOUtils::convertString(tmp_md.date, timestamp.iso, current_timezone);
+		}
 
 		//Copy data points
 		for (size_t jj=0; jj<nr_of_fields; jj++){
@@ -480,7 +493,7 @@ void SMETIO::readMeteoData(const Date& dateStart, const Date& dateEnd,
 		myreader.convert_to_MKSA(true); // we want converted values for MeteoIO
 
 		std::vector<double> mydata; //sequentially store all data in the smet file
-		std::vector<std::string> mytimestamps;
+		std::vector<smet::SMETTimestamp> mytimestamps;
 
 		if (myreader.contains_timestamp()){
 			myreader.read(dateStart.toString(Date::ISO), dateEnd.toString(Date::ISO), mytimestamps, mydata);
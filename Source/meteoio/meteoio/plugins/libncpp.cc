@@ -274,6 +274,26 @@ void read_data(const int& ncid, const nc_variable& var, double* data)
 		throw mio::IOException("Could not retrieve data for variable '" + var.attributes.name + "': " + nc_strerror(status), AT);
 }
 
+/**
+* @brief Read the time series of one cell of a 2D gridded variable, with one hyperslab request
+* @param[in] ncid file ID
+* @param[in] var variable to read
+* @param[in] pos first time index in the file
+* @param[in] nr_pos number of time steps to read
+* @param[in] row row of the cell in the file
+* @param[in] col column of the cell in the file
+* @param[out] data data extracted from the file (it must be able to contain nr_pos values)
+*/
+void read_timeseries(const int& ncid, const nc_variable& var, const size_t& pos, const size_t& nr_pos, const size_t& row, const size_t& col, double* data)
+{
+	const size_t start[] = {pos, row, col};
+	const size_t count[] = {nr_pos, 1, 1};
+
+	const int status = nc_get_vara_double(ncid, var.varid, start, count, data);
+	if (status != NC_NOERR)
+		throw mio::IOException("Could not retrieve data for variable '" + var.attributes.name + "': " + nc_strerror(status), AT);
+}
+
 /**
  * @brief Read all the data for a specific variable
  * @param[in] ncid file ID
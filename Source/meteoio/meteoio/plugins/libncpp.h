@@ -116,6 +116,7 @@ namespace ncpp {
 	void read_data(const int& ncid, const nc_variable& var, const size_t& pos, const size_t& nrows, const size_t& ncols, double* data);
 	void read_data(const int& ncid, const nc_variable& var, double* data);
 	void read_data(const int& ncid, const nc_variable& var, int* data);
+	void read_timeseries(const int& ncid, const nc_variable& var, const size_t& pos, const size_t& nr_pos, const size_t& row, const size_t& col, double* data);
 	void readVariableMetadata(const int& ncid, ncpp::nc_variable& var, const bool& readTimeTransform=false, const double& TZ=0.);
 	void write_data(const int& ncid, const nc_variable& var, const size_t& pos, const size_t& nrows, const size_t& ncols, const double * const data);
 	void write_1Ddata(const int& ncid, const nc_variable& var, const std::vector<double>& data, const bool& isUnlimited=false);
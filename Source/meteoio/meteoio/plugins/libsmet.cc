@@ -17,6 +17,7 @@
     along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <meteoio/plugins/libsmet.h>
+#include <meteoio/IOUtils.h>
 #include <cerrno>
 #include <cstring>
 #include <string.h>
@@ -28,6 +29,7 @@
 #include <iomanip>
 #include <fstream>
 #include <algorithm>
+#include <utility>
 
 #if defined _WIN32 || defined __MINGW32__
 	#include <windows.h>
@@ -163,6 +165,77 @@ double SMETCommon::convert_to_double(const std::string& in_string)
 	}
 }
 
+/**
+ * @brief Convert the characters in [start, end) to double, with the same rules as convert_to_double(const std::string&)
+ * @details The character at end must not be part of a number (such as a separator, a white space, an end of line
+ * or the '\0' terminating the buffer), so the characters can be converted in place.
+ * Plain decimal numbers are converted by mio::IOUtils::convertDecimal(), which gives exactly the same result as strtod.
+ */
+double SMETCommon::convert_to_double(const char* start, const char* end)
+{
+	if (start==end) return 0.; //same as an empty string
+
+	double value;
+	if (mio::IOUtils::convertDecimal(start, end, value)) return value;
+
+	//any other form (exponent, too many digits, invalid characters...) is left to strtod
+	char* conversion_end = nullptr;
+	const double conversion_value = strtod(start, &conversion_end);
+
+	if (conversion_end == end) {
+		return conversion_value;
+	} else {
+		throw SMETException("Value \"" + std::string(start, end) + "\" cannot be converted to double", SMET_AT);
+	}
+}
+
+//read an unsigned number of at most 9 digits from *pos onward, advancing pos
+static bool read_digits(const char*& pos, const char* end, unsigned int& value)
+{
+	const char* start = pos;
+	value = 0;
+	while (pos<end && *pos>='0' && *pos<='9' && (pos-start)<9) {
+		value = value*10 + static_cast<unsigned int>(*pos - '0');
+		pos++;
+	}
+	return (pos!=start && (pos==end || *pos<'0' || *pos>'9'));
+}
+
+/**
+ * @brief Break down an ISO timestamp of the form YYYY-MM-DDTHH:MM[:SS] in [start, end) into its components.
+ * @details The character at end must not be part of the timestamp. Nothing is checked for plausibility.
+ * @return false if the timestamp has another form (for example with a time zone), it then has to be parsed as a string
+ */
+bool SMETCommon::convert_to_timestamp(const char* start, const char* end, SMETTimestamp& timestamp)
+{
+	const char* pos = start;
+	unsigned int year;
+	if (!read_digits(pos, end, year) || pos==end || *pos++!='-') return false;
+	if (!read_digits(pos, end, timestamp.month) || pos==end || *pos++!='-') return false;
+	if (!read_digits(pos, end, timestamp.day) || pos==end || *pos++!='T') return false;
+	if (!read_digits(pos, end, timestamp.hour) || pos==end || *pos++!=':') return false;
+	if (!read_digits(pos, end, timestamp.minute)) return false;
+
+	if (pos==end) {
+		timestamp.second = 0.;
+	} else {
+		if (*pos++!=':') return false;
+		const char* seconds_start = pos;
+		while (pos<end && *pos>='0' && *pos<='9') pos++;
+		if (pos==seconds_start) return false;
+		if (pos<end && *pos=='.') {
+			pos++;
+			while (pos<end && *pos>='0' && *pos<='9') pos++;
+		}
+		if (pos!=end) return false;
+		timestamp.second = convert_to_double(seconds_start, end);
+	}
+
+	timestamp.year = static_cast<int>(year);
+	timestamp.is_parsed = true;
+	return true;
+}
+
 int SMETCommon::convert_to_int(const std::string& in_string)
 {
 	istringstream ss(in_string);
@@ -877,7 +950,7 @@ const size_t SMETReader::streampos_every_n_lines = 2000; //save streampos every
 SMETReader::SMETReader(const std::string& in_fname)
             : data_start_fpointer(), vec_offset(), vec_multiplier(), vec_fieldnames(),
               header(), indexer(),
-              filename(in_fname), timestamp_start("-4714-11-24T00:00"),
+              filename(in_fname), index_filename(), timestamp_start("-4714-11-24T00:00"),
               timestamp_end("9999-12-31T00:00"), nodata_value(-999.),
               julian_start(0.), julian_end(5373483.5),
               nr_of_fields(0), timestamp_field(0), julian_field(0),
@@ -907,6 +980,17 @@ SMETReader::SMETReader(const std::string& in_fname)
 	cleanup(fin); //closes file
 }
 
+void SMETReader::set_index_file(const std::string& i_index_filename)
+{
+	index_filename = i_index_filename;
+	if (!index_filename.empty()) indexer.read(index_filename, filename);
+}
+
+void SMETReader::save_index()
+{
+	if (!index_filename.empty() && indexer.isModified()) indexer.write(index_filename, filename);
+}
+
 void SMETReader::cleanup(std::ifstream& fin) noexcept
 {
 	if (fin.is_open()) //close fin if open
@@ -1235,6 +1319,22 @@ void SMETReader::read(const std::string& i_timestamp_start, const std::string& i
 	}
 }
 
+void SMETReader::read(const std::string& i_timestamp_start, const std::string& i_timestamp_end,
+                      std::vector<SMETTimestamp>& vec_timestamp, std::vector<double>& vec_data)
+{
+	if (!timestamp_present){
+		read(vec_timestamp, vec_data);
+	} else {
+		timestamp_interval = true;
+		timestamp_start = i_timestamp_start;
+		timestamp_end = i_timestamp_end;
+
+		read(vec_timestamp, vec_data);
+
+		timestamp_interval = false;
+	}
+}
+
 void SMETReader::read(const double& i_julian_start, const double& i_julian_end, std::vector<double>& vec_data)
 {
 	if (!julian_present){
@@ -1251,6 +1351,21 @@ void SMETReader::read(const double& i_julian_start, const double& i_julian_end,
 }
 
 void SMETReader::read(std::vector<std::string>& vec_timestamp, std::vector<double>& vec_data)
+{
+	std::vector<SMETTimestamp> tmp_timestamps;
+	read_timestamped(tmp_timestamps, vec_data, false);
+
+	vec_timestamp.reserve( vec_timestamp.size() + tmp_timestamps.size() );
+	for (size_t ii=0; ii<tmp_timestamps.size(); ii++)
+		vec_timestamp.push_back( std::move(tmp_timestamps[ii].iso) );
+}
+
+void SMETReader::read(std::vector<SMETTimestamp>& vec_timestamp, std::vector<double>& vec_data)
+{
+	read_timestamped(vec_timestamp, vec_data, true);
+}
+
+void SMETReader::read_timestamped(std::vector<SMETTimestamp>& vec_timestamp, std::vector<double>& vec_data, const bool& parse_timestamps)
 {
 	if (!timestamp_present)
 		throw SMETException("Requesting to read timestamp when there is none present in \""+filename+"\"", SMET_AT);
@@ -1287,7 +1402,7 @@ void SMETReader::read(std::vector<std::string>& vec_timestamp, std::vector<doubl
 			fin.seekg(data_start_fpointer);
 
 		if (isAscii)
-			read_data_ascii(fin, vec_timestamp, vec_data);
+			read_data_ascii(fin, vec_timestamp, vec_data, parse_timestamps);
 		else
 			throw SMETException("Binary SMET file \""+filename+"\" has no field timestamp, only julian date", SMET_AT);
 	} catch(...) {
@@ -1296,6 +1411,7 @@ void SMETReader::read(std::vector<std::string>& vec_timestamp, std::vector<doubl
 	}
 
 	cleanup(fin);
+	save_index();
 }
 
 void SMETReader::read(std::vector<double>& vec_data)
@@ -1333,8 +1449,8 @@ void SMETReader::read(std::vector<double>& vec_data)
 			fin.seekg(data_start_fpointer);
 
 		if (isAscii) {
-			std::vector<std::string> tmp_vec;
-			read_data_ascii(fin, tmp_vec, vec_data);
+			std::vector<SMETTimestamp> tmp_vec;
+			read_data_ascii(fin, tmp_vec, vec_data, false);
 		} else {
 			read_data_binary(fin, vec_data);
 		}
@@ -1344,6 +1460,7 @@ void SMETReader::read(std::vector<double>& vec_data)
 	}
 
 	cleanup(fin);
+	save_index();
 }
 
 std::string SMETReader::getLastTimestamp() const
@@ -1427,73 +1544,153 @@ void SMETReader::copy_file_data(const std::string& date_stop, std::ifstream& fin
 	}
 }
 
-void SMETReader::read_data_ascii(std::ifstream& fin, std::vector<std::string>& vec_timestamp, std::vector<double>& vec_data)
+static inline bool is_whitespace(const char& c)
 {
+	return (c==' ' || c=='\t' || c=='\f' || c=='\v' || c=='\n' || c=='\r');
+}
+
+/**
+ * @brief Read the ASCII data section, starting at the current position of fin
+ * @details The file is read by large blocks and each line is tokenized in place, so the values are converted
+ * without going through temporary strings. The lines are processed with the same rules as reading them with
+ * getline(), stripComments(), trim() and readLineToVec().
+ */
+void SMETReader::read_data_ascii(std::ifstream& fin, std::vector<SMETTimestamp>& vec_timestamp, std::vector<double>& vec_data, const bool& parse_timestamps)
+{
+	static const size_t block_size = 1048576; //the file is read by blocks of 1MB
 	const size_t nr_of_data_fields = (timestamp_present)? nr_of_fields+1 : nr_of_fields;
-	std::vector<std::string> tmp_vec;
-	std::string line;
+	std::vector<const char*> field_start(nr_of_data_fields), field_end(nr_of_data_fields);
+	std::vector<char> buffer;
+	size_t buffer_len = 0; //number of valid characters in the buffer
+	const std::streampos data_fpointer = fin.tellg();
+	std::streamoff buffer_offset = 0; //position of the beginning of the buffer in the file, relative to data_fpointer
 	size_t linenr = 0;
 	streampos current_fpointer = static_cast<streampos>(-1);
+	bool end_of_file = false, end_of_interval = false;
+
+	while (!end_of_file && !end_of_interval) {
+		//append the next block to what is left of the previous one (an incomplete line)
+		buffer.resize(buffer_len + block_size + 1);
+		fin.read(&buffer[buffer_len], static_cast<std::streamsize>(block_size));
+		buffer_len += static_cast<size_t>( fin.gcount() );
+		end_of_file = !fin;
+		buffer[buffer_len] = '\0'; //so the conversions never run past the data
+
+		size_t pos = 0;
+		while (pos<buffer_len) {
+			const char* line_start = &buffer[pos];
+			const char* line_end = static_cast<const char*>( memchr(line_start, eoln, buffer_len-pos) );
+			if (line_end==nullptr) {
+				if (!end_of_file) break; //incomplete line, wait for the next block
+				line_end = &buffer[0] + buffer_len;
+			}
+			const std::streampos tmp_fpointer = (data_fpointer!=static_cast<streampos>(-1))? data_fpointer + (buffer_offset + static_cast<std::streamoff>(pos)) : data_fpointer;
+			pos = static_cast<size_t>(line_end - &buffer[0]) + 1;
+			linenr++;
 
-	while (!fin.eof()){
-		const std::streampos tmp_fpointer = fin.tellg();
-		line.clear();
-		getline(fin, line, eoln);
-		linenr++;
-		SMETCommon::stripComments(line);
-		SMETCommon::trim(line);
-		if (line.empty()) continue; //Pure comment lines and empty lines are ignored
-
-		const size_t nr_fields_read = (separator==' ')? SMETCommon::readLineToVec(line, tmp_vec) : SMETCommon::readLineToVec(line, tmp_vec, separator);
-		if (nr_fields_read == nr_of_data_fields){
-			try {
-				size_t shift = 0;
-				if (julian_interval && julian_present){
-					const double current_julian = SMETCommon::convert_to_double(tmp_vec[julian_field]);
-					if ( (linenr % streampos_every_n_lines)==0 && (current_fpointer != static_cast<streampos>(-1)) )
-						indexer.setIndex(current_julian, tmp_fpointer);
-					if (current_julian < julian_start)
-						continue; //skip lines that don't hold the dates we're interested in
-					else if (current_julian > julian_end)
-						break; //skip the rest of the file
+			//strip comments and trim the line
+			const char* comment = line_start;
+			while (comment<line_end && *comment!='#' && *comment!=';') comment++;
+			line_end = comment;
+			while (line_start<line_end && is_whitespace(*line_start)) line_start++;
+			while (line_end>line_start && is_whitespace(*(line_end-1))) line_end--;
+			if (line_start==line_end) continue; //Pure comment lines and empty lines are ignored
+
+			//split the line into fields
+			size_t nr_fields_read = 0;
+			if (separator==' ') {
+				const char* field = line_start;
+				while (field<line_end) {
+					while (field<line_end && is_whitespace(*field)) field++;
+					if (field==line_end) break;
+					const char* next = field;
+					while (next<line_end && !is_whitespace(*next)) next++;
+					if (nr_fields_read<nr_of_data_fields) {
+						field_start[nr_fields_read] = field;
+						field_end[nr_fields_read] = next;
+					}
+					nr_fields_read++;
+					field = next;
 				}
-
-				if (timestamp_interval && timestamp_present){
-					const string& current_timestamp = tmp_vec[timestamp_field];
-					if ( (linenr % streampos_every_n_lines)==0 && (tmp_fpointer != static_cast<streampos>(-1)) )
-						indexer.setIndex(current_timestamp, tmp_fpointer);
-					if (current_timestamp < timestamp_start)
-						continue; //skip lines that don't hold the dates we're interested in
-					else if (current_timestamp > timestamp_end)
-						break; //skip the rest of the file
+			} else {
+				const char* field = line_start;
+				while (true) {
+					const char* next = field;
+					while (next<line_end && *next!=separator) next++;
+					if (nr_fields_read<nr_of_data_fields) {
+						field_start[nr_fields_read] = field;
+						field_end[nr_fields_read] = next;
+					}
+					nr_fields_read++;
+					if (next==line_end) break;
+					field = next + 1;
 				}
+			}
 
-				for (size_t ii=0; ii<tmp_vec.size(); ii++){
-					if (timestamp_present && (ii == timestamp_field)) {
-						vec_timestamp.push_back(tmp_vec[ii]);
-						shift = 1;
-					} else {
-						double tmp = SMETCommon::convert_to_double(tmp_vec[ii]);
-						if ((mksa) && (tmp != nodata_value)){
-							tmp *= vec_multiplier[ii-shift];
-							tmp += vec_offset[ii-shift];
+			if (nr_fields_read == nr_of_data_fields){
+				try {
+					size_t shift = 0;
+					if (julian_interval && julian_present){
+						const double current_julian = SMETCommon::convert_to_double(field_start[julian_field], field_end[julian_field]);
+						if ( (linenr % streampos_every_n_lines)==0 && (current_fpointer != static_cast<streampos>(-1)) )
+							indexer.setIndex(current_julian, tmp_fpointer);
+						if (current_julian < julian_start)
+							continue; //skip lines that don't hold the dates we're interested in
+						else if (current_julian > julian_end) {
+							end_of_interval = true;
+							break; //skip the rest of the file
+						}
+					}
+
+					if (timestamp_interval && timestamp_present){
+						const char* current_timestamp = field_start[timestamp_field];
+						const size_t timestamp_len = static_cast<size_t>(field_end[timestamp_field] - current_timestamp);
+						if ( (linenr % streampos_every_n_lines)==0 && (tmp_fpointer != static_cast<streampos>(-1)) )
+							indexer.setIndex(std::string(current_timestamp, timestamp_len), tmp_fpointer);
+						if (timestamp_start.compare(0, std::string::npos, current_timestamp, timestamp_len) > 0)
+							continue; //skip lines that don't hold the dates we're interested in
+						else if (timestamp_end.compare(0, std::string::npos, current_timestamp, timestamp_len) < 0) {
+							end_of_interval = true;
+							break; //skip the rest of the file
+						}
+					}
+
+					for (size_t ii=0; ii<nr_of_data_fields; ii++){
+						if (timestamp_present && (ii == timestamp_field)) {
+							vec_timestamp.push_back( SMETTimestamp() );
+							SMETTimestamp& timestamp = vec_timestamp.back();
+							if (!parse_timestamps || !SMETCommon::convert_to_timestamp(field_start[ii], field_end[ii], timestamp))
+								timestamp.iso.assign(field_start[ii], field_end[ii]);
+							shift = 1;
+						} else {
+							double tmp = SMETCommon::convert_to_double(field_start[ii], field_end[ii]);
+							if ((mksa) && (tmp != nodata_value)){
+								tmp *= vec_multiplier[ii-shift];
+								tmp += vec_offset[ii-shift];
+							}
+							vec_data.push_back(tmp);
 						}
-						vec_data.push_back(tmp);
 					}
+					current_fpointer = tmp_fpointer;
+				} catch(SMETException&) {
+					cerr << "Error reading file \"" << filename << "\" at line \"" << std::string(line_start, line_end) << "\"" << endl;
+					throw;
 				}
-				current_fpointer = tmp_fpointer;
-			} catch(SMETException&) {
-				cerr << "Error reading file \"" << filename << "\" at line \"" << line << "\"" << endl;
-				throw;
+			} else {
+				std::ostringstream ss;
+				ss << "File \'" << filename << "\' declares " << nr_of_data_fields << " columns ";
+				ss << "but this does not match the following line";
+				if (separator!=' ') ss << " (column delimiter: '" << separator << "')";
+				ss << ":\n" << std::string(line_start, line_end) << "\n";
+				throw SMETException(ss.str(), SMET_AT);
 			}
-		} else {
-			std::ostringstream ss;
-			ss << "File \'" << filename << "\' declares " << nr_of_data_fields << " columns ";
-			ss << "but this does not match the following line";
-			if (separator!=' ') ss << " (column delimiter: '" << separator << "')";
-			ss << ":\n" << line << "\n";
-			throw SMETException(ss.str(), SMET_AT);
 		}
+
+		//keep the incomplete last line for the next block
+		if (pos>buffer_len) pos = buffer_len;
+		buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(pos));
+		buffer_len -= pos;
+		buffer_offset += static_cast<std::streamoff>(pos);
 	}
 
 	if (current_fpointer != static_cast<streampos>(-1)){
@@ -51,6 +51,23 @@ class SMETException : public std::exception {
 		std::string msg;
 };
 
+/**
+ * @class SMETTimestamp
+ * @brief The timestamp of a data line, broken down into its components while reading the file.
+ * @details Only timestamps of the form YYYY-MM-DDTHH:MM[:SS] are broken down, for any other form
+ * (for example when they contain a time zone) is_parsed is false and the timestamp is kept as it was read in iso.
+ */
+class SMETTimestamp {
+	public:
+		SMETTimestamp() : iso(), second(0.), year(0), month(0), day(0), hour(0), minute(0), is_parsed(false) {}
+
+		std::string iso; ///< the timestamp as read from the file, only set when it has not been broken down
+		double second;
+		int year;
+		unsigned int month, day, hour, minute;
+		bool is_parsed; ///< true if the components have been set
+};
+
 /**
  * @class SMETCommon
  * @brief A static class to provide basic operations and variables for the libsmet library
@@ -62,6 +79,8 @@ class SMETCommon {
 		static void copy_file(const std::string& src, const std::string& dest);
 		static bool fileExists(const std::string& filename);
 		static double convert_to_double(const std::string& in_string);
+		static double convert_to_double(const char* start, const char* end);
+		static bool convert_to_timestamp(const char* start, const char* end, SMETTimestamp& timestamp);
 		static int convert_to_int(const std::string& in_string);
 		static char convert_to_char(const std::string& in_string);
 		static void stripComments(std::string& str);
@@ -237,6 +256,18 @@ class SMETReader {
 		void read(const std::string& timestamp_start, const std::string& timestamp_end,
 		          std::vector<std::string>& vec_timestamp, std::vector<double>& vec_data);
 
+		/**
+		 * @brief Read the data in a SMET file for a given interval of time, with the timestamps broken down
+		 *        into their components (this avoids having to parse them again as strings)
+		 *        if no timestamp is present in the file, the whole file is read
+		 * @param[in] timestamp_start ISO formatted string, beginning of interval (inclusive)
+		 * @param[in] timestamp_end ISO formatted string, end of interval (inclusive)
+		 * @param[out] vec_timestamp A vector of SMETTimestamp to hold the timestamp of each line
+		 * @param[out] vec_data A vector of double holding all double values of all lines sequentially
+		 */
+		void read(const std::string& timestamp_start, const std::string& timestamp_end,
+		          std::vector<SMETTimestamp>& vec_timestamp, std::vector<double>& vec_data);
+
 		/**
 		 * @brief Read the data in a SMET file for a given interval of time
 		 *        if no julian field is present in the file, the whole file is read
@@ -253,6 +284,14 @@ class SMETReader {
 		 */
 		void read(std::vector<std::string>& vec_timestamp, std::vector<double>& vec_data);
 
+		/**
+		 * @brief Read all the data in a SMET file, if a timestamp is present, with the timestamps broken down
+		 *        into their components
+		 * @param[out] vec_timestamp A vector of SMETTimestamp to hold the timestamp of each line
+		 * @param[out] vec_data A vector of double holding all double values of all lines sequentially
+		 */
+		void read(std::vector<SMETTimestamp>& vec_timestamp, std::vector<double>& vec_data);
+
 		/**
 		 * @brief Read all the data in a SMET file, if no timestamp is present
 		 * @param[out] vec_data A vector of double holding all double values of all lines sequentially
@@ -335,18 +374,29 @@ class SMETReader {
 		 * @return a std::string representing the filename
 		 */
 		std::string get_filename() const;
+
+		/**
+		 * @brief Persist the index of the file positions in a sidecar file, so the next runs can directly seek
+		 *        to the requested dates instead of scanning the file from its beginning
+		 * @details The index is read from this file if it is still valid for the SMET file, and written
+		 *        back to it after each read that has extended it (see mio::FileUtils::FileIndexer)
+		 * @param[in] i_index_filename The filename of the sidecar file
+		 */
+		void set_index_file(const std::string& i_index_filename);
 		
 	private:
 		void truncate_file(const std::string& date_stop) const;
 		void copy_file_header(std::ifstream& fin, std::ofstream& fout) const;
 		void copy_file_data(const std::string& date_stop, std::ifstream& fin, std::ofstream& fout) const;
 		std::string getLastTimestamp() const;
-		void read_data_ascii(std::ifstream& fin, std::vector<std::string>& vec_timestamp, std::vector<double>& vec_data);
+		void read_timestamped(std::vector<SMETTimestamp>& vec_timestamp, std::vector<double>& vec_data, const bool& parse_timestamps);
+		void read_data_ascii(std::ifstream& fin, std::vector<SMETTimestamp>& vec_timestamp, std::vector<double>& vec_data, const bool& parse_timestamps);
 		void read_data_binary(std::ifstream& fin, std::vector<double>& vec_data);
 		void cleanup(std::ifstream& fin) noexcept;
 		void checkSignature(const std::vector<std::string>& vecSignature, bool& o_isAscii);
 		void read_header(std::ifstream& fin);
 		void process_header();
+		void save_index();
 
 		std::streampos data_start_fpointer;
 
@@ -357,6 +407,7 @@ class SMETReader {
 		mio::FileUtils::FileIndexer indexer; //in order to save file pointers
 
 		std::string filename;
+		std::string index_filename; //sidecar file to persist the indexer into, empty if it is only kept in memory
 		std::string timestamp_start, timestamp_end; //the beginning and end date of the current timestamp_interval
 		double nodata_value; //The nodata value as seen in the header section of the SMET file
 		double julian_start, julian_end; //the beginning and end date of the current julian_interval
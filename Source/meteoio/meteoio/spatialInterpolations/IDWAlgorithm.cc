@@ -53,7 +53,7 @@ double IDWAlgorithm::getQualityRating(const Date& i_date)
 
 void IDWAlgorithm::calculate(const DEMObject& dem, Grid2DObject& grid)
 {
-	Interpol2D::IDW(vecData, vecMeta, dem, grid, scale, alpha);
+	Interpol2D::IDW(vecData, vecMeta, dem, grid, scale, alpha, nb_threads);
 }
 
 } //namespace
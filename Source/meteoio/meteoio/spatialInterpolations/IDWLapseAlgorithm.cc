@@ -51,7 +51,7 @@ void IDWLapseAlgorithm::calculate(const DEMObject& dem, Grid2DObject& grid)
 	info.clear(); info.str("");
 	trend.detrend(vecMeta, vecData);
 	info << trend.getInfo();
-	Interpol2D::IDW(vecData, vecMeta, dem, grid, scale, alpha); //the meta should NOT be used for elevations!
+	Interpol2D::IDW(vecData, vecMeta, dem, grid, scale, alpha, nb_threads); //the meta should NOT be used for elevations!
 	trend.retrend(dem, grid);
 }
 
@@ -54,7 +54,7 @@ void LocalIDWLapseAlgorithm::calculate(const DEMObject& dem, Grid2DObject& grid)
 {
 	info.clear(); info.str("");
 	trend.detrend(vecMeta, vecData);
-	Interpol2D::LocalLapseIDW(vecData, vecMeta, dem, nrOfNeighbors, grid, scale, alpha);
+	Interpol2D::LocalLapseIDW(vecData, vecMeta, dem, nrOfNeighbors, grid, scale, alpha, nb_threads);
 	info << "using nearest " << nrOfNeighbors << " neighbors";
 	trend.retrend(dem, grid);
 }
@@ -89,7 +89,7 @@ Grid2DObject IDWSlopesAlgorithm::computeAspect(const DEMObject& dem, const Slope
 {
 	Grid2DObject grid;
 	trend.detrend(vecMetaCache[curr_slope], vecDataCache[curr_slope]);
-	Interpol2D::IDW(vecDataCache[curr_slope], vecMetaCache[curr_slope], dem, grid, scale, alpha);
+	Interpol2D::IDW(vecDataCache[curr_slope], vecMetaCache[curr_slope], dem, grid, scale, alpha, nb_threads);
 	trend.retrend(dem, grid);
 	return grid;
 }
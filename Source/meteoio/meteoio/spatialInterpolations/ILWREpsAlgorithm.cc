@@ -67,7 +67,7 @@ void ILWREpsAlgorithm::calculate(const DEMObject& dem, Grid2DObject& grid)
 
 	trend.detrend(vecMeta, vecDataEA);
 	info << trend.getInfo();
-	Interpol2D::IDW(vecDataEA, vecMeta, dem, grid, scale, alpha); //the meta should NOT be used for elevations!
+	Interpol2D::IDW(vecDataEA, vecMeta, dem, grid, scale, alpha, nb_threads); //the meta should NOT be used for elevations!
 	trend.retrend(dem, grid);
 
 	//Recompute ILWR from the interpolated ea
@@ -105,6 +105,10 @@ namespace mio {
  * ISWR::algorithms = SWRAD
  * @endcode
  *
+ * @note When MeteoIO has been compiled with OpenMP support (OPENMP cmake option), the most expensive algorithms (IDW and the algorithms relying
+ * on it, LIDW_LAPSE, ODKRIG, WINSTRAL) can process the grid with several threads. Set the \b NB_THREADS key in the [Interpolations2D] section
+ * to the number of threads to use (default: 1). The results do not depend on the number of threads.
+ *
  * @section interpol2D_keywords Available algorithms
  * The keywords defining the algorithms are the following:
  * - NONE: returns a nodata filled grid (see NoneAlgorithm)
@@ -180,6 +184,15 @@ InterpolationAlgorithm* AlgorithmFactory::getAlgorithm(std::string algoname,
                                                        const std::vector< std::pair<std::string, std::string> >& vecArgs, TimeSeriesManager& tsm, GridsManager& gdm, const std::string& param)
 {
 	IOUtils::toUpper(algoname);
+	InterpolationAlgorithm* algorithm( createAlgorithm(algoname, mi, vecArgs, tsm, gdm, param) );
+	algorithm->setNbThreads( mi.getNbThreads() );
+	return algorithm;
+}
+
+InterpolationAlgorithm* AlgorithmFactory::createAlgorithm(const std::string& algoname,
+                                                       Meteo2DInterpolator& mi,
+                                                       const std::vector< std::pair<std::string, std::string> >& vecArgs, TimeSeriesManager& tsm, GridsManager& gdm, const std::string& param)
+{
 
 	if (algoname == "NONE") {// return a nodata grid
 		return new NoneAlgorithm(vecArgs, algoname, param, tsm);
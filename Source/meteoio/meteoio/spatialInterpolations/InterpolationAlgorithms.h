@@ -72,7 +72,7 @@ class InterpolationAlgorithm {
 		InterpolationAlgorithm(const std::vector< std::pair<std::string, std::string> >& /*vecArgs*/,
 		                       const std::string& i_algo, const std::string& i_param, TimeSeriesManager& i_tsm) :
 		                      algo(i_algo), tsmanager(i_tsm), date(0., 0), vecMeteo(), vecData(),
-		                      vecMeta(), info(), param(i_param), nrOfMeasurments(0) {}
+		                      vecMeta(), info(), param(i_param), nrOfMeasurments(0), nb_threads(1) {}
 		virtual ~InterpolationAlgorithm() {}
 		
 		//if anything is not ok (wrong parameter for this algo, insufficient data, etc) -> return zero
@@ -80,6 +80,7 @@ class InterpolationAlgorithm {
 		virtual void calculate(const DEMObject& dem, Grid2DObject& grid) = 0;
 
 		std::string getInfo() const;
+		void setNbThreads(const unsigned int& i_nb_threads) {nb_threads = (i_nb_threads>0)? i_nb_threads : 1;}
 		const std::string algo;
 
  	protected:
@@ -95,6 +96,7 @@ class InterpolationAlgorithm {
 		std::ostringstream info; ///<to store some extra information about the interplation process
 		const std::string param; ///<the parameter that we will interpolate
 		size_t nrOfMeasurments; ///<Number of stations that have been used, so this can be reported to the user
+		unsigned int nb_threads; ///<number of threads for filling the grid (only if compiled with OpenMP)
 };
 
 class AlgorithmFactory {
@@ -102,6 +104,10 @@ class AlgorithmFactory {
 		static InterpolationAlgorithm* getAlgorithm(std::string algoname,
 		                                            Meteo2DInterpolator& mi,
 		                                            const std::vector< std::pair<std::string, std::string> >& vecArgs, TimeSeriesManager& tsm, GridsManager& gdm, const std::string& param);
+	private:
+		static InterpolationAlgorithm* createAlgorithm(const std::string& algoname,
+		                                            Meteo2DInterpolator& mi,
+		                                            const std::vector< std::pair<std::string, std::string> >& vecArgs, TimeSeriesManager& tsm, GridsManager& gdm, const std::string& param);
 };
 
 } //end namespace mio
@@ -114,16 +114,16 @@ void ListonWindAlgorithm::simpleWindInterpolate(const DEMObject& dem, Grid2DObje
 	if (vecDataVW.size()>=4) { //at least for points to perform detrending
 		trend.detrend(vecMeta, Ve);
 		info << trend.getInfo();
-		Interpol2D::IDW(Ve, vecMeta, dem, VW, scale, alpha);
+		Interpol2D::IDW(Ve, vecMeta, dem, VW, scale, alpha, nb_threads);
 		trend.retrend(dem, VW);
 
 		trend.detrend(vecMeta, Vn);
 		info << trend.getInfo();
-		Interpol2D::IDW(Vn, vecMeta, dem, DW, scale, alpha);
+		Interpol2D::IDW(Vn, vecMeta, dem, DW, scale, alpha, nb_threads);
 		trend.retrend(dem, DW);
 	} else {
-		Interpol2D::IDW(Ve, vecMeta, dem, VW, scale, alpha);
-		Interpol2D::IDW(Vn, vecMeta, dem, DW, scale, alpha);
+		Interpol2D::IDW(Ve, vecMeta, dem, VW, scale, alpha, nb_threads);
+		Interpol2D::IDW(Vn, vecMeta, dem, DW, scale, alpha, nb_threads);
 	}
 
 	//recompute VW, DW in each cell
@@ -212,7 +212,7 @@ void OrdinaryKrigingAlgorithm::calculate(const DEMObject& dem, Grid2DObject& gri
 	//or, get max range from io.ini, build variogram from this user defined max range
 	if (!computeVariogram(false)) //only refresh once a month, or once a week, etc
 		throw IOException("The variogram for parameter " + param + " could not be computed!", AT);
-	Interpol2D::ODKriging(vecData, vecMeta, dem, variogram, grid);
+	Interpol2D::ODKriging(vecData, vecMeta, dem, variogram, grid, nb_threads);
 }
 
 } //namespace
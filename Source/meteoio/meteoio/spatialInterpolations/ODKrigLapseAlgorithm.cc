@@ -35,7 +35,7 @@ void LapseOrdinaryKrigingAlgorithm::calculate(const DEMObject& dem, Grid2DObject
 
 	if (!computeVariogram(true)) //only refresh once a month, or once a week, etc
 		throw IOException("The variogram for parameter " + param + " could not be computed!", AT);
-	Interpol2D::ODKriging(vecData, vecMeta, dem, variogram, grid);
+	Interpol2D::ODKriging(vecData, vecMeta, dem, variogram, grid, nb_threads);
 
 	trend.retrend(dem, grid);
 }
@@ -86,10 +86,10 @@ void RHListonAlgorithm::calculate(const DEMObject& dem, Grid2DObject& grid)
 	if (nrOfMeasurments>=2) {
 		trend.detrend(vecMeta, vecTd);
 		info << trend.getInfo();
-		Interpol2D::IDW(vecTd, vecMeta, dem, grid, scale, alpha); //the meta should NOT be used for elevations!
+		Interpol2D::IDW(vecTd, vecMeta, dem, grid, scale, alpha, nb_threads); //the meta should NOT be used for elevations!
 		trend.retrend(dem, grid);
 	} else {
-		Interpol2D::IDW(vecTd, vecMeta, dem, grid, scale, alpha); //the meta should NOT be used for elevations!
+		Interpol2D::IDW(vecTd, vecMeta, dem, grid, scale, alpha, nb_threads); //the meta should NOT be used for elevations!
 	}
 
 	//Recompute Rh from the interpolated td
@@ -76,7 +76,7 @@ void StandardPressureAlgorithm::calculate(const DEMObject& dem, Grid2DObject& gr
 			throw IOException("Not enough data for spatially interpolating parameter " + param, AT);
 
 		Grid2DObject offset;
-		Interpol2D::IDW(residuals, vecMeta, dem, offset, scale, alpha);
+		Interpol2D::IDW(residuals, vecMeta, dem, offset, scale, alpha, nb_threads);
 		grid += offset;
 	}
 }
@@ -19,7 +19,6 @@
 
 #include <meteoio/spatialInterpolations/SwRadAlgorithm.h>
 #include <meteoio/meteoStats/libinterpol2D.h>
-#include <meteoio/dataClasses/DEMAlgorithms.h>
 
 namespace mio {
 
@@ -29,7 +28,7 @@ const double SWRadInterpolation::snow_thresh = .1; //if snow height greater than
 
 SWRadInterpolation::SWRadInterpolation(const std::vector< std::pair<std::string, std::string> >& vecArgs, const std::string& i_algo, const std::string& i_param, TimeSeriesManager& i_tsm,
                                                                        Meteo2DInterpolator& i_mi)
-                                   : InterpolationAlgorithm(vecArgs, i_algo, i_param, i_tsm), mi(i_mi), Sun(), vecIdx(), scale(1e3), alpha(1.), shading(true), project_on_slope(false)
+                                   : InterpolationAlgorithm(vecArgs, i_algo, i_param, i_tsm), mi(i_mi), Sun(), horizons(), vecIdx(), scale(1e3), alpha(1.), shading(true), project_on_slope(false), horizon_cache(false)
 {
 	const std::string where( "Interpolations2D::"+i_param+"::"+i_algo );
 	for (size_t ii=0; ii<vecArgs.size(); ii++) {
@@ -41,6 +40,12 @@ SWRadInterpolation::SWRadInterpolation(const std::vector< std::pair<std::string,
 			IOUtils::parseArg(vecArgs[ii], where, scale);
 		} else if (vecArgs[ii].first=="ALPHA") {
 			IOUtils::parseArg(vecArgs[ii], where, alpha);
+		} else if (vecArgs[ii].first=="HORIZON_CACHE") {
+			IOUtils::parseArg(vecArgs[ii], where, horizon_cache);
+		} else if (vecArgs[ii].first=="HORIZON_CACHE_PATH") {
+			std::string cache_path;
+			IOUtils::parseArg(vecArgs[ii], where, cache_path);
+			horizons.setCachePath( cache_path );
 		}
 	}
 }
@@ -110,9 +115,9 @@ void SWRadInterpolation::calculate(const DEMObject& dem, Grid2DObject& grid)
 
 	//compute the distributed  splitting and correction coefficient fields
 	Grid2DObject Md;
-	Interpol2D::IDW(vecMd, vecMeta, dem, Md, scale, alpha);
+	Interpol2D::IDW(vecMd, vecMeta, dem, Md, scale, alpha, nb_threads);
 	Grid2DObject Corr;
-	Interpol2D::IDW(vecCorr, vecMeta, dem, Corr, scale, alpha);
+	Interpol2D::IDW(vecCorr, vecMeta, dem, Corr, scale, alpha, nb_threads);
 
 	//get TA, RH and P interpolation from call back to Meteo2DInterpolator
 	Grid2DObject ta;
@@ -126,32 +131,50 @@ void SWRadInterpolation::calculate(const DEMObject& dem, Grid2DObject& grid)
 	double solarAzimuth, solarElevation;
 	Sun.position.getHorizontalCoordinates(solarAzimuth, solarElevation);
 	const double tan_sun_elev = tan(solarElevation*Cst::to_rad);
+	const bool use_horizons = glob_day && shading && horizon_cache;
+	if (use_horizons) {
+		horizons.setNbThreads( nb_threads );
+		horizons.setDEM( dem );
+	}
+
+	//clear sky radiation of all the valid cells at once
+	const size_t nx = dem.getNx();
+	std::vector<size_t> cells;
+	std::vector<double> altitudes, vec_ta, vec_rh, vec_p;
+	cells.reserve( dem.size() ); altitudes.reserve( dem.size() );
+	vec_ta.reserve( dem.size() ); vec_rh.reserve( dem.size() ); vec_p.reserve( dem.size() );
+	for (size_t idx=0; idx<dem.size(); idx++) {
+		if (dem(idx)==IOUtils::nodata) continue;
+		cells.push_back( idx );
+		altitudes.push_back( dem(idx) );
+		vec_ta.push_back( ta(idx) );
+		vec_rh.push_back( rh(idx) );
+		vec_p.push_back( p(idx) );
+	}
+	std::vector<double> vec_direct, vec_diffuse;
+	Sun.getHorizontalRadiation(altitudes, vec_ta, vec_rh, vec_p, .5, vec_direct, vec_diffuse, nb_threads); //we don't have any albedo, so use .5
 
 	grid.set(dem, IOUtils::nodata);
-	for (size_t jj=0; jj<dem.getNy(); jj++) {
-		for (size_t ii=0; ii<dem.getNx(); ii++) {
-			if (dem(ii,jj)==IOUtils::nodata) continue;
-
-			Sun.resetAltitude( dem(ii,jj) );
-			Sun.calculateRadiation(ta(ii,jj), rh(ii,jj), p(ii,jj), .5); //we don't have any albedo, so use .5
-			double cell_toa, cell_direct, cell_diffuse;
-			Sun.getHorizontalRadiation(cell_toa, cell_direct, cell_diffuse);
-
-			if (glob_day && shading) { //at dawn/dusk, we consider it to be all diffuse, so no shading
-				const double tan_horizon = DEMAlgorithms::getHorizon(dem, ii, jj, solarAzimuth);
-
-				//redo the splitting using the distributed splitting coefficient
-				const double global = cell_direct + cell_diffuse;
-				cell_direct = global * (1. - Md(ii,jj));
-				cell_diffuse = global * Md(ii,jj);
-
-				if ( tan_sun_elev<tan_horizon ) cell_direct = 0.;//cell is shaded
-			}
-			if (project_on_slope && glob_day && cell_direct>0.) {
-				cell_direct = SunTrajectory::projectHorizontalToSlope( solarAzimuth, solarElevation, dem.azi(ii,jj), dem.slope(ii,jj), cell_direct );
-			}
-			grid(ii,jj) = Corr(ii,jj) * (cell_direct+cell_diffuse);
+	for (size_t kk=0; kk<cells.size(); kk++) {
+		const size_t ii = cells[kk] % nx;
+		const size_t jj = cells[kk] / nx;
+		double cell_direct = vec_direct[kk];
+		double cell_diffuse = vec_diffuse[kk];
+
+		if (glob_day && shading) { //at dawn/dusk, we consider it to be all diffuse, so no shading
+			const double tan_horizon = (use_horizons)? horizons.getHorizon(ii, jj, solarAzimuth) : DEMAlgorithms::getHorizon(dem, ii, jj, solarAzimuth);
+
+			//redo the splitting using the distributed splitting coefficient
+			const double global = cell_direct + cell_diffuse;
+			cell_direct = global * (1. - Md(ii,jj));
+			cell_diffuse = global * Md(ii,jj);
+
+			if ( tan_sun_elev<tan_horizon ) cell_direct = 0.;//cell is shaded
+		}
+		if (project_on_slope && glob_day && cell_direct>0.) {
+			cell_direct = SunTrajectory::projectHorizontalToSlope( solarAzimuth, solarElevation, dem.azi(ii,jj), dem.slope(ii,jj), cell_direct );
 		}
+		grid(ii,jj) = Corr(ii,jj) * (cell_direct+cell_diffuse);
 	}
 }
 
@@ -27,7 +27,7 @@ namespace mio {
 WinstralAlgorithm::WinstralAlgorithm(const std::vector< std::pair<std::string, std::string> >& vecArgs, const std::string& i_algo, const std::string& i_param, TimeSeriesManager& i_tsm,
 		                               GridsManager& i_gdm, Meteo2DInterpolator& i_mi)
                   : InterpolationAlgorithm(vecArgs, i_algo, i_param, i_tsm), mi(i_mi), gdm(i_gdm), base_algo_user("IDW_LAPSE"), ref_station(),
-                    user_synoptic_bearing(IOUtils::nodata), inputIsAllZeroes(false), dmax(300.)
+                    user_synoptic_bearing(IOUtils::nodata), inputIsAllZeroes(false), sx_cache(), dmax(300.), use_sx_cache(true)
 {
 	const std::string where( "Interpolations2D::"+i_param+"::"+i_algo );
 	synoptic_wind_type type = AUTO;
@@ -50,9 +50,17 @@ WinstralAlgorithm::WinstralAlgorithm(const std::vector< std::pair<std::string, s
 			has_synop = true;
 		} else if (vecArgs[ii].first=="DMAX") {
 			IOUtils::parseArg(vecArgs[ii], where, dmax);
+		} else if (vecArgs[ii].first=="SX_CACHE") {
+			IOUtils::parseArg(vecArgs[ii], where, use_sx_cache);
+		} else if (vecArgs[ii].first=="SX_CACHE_SIZE") {
+			size_t max_sectors;
+			IOUtils::parseArg(vecArgs[ii], where, max_sectors);
+			sx_cache.setMaxSectors(max_sectors);
 		}
 	}
 
+	sx_cache.setDmax(dmax);
+
 	if (type==AUTO && (has_synop || has_ref)) throw InvalidArgumentException("No REF_STATION or DW_SYNOP arguments expected when TYPE=AUTO for "+where, AT);
 	if (has_synop && has_ref) throw InvalidArgumentException("It is not possible to provide both REF and DW_SYNOP for "+where, AT);
 	if (type==FIXED && !has_synop) throw InvalidArgumentException("Please provide DW_SYNOP for "+where, AT);
@@ -232,7 +240,13 @@ void WinstralAlgorithm::calculate(const DEMObject& dem, Grid2DObject& grid)
 	mi.interpolate(date, dem, MeteoData::TA, ta);
 
 	//alter the field with Winstral and the chosen wind direction
-	Interpol2D::Winstral(dem, ta,  dmax, synoptic_bearing, grid);
+	if (use_sx_cache) {
+		Grid2DObject Sx;
+		sx_cache.getSx(dem, synoptic_bearing, Sx, nb_threads);
+		Interpol2D::Winstral(Sx, ta, grid);
+	} else {
+		Interpol2D::Winstral(dem, ta,  dmax, synoptic_bearing, grid, nb_threads);
+	}
 }
 
 } //namespace
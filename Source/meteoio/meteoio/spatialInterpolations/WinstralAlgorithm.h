@@ -20,6 +20,7 @@
 #define WINSTRAL_ALGORITHM_H
 
 #include <meteoio/spatialInterpolations/InterpolationAlgorithms.h>
+#include <meteoio/meteoStats/libinterpol2D.h>
 
 namespace mio {
 
@@ -47,6 +48,12 @@ namespace mio {
  *     - REF_STATION: the wind direction at the provided station is assumed to be the synoptic wind direction. It then needs the following argument:
  *          - REF_STATION: the station ID providing the wind direction;
  *  - DMAX: maximum search distance or radius (default: 300m);
+ *  - SX_CACHE: keep the wind exposure grids of each 5° wind sector in memory and blend the two sectors that are closest
+ * to the wind direction instead of recomputing the wind exposure at each time step (default: true). This is much faster
+ * but each cached sector takes as much memory as the DEM and the cache is flushed whenever the DEM changes;
+ *  - SX_CACHE_SIZE: maximum number of wind sectors kept in the cache, the least recently used sectors being dropped first (default: 24).
+ * If a wind direction field needs more sectors than this, the missing sectors are computed again for this field only and blended
+ * the same way, so the results do not depend on the cache size (but this is slower);
  *
  * If type=AUTO, the synoptic wind direction will be computed as follow:
  * the stations are located in the DEM and their wind shading (or exposure) is computed. If at least one station is found
@@ -88,7 +95,9 @@ class WinstralAlgorithm : public InterpolationAlgorithm {
 		std::string base_algo_user, ref_station;
 		double user_synoptic_bearing;
 		bool inputIsAllZeroes;
+		WinstralSxCache sx_cache;
 		double dmax;
+		bool use_sx_cache;
 };
 
 } //end namespace mio
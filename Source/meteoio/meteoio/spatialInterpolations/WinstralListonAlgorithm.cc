@@ -26,7 +26,7 @@ namespace mio {
 WinstralListonAlgorithm::WinstralListonAlgorithm(const std::vector< std::pair<std::string, std::string> >& vecArgs, const std::string& i_algo, const std::string& i_param, TimeSeriesManager& i_tsm,
 		                               GridsManager& i_gdm, Meteo2DInterpolator& i_mi)
                   : InterpolationAlgorithm(vecArgs, i_algo, i_param, i_tsm), mi(i_mi), gdm(i_gdm), base_algo_user("IDW_LAPSE"),
-                    inputIsAllZeroes(false), dmax(300.)
+                    inputIsAllZeroes(false), sx_cache(), dmax(300.), use_sx_cache(true)
 {
 	const std::string where( "Interpolations2D::"+i_param+"::"+i_algo );
 	bool has_base=false;
@@ -37,8 +37,15 @@ WinstralListonAlgorithm::WinstralListonAlgorithm(const std::vector< std::pair<st
 			has_base = true;
 		} else if (vecArgs[ii].first=="DMAX") {
 			IOUtils::parseArg(vecArgs[ii], where, dmax);
+		} else if (vecArgs[ii].first=="SX_CACHE") {
+			IOUtils::parseArg(vecArgs[ii], where, use_sx_cache);
+		} else if (vecArgs[ii].first=="SX_CACHE_SIZE") {
+			size_t max_sectors;
+			IOUtils::parseArg(vecArgs[ii], where, max_sectors);
+			sx_cache.setMaxSectors(max_sectors);
 		}
 	}
+	sx_cache.setDmax(dmax);
 
 	if (!has_base) throw InvalidArgumentException("Wrong number of arguments supplied for "+where, AT);
 }
@@ -90,7 +97,13 @@ void WinstralListonAlgorithm::calculate(const DEMObject& dem, Grid2DObject& grid
 	mi.interpolate(date, dem, MeteoData::VW, vw);
 
 	//alter the field with Winstral and the chosen wind direction
-	Interpol2D::Winstral(dem, ta, dw, vw, dmax, grid);
+	if (use_sx_cache) {
+		Grid2DObject Sx;
+		sx_cache.getSx(dem, dw, Sx, nb_threads);
+		Interpol2D::Winstral(Sx, ta, vw, grid);
+	} else {
+		Interpol2D::Winstral(dem, ta, dw, vw, dmax, grid, nb_threads);
+	}
 }
 
 } //namespace
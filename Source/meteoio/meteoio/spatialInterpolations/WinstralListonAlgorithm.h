@@ -20,6 +20,7 @@
 #define WINSTRAL_LISTON_ALGORITHM_H
 
 #include <meteoio/spatialInterpolations/InterpolationAlgorithms.h>
+#include <meteoio/meteoStats/libinterpol2D.h>
 
 namespace mio {
 
@@ -42,6 +43,12 @@ namespace mio {
  * "avg" if only one station can provide the precipitation at a given time step (for an easy fallback). Please do not forget
  * to provide any necessary arguments for this base method!
  *  - DMAX: maximum search distance or radius (default: 300m);
+ *  - SX_CACHE: keep the wind exposure grids of each 5° wind sector in memory and blend the two sectors that are closest
+ * to the wind direction instead of recomputing the wind exposure at each time step (default: true). This is much faster
+ * but each cached sector takes as much memory as the DEM and the cache is flushed whenever the DEM changes;
+ *  - SX_CACHE_SIZE: maximum number of wind sectors kept in the cache, the least recently used sectors being dropped first (default: 24).
+ * When the wind directions of a time step need more sectors than this, the missing sectors are computed again for this time step
+ * only and blended the same way, so the results do not depend on the cache size (but this is slower);
  *
  * @remarks
  *  - Only cells with an air temperature below freezing participate in the redistribution
@@ -68,7 +75,9 @@ class WinstralListonAlgorithm : public InterpolationAlgorithm {
 		GridsManager& gdm;
 		std::string base_algo_user;
 		bool inputIsAllZeroes;
+		WinstralSxCache sx_cache;
 		double dmax;
+		bool use_sx_cache;
 };
 
 } //end namespace mio
@@ -25,7 +25,7 @@ namespace mio {
 WinstralListonDriftAlgorithm::WinstralListonDriftAlgorithm(const std::vector< std::pair<std::string, std::string> >& vecArgs, const std::string& i_algo, const std::string& i_param, TimeSeriesManager& i_tsm,
 		                               GridsManager& i_gdm, Meteo2DInterpolator& i_mi)
                   : InterpolationAlgorithm(vecArgs, i_algo, i_param, i_tsm), mi(i_mi), gdm(i_gdm), base_algo_user("IDW_LAPSE"), ref_station(),
-                    inputIsAllZeroes(false), dmax(300.)
+                    inputIsAllZeroes(false), sx_cache(), dmax(300.), use_sx_cache(true)
 {
 	const std::string where( "Interpolations2D::"+i_param+"::"+i_algo );
 	bool has_base=false, has_ref=false;
@@ -39,8 +39,15 @@ WinstralListonDriftAlgorithm::WinstralListonDriftAlgorithm(const std::vector< st
 			has_base = true;
 		} else if (vecArgs[ii].first=="DMAX") {
 			IOUtils::parseArg(vecArgs[ii], where, dmax);
+		} else if (vecArgs[ii].first=="SX_CACHE") {
+			IOUtils::parseArg(vecArgs[ii], where, use_sx_cache);
+		} else if (vecArgs[ii].first=="SX_CACHE_SIZE") {
+			size_t max_sectors;
+			IOUtils::parseArg(vecArgs[ii], where, max_sectors);
+			sx_cache.setMaxSectors(max_sectors);
 		}
 	}
+	sx_cache.setDmax(dmax);
 
 	//if (!has_ref || !has_base) throw InvalidArgumentException("Wrong number of arguments supplied for "+where, AT);
 }
@@ -126,7 +133,13 @@ void WinstralListonDriftAlgorithm::calculate(const DEMObject& dem, Grid2DObject&
 	mi.interpolate(date, dem, MeteoData::VW, vw);
 
 	//alter the field with Winstral and the chosen wind direction
-	Interpol2D::WinstralDrift(dem, dw, vw, dmax, grid);
+	if (use_sx_cache) {
+		Grid2DObject Sx;
+		sx_cache.getSx(dem, dw, Sx, nb_threads);
+		Interpol2D::WinstralDrift(Sx, vw, grid);
+	} else {
+		Interpol2D::WinstralDrift(dem, dw, vw, dmax, grid, nb_threads);
+	}
 }
 
 } //namespace
@@ -19,9 +19,39 @@
 #define WINSTRAL_LISTON_DRIFT_ALGORITHM_H
 
 #include <meteoio/spatialInterpolations/InterpolationAlgorithms.h>
+#include <meteoio/meteoStats/libinterpol2D.h>
 
 namespace mio {
 
+/**
+ * @class WinstralListonDriftAlgorithm
+ * @ingroup spatialization
+ * @brief DEM-based wind-exposure snow drift algorithm, for spatially explicit varying DW and VW fields.
+ * @details
+ * This is a variation of the WinstralListonAlgorithm: the wind exposure factors are computed from the DEM for the wind
+ * directions taken from a 2D wind direction field and combined with a 2D wind velocity field in order to
+ * redistribute the initial precipitation field.
+ *
+ * It takes the following arguments:
+ *  - BASE:: provide the base algorithm to pre-fill the grid (default: "idw_lapse", switching to "avg" if only one station
+ * can provide data at a given time step). Please do not forget to provide any necessary arguments for this base method!
+ *  - REF: station ID whose wind must be available for this algorithm to be used (optional);
+ *  - DMAX: maximum search distance or radius (default: 300m);
+ *  - SX_CACHE: keep the wind exposure grids of each 5° wind sector in memory and blend the two sectors that are closest
+ * to the wind direction instead of recomputing the wind exposure at each time step (default: true). This is much faster
+ * but each cached sector takes as much memory as the DEM and the cache is flushed whenever the DEM changes;
+ *  - SX_CACHE_SIZE: maximum number of wind sectors kept in the cache, the least recently used sectors being dropped first (default: 24).
+ * When the wind directions of a time step need more sectors than this, the missing sectors are computed again for this time step
+ * only and blended the same way, so the results do not depend on the cache size (but this is slower);
+ *
+ * @remarks Using the WinstralListonDriftAlgorithm also requires the specification of interpolation methods for DW and VW
+ *
+ * @code
+ * PSUM::algorithms                = WINSTRAL++_DRIFT
+ * PSUM::winstral++_drift::dmax    = 300
+ * PSUM::winstral++_drift::sx_cache_size = 36
+ * @endcode
+ */
 class WinstralListonDriftAlgorithm : public InterpolationAlgorithm {
 	public:
 		WinstralListonDriftAlgorithm(const std::vector< std::pair<std::string, std::string> >& vecArgs, const std::string& i_algo, const std::string& i_param, TimeSeriesManager& i_tsm,
@@ -37,7 +67,9 @@ class WinstralListonDriftAlgorithm : public InterpolationAlgorithm {
 		GridsManager& gdm;
 		std::string base_algo_user, ref_station;
 		bool inputIsAllZeroes;
+		WinstralSxCache sx_cache;
 		double dmax;
+		bool use_sx_cache;
 };
 
 } //end namespace mio
@@ -325,6 +325,63 @@ bool check_regressions(const vector<double>& x, const vector<double>& y) {
 	return status;
 }
 
+//slide windows of random widths along a series containing nodata and duplicates and compare
+//the SortedWindow statistics with the ones computed from scratch on each window
+bool check_sorted_window() {
+	const size_t N = 2000;
+	srand( 12345 ); //fixed seed so a failure can be reproduced
+	vector<double> data(N);
+	for (size_t ii=0; ii<N; ++ii) {
+		if (rand()%10==0) data[ii] = IOUtils::nodata;
+		else if (rand()%3==0) data[ii] = static_cast<double>(rand()%5); //lots of duplicates
+		else data[ii] = rand()/(double)RAND_MAX*rand_range - rand_range/2.;
+	}
+
+	static const double arr[] = {0., .1, .25, .5, .75, .9, 1.};
+	const vector<double> quartiles(arr, arr + sizeof(arr) / sizeof(arr[0]));
+	SortedWindow window;
+	bool status = true;
+	size_t nr_odd=0, nr_even=0;
+	for (size_t ii=0; ii<N && status; ++ii) {
+		const size_t width = 1 + rand()%24;
+		const size_t start = (ii>=width)? ii-width+1+rand()%width : 0; //the window overlaps the previous one, but not always
+		const size_t end = std::min(N-1, start+width-1);
+		window.slide(data, start, end);
+
+		const vector<double> win_data(data.begin()+start, data.begin()+end+1);
+		const double median_ref = Interpol1D::getMedian(win_data);
+		const double mad_ref = Interpol1D::getMedianAverageDeviation(win_data);
+		const vector<double> quantiles_ref = Interpol1D::quantiles(win_data, quartiles);
+		if (window.size()%2==1) nr_odd++;
+		else nr_even++;
+
+		if (!IOUtils::checkEpsilonEquality(window.getMedian(), median_ref, 1e-9)) {
+			std::cout << setprecision(12) << "Window [" << start << "-" << end << "]: median should be " << median_ref << ", computed " << window.getMedian() << "\n";
+			status = false;
+		}
+		if (!IOUtils::checkEpsilonEquality(window.getMAD(), mad_ref, 1e-9)) {
+			std::cout << setprecision(12) << "Window [" << start << "-" << end << "]: MAD should be " << mad_ref << ", computed " << window.getMAD() << "\n";
+			status = false;
+		}
+		for (size_t jj=0; jj<quartiles.size(); ++jj) {
+			if (!IOUtils::checkEpsilonEquality(window.getQuantile(quartiles[jj]), quantiles_ref[jj], 1e-9)) {
+				std::cout << setprecision(12) << "Window [" << start << "-" << end << "]: quantile " << quartiles[jj] << " should be " << quantiles_ref[jj] << ", computed " << window.getQuantile(quartiles[jj]) << "\n";
+				status = false;
+			}
+		}
+	}
+	if (nr_odd==0 || nr_even==0) {
+		std::cout << "Sorted window: both odd and even window sizes should have been tested\n";
+		status = false;
+	}
+
+	if(status)
+		std::cout << "Sorted window: success\n";
+	else
+		std::cout << "Sorted window: failed\n";
+	return status;
+}
+
 int main() {
 	vector<double> x,y;
 	//cr_rand_vectors(x, y);
@@ -337,8 +394,9 @@ int main() {
 	const bool der_status = check_derivative(x,y);
 	const bool quantiles_status = check_quantiles(x);
 	const bool regressions_status = check_regressions(x, y);
+	const bool sorted_window_status = check_sorted_window();
 
-	if(!basics_status || !sort_status || !bin_status || !quantiles_status || !covariance_status || !der_status || !regressions_status)
+	if(!basics_status || !sort_status || !bin_status || !quantiles_status || !covariance_status || !der_status || !regressions_status || !sorted_window_status)
 		throw IOException("Statistical functions error!", AT);
 
 
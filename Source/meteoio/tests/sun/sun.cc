@@ -83,6 +83,54 @@ bool writeSun24h(ofstream& os, const mio::Date start_date, const double i_iswr_r
 }
 
 
+//compare the radiation computed for many locations at once with the radiation computed for each location
+bool checkGridRadiation(const mio::Date start_date)
+{
+	static const double altitudes[] = {0., 500., 1500., 2192., 2999., 3000., 4500.};
+	static const double pressures[] = {IOUtils::nodata, 101325., 85000., 78000., 70000., 65000., 58000.};
+	static const double tas[] = {273.15+11., 273.15-20., IOUtils::nodata, 273.15+25., 273.15, 273.15+5., 273.15-5.};
+	static const double rhs[] = {0.5, 0.9, 0.5, IOUtils::nodata, 0.1, 1., 0.7};
+	const size_t nr_locations = sizeof(altitudes) / sizeof(double);
+	const std::vector<double> vecAlt(altitudes, altitudes+nr_locations), vecP(pressures, pressures+nr_locations);
+	const std::vector<double> vecTA(tas, tas+nr_locations), vecRH(rhs, rhs+nr_locations);
+
+	mio::SunObject gridSun(46.77181, 9.86820, 2192.), pointSun(46.77181, 9.86820, 2192.);
+	for (mio::Date date(start_date); date <= (start_date+1.); date+=(30./minutes_per_day)) { //every 30 minutes
+		gridSun.setDate(date.getJulian(), date.getTimeZone());
+		pointSun.setDate(date.getJulian(), date.getTimeZone());
+
+		std::vector<double> vecDirect, vecDiffuse;
+		gridSun.getHorizontalRadiation(vecAlt, vecTA, vecRH, vecP, mean_albedo, vecDirect, vecDiffuse);
+		for (size_t ii=0; ii<nr_locations; ii++) {
+			pointSun.resetAltitude(vecAlt[ii]);
+			pointSun.calculateRadiation(vecTA[ii], vecRH[ii], vecP[ii], mean_albedo);
+			double toa, direct, diffuse;
+			pointSun.getHorizontalRadiation(toa, direct, diffuse);
+			if (!IOUtils::checkEpsilonEquality(direct, vecDirect[ii], 1e-9) || !IOUtils::checkEpsilonEquality(diffuse, vecDiffuse[ii], 1e-9)) {
+				std::cout << "\n -- error: at " << date.toString(Date::ISO) << " and " << vecAlt[ii] << " m, the radiation for many locations (";
+				std::cout << vecDirect[ii] << ", " << vecDiffuse[ii] << ") differs from the radiation of a single location (" << direct << ", " << diffuse << ")\n";
+				return false;
+			}
+		}
+	}
+
+	//at night, invalid inputs are not used so they must be accepted as for a single location
+	const mio::Date night(start_date.getJulian()+1./24., start_date.getTimeZone()); //02:00
+	gridSun.setDate(night.getJulian(), night.getTimeZone());
+	const std::vector<double> vecInvalidTA(nr_locations, -10.);
+	std::vector<double> vecDirect, vecDiffuse;
+	gridSun.getHorizontalRadiation(vecAlt, vecInvalidTA, vecRH, vecP, mean_albedo, vecDirect, vecDiffuse);
+	for (size_t ii=0; ii<nr_locations; ii++) {
+		const double expected = (vecRH[ii]==IOUtils::nodata)? IOUtils::nodata : 0.;
+		if (vecDirect[ii]!=expected || vecDiffuse[ii]!=expected) {
+			std::cout << "\n -- error: the radiation for many locations at night should be " << expected << ", got (" << vecDirect[ii] << ", " << vecDiffuse[ii] << ")\n";
+			return false;
+		}
+	}
+
+	return true;
+}
+
 // print out header to know which line is which
 void printHeader(ostream& os){
 	os << "# date" << "\t" ;
@@ -126,5 +174,11 @@ int main()
 	}
 	ofs.close();
 
+	// ----- Compare the radiation for many locations at once with the radiation of each location ------
+	std::cout << " --- Compare the radiation computed for many locations with the radiation of each location\n";
+	for (list<mio::Date>::iterator it_date = date.begin(); it_date != date.end(); it_date++) {
+		if (!checkGridRadiation(*it_date)) exit(1);
+	}
+
 	return 0;
 }
@@ -24,6 +24,10 @@
 #include <string>
 #include <sstream>
 #include <ctime>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 #ifdef _MSC_VER
 	/*
@@ -105,6 +109,9 @@ static string mode = "RESEARCH";
 bool restart = false;
 static mio::Date dateBegin, dateEnd;
 static vector<string> vecStationIDs;
+static unsigned int nr_threads = 1;
+static bool write_forcing = false;
+static std::mutex forcing_mutex;
 
 /// @brief Main control parameters
 struct MainControl
@@ -120,6 +127,35 @@ struct MainControl
 	bool   resFirstDump; ///< Flag to dump initial state of snowpack
 };
 
+/// @brief Outcome of the simulation of one station
+struct StationReport
+{
+	typedef enum STATUS {
+		PENDING, ///< not simulated (yet)
+		DONE,    ///< the simulation ran
+		SKIPPED, ///< the station could not be initialized (inconsistent or too recent sno files)
+		FAILED   ///< the simulation threw an exception
+	} status_type;
+
+	StationReport() : status(PENDING), error() {}
+	status_type status;
+	std::string error; ///< message of the exception that stopped the simulation
+};
+
+/**
+ * @brief Everything that a thread needs in order to simulate stations on its own
+ * @details Each worker has its own copy of the configuration and its own data managers, so that
+ * several stations can be simulated concurrently.
+ */
+struct StationsWorker
+{
+	StationsWorker(const SnowpackConfig& i_cfg);
+
+	SnowpackConfig cfg;
+	SnowpackIO snowpackio;
+	mio::IOManager io;
+};
+
 /************************************************************
  * non-static section                                       *
  ************************************************************/
@@ -200,6 +236,12 @@ void Slope::setSlope(const unsigned int slope_sequence, vector<SnowStation>& vec
 	south = (vecXdata[sector].meta.getSlopeAngle() > 0. && vecXdata[sector].meta.getAzimuth() == 180.);
 }
 
+StationsWorker::StationsWorker(const SnowpackConfig& i_cfg)
+               : cfg(i_cfg), snowpackio(cfg), io(cfg)
+{
+	io.setMinBufferRequirements(IOUtils::nodata, 1.1); //we require the buffer to contain at least 1.1 day before the current point
+}
+
 Cumsum::Cumsum(const unsigned int nSlopes)
         : precip(0.),
           drift(0.), snow(0.), runoff(0.), rain(0.),
@@ -229,6 +271,7 @@ inline void Usage(const string& programname)
 		<< "\t[-m, --mode=<operational or research>] (default: research)\n"
 		<< "\t[-r, --restart (skip first time step, only in research mode)\n"
 		<< "\t[-s, --stations=<comma delimited stationnames>] (e.g. DAV2,WFJ2)\n"
+		<< "\t[-t, --threads=<number of threads>] Simulate several stations in parallel (default: 1)\n"
 		<< "\t[-v, --version] Print the version number\n"
 		<< "\t[-h, --help] Print help message and version information\n\n";
 	cout << "\tPlease note that the operational mode should only be used within SLF\n";
@@ -249,6 +292,7 @@ inline void parseCmdLine(int argc, char **argv, string& begin_date_str, string&
 		{"restart", no_argument, 0, 'r'},
 		{"config", required_argument, 0, 'c'},
 		{"stations", required_argument, 0, 's'},
+		{"threads", required_argument, 0, 't'},
 		{"version", no_argument, 0, 'v'},
 		{"help", no_argument, 0, 'h'},
 		{0, 0, 0, 0}
@@ -259,7 +303,7 @@ inline void parseCmdLine(int argc, char **argv, string& begin_date_str, string&
 		exit(1);
 	}
 
-	while ((opt=getopt_long( argc, argv, ":b:e:m:rc:s:v:h", long_options, &longindex)) != -1) {
+	while ((opt=getopt_long( argc, argv, ":b:e:m:rc:s:t:v:h", long_options, &longindex)) != -1) {
 		switch (opt) {
 		case 0:
 			break;
@@ -290,6 +334,13 @@ inline void parseCmdLine(int argc, char **argv, string& begin_date_str, string&
 		case 's':
 			mio::IOUtils::readLineToVec(string(optarg), vecStationIDs, ',');
 			break;
+		case 't':
+			if (!mio::IOUtils::convertString(nr_threads, string(optarg)) || nr_threads==0) {
+				cerr << endl << "[E] Command line option '-" << char(opt) << "' requires a strictly positive number of threads as operand\n";
+				Usage(string(argv[0]));
+				exit(1);
+			}
+			break;
 		case ':': //operand missing
 			cerr << endl << "[E] Command line option '-" << char(opt) << "' requires an operand\n";
 			Usage(string(argv[0]));
@@ -937,40 +988,17 @@ inline void printStartInfo(const SnowpackConfig& cfg, const std::string& name)
 	}
 }
 
-// SNOWPACK MAIN **************************************************************
-inline void real_main (int argc, char *argv[])
+/**
+ * @brief Run the simulation of one station (including its virtual slopes)
+ * @param cfg configuration for this station (it is altered during the simulation)
+ * @param io meteo data manager of the calling worker
+ * @param snowpackio snowpack data manager of the calling worker
+ * @param i_stn index of the station in vecStationIDs
+ * @return false if the station had to be skipped
+ */
+inline bool runStation(SnowpackConfig& cfg, mio::IOManager& io, SnowpackIO& snowpackio, const size_t& i_stn)
 {
-	setbuf(stdout, NULL); //always flush stdout
-	setbuf(stderr, NULL); //always flush stderr
-#ifdef DEBUG_ARITHM
-	feenableexcept(FE_DIVBYZERO | FE_INVALID | FE_OVERFLOW ); //for halting the process at arithmetic exceptions, see also ReSolver1d
-#endif
-	//parse the command line arguments
-	std::string begin_date_str, end_date_str;
-	parseCmdLine(argc, argv, begin_date_str, end_date_str);
-
 	const bool prn_check = false;
-	mio::Timer meteoRead_timer;
-	mio::Timer run_timer;
-	run_timer.start();
-	time_t nowSRT = time(NULL);
-	MainControl mn_ctrl; //Time step control parameters
-
-	SnowpackConfig cfg(cfgfile);
-	addSpecialKeys(cfg);
-
-	const double i_time_zone = cfg.get("TIME_ZONE", "Input"); //get user provided input time_zone
-	if (!begin_date_str.empty()) {
-		mio::IOUtils::convertString(dateBegin, begin_date_str, i_time_zone);
-	}
-	if (end_date_str == "NOW") { //interpret user provided end date
-		dateEnd.setFromSys();
-		dateEnd.setTimeZone(i_time_zone);
-		dateEnd.rnd(1800, mio::Date::DOWN);
-	} else {
-		mio::IOUtils::convertString(dateEnd, end_date_str, i_time_zone);
-	}
-
 	const std::string variant = cfg.get("VARIANT", "SnowpackAdvanced");
 	const std::string experiment = cfg.get("EXPERIMENT", "Output");
 	const std::string outpath = cfg.get("METEOPATH", "Output");
@@ -978,11 +1006,6 @@ inline void real_main (int argc, char *argv[])
 	const bool useCanopyModel = cfg.get("CANOPY", "Snowpack");
 	const double calculation_step_length = cfg.get("CALCULATION_STEP_LENGTH", "Snowpack");
 	const double sn_dt = M_TO_S(calculation_step_length); //Calculation time step in seconds
-
-	int nSolutes = Constants::iundefined;
-	cfg.getValue("NUMBER_OF_SOLUTES", "Input", nSolutes, mio::IOUtils::nothrow);
-	if (nSolutes > 0) SnowStation::number_of_solutes = static_cast<short unsigned int>(nSolutes);
-
 	//Interval between profile backups (*.sno\<JulianDate\>) (d)
 	double backup_days_between = 400.;
 	cfg.getValue("SNOW_DAYS_BETWEEN", "Output", backup_days_between, mio::IOUtils::nothrow);
@@ -1009,446 +1032,558 @@ inline void real_main (int argc, char *argv[])
 	const bool advective_heat = cfg.get("ADVECTIVE_HEAT", "SnowpackAdvanced");
 	const bool soil_flux = cfg.get("SOIL_FLUX", "Snowpack");
 
-	//If the user provides the stationIDs - operational use case
-	if (!vecStationIDs.empty()) { //operational use case: stationIDs provided on the command line
-		for (size_t i_stn=0; i_stn<vecStationIDs.size(); i_stn++) {
-			stringstream ss;
-			ss << "STATION" << i_stn+1;
-			cfg.addKey(ss.str(), "Input", vecStationIDs[i_stn]);
-		}
-	}
+	cout << endl;
+	prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "Run on meteo station %s", vecStationIDs[i_stn].c_str());
+	mio::Timer meteoRead_timer;
+	mio::Timer run_timer;
+	run_timer.start();
+	MainControl mn_ctrl; //Time step control parameters
 
-	SnowpackIO snowpackio(cfg);
-	mio::IOManager io(cfg);
-	io.setMinBufferRequirements(IOUtils::nodata, 1.1); //we require the buffer to contain at least 1.1 day before the current point
+	Slope slope(cfg);
+	Cumsum cumsum(slope.nSlopes);
+
+	double lw_in = Constants::undefined;    // Storage for LWin from flat field energy balance
+
+	// Used to scale wind for blowing and drifting snowpack (from statistical analysis)
+	double wind_scaling_factor = cfg.get("WIND_SCALING_FACTOR", "SnowpackAdvanced");
+
+	// Control of time window: used for adapting diverging snow depth in operational mode
+	double time_count_deltaHS = 0.;
+
+	// Snowpack data (input/output)
+	ZwischenData sn_Zdata;   // "Memory"-data, required for every operational station
+	vector<SN_SNOWSOIL_DATA> vecSSdata(slope.nSlopes, SN_SNOWSOIL_DATA(/*number_of_solutes*/));
+	vector<SnowStation> vecXdata;
+	for (size_t ii=0; ii<slope.nSlopes; ii++) //fill vecXdata with *different* SnowStation objects
+		vecXdata.push_back( SnowStation(useCanopyModel, useSoilLayers, (variant=="SEAICE")/*, number_of_solutes*/) );
+
+	// Create meteo data object to hold interpolated current time steps
+	CurrentMeteo Mdata(cfg);
+	// To collect surface exchange data for output
+	SurfaceFluxes surfFluxes/*(number_of_solutes)*/;
+	// Boundary condition (fluxes)
+	BoundCond sn_Bdata;
+
+	mio::Date current_date( dateBegin );
+	meteoRead_timer.start();
+	if (mode == "OPERATIONAL")
+		cfg.addKey("PERP_TO_SLOPE", "SnowpackAdvanced", "false");
+	const bool read_slope_status = readSlopeMeta(io, snowpackio, cfg, i_stn, slope, current_date, vecSSdata, vecXdata, sn_Zdata, Mdata, wind_scaling_factor, time_count_deltaHS);
+	meteoRead_timer.stop();
+	if (!read_slope_status) return false; //something went wrong, move to the next station
+
+	memset(&mn_ctrl, 0, sizeof(MainControl));
+	if (mode == "RESEARCH") {
+		mn_ctrl.resFirstDump = true; //HACK to dump the initial state in research mode
+		deleteOldOutputFiles(outpath, experiment, vecStationIDs[i_stn], slope.nSlopes, snowpackio.getExtensions());
+		cfg.write(outpath + "/" + vecStationIDs[i_stn] + "_" + experiment + ".ini"); //output config
+		if (!restart) current_date -= calculation_step_length/(24.*60.);
+	} else {
+		const std::string db_name = cfg.get("DBNAME", "Output", "");
+		if (db_name == "sdbo" || db_name == "sdbt")
+			mn_ctrl.sdbDump = true;
+	}
 
-	if (vecStationIDs.empty()) { //research use case: stationIDs provided by the available input files
-		vector<StationData> accessible_stations;
-		io.getStationData(dateEnd, accessible_stations); //we are retrieving meta information from MeteoIO
-		for (size_t ii=0; ii<accessible_stations.size(); ii++) {
-			vecStationIDs.push_back( accessible_stations[ii].getStationID() ); //HACK: accessible_stations should be directly used
+	SunObject sun(vecSSdata[slope.mainStation].meta.position.getLat(), vecSSdata[slope.mainStation].meta.position.getLon(), vecSSdata[slope.mainStation].meta.position.getAltitude());
+	sun.setElevationThresh(0.6);
+	vector<ProcessDat> qr_Hdata;     //Hazard data for t=0...tn
+	vector<ProcessInd> qr_Hdata_ind; //Hazard data Index for t=0...tn
+	const double duration = (dateEnd.getJulian() - current_date.getJulian() + 0.5/24)*24*3600; //HACK: why is it computed this way?
+	Hazard hazard(cfg, duration);
+	hazard.initializeHazard(sn_Zdata.drift24, vecXdata.at(0).meta.getSlopeAngle(), qr_Hdata, qr_Hdata_ind);
+
+	prn_msg(__FILE__, __LINE__, "msg", mio::Date(), "Start simulation for %s on %s",
+		vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO_TZ).c_str());
+	prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "End date specified by user: %s",
+	        dateEnd.toString(mio::Date::ISO_TZ).c_str());
+	prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "Integration step length: %f min",
+	        calculation_step_length);
+
+	bool computed_one_timestep = false;
+	double meteo_step_length = -1.;
+	const bool enforce_snow_height = cfg.get("ENFORCE_MEASURED_SNOW_HEIGHTS", "Snowpack");
+
+	//from current_date to dateEnd, if necessary write out meteo forcing
+	{ //when running on multiple threads, only the first station to get there writes the forcing
+		std::lock_guard<std::mutex> lock(forcing_mutex);
+		if (write_forcing==true) {
+			writeForcing(current_date, dateEnd, calculation_step_length/1440, io);
+			write_forcing = false; //no need to call it again for the other stations
 		}
 	}
 
-	//now, let's start!
-	printStartInfo(cfg, string(argv[0]));
+	// START TIME INTEGRATION LOOP
+	do {
+		current_date += calculation_step_length/1440;
+		mn_ctrl.nStep++;
+		mn_ctrl.nAvg++;
 
-	// START LOOP OVER ALL STATIONS
-	bool write_forcing = cfg.get("WRITE_PROCESSED_METEO", "Output"); //it will be set to false once it has been done
-	for (size_t i_stn=0; i_stn<vecStationIDs.size(); i_stn++) {
-		cout << endl;
-		prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "Run on meteo station %s", vecStationIDs[i_stn].c_str());
-		run_timer.reset();
-		meteoRead_timer.reset();
-
-		Slope slope(cfg);
-		Cumsum cumsum(slope.nSlopes);
-
-		double lw_in = Constants::undefined;    // Storage for LWin from flat field energy balance
-
-		// Used to scale wind for blowing and drifting snowpack (from statistical analysis)
-		double wind_scaling_factor = cfg.get("WIND_SCALING_FACTOR", "SnowpackAdvanced");
-
-		// Control of time window: used for adapting diverging snow depth in operational mode
-		double time_count_deltaHS = 0.;
-
-		// Snowpack data (input/output)
-		ZwischenData sn_Zdata;   // "Memory"-data, required for every operational station
-		vector<SN_SNOWSOIL_DATA> vecSSdata(slope.nSlopes, SN_SNOWSOIL_DATA(/*number_of_solutes*/));
-		vector<SnowStation> vecXdata;
-		for (size_t ii=0; ii<slope.nSlopes; ii++) //fill vecXdata with *different* SnowStation objects
-			vecXdata.push_back( SnowStation(useCanopyModel, useSoilLayers, (variant=="SEAICE")/*, number_of_solutes*/) );
-
-		// Create meteo data object to hold interpolated current time steps
-		CurrentMeteo Mdata(cfg);
-		// To collect surface exchange data for output
-		SurfaceFluxes surfFluxes/*(number_of_solutes)*/;
-		// Boundary condition (fluxes)
-		BoundCond sn_Bdata;
-
-		mio::Date current_date( dateBegin );
+		// Get meteo data
+		vector<mio::MeteoData> vecMyMeteo;
 		meteoRead_timer.start();
-		if (mode == "OPERATIONAL")
-			cfg.addKey("PERP_TO_SLOPE", "SnowpackAdvanced", "false");
-		const bool read_slope_status = readSlopeMeta(io, snowpackio, cfg, i_stn, slope, current_date, vecSSdata, vecXdata, sn_Zdata, Mdata, wind_scaling_factor, time_count_deltaHS);
-		meteoRead_timer.stop();
-		if (!read_slope_status) continue; //something went wrong, move to the next station
-
-		memset(&mn_ctrl, 0, sizeof(MainControl));
-		if (mode == "RESEARCH") {
-			mn_ctrl.resFirstDump = true; //HACK to dump the initial state in research mode
-			deleteOldOutputFiles(outpath, experiment, vecStationIDs[i_stn], slope.nSlopes, snowpackio.getExtensions());
-			cfg.write(outpath + "/" + vecStationIDs[i_stn] + "_" + experiment + ".ini"); //output config
-			if (!restart) current_date -= calculation_step_length/(24.*60.);
-		} else {
-			const std::string db_name = cfg.get("DBNAME", "Output", "");
-			if (db_name == "sdbo" || db_name == "sdbt")
-				mn_ctrl.sdbDump = true;
+		io.getMeteoData(current_date, vecMyMeteo);
+		if(meteo_step_length<0.) {
+			std::stringstream ss2;
+			meteo_step_length = io.getAvgSamplingRate();
+			ss2 << "" << meteo_step_length;
+			cfg.addKey("METEO_STEP_LENGTH", "Snowpack", ss2.str());
 		}
-
-		SunObject sun(vecSSdata[slope.mainStation].meta.position.getLat(), vecSSdata[slope.mainStation].meta.position.getLon(), vecSSdata[slope.mainStation].meta.position.getAltitude());
-		sun.setElevationThresh(0.6);
-		vector<ProcessDat> qr_Hdata;     //Hazard data for t=0...tn
-		vector<ProcessInd> qr_Hdata_ind; //Hazard data Index for t=0...tn
-		const double duration = (dateEnd.getJulian() - current_date.getJulian() + 0.5/24)*24*3600; //HACK: why is it computed this way?
-		Hazard hazard(cfg, duration);
-		hazard.initializeHazard(sn_Zdata.drift24, vecXdata.at(0).meta.getSlopeAngle(), qr_Hdata, qr_Hdata_ind);
-
-		prn_msg(__FILE__, __LINE__, "msg", mio::Date(), "Start simulation for %s on %s",
-			vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO_TZ).c_str());
-		prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "End date specified by user: %s",
-		        dateEnd.toString(mio::Date::ISO_TZ).c_str());
-		prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "Integration step length: %f min",
-		        calculation_step_length);
-
-		bool computed_one_timestep = false;
-		double meteo_step_length = -1.;
-		const bool enforce_snow_height = cfg.get("ENFORCE_MEASURED_SNOW_HEIGHTS", "Snowpack");
-
-		//from current_date to dateEnd, if necessary write out meteo forcing
-		if (write_forcing==true) {
-			writeForcing(current_date, dateEnd, calculation_step_length/1440, io);
-			write_forcing = false; //no need to call it again for the other stations
+		meteoRead_timer.stop();
+		editMeteoData(vecMyMeteo[i_stn], variant, thresh_rain);
+		if (!validMeteoData(vecMyMeteo[i_stn], vecStationIDs[i_stn], variant, enforce_snow_height, advective_heat, soil_flux, slope.nSlopes)) {
+			prn_msg(__FILE__, __LINE__, "msg-", current_date, "No valid data for station %s on [%s]",
+			        vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO).c_str());
+			current_date -= calculation_step_length/1440;
+			break;
 		}
 
-		// START TIME INTEGRATION LOOP
-		do {
-			current_date += calculation_step_length/1440;
-			mn_ctrl.nStep++;
-			mn_ctrl.nAvg++;
-
-			// Get meteo data
-			vector<mio::MeteoData> vecMyMeteo;
-			meteoRead_timer.start();
-			io.getMeteoData(current_date, vecMyMeteo);
-			if(meteo_step_length<0.) {
-				std::stringstream ss2;
-				meteo_step_length = io.getAvgSamplingRate();
-				ss2 << "" << meteo_step_length;
-				cfg.addKey("METEO_STEP_LENGTH", "Snowpack", ss2.str());
-			}
-			meteoRead_timer.stop();
-			editMeteoData(vecMyMeteo[i_stn], variant, thresh_rain);
-			if (!validMeteoData(vecMyMeteo[i_stn], vecStationIDs[i_stn], variant, enforce_snow_height, advective_heat, soil_flux, slope.nSlopes)) {
-				prn_msg(__FILE__, __LINE__, "msg-", current_date, "No valid data for station %s on [%s]",
-				        vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO).c_str());
-				current_date -= calculation_step_length/1440;
-				break;
-			}
-
-			//determine which outputs will have to be done
-			getOutputControl(mn_ctrl, current_date, vecSSdata[slope.mainStation].profileDate, calculation_step_length,
-			                 tsstart, tsdaysbetween, profstart, profdaysbetween,
-			                 first_backup, backup_days_between);
-			//Radiation data
-			sun.setDate(current_date.getJulian(), current_date.getTimeZone());
-			const double hs_a3hl6 = getHS_last3hours(io, current_date);
-
-			// START LOOP OVER ASPECTS
-			for (unsigned int slope_sequence=0; slope_sequence<slope.nSlopes; slope_sequence++) {
-				double tot_mass_in = 0.; // To check mass balance over one CALCULATION_STEP_LENGTH if MASS_BALANCE is set
-				SnowpackConfig tmpcfg(cfg);
-
-				//fill Snowpack internal structure with forcing data
-				bool iswr_is_net = false;
-				copyMeteoData(vecMyMeteo[i_stn], Mdata, slope.prevailing_wind_dir, wind_scaling_factor, iswr_is_net);
-				Mdata.copySnowTemperatures(vecMyMeteo[i_stn], slope_sequence);
-				Mdata.copySolutes(vecMyMeteo[i_stn], SnowStation::number_of_solutes);
-				slope.setSlope(slope_sequence, vecXdata, Mdata.dw_drift);
-				dataForCurrentTimeStep(Mdata, surfFluxes, vecXdata, slope, tmpcfg,
+		//determine which outputs will have to be done
+		getOutputControl(mn_ctrl, current_date, vecSSdata[slope.mainStation].profileDate, calculation_step_length,
+		                 tsstart, tsdaysbetween, profstart, profdaysbetween,
+		                 first_backup, backup_days_between);
+		//Radiation data
+		sun.setDate(current_date.getJulian(), current_date.getTimeZone());
+		const double hs_a3hl6 = getHS_last3hours(io, current_date);
+
+		// START LOOP OVER ASPECTS
+		for (unsigned int slope_sequence=0; slope_sequence<slope.nSlopes; slope_sequence++) {
+			double tot_mass_in = 0.; // To check mass balance over one CALCULATION_STEP_LENGTH if MASS_BALANCE is set
+			SnowpackConfig tmpcfg(cfg);
+
+			//fill Snowpack internal structure with forcing data
+			bool iswr_is_net = false;
+			copyMeteoData(vecMyMeteo[i_stn], Mdata, slope.prevailing_wind_dir, wind_scaling_factor, iswr_is_net);
+			Mdata.copySnowTemperatures(vecMyMeteo[i_stn], slope_sequence);
+			Mdata.copySolutes(vecMyMeteo[i_stn], SnowStation::number_of_solutes);
+			slope.setSlope(slope_sequence, vecXdata, Mdata.dw_drift);
+			dataForCurrentTimeStep(Mdata, surfFluxes, vecXdata, slope, tmpcfg,
                                        sun, cumsum.precip, lw_in, hs_a3hl6,
                                        tot_mass_in, variant, iswr_is_net);
 
-				// Notify user every fifteen days of date being processed
-				const double notify_start = floor(vecSSdata[slope.mainStation].profileDate.getJulian()) + 15.5;
-				if ((mode == "RESEARCH") && (slope.sector == slope.mainStation)
-				        && booleanTime(current_date.getJulian(), 15., notify_start, calculation_step_length)) {
-					prn_msg(__FILE__, __LINE__, "msg", current_date,
-					            "Station %s (%d slope(s)): advanced to %s station time",
-					                vecSSdata[slope.mainStation].meta.stationID.c_str(), slope.nSlopes,
-					                    current_date.toString(mio::Date::DIN).c_str());
-				}
+			// Notify user every fifteen days of date being processed
+			const double notify_start = floor(vecSSdata[slope.mainStation].profileDate.getJulian()) + 15.5;
+			if ((mode == "RESEARCH") && (slope.sector == slope.mainStation)
+			        && booleanTime(current_date.getJulian(), 15., notify_start, calculation_step_length)) {
+				prn_msg(__FILE__, __LINE__, "msg", current_date,
+				            "Station %s (%d slope(s)): advanced to %s station time",
+				                vecSSdata[slope.mainStation].meta.stationID.c_str(), slope.nSlopes,
+				                    current_date.toString(mio::Date::DIN).c_str());
+			}
 
-				// SNOWPACK model (Temperature and Settlement computations)
-				Snowpack snowpack(tmpcfg); //the snowpack model to use
-				Stability stability(tmpcfg, classify_profile);
-				snowpack.runSnowpackModel(Mdata, vecXdata[slope.sector], cumsum.precip, sn_Bdata, surfFluxes);
-				
-				if (grooming)
-					snowpack.snowPreparation(current_date, vecXdata[slope.sector] );
-
-				stability.checkStability(Mdata, vecXdata[slope.sector]);
-
-				/***** OUTPUT SECTION *****/
-				surfFluxes.collectSurfaceFluxes(sn_Bdata, vecXdata[slope.sector], Mdata);
-				if (slope.sector == slope.mainStation) { // main station only (usually flat field)
-					// Calculate consistent lw_in for virtual slopes
-					if ( vecXdata[slope.mainStation].getNumberOfElements() > 0 ) {
-						double k_eff, gradT;
-						k_eff =
-						    vecXdata[slope.mainStation].Edata[vecXdata[slope.mainStation].getNumberOfElements()-1].k[TEMPERATURE];
-						gradT =
-						    vecXdata[slope.mainStation].Edata[vecXdata[slope.mainStation].getNumberOfElements()-1].gradT;
-						lw_in = k_eff*gradT + sn_Bdata.lw_out - sn_Bdata.qs - sn_Bdata.ql - sn_Bdata.qr;
+			// SNOWPACK model (Temperature and Settlement computations)
+			Snowpack snowpack(tmpcfg); //the snowpack model to use
+			Stability stability(tmpcfg, classify_profile);
+			snowpack.runSnowpackModel(Mdata, vecXdata[slope.sector], cumsum.precip, sn_Bdata, surfFluxes);
+			
+			if (grooming)
+				snowpack.snowPreparation(current_date, vecXdata[slope.sector] );
+
+			stability.checkStability(Mdata, vecXdata[slope.sector]);
+
+			/***** OUTPUT SECTION *****/
+			surfFluxes.collectSurfaceFluxes(sn_Bdata, vecXdata[slope.sector], Mdata);
+			if (slope.sector == slope.mainStation) { // main station only (usually flat field)
+				// Calculate consistent lw_in for virtual slopes
+				if ( vecXdata[slope.mainStation].getNumberOfElements() > 0 ) {
+					double k_eff, gradT;
+					k_eff =
+					    vecXdata[slope.mainStation].Edata[vecXdata[slope.mainStation].getNumberOfElements()-1].k[TEMPERATURE];
+					gradT =
+					    vecXdata[slope.mainStation].Edata[vecXdata[slope.mainStation].getNumberOfElements()-1].gradT;
+					lw_in = k_eff*gradT + sn_Bdata.lw_out - sn_Bdata.qs - sn_Bdata.ql - sn_Bdata.qr;
+				} else {
+					lw_in = Constants::undefined;
+				}
+				// Deal with new snow densities
+				if (vecXdata[slope.mainStation].hn > 0.) {
+					surfFluxes.cRho_hn = vecXdata[slope.mainStation].rho_hn;
+					surfFluxes.mRho_hn = Mdata.rho_hn;
+				}
+				if (slope.snow_erosion != "NONE") {
+					// Update drifting snow index (VI24),
+					//   from erosion at the main station only if no virtual slopes are available
+					if (slope.mainStationDriftIndex)
+						cumulate(cumsum.drift, surfFluxes.drift);
+					// Update erosion mass from main station
+					// NOTE cumsum.erosion[] will be positive in case of real erosion at any time during the output time step
+					if (vecXdata[slope.mainStation].ErosionMass > Constants::eps) {
+						// Real erosion
+						if (cumsum.erosion[slope.mainStation] > Constants::eps) {
+							cumsum.erosion[slope.mainStation] += vecXdata[slope.mainStation].ErosionMass;
+							cumsum.erosion_length[slope.mainStation] += vecXdata[slope.mainStation].ErosionLength;
+						} else {
+							cumsum.erosion[slope.mainStation] = vecXdata[slope.mainStation].ErosionMass;
+							cumsum.erosion_length[slope.mainStation] = vecXdata[slope.mainStation].ErosionLength;
+						}
 					} else {
-						lw_in = Constants::undefined;
+						// Potential erosion at main station only
+						if (cumsum.erosion[slope.mainStation] < -Constants::eps)
+							cumsum.erosion[slope.mainStation] -= surfFluxes.mass[SurfaceFluxes::MS_WIND];
+						else if (!(cumsum.erosion[slope.mainStation] > Constants::eps))
+							cumsum.erosion[slope.mainStation] = -surfFluxes.mass[SurfaceFluxes::MS_WIND];
 					}
-					// Deal with new snow densities
-					if (vecXdata[slope.mainStation].hn > 0.) {
-						surfFluxes.cRho_hn = vecXdata[slope.mainStation].rho_hn;
-						surfFluxes.mRho_hn = Mdata.rho_hn;
+					cumsum.redeposition[slope.mainStation] += vecXdata[slope.mainStation].hn_redeposit * vecXdata[slope.mainStation].rho_hn_redeposit;
+					cumsum.redeposition_length[slope.mainStation] += vecXdata[slope.mainStation].hn_redeposit;
+				}
+				const size_t i_hz = mn_ctrl.HzStep;
+				if (mode == "OPERATIONAL") {
+					if (!cumsum_mass) { // Cumulate flat field runoff in operational mode
+						qr_Hdata.at(i_hz).runoff += surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF];
+						cumsum.runoff += surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF];
 					}
-					if (slope.snow_erosion != "NONE") {
-						// Update drifting snow index (VI24),
-						//   from erosion at the main station only if no virtual slopes are available
-						if (slope.mainStationDriftIndex)
-							cumulate(cumsum.drift, surfFluxes.drift);
-						// Update erosion mass from main station
-						// NOTE cumsum.erosion[] will be positive in case of real erosion at any time during the output time step
-						if (vecXdata[slope.mainStation].ErosionMass > Constants::eps) {
-							// Real erosion
-							if (cumsum.erosion[slope.mainStation] > Constants::eps) {
-								cumsum.erosion[slope.mainStation] += vecXdata[slope.mainStation].ErosionMass;
-								cumsum.erosion_length[slope.mainStation] += vecXdata[slope.mainStation].ErosionLength;
-							} else {
-								cumsum.erosion[slope.mainStation] = vecXdata[slope.mainStation].ErosionMass;
-								cumsum.erosion_length[slope.mainStation] = vecXdata[slope.mainStation].ErosionLength;
-							}
+					/*
+					 * Snow depth and mass corrections (deflate-inflate):
+					 *   Monitor snow depth discrepancy assumed to be due to ...
+					 *   ... wrong settling, which in turn is assumed to be due to a wrong estimation ...
+					 *   of fresh snow mass because Michi spent many painful days calibrating the settling ...
+					 *   and therefore it can't be wrong, dixunt Michi and Charles.
+					 */
+					const double cH = vecXdata[slope.mainStation].cH - vecXdata[slope.mainStation].Ground;
+					const double mH = vecXdata[slope.mainStation].mH - vecXdata[slope.mainStation].Ground;
+					// Look for missed erosion or not strong enough settling ...
+					// ... and nastily deep "dips" caused by buggy data ...
+					if (time_count_deltaHS > -Constants::eps2) {
+						if ((mH + 0.01) < cH) {
+							time_count_deltaHS += S_TO_D(sn_dt);
 						} else {
-							// Potential erosion at main station only
-							if (cumsum.erosion[slope.mainStation] < -Constants::eps)
-								cumsum.erosion[slope.mainStation] -= surfFluxes.mass[SurfaceFluxes::MS_WIND];
-							else if (!(cumsum.erosion[slope.mainStation] > Constants::eps))
-								cumsum.erosion[slope.mainStation] = -surfFluxes.mass[SurfaceFluxes::MS_WIND];
-						}
-						cumsum.redeposition[slope.mainStation] += vecXdata[slope.mainStation].hn_redeposit * vecXdata[slope.mainStation].rho_hn_redeposit;
-						cumsum.redeposition_length[slope.mainStation] += vecXdata[slope.mainStation].hn_redeposit;
-					}
-					const size_t i_hz = mn_ctrl.HzStep;
-					if (mode == "OPERATIONAL") {
-						if (!cumsum_mass) { // Cumulate flat field runoff in operational mode
-							qr_Hdata.at(i_hz).runoff += surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF];
-							cumsum.runoff += surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF];
-						}
-						/*
-						 * Snow depth and mass corrections (deflate-inflate):
-						 *   Monitor snow depth discrepancy assumed to be due to ...
-						 *   ... wrong settling, which in turn is assumed to be due to a wrong estimation ...
-						 *   of fresh snow mass because Michi spent many painful days calibrating the settling ...
-						 *   and therefore it can't be wrong, dixunt Michi and Charles.
-						 */
-						const double cH = vecXdata[slope.mainStation].cH - vecXdata[slope.mainStation].Ground;
-						const double mH = vecXdata[slope.mainStation].mH - vecXdata[slope.mainStation].Ground;
-						// Look for missed erosion or not strong enough settling ...
-						// ... and nastily deep "dips" caused by buggy data ...
-						if (time_count_deltaHS > -Constants::eps2) {
-							if ((mH + 0.01) < cH) {
-								time_count_deltaHS += S_TO_D(sn_dt);
-							} else {
-								time_count_deltaHS = 0.;
-							}
-						}
-						// ... or too strong settling
-						if (time_count_deltaHS < Constants::eps2) {
-							if ((mH - 0.01) > cH) {
-								time_count_deltaHS -= S_TO_D(sn_dt);
-							} else {
-								time_count_deltaHS = 0.;
-							}
-						}
-						// If the error persisted for at least one day => apply correction
-						if (enforce_snow_height && (fabs(time_count_deltaHS) > (1. - 0.05 * M_TO_D(calculation_step_length)))) {
-							deflateInflate(Mdata, vecXdata[slope.mainStation],
-							               qr_Hdata.at(i_hz).dhs_corr, qr_Hdata.at(i_hz).mass_corr);
-							if (prn_check) {
-								prn_msg(__FILE__, __LINE__, "msg+", Mdata.date,
-								        "InflDefl (i_hz=%u): dhs=%f, dmass=%f, counter=%f",
-								        i_hz, qr_Hdata.at(i_hz).dhs_corr, qr_Hdata.at(i_hz).mass_corr,
-								        time_count_deltaHS);
-							}
 							time_count_deltaHS = 0.;
 						}
 					}
-					if (mn_ctrl.HzDump) { // Save hazard data ...
-						qr_Hdata.at(i_hz).stat_abbrev = vecStationIDs[i_stn];
-						if (mode == "OPERATIONAL") {
-							qr_Hdata.at(i_hz).loc_for_snow = (unsigned char)vecStationIDs[i_stn][vecStationIDs[i_stn].length()-1];
-							//TODO: WHAT SHOULD WE SET HERE? wstat_abk (not existing yet in DB) and wstao_nr, of course;-)
-							qr_Hdata_ind.at(i_hz).loc_for_wind = -1;
+					// ... or too strong settling
+					if (time_count_deltaHS < Constants::eps2) {
+						if ((mH - 0.01) > cH) {
+							time_count_deltaHS -= S_TO_D(sn_dt);
 						} else {
-							qr_Hdata.at(i_hz).loc_for_snow = 2;
-							qr_Hdata.at(i_hz).loc_for_wind = 1;
-						}
-						hazard.getHazardDataMainStation(qr_Hdata.at(i_hz), qr_Hdata_ind.at(i_hz),
-						                                sn_Zdata, cumsum.drift, slope.mainStationDriftIndex,
-						                                vecXdata[slope.mainStation], Mdata, surfFluxes);
-						if (slope.nSlopes==1) { //only one slope, so set lwi_N and lwi_S to the same value
-							const double lwi = vecXdata[slope.mainStation].getLiquidWaterIndex();
-							if ((lwi < -Constants::eps) || (lwi >= 10.))
-								qr_Hdata_ind.at(i_hz).lwi_N = qr_Hdata_ind.at(i_hz).lwi_S = false;
-							qr_Hdata.at(i_hz).lwi_N = lwi;
-							qr_Hdata.at(i_hz).lwi_S = lwi;
+							time_count_deltaHS = 0.;
 						}
-						mn_ctrl.HzStep++;
-						if (slope.mainStationDriftIndex)
-							cumsum.drift = 0.;
-						surfFluxes.hoar = 0.;
-					}
-					// New snow water equivalent (kg m-2), rain was dealt with in Watertransport.cc
-					surfFluxes.mass[SurfaceFluxes::MS_HNW] += vecXdata[slope.mainStation].hn
-					                                              * vecXdata[slope.mainStation].rho_hn;
-					if (!avgsum_time_series) { // Sum up precipitations
-						cumsum.rain += surfFluxes.mass[SurfaceFluxes::MS_RAIN];
-						cumsum.snow += surfFluxes.mass[SurfaceFluxes::MS_HNW];
 					}
-				} else {
-					const size_t i_hz = (mn_ctrl.HzStep > 0) ? mn_ctrl.HzStep-1 : 0;
-					if (slope.luvDriftIndex) {
-						// Update drifting snow index (VI24),
-						// considering only snow eroded from the windward slope
-						cumulate(cumsum.drift, surfFluxes.drift);
-					}
-					if (mn_ctrl.HzDump) {
-						// NOTE qr_Hdata was first saved at the end of the mainStation simulation, at which time the drift index could not be dumped!
-						hazard.getHazardDataSlope(qr_Hdata.at(i_hz), qr_Hdata_ind.at(i_hz),
-						                          sn_Zdata.drift24, cumsum.drift, vecXdata[slope.sector],
-						                          slope.luvDriftIndex, slope.north, slope.south);
-						if(slope.luvDriftIndex) cumsum.drift = 0.;
+					// If the error persisted for at least one day => apply correction
+					if (enforce_snow_height && (fabs(time_count_deltaHS) > (1. - 0.05 * M_TO_D(calculation_step_length)))) {
+						deflateInflate(Mdata, vecXdata[slope.mainStation],
+						               qr_Hdata.at(i_hz).dhs_corr, qr_Hdata.at(i_hz).mass_corr);
+						if (prn_check) {
+							prn_msg(__FILE__, __LINE__, "msg+", Mdata.date,
+							        "InflDefl (i_hz=%u): dhs=%f, dmass=%f, counter=%f",
+							        i_hz, qr_Hdata.at(i_hz).dhs_corr, qr_Hdata.at(i_hz).mass_corr,
+							        time_count_deltaHS);
+						}
+						time_count_deltaHS = 0.;
 					}
-
-					// Update erosion mass from windward virtual slope
-					cumsum.erosion[slope.sector] += vecXdata[slope.sector].ErosionMass;
-					cumsum.erosion_length[slope.sector] += vecXdata[slope.sector].ErosionLength;
 				}
-
-				// TIME SERIES (*.met)
-				if (tswrite && mn_ctrl.TsDump) {
-					// Average fluxes
-					if (avgsum_time_series) {
-						averageFluxTimeSeries(mn_ctrl.nAvg, useCanopyModel, surfFluxes, vecXdata[slope.sector]);
+				if (mn_ctrl.HzDump) { // Save hazard data ...
+					qr_Hdata.at(i_hz).stat_abbrev = vecStationIDs[i_stn];
+					if (mode == "OPERATIONAL") {
+						qr_Hdata.at(i_hz).loc_for_snow = (unsigned char)vecStationIDs[i_stn][vecStationIDs[i_stn].length()-1];
+						//TODO: WHAT SHOULD WE SET HERE? wstat_abk (not existing yet in DB) and wstao_nr, of course;-)
+						qr_Hdata_ind.at(i_hz).loc_for_wind = -1;
 					} else {
-						surfFluxes.mass[SurfaceFluxes::MS_RAIN] = cumsum.rain;
-						surfFluxes.mass[SurfaceFluxes::MS_HNW] = cumsum.snow;
-						// Add eroded snow from luv to precipitations on lee slope
-						if (slope.sector == slope.lee && cumsum.erosion[slope.luv] > Constants::eps)
-							surfFluxes.mass[SurfaceFluxes::MS_HNW] += cumsum.erosion[slope.luv] / vecXdata[slope.luv].cos_sl;
+						qr_Hdata.at(i_hz).loc_for_snow = 2;
+						qr_Hdata.at(i_hz).loc_for_wind = 1;
 					}
-
-					if (precip_rates) { // Precip rates in kg m-2 h-1
-						surfFluxes.mass[SurfaceFluxes::MS_RAIN] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
-						surfFluxes.mass[SurfaceFluxes::MS_HNW] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
-						if ((mode == "OPERATIONAL") && (!cumsum_mass)) {
-							surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF] = cumsum.runoff;
-							surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
-							cumsum.runoff = 0.;
-						}
+					hazard.getHazardDataMainStation(qr_Hdata.at(i_hz), qr_Hdata_ind.at(i_hz),
+					                                sn_Zdata, cumsum.drift, slope.mainStationDriftIndex,
+					                                vecXdata[slope.mainStation], Mdata, surfFluxes);
+					if (slope.nSlopes==1) { //only one slope, so set lwi_N and lwi_S to the same value
+						const double lwi = vecXdata[slope.mainStation].getLiquidWaterIndex();
+						if ((lwi < -Constants::eps) || (lwi >= 10.))
+							qr_Hdata_ind.at(i_hz).lwi_N = qr_Hdata_ind.at(i_hz).lwi_S = false;
+						qr_Hdata.at(i_hz).lwi_N = lwi;
+						qr_Hdata.at(i_hz).lwi_S = lwi;
 					}
+					mn_ctrl.HzStep++;
+					if (slope.mainStationDriftIndex)
+						cumsum.drift = 0.;
+					surfFluxes.hoar = 0.;
+				}
+				// New snow water equivalent (kg m-2), rain was dealt with in Watertransport.cc
+				surfFluxes.mass[SurfaceFluxes::MS_HNW] += vecXdata[slope.mainStation].hn
+				                                              * vecXdata[slope.mainStation].rho_hn;
+				if (!avgsum_time_series) { // Sum up precipitations
+					cumsum.rain += surfFluxes.mass[SurfaceFluxes::MS_RAIN];
+					cumsum.snow += surfFluxes.mass[SurfaceFluxes::MS_HNW];
+				}
+			} else {
+				const size_t i_hz = (mn_ctrl.HzStep > 0) ? mn_ctrl.HzStep-1 : 0;
+				if (slope.luvDriftIndex) {
+					// Update drifting snow index (VI24),
+					// considering only snow eroded from the windward slope
+					cumulate(cumsum.drift, surfFluxes.drift);
+				}
+				if (mn_ctrl.HzDump) {
+					// NOTE qr_Hdata was first saved at the end of the mainStation simulation, at which time the drift index could not be dumped!
+					hazard.getHazardDataSlope(qr_Hdata.at(i_hz), qr_Hdata_ind.at(i_hz),
+					                          sn_Zdata.drift24, cumsum.drift, vecXdata[slope.sector],
+					                          slope.luvDriftIndex, slope.north, slope.south);
+					if(slope.luvDriftIndex) cumsum.drift = 0.;
+				}
 
-					// Erosion mass rate in kg m-2 h-1
-					surfFluxes.mass[SurfaceFluxes::MS_WIND] = cumsum.erosion[slope.sector];
-					surfFluxes.mass[SurfaceFluxes::MS_WIND] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
+				// Update erosion mass from windward virtual slope
+				cumsum.erosion[slope.sector] += vecXdata[slope.sector].ErosionMass;
+				cumsum.erosion_length[slope.sector] += vecXdata[slope.sector].ErosionLength;
+			}
 
-					// REDEPOSIT mode variables:
-					if (cumsum.erosion_length[slope.sector] != 0. && cumsum.redeposition_length[slope.sector] != 0.) {
-						surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DRHO] = cumsum.redeposition[slope.sector]/cumsum.redeposition_length[slope.sector] + cumsum.erosion[slope.sector]/cumsum.erosion_length[slope.sector];
-						surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DHS] = cumsum.redeposition_length[slope.sector] + cumsum.erosion_length[slope.sector];
-					} else {
-						surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DRHO] = IOUtils::nodata;
-						surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DHS] = IOUtils::nodata;
-					}
+			// TIME SERIES (*.met)
+			if (tswrite && mn_ctrl.TsDump) {
+				// Average fluxes
+				if (avgsum_time_series) {
+					averageFluxTimeSeries(mn_ctrl.nAvg, useCanopyModel, surfFluxes, vecXdata[slope.sector]);
+				} else {
+					surfFluxes.mass[SurfaceFluxes::MS_RAIN] = cumsum.rain;
+					surfFluxes.mass[SurfaceFluxes::MS_HNW] = cumsum.snow;
+					// Add eroded snow from luv to precipitations on lee slope
+					if (slope.sector == slope.lee && cumsum.erosion[slope.luv] > Constants::eps)
+						surfFluxes.mass[SurfaceFluxes::MS_HNW] += cumsum.erosion[slope.luv] / vecXdata[slope.luv].cos_sl;
+				}
 
-					// Dump
-					const size_t i_hz = (mn_ctrl.HzStep > 0) ? mn_ctrl.HzStep - 1 : 0;
-					size_t i_hz0 = (mn_ctrl.HzStep > 1) ? mn_ctrl.HzStep - 2 : 0;
-					if (slope.mainStationDriftIndex)
-						i_hz0 = i_hz;
-					const double wind_trans24 = (slope.sector == slope.mainStation) ? qr_Hdata.at(i_hz0).wind_trans24 : qr_Hdata.at(i_hz).wind_trans24;
-					snowpackio.writeTimeSeries(vecXdata[slope.sector], surfFluxes, Mdata,
-					                           qr_Hdata.at(i_hz), wind_trans24);
-
-					if (avgsum_time_series) {
-						surfFluxes.reset(cumsum_mass);
-						if (useCanopyModel) vecXdata[slope.sector].Cdata.reset(cumsum_mass);
-					}
-					surfFluxes.cRho_hn = Constants::undefined;
-					surfFluxes.mRho_hn = Constants::undefined;
-					// reset cumulative variables
-					if (slope_sequence == slope.nSlopes-1) {
-						cumsum.erosion.assign(cumsum.erosion.size(), 0.);
-						cumsum.erosion_length.assign(cumsum.erosion_length.size(), 0.);
-						cumsum.redeposition.assign(cumsum.redeposition.size(), 0.);
-						cumsum.redeposition_length.assign(cumsum.redeposition_length.size(), 0.);
-						cumsum.rain = cumsum.snow = 0.;
-						mn_ctrl.nAvg = 0;
+				if (precip_rates) { // Precip rates in kg m-2 h-1
+					surfFluxes.mass[SurfaceFluxes::MS_RAIN] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
+					surfFluxes.mass[SurfaceFluxes::MS_HNW] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
+					if ((mode == "OPERATIONAL") && (!cumsum_mass)) {
+						surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF] = cumsum.runoff;
+						surfFluxes.mass[SurfaceFluxes::MS_SNOWPACK_RUNOFF] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
+						cumsum.runoff = 0.;
 					}
 				}
 
-				// SNOW PROFILES ...
-				// ... for visualization (*.pro), etc. (*.prf)
-				if (profwrite && mn_ctrl.PrDump)
-					snowpackio.writeProfile(current_date, vecXdata[slope.sector]);
-
-				// ... backup Xdata (*.sno<JulianDate>)
-				if (mn_ctrl.XdataDump) {
-					std::stringstream ss;
-					ss << "" << vecStationIDs[i_stn];
-					if (slope.sector != slope.mainStation) ss << "" << slope.sector;
-					snowpackio.writeSnowCover(current_date, vecXdata[slope.sector], sn_Zdata, (label_snow)?(2):(1));
-					prn_msg(__FILE__, __LINE__, "msg", current_date,
-					        "Backup Xdata dumped for station %s [%.2f days, step %d]", ss.str().c_str(),
-					        (current_date.getJulian()
-					            - (vecSSdata[slope.mainStation].profileDate.getJulian() + 0.5/24)),
-					        mn_ctrl.nStep);
-				}
+				// Erosion mass rate in kg m-2 h-1
+				surfFluxes.mass[SurfaceFluxes::MS_WIND] = cumsum.erosion[slope.sector];
+				surfFluxes.mass[SurfaceFluxes::MS_WIND] /= static_cast<double>(mn_ctrl.nAvg)*M_TO_H(calculation_step_length);
 
-				// check mass balance if AVGSUM_TIME_SERIES is not set (screen output only)
-				if (!avgsum_time_series) {
-					const bool mass_balance = cfg.get("MASS_BALANCE", "SnowpackAdvanced");
-					if (mass_balance) {
-						if (massBalanceCheck(vecXdata[slope.sector], surfFluxes, tot_mass_in) == false)
-							prn_msg(__FILE__, __LINE__, "msg+", current_date, "Mass error at end of time step!");
-					}
+				// REDEPOSIT mode variables:
+				if (cumsum.erosion_length[slope.sector] != 0. && cumsum.redeposition_length[slope.sector] != 0.) {
+					surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DRHO] = cumsum.redeposition[slope.sector]/cumsum.redeposition_length[slope.sector] + cumsum.erosion[slope.sector]/cumsum.erosion_length[slope.sector];
+					surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DHS] = cumsum.redeposition_length[slope.sector] + cumsum.erosion_length[slope.sector];
+				} else {
+					surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DRHO] = IOUtils::nodata;
+					surfFluxes.mass[SurfaceFluxes::MS_REDEPOSIT_DHS] = IOUtils::nodata;
 				}
-			} //end loop on slopes
-			computed_one_timestep = true;
-		} while ((dateEnd.getJulian() - current_date.getJulian()) > calculation_step_length/(2.*1440));
-		//end loop on timesteps
-
-		// If the simulation run for at least one time step,
-		//   dump the PROFILEs (Xdata) for every station referred to as sector where sector 0 corresponds to the main station
-		if (computed_one_timestep && snow_write) {
-			for (size_t sector=slope.mainStation; sector<slope.nSlopes; sector++) {
-				if ((mode == "OPERATIONAL") && (sector == slope.mainStation)) {
-					// Operational mode ONLY: dump snow depth discrepancy time counter
-					vecXdata[slope.mainStation].TimeCountDeltaHS = time_count_deltaHS;
+
+				// Dump
+				const size_t i_hz = (mn_ctrl.HzStep > 0) ? mn_ctrl.HzStep - 1 : 0;
+				size_t i_hz0 = (mn_ctrl.HzStep > 1) ? mn_ctrl.HzStep - 2 : 0;
+				if (slope.mainStationDriftIndex)
+					i_hz0 = i_hz;
+				const double wind_trans24 = (slope.sector == slope.mainStation) ? qr_Hdata.at(i_hz0).wind_trans24 : qr_Hdata.at(i_hz).wind_trans24;
+				snowpackio.writeTimeSeries(vecXdata[slope.sector], surfFluxes, Mdata,
+				                           qr_Hdata.at(i_hz), wind_trans24);
+
+				if (avgsum_time_series) {
+					surfFluxes.reset(cumsum_mass);
+					if (useCanopyModel) vecXdata[slope.sector].Cdata.reset(cumsum_mass);
 				}
-				snowpackio.writeSnowCover(current_date, vecXdata[sector], sn_Zdata);
-				if (sector == slope.mainStation) {
-					prn_msg(__FILE__, __LINE__, "msg", mio::Date(),
-					        "Writing data to sno file(s) for %s (station %s) on %s",
-					        vecSSdata[slope.mainStation].meta.getStationName().c_str(),
-					        vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO).c_str());
+				surfFluxes.cRho_hn = Constants::undefined;
+				surfFluxes.mRho_hn = Constants::undefined;
+				// reset cumulative variables
+				if (slope_sequence == slope.nSlopes-1) {
+					cumsum.erosion.assign(cumsum.erosion.size(), 0.);
+					cumsum.erosion_length.assign(cumsum.erosion_length.size(), 0.);
+					cumsum.redeposition.assign(cumsum.redeposition.size(), 0.);
+					cumsum.redeposition_length.assign(cumsum.redeposition_length.size(), 0.);
+					cumsum.rain = cumsum.snow = 0.;
+					mn_ctrl.nAvg = 0;
 				}
 			}
-			// Dump time series to snowpack.ams_pmod@SDBx (hazard data)
-			if (mn_ctrl.sdbDump) {
-				mio::Timer sdbDump_timer;
-				sdbDump_timer.reset();
-				sdbDump_timer.start();
-				if (snowpackio.writeHazardData(vecStationIDs[i_stn], qr_Hdata, qr_Hdata_ind, mn_ctrl.HzStep)) {
-					sdbDump_timer.stop();
-					prn_msg(__FILE__, __LINE__, "msg-", mio::Date(),
-					        "Finished writing Hdata to SDB for station %s on %s (%lf s)",
-					        vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO).c_str(), sdbDump_timer.getElapsed());
+
+			// SNOW PROFILES ...
+			// ... for visualization (*.pro), etc. (*.prf)
+			if (profwrite && mn_ctrl.PrDump)
+				snowpackio.writeProfile(current_date, vecXdata[slope.sector]);
+
+			// ... backup Xdata (*.sno<JulianDate>)
+			if (mn_ctrl.XdataDump) {
+				std::stringstream ss;
+				ss << "" << vecStationIDs[i_stn];
+				if (slope.sector != slope.mainStation) ss << "" << slope.sector;
+				snowpackio.writeSnowCover(current_date, vecXdata[slope.sector], sn_Zdata, (label_snow)?(2):(1));
+				prn_msg(__FILE__, __LINE__, "msg", current_date,
+				        "Backup Xdata dumped for station %s [%.2f days, step %d]", ss.str().c_str(),
+				        (current_date.getJulian()
+				            - (vecSSdata[slope.mainStation].profileDate.getJulian() + 0.5/24)),
+				        mn_ctrl.nStep);
+			}
+
+			// check mass balance if AVGSUM_TIME_SERIES is not set (screen output only)
+			if (!avgsum_time_series) {
+				const bool mass_balance = cfg.get("MASS_BALANCE", "SnowpackAdvanced");
+				if (mass_balance) {
+					if (massBalanceCheck(vecXdata[slope.sector], surfFluxes, tot_mass_in) == false)
+						prn_msg(__FILE__, __LINE__, "msg+", current_date, "Mass error at end of time step!");
 				}
 			}
+		} //end loop on slopes
+		computed_one_timestep = true;
+	} while ((dateEnd.getJulian() - current_date.getJulian()) > calculation_step_length/(2.*1440));
+	//end loop on timesteps
+
+	// If the simulation run for at least one time step,
+	//   dump the PROFILEs (Xdata) for every station referred to as sector where sector 0 corresponds to the main station
+	if (computed_one_timestep && snow_write) {
+		for (size_t sector=slope.mainStation; sector<slope.nSlopes; sector++) {
+			if ((mode == "OPERATIONAL") && (sector == slope.mainStation)) {
+				// Operational mode ONLY: dump snow depth discrepancy time counter
+				vecXdata[slope.mainStation].TimeCountDeltaHS = time_count_deltaHS;
+			}
+			snowpackio.writeSnowCover(current_date, vecXdata[sector], sn_Zdata);
+			if (sector == slope.mainStation) {
+				prn_msg(__FILE__, __LINE__, "msg", mio::Date(),
+				        "Writing data to sno file(s) for %s (station %s) on %s",
+				        vecSSdata[slope.mainStation].meta.getStationName().c_str(),
+				        vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO).c_str());
+			}
+		}
+		// Dump time series to snowpack.ams_pmod@SDBx (hazard data)
+		if (mn_ctrl.sdbDump) {
+			mio::Timer sdbDump_timer;
+			sdbDump_timer.reset();
+			sdbDump_timer.start();
+			if (snowpackio.writeHazardData(vecStationIDs[i_stn], qr_Hdata, qr_Hdata_ind, mn_ctrl.HzStep)) {
+				sdbDump_timer.stop();
+				prn_msg(__FILE__, __LINE__, "msg-", mio::Date(),
+				        "Finished writing Hdata to SDB for station %s on %s (%lf s)",
+				        vecStationIDs[i_stn].c_str(), current_date.toString(mio::Date::ISO).c_str(), sdbDump_timer.getElapsed());
+			}
+		}
+	}
+	prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "Total time to read meteo data : %lf s",
+	        meteoRead_timer.getElapsed());
+	prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "Runtime for station %s: %lf s",
+	        vecStationIDs[i_stn].c_str(), run_timer.getElapsed());
+	return true;
+}
+
+/**
+ * @brief Simulate stations until there are none left
+ * @details The stations are taken one after the other from the shared counter next_stn, so that
+ * several workers can share the stations. Each station starts from its own copy of the configuration, so its
+ * results do not depend on which worker ran it, nor on the stations that this worker ran before.
+ * A failing station is reported and the worker moves on to the next one.
+ * @param worker the objects owned by the calling thread
+ * @param reports one report per station in vecStationIDs
+ * @param next_stn index of the next station to simulate, shared between all workers
+ */
+inline void runStations(StationsWorker& worker, std::vector<StationReport>& reports, std::atomic<size_t>& next_stn)
+{
+	for (size_t i_stn=next_stn++; i_stn<vecStationIDs.size(); i_stn=next_stn++) {
+		try {
+			SnowpackConfig cfg( worker.cfg );
+			reports[i_stn].status = (runStation(cfg, worker.io, worker.snowpackio, i_stn))? StationReport::DONE : StationReport::SKIPPED;
+		} catch (const std::exception& e) {
+			reports[i_stn].status = StationReport::FAILED;
+			reports[i_stn].error = e.what();
+			cerr << "[E] Simulation of station " << vecStationIDs[i_stn] << " failed\n";
+		} catch (...) {
+			//an exception escaping a std::thread would terminate the whole program
+			reports[i_stn].status = StationReport::FAILED;
+			reports[i_stn].error = "unknown exception";
+			cerr << "[E] Simulation of station " << vecStationIDs[i_stn] << " failed\n";
+		}
+	}
+}
+
+/**
+ * @brief Print how each station went and count the failures
+ * @param reports one report per station in vecStationIDs
+ * @return number of stations that failed
+ */
+inline size_t printReports(const std::vector<StationReport>& reports)
+{
+	size_t nr_done=0, nr_skipped=0, nr_failed=0;
+	for (size_t i_stn=0; i_stn<reports.size(); i_stn++) {
+		if (reports[i_stn].status == StationReport::DONE) nr_done++;
+		else if (reports[i_stn].status == StationReport::SKIPPED) nr_skipped++;
+		else nr_failed++;
+	}
+
+	cout << endl;
+	prn_msg(__FILE__, __LINE__, "msg", mio::Date(), "Stations: %u computed, %u skipped, %u failed",
+	        (unsigned int)nr_done, (unsigned int)nr_skipped, (unsigned int)nr_failed);
+	for (size_t i_stn=0; i_stn<reports.size(); i_stn++) {
+		if (reports[i_stn].status == StationReport::SKIPPED)
+			cerr << "[W] Station " << vecStationIDs[i_stn] << " skipped\n";
+		else if (reports[i_stn].status == StationReport::FAILED)
+			cerr << "[E] Station " << vecStationIDs[i_stn] << " failed: " << reports[i_stn].error << "\n";
+	}
+	return nr_failed;
+}
+
+// SNOWPACK MAIN **************************************************************
+inline void real_main (int argc, char *argv[])
+{
+	setbuf(stdout, NULL); //always flush stdout
+	setbuf(stderr, NULL); //always flush stderr
+#ifdef DEBUG_ARITHM
+	feenableexcept(FE_DIVBYZERO | FE_INVALID | FE_OVERFLOW ); //for halting the process at arithmetic exceptions, see also ReSolver1d
+#endif
+	//parse the command line arguments
+	std::string begin_date_str, end_date_str;
+	parseCmdLine(argc, argv, begin_date_str, end_date_str);
+
+	time_t nowSRT = time(NULL);
+
+	SnowpackConfig cfg(cfgfile);
+	addSpecialKeys(cfg);
+
+	const double i_time_zone = cfg.get("TIME_ZONE", "Input"); //get user provided input time_zone
+	if (!begin_date_str.empty()) {
+		mio::IOUtils::convertString(dateBegin, begin_date_str, i_time_zone);
+	}
+	if (end_date_str == "NOW") { //interpret user provided end date
+		dateEnd.setFromSys();
+		dateEnd.setTimeZone(i_time_zone);
+		dateEnd.rnd(1800, mio::Date::DOWN);
+	} else {
+		mio::IOUtils::convertString(dateEnd, end_date_str, i_time_zone);
+	}
+
+	int nSolutes = Constants::iundefined;
+	cfg.getValue("NUMBER_OF_SOLUTES", "Input", nSolutes, mio::IOUtils::nothrow);
+	if (nSolutes > 0) SnowStation::number_of_solutes = static_cast<short unsigned int>(nSolutes);
+
+	//If the user provides the stationIDs - operational use case
+	if (!vecStationIDs.empty()) { //operational use case: stationIDs provided on the command line
+		for (size_t i_stn=0; i_stn<vecStationIDs.size(); i_stn++) {
+			stringstream ss;
+			ss << "STATION" << i_stn+1;
+			cfg.addKey(ss.str(), "Input", vecStationIDs[i_stn]);
+		}
+	}
+
+	std::vector<StationsWorker*> workers;
+	workers.push_back( new StationsWorker(cfg) );
+
+	if (vecStationIDs.empty()) { //research use case: stationIDs provided by the available input files
+		vector<StationData> accessible_stations;
+		workers[0]->io.getStationData(dateEnd, accessible_stations); //we are retrieving meta information from MeteoIO
+		for (size_t ii=0; ii<accessible_stations.size(); ii++) {
+			vecStationIDs.push_back( accessible_stations[ii].getStationID() ); //HACK: accessible_stations should be directly used
 		}
-		prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "Total time to read meteo data : %lf s",
-		        meteoRead_timer.getElapsed());
-		prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "Runtime for station %s: %lf s",
-		        vecStationIDs[i_stn].c_str(), run_timer.getElapsed());
 	}
 
+	//now, let's start!
+	printStartInfo(cfg, string(argv[0]));
+
+	// START LOOP OVER ALL STATIONS
+	write_forcing = cfg.get("WRITE_PROCESSED_METEO", "Output"); //it will be set to false once it has been done
+	const size_t nr_workers = std::max(static_cast<size_t>(1), std::min(static_cast<size_t>(nr_threads), vecStationIDs.size()));
+	if (nr_workers > 1) {
+		prn_msg(__FILE__, __LINE__, "msg-", mio::Date(), "Running %u stations on %u threads", (unsigned int)vecStationIDs.size(), (unsigned int)nr_workers);
+		//the static data of SnLaws would otherwise be initialized by whichever worker needs it first
+		const std::string variant = cfg.get("VARIANT", "SnowpackAdvanced");
+		const std::string watertransportmodel_snow = cfg.get("WATERTRANSPORTMODEL_SNOW", "SnowpackAdvanced");
+		if (variant != SnLaws::current_variant) SnLaws::setStaticData(variant, watertransportmodel_snow);
+		while (workers.size() < nr_workers) workers.push_back( new StationsWorker(cfg) );
+	}
+
+	std::vector<StationReport> reports( vecStationIDs.size() );
+	std::atomic<size_t> next_stn( 0 );
+	std::vector<std::thread> threads;
+	for (size_t ii=1; ii<workers.size(); ii++)
+		threads.push_back( std::thread(runStations, std::ref(*workers[ii]), std::ref(reports), std::ref(next_stn)) );
+	runStations(*workers[0], reports, next_stn);
+	for (size_t ii=0; ii<threads.size(); ii++) threads[ii].join();
+	for (size_t ii=0; ii<workers.size(); ii++) delete workers[ii];
+	const size_t nr_failed = printReports(reports);
+
 	time_t nowEND=time(NULL);
 	cout << endl;
 	cout << "[i] []                 STARTED  running SLF " << mode << " Snowpack Model on " << ctime(&nowSRT);
@@ -1458,6 +1593,12 @@ inline void real_main (int argc, char *argv[])
 		cout << "                       ========================================================================" << endl;
 	}
 	cout << "                       FINISHED running SLF " << mode << " Snowpack Model on " << ctime(&nowEND) << endl;
+
+	if (nr_failed > 0) {
+		std::ostringstream ss;
+		ss << nr_failed << " station(s) failed";
+		throw mio::IOException(ss.str(), AT);
+	}
 }
 
 int main(int argc, char *argv[]) {
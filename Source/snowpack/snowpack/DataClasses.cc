@@ -31,6 +31,7 @@
 #include <snowpack/Laws_sn.h>
 #include <snowpack/snowpackCore/Aggregate.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <fstream>
 #include <sstream>
@@ -1138,7 +1139,7 @@ void CanopyData::initializeSurfaceExchangeData()
 const unsigned short int ElementData::noID = static_cast<unsigned short int>(-1);
 ElementData::ElementData(const unsigned short int& in_ID) : depositionDate(), L0(0.), L(0.),
                              Te(0.), gradT(0.), meltfreeze_tk(Constants::meltfreeze_tk),
-                             theta((size_t)N_COMPONENTS), h(Constants::undefined), conc((size_t)N_COMPONENTS, SnowStation::number_of_solutes), k((size_t)N_SN_FIELDS), c((size_t)N_SN_FIELDS), soil((size_t)N_SOIL_FIELDS),
+                             h(Constants::undefined), conc((size_t)N_COMPONENTS, SnowStation::number_of_solutes),
                              Rho(0.), M(0.), sw_abs(0.),
                              rg(0.), dd(0.), sp(0.), ogs(0.), rb(0.), N3(0.), mk(0),
                              type(0), metamo(0.), salinity(0.), dth_w(0.), res_wat_cont(0.), Qmf(0.), QIntmf(0.),
@@ -1146,12 +1147,18 @@ ElementData::ElementData(const unsigned short int& in_ID) : depositionDate(), L0
                              S(0.), C(0.), CDot(0.), ps2rb(0.),
                              s_strength(0.), hard(0.), S_dr(0.), crit_cut_length(Constants::undefined), soot_ppmv(0.), VG(*this), lwc_source(0.), PrefFlowArea(0.),
                              theta_w_transfer(0.), theta_i_reservoir(0.), theta_i_reservoir_cumul(0.),
-                             SlopeParFlux(0.), Qph_up(0.), Qph_down(0.), dsm(0.), rime(0.), ID(in_ID) {}
+                             SlopeParFlux(0.), Qph_up(0.), Qph_down(0.), dsm(0.), rime(0.), ID(in_ID)
+{
+	std::fill(theta, theta+N_COMPONENTS, 0.);
+	std::fill(k, k+N_SN_FIELDS, 0.);
+	std::fill(c, c+N_SN_FIELDS, 0.);
+	std::fill(soil, soil+N_SOIL_FIELDS, 0.);
+}
 
 ElementData::ElementData(const ElementData& cc) :
                              depositionDate(cc.depositionDate), L0(cc.L0), L(cc.L),
                              Te(cc.Te), gradT(cc.gradT), meltfreeze_tk(cc.meltfreeze_tk),
-                             theta(cc.theta), h(cc.h), conc(cc.conc), k(cc.k), c(cc.c), soil(cc.soil),
+                             h(cc.h), conc(cc.conc),
                              Rho(cc.Rho), M(cc.M), sw_abs(cc.sw_abs),
                              rg(cc.rg), dd(cc.dd), sp(cc.sp), ogs(cc.ogs), rb(cc.rb), N3(cc.N3), mk(cc.mk),
                              type(cc.type), metamo(cc.metamo), salinity(cc.salinity), dth_w(cc.dth_w), res_wat_cont(cc.res_wat_cont), Qmf(cc.Qmf), QIntmf(cc.QIntmf),
@@ -1159,7 +1166,13 @@ ElementData::ElementData(const ElementData& cc) :
                              S(cc.S), C(cc.C), CDot(cc.CDot), ps2rb(cc.ps2rb),
                              s_strength(cc.s_strength), hard(cc.hard), S_dr(cc.S_dr), crit_cut_length(cc.crit_cut_length), soot_ppmv(cc.soot_ppmv), VG(*this), lwc_source(cc.lwc_source), PrefFlowArea(cc.PrefFlowArea),
                              theta_w_transfer(cc.theta_w_transfer), theta_i_reservoir(cc.theta_i_reservoir), theta_i_reservoir_cumul(cc.theta_i_reservoir_cumul),
-                             SlopeParFlux(cc.SlopeParFlux), Qph_up(cc.Qph_up), Qph_down(cc.Qph_down), dsm(cc.dsm), rime(cc.rime), ID(cc.ID) {}
+                             SlopeParFlux(cc.SlopeParFlux), Qph_up(cc.Qph_up), Qph_down(cc.Qph_down), dsm(cc.dsm), rime(cc.rime), ID(cc.ID)
+{
+	std::copy(cc.theta, cc.theta+N_COMPONENTS, theta);
+	std::copy(cc.k, cc.k+N_SN_FIELDS, k);
+	std::copy(cc.c, cc.c+N_SN_FIELDS, c);
+	std::copy(cc.soil, cc.soil+N_SOIL_FIELDS, soil);
+}
 
 std::ostream& operator<<(std::ostream& os, const ElementData& data)
 {
@@ -1170,21 +1183,21 @@ std::ostream& operator<<(std::ostream& os, const ElementData& data)
 	os.write(reinterpret_cast<const char*>(&data.gradT), sizeof(data.gradT));
 	os.write(reinterpret_cast<const char*>(&data.meltfreeze_tk), sizeof(data.meltfreeze_tk));
 
-	const size_t s_theta = data.theta.size();
+	const size_t s_theta = N_COMPONENTS;
 	os.write(reinterpret_cast<const char*>(&s_theta), sizeof(size_t));
 	os.write(reinterpret_cast<const char*>(&data.theta[0]), static_cast<streamsize>(s_theta*sizeof(data.theta[0])));
 	os.write(reinterpret_cast<const char*>(&data.h), sizeof(data.h));
 	os << data.conc;
 
-	const size_t s_k = data.k.size();
+	const size_t s_k = N_SN_FIELDS;
 	os.write(reinterpret_cast<const char*>(&s_k), sizeof(size_t));
 	os.write(reinterpret_cast<const char*>(&data.k[0]), static_cast<streamsize>(s_k*sizeof(data.k[0])));
 
-	const size_t s_c = data.c.size();
+	const size_t s_c = N_SN_FIELDS;
 	os.write(reinterpret_cast<const char*>(&s_c), sizeof(size_t));
 	os.write(reinterpret_cast<const char*>(&data.c[0]), static_cast<streamsize>(s_c*sizeof(data.c[0])));
 
-	const size_t s_soil = data.soil.size();
+	const size_t s_soil = N_SOIL_FIELDS;
 	os.write(reinterpret_cast<const char*>(&s_soil), sizeof(size_t));
 	os.write(reinterpret_cast<const char*>(&data.soil[0]), static_cast<streamsize>(s_soil*sizeof(data.soil[0])));
 
@@ -1249,24 +1262,28 @@ std::istream& operator>>(std::istream& is, ElementData& data)
 
 	size_t s_theta;
 	is.read(reinterpret_cast<char*>(&s_theta), sizeof(size_t));
-	data.theta.resize(s_theta);
+	if (s_theta != N_COMPONENTS)
+		throw IOException("Invalid size for ElementData::theta in serialized stream", AT);
 	is.read(reinterpret_cast<char*>(&data.theta[0]), static_cast<streamsize>(s_theta*sizeof(data.theta[0])));
 	is.read(reinterpret_cast<char*>(&data.h), sizeof(data.h));
 	is >> data.conc;
 
 	size_t s_k;
 	is.read(reinterpret_cast<char*>(&s_k), sizeof(size_t));
-	data.k.resize(s_k);
+	if (s_k != N_SN_FIELDS)
+		throw IOException("Invalid size for ElementData::k in serialized stream", AT);
 	is.read(reinterpret_cast<char*>(&data.k[0]), static_cast<streamsize>(s_k*sizeof(data.k[0])));
 
 	size_t s_c;
 	is.read(reinterpret_cast<char*>(&s_c), sizeof(size_t));
-	data.c.resize(s_c);
+	if (s_c != N_SN_FIELDS)
+		throw IOException("Invalid size for ElementData::c in serialized stream", AT);
 	is.read(reinterpret_cast<char*>(&data.c[0]), static_cast<streamsize>(s_c*sizeof(data.c[0])));
 
 	size_t s_soil;
 	is.read(reinterpret_cast<char*>(&s_soil), sizeof(size_t));
-	data.soil.resize(s_soil);
+	if (s_soil != N_SOIL_FIELDS)
+		throw IOException("Invalid size for ElementData::soil in serialized stream", AT);
 	is.read(reinterpret_cast<char*>(&data.soil[0]), static_cast<streamsize>(s_soil*sizeof(data.soil[0])));
 
 	is.read(reinterpret_cast<char*>(&data.theta_i_reservoir), sizeof(data.theta_i_reservoir));
@@ -1888,7 +1905,7 @@ SnowStation::SnowStation(const bool& i_useCanopyModel, const bool& i_useSoilLaye
 	hn_redeposit(0.), rho_hn_redeposit(0.), ErosionLevel(0), ErosionMass(0.), ErosionLength(0.),
 	S_class1(0), S_class2(0), S_d(0.), z_S_d(0.), S_n(0.), z_S_n(0.),
 	S_s(0.), z_S_s(0.), S_4(0.), z_S_4(0.), S_5(0.), z_S_5(0.),
-	Ndata(), Edata(), Kt(NULL), ColdContent(0.), ColdContentSoil(0.), dIntEnergy(0.), dIntEnergySoil(0.), meltFreezeEnergy(0.), meltFreezeEnergySoil(0.), meltMassTot(0.), refreezeMassTot(0.),
+	Ndata(), Edata(), Kt(NULL), KtTridiag(NULL), Tsolution(), ColdContent(0.), ColdContentSoil(0.), dIntEnergy(0.), dIntEnergySoil(0.), meltFreezeEnergy(0.), meltFreezeEnergySoil(0.), meltMassTot(0.), refreezeMassTot(0.),
 	ReSolver_dt(-1), windward(false),
 	WindScalingFactor(1.), TimeCountDeltaHS(0.),
 	nNodes(0), nElems(0), maxElementID(0), useCanopyModel(i_useCanopyModel), useSoilLayers(i_useSoilLayers)
@@ -1906,7 +1923,7 @@ SnowStation::SnowStation(const SnowStation& c) :
 	hn_redeposit(c.hn_redeposit), rho_hn_redeposit(c.rho_hn_redeposit), ErosionLevel(c.ErosionLevel), ErosionMass(c.ErosionMass), ErosionLength(c.ErosionLength),
 	S_class1(c.S_class1), S_class2(c.S_class2), S_d(c.S_d), z_S_d(c.z_S_d), S_n(c.S_n), z_S_n(c.z_S_n),
 	S_s(c.S_s), z_S_s(c.z_S_s), S_4(c.S_4), z_S_4(c.z_S_4), S_5(c.S_5), z_S_5(c.z_S_5),
-	Ndata(c.Ndata), Edata(c.Edata), Kt(NULL), ColdContent(c.ColdContent), ColdContentSoil(c.ColdContentSoil), dIntEnergy(c.dIntEnergy), dIntEnergySoil(c.dIntEnergySoil), meltFreezeEnergy(c.meltFreezeEnergy), meltFreezeEnergySoil(c.meltFreezeEnergySoil), meltMassTot(c.meltMassTot), refreezeMassTot(c.refreezeMassTot),
+	Ndata(c.Ndata), Edata(c.Edata), Kt(NULL), KtTridiag(NULL), Tsolution(), ColdContent(c.ColdContent), ColdContentSoil(c.ColdContentSoil), dIntEnergy(c.dIntEnergy), dIntEnergySoil(c.dIntEnergySoil), meltFreezeEnergy(c.meltFreezeEnergy), meltFreezeEnergySoil(c.meltFreezeEnergySoil), meltMassTot(c.meltMassTot), refreezeMassTot(c.refreezeMassTot),
 	ReSolver_dt(-1), windward(c.windward),
 	WindScalingFactor(c.WindScalingFactor), TimeCountDeltaHS(c.TimeCountDeltaHS),
 	nNodes(c.nNodes), nElems(c.nElems), maxElementID(c.maxElementID), useCanopyModel(c.useCanopyModel), useSoilLayers(c.useSoilLayers) {
@@ -1965,6 +1982,10 @@ SnowStation& SnowStation::operator=(const SnowStation& source) {
 		Ndata = source.Ndata;
 		Edata = source.Edata;
 		Kt = NULL;
+		if (KtTridiag != NULL) {
+			td_Solve(ReleaseMatrixData, (SD_TRIDIAG_MATRIX_DATA*)KtTridiag, 0);
+			KtTridiag = NULL;
+		}
 		ColdContent = source.ColdContent;
 		ColdContentSoil = source.ColdContentSoil;
 		dIntEnergy = source.dIntEnergy;
@@ -2000,6 +2021,11 @@ SnowStation::~SnowStation()
 		pMat = NULL;
 	}
 
+	if (KtTridiag != NULL) {
+		td_Solve(ReleaseMatrixData, (SD_TRIDIAG_MATRIX_DATA*)KtTridiag, 0);
+		KtTridiag = NULL;
+	}
+
 	if (Seaice != NULL) {
 		delete Seaice;
 		Seaice = NULL;
@@ -2977,6 +3003,10 @@ std::istream& operator>>(std::istream& is, SnowStation& data)
 	for (size_t ii=0; ii<s_Edata; ii++) is >> data.Edata[ii];
 
 	data.Kt = NULL;
+	if (data.KtTridiag != NULL) {
+		td_Solve(ReleaseMatrixData, (SD_TRIDIAG_MATRIX_DATA*)data.KtTridiag, 0);
+		data.KtTridiag = NULL;
+	}
 
 	is.read(reinterpret_cast<char*>(&data.ColdContent), sizeof(data.ColdContent));
 	is.read(reinterpret_cast<char*>(&data.ColdContentSoil), sizeof(data.ColdContentSoil));
@@ -284,6 +284,9 @@ class SN_SNOWSOIL_DATA {
  * NOTE on M below: this is the mass of an element that is neither changed by phase changes nor densification. \n
  * It is set in the data initialization and used to compute the stress field.
  * It can ONLY be changed by the WATER TRANSPORT or SURFACE SUBLIMATION or WIND TRANSPORT routines.
+ * NOTE on theta, k, c and soil: these are fixed-size arrays stored inside the element, so creating, copying or
+ * shifting elements (for example when SnowStation merges or splits them) does not allocate (conc only allocates
+ * if there are solutes). The elements themselves are still kept as an array of ElementData in SnowStation::Edata.
  */
 class ElementData {
 	public:
@@ -329,15 +332,15 @@ class ElementData {
 		double Te;                 ///< mean element temperature (K)
 		double gradT;              ///< temperature gradient over element (K m-1)
 		double meltfreeze_tk;	   ///< melt/freeze temperature of layer (principally initialized as 0 degC, but enables possibility for freezing point depression)
-		std::vector<double> theta; ///< volumetric contents: SOIL, ICE, WATER, WATER_PREF, AIR (1)
+		double theta[N_COMPONENTS]; ///< volumetric contents: SOIL, ICE, WATER, WATER_PREF, AIR (1)
 		double h;                  ///< capillary pressure head (m)
 		mio::Array2D<double> conc; ///< Concentration for chemical constituents in (kg m-3)
-		std::vector<double> k;     ///< For example, heat conductivity of TEMPERATURE field (W m-1 K-1)
+		double k[N_SN_FIELDS];     ///< For example, heat conductivity of TEMPERATURE field (W m-1 K-1)
 		//   Stored in order to visualize constitutive laws
 		//   Will be used for creep field hydraulic conductivity in m3 s kg-1
-		std::vector<double> c;     ///< For example, specific heat of TEMPERATURE field (J kg-1 K-1)
+		double c[N_SN_FIELDS];     ///< For example, specific heat of TEMPERATURE field (J kg-1 K-1)
 		//   Will also be used for creep specific snow water capacity  in m3 J-1
-		std::vector<double> soil;  ///< Contains the heat conductivity, capacity and dry density of the soil (solid, non-ice)  component phase
+		double soil[N_SOIL_FIELDS]; ///< Contains the heat conductivity, capacity and dry density of the soil (solid, non-ice)  component phase
 		double Rho;                ///< mean element density (or BULK density; kg m-3), that is, rho=M/V=sum( theta(i)*rho(i) )
 		double M;                  ///< the total mass of the element (kg m-2)
 		double sw_abs;             ///< total absorbed shortwave radiation by the element (W m-2)
@@ -671,6 +674,8 @@ class SnowStation {
 		std::vector<NodeData> Ndata;    ///< pointer to nodal data array (e.g. T, z, u, etc..)
 		std::vector<ElementData> Edata; ///< pointer to element data array (e.g. Te, L, Rho, etc..)
 		void *Kt;                   ///< Pointer to pseudo-conductivity and stiffnes matrix
+		void *KtTridiag;            ///< Pointer to the banded pseudo-conductivity and stiffnes matrix (TRIDIAGONAL heat equation solver)
+		std::vector<double> Tsolution; ///< Work space for the solution vectors of the heat equation (U, dU and ddU, 3*nNodes)
 		double ColdContent;         ///< Cold content of snowpack (J m-2)
 		double ColdContentSoil;     ///< Cold content of soil (J m-2)
 		double dIntEnergy;          ///< Internal energy change of snowpack (J m-2)
@@ -56,6 +56,7 @@ bool SnowpackConfig::initStaticData()
 	advancedConfig["FORCE_RH_WATER"] = "true";
 	advancedConfig["FORCE_ADD_SNOWFALL"] = "false";
 	advancedConfig["HARDNESS_PARAMETERIZATION"] = "MONTI";
+	advancedConfig["HEAT_EQUATION_SOLVER"] = "TRIDIAGONAL";
 	advancedConfig["HEIGHT_NEW_ELEM"] = "0.02";
 	advancedConfig["HN_DENSITY"] = "PARAMETERIZED";
 	advancedConfig["HN_DENSITY_FIXEDVALUE"] = "100.";
@@ -80,6 +80,30 @@ void Snowpack::EL_RGT_ASSEM(double F[], const int Ie[], const double Fe[]) {
 	F[Ie[1]] += Fe[1];
 }
 
+/**
+ * @brief Assemble an element matrix into the global pseudo-conductivity matrix of the heat equation,
+ * using either the sparse or the tridiagonal solver (see HEAT_EQUATION_SOLVER)
+ */
+void Snowpack::assembleTemperatureMatrix(SnowStation& Xdata, const int& nEq, int Eq[], const int& Dim, const double *ElMat) const
+{
+	if (heat_solver == HEAT_SOLVER_TRIDIAGONAL)
+		td_AssembleMatrix((SD_TRIDIAG_MATRIX_DATA*)Xdata.KtTridiag, nEq, Eq, Dim, ElMat);
+	else
+		ds_AssembleMatrix((SD_MATRIX_DATA*)Xdata.Kt, nEq, Eq, Dim, ElMat);
+}
+
+/**
+ * @brief Call the linear solver of the heat equation (see HEAT_EQUATION_SOLVER) with the given functionality code
+ * @return false whenever the solve failed
+ */
+bool Snowpack::solveTemperatureMatrix(const SD_MATRIX_WHAT& Code, SnowStation& Xdata, double *pX) const
+{
+	if (heat_solver == HEAT_SOLVER_TRIDIAGONAL)
+		return td_Solve(Code, (SD_TRIDIAG_MATRIX_DATA*)Xdata.KtTridiag, pX);
+	else
+		return ds_Solve(Code, (SD_MATRIX_DATA*)Xdata.Kt, pX);
+}
+
 /************************************************************
  * non-static section                                       *
  ************************************************************/
@@ -98,7 +122,7 @@ Snowpack::Snowpack(const SnowpackConfig& i_cfg)
             soil_flux(false), useSoilLayers(false), useNewPhaseChange(false), combine_elements(false), reduce_n_elements(0), force_add_snowfall(false), max_simulated_hs(-1.),
             change_bc(false), meas_tss(false), vw_dendricity(false),
             enhanced_wind_slab(false), snow_erosion("NONE"), alpine3d(false), ageAlbedo(true), soot_ppmv(0.), adjust_height_of_meteo_values(true), advective_heat(false), heat_begin(0.), heat_end(0.),
-            temp_index_degree_day(0.), temp_index_swr_factor(0.), forestfloor_alb(false), rime_index(false), newsnow_lwc(false), read_dsm(false), soil_evaporation(EVAP_RELATIVE_HUMIDITY)
+            temp_index_degree_day(0.), temp_index_swr_factor(0.), forestfloor_alb(false), rime_index(false), newsnow_lwc(false), read_dsm(false), soil_evaporation(EVAP_RELATIVE_HUMIDITY), heat_solver(HEAT_SOLVER_TRIDIAGONAL)
 {
 	cfg.getValue("FORCING", "Snowpack", forcing);
 	cfg.getValue("ALPINE3D", "SnowpackAdvanced", alpine3d);
@@ -325,6 +349,17 @@ Snowpack::Snowpack(const SnowpackConfig& i_cfg)
 
 	// Soot/impurity in ppmv for albedo caclulations
 	cfg.getValue("SOOT_PPMV", "SnowpackAdvanced", soot_ppmv);
+
+	// Linear solver for the heat equation
+	std::string heat_equation_solver;
+	cfg.getValue("HEAT_EQUATION_SOLVER", "SnowpackAdvanced", heat_equation_solver);
+	if (heat_equation_solver=="TRIDIAGONAL") {
+		heat_solver = HEAT_SOLVER_TRIDIAGONAL;
+	} else if (heat_equation_solver=="SPARSE") {
+		heat_solver = HEAT_SOLVER_SPARSE;
+	} else {
+		throw IOException("Unknown value for key HEAT_EQUATION_SOLVER in [SnowpackAdvanced]. Accepted values are \"TRIDIAGONAL\" and \"SPARSE\".", AT);
+	}
 }
 
 void Snowpack::setUseSoilLayers(const bool& value) { //NOTE is this really needed?
@@ -878,10 +913,9 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 	double Se[N_OF_INCIDENCES][N_OF_INCIDENCES]; // Element stiffnes matrix
 	double Fe[N_OF_INCIDENCES];                  // Element right hand side vector
 
-	double *U=NULL, *dU=NULL, *ddU=NULL;         // Solution vectors
+	double *U=NULL, *dU=NULL, *ddU=NULL;         // Solution vectors (stored in Xdata.Tsolution)
 
 	// Dereference the pointers
-	void *Kt = Xdata.Kt;
 	vector<NodeData>& NDS = Xdata.Ndata;
 	vector<ElementData>& EMS = Xdata.Edata;
 
@@ -933,56 +967,50 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 		return true;
 	}
 
-	if (Kt != NULL)
-		ds_Solve(ReleaseMatrixData, (SD_MATRIX_DATA*)Kt, 0);
-	ds_Initialize(static_cast<int>(nN), (SD_MATRIX_DATA**)&Kt);
-	/*
-	 * Define the structure of the matrix, i.e. its connectivity. For each element
-	 * we compute the element incidences and pass the incidences to the solver.
-	 * The solver assumes that the element incidences build a crique, i.e. the
-	 * equations specified by the incidence set are all connected to each other.
-	 * Initialize element data.
-	*/
-	for (int e = 0; e < static_cast<int>(nE); e++) {
-		int Nodes[2] = {e, e+1};
-		ds_DefineConnectivity( (SD_MATRIX_DATA*)Kt, 2, Nodes , 1, 0 );
-	}
+	if (heat_solver == HEAT_SOLVER_TRIDIAGONAL) {
+		/*
+		 * The elements form a 1D chain of 2-node elements, so the matrix is always tridiagonal:
+		 * its structure is known in advance and there is no need for a symbolic factorization.
+		 * The matrix data is kept in Xdata and only reallocated when the number of nodes grows.
+		*/
+		td_Initialize(static_cast<int>(nN), (SD_TRIDIAG_MATRIX_DATA**)&Xdata.KtTridiag);
+	} else {
+		void *Kt = Xdata.Kt;
+		if (Kt != NULL)
+			ds_Solve(ReleaseMatrixData, (SD_MATRIX_DATA*)Kt, 0);
+		ds_Initialize(static_cast<int>(nN), (SD_MATRIX_DATA**)&Kt);
+		/*
+		 * Define the structure of the matrix, i.e. its connectivity. For each element
+		 * we compute the element incidences and pass the incidences to the solver.
+		 * The solver assumes that the element incidences build a crique, i.e. the
+		 * equations specified by the incidence set are all connected to each other.
+		 * Initialize element data.
+		*/
+		for (int e = 0; e < static_cast<int>(nE); e++) {
+			int Nodes[2] = {e, e+1};
+			ds_DefineConnectivity( (SD_MATRIX_DATA*)Kt, 2, Nodes , 1, 0 );
+		}
 
-	/*
-	 * Perform the symbolic factorization. By specifying the element incidences, we
-	 * have simply declared which coefficients of the global matrix are not zero.
-	 * However, when we factorize the matrix in a LU form there is some fill-in.
-	 * Coefficients that were zero prior to start the factorization process will
-	 * have a value different from zero thereafter. At this step the solver compute
-	 * exactly how many memory is required to solve the problem and allocate this
-	 * memory in order to store the numerical matrix. Then reallocate all the
-	 * solution vectors.
-	*/
-	ds_Solve(SymbolicFactorize, (SD_MATRIX_DATA*)Kt, 0);
-
-	// Make sure that these vectors are always available for use ....
-	errno=0;
-	U=(double *) realloc(U, nN*sizeof(double));
-	if (errno != 0 || U==NULL) {
-		free(U);
-		prn_msg(__FILE__, __LINE__, "err", Date(), "%s (allocating  solution vector U)", strerror(errno));
-		throw IOException("Runtime error in compTemperatureProfile", AT);
-	}
-	dU=(double *) realloc(dU, nN*sizeof(double));
-	if (errno != 0 || dU==NULL) {
-		free(U); free(dU);
-		prn_msg(__FILE__, __LINE__, "err", Date(), "%s (allocating  solution vector dU)", strerror(errno));
-		throw IOException("Runtime error in compTemperatureProfile", AT);
-	}
-	ddU=(double *) realloc(ddU, nN*sizeof(double));
-	if (errno != 0 || ddU==NULL) {
-		free(U); free(dU); free(ddU);
-		prn_msg(__FILE__, __LINE__, "err", Date(), "%s (allocating  solution vector ddU)", strerror(errno));
-		throw IOException("Runtime error in compTemperatureProfile", AT);
+		/*
+		 * Perform the symbolic factorization. By specifying the element incidences, we
+		 * have simply declared which coefficients of the global matrix are not zero.
+		 * However, when we factorize the matrix in a LU form there is some fill-in.
+		 * Coefficients that were zero prior to start the factorization process will
+		 * have a value different from zero thereafter. At this step the solver compute
+		 * exactly how many memory is required to solve the problem and allocate this
+		 * memory in order to store the numerical matrix.
+		*/
+		ds_Solve(SymbolicFactorize, (SD_MATRIX_DATA*)Kt, 0);
+
+		// Make sure that the global data structures know where the pointer is for the next integration step after the reallocation ....
+		Xdata.Kt = Kt;
 	}
 
-	// Make sure that the global data structures know where the pointers are for the next integration step after the reallocation ....
-	Xdata.Kt = Kt;
+	// Make sure that the solution vectors are always available for use, they are only reallocated when the number of nodes grows
+	Xdata.Tsolution.resize(3*nN);
+	U = &Xdata.Tsolution[0];
+	dU = &Xdata.Tsolution[nN];
+	ddU = &Xdata.Tsolution[2*nN];
 
 	// Set the temperature at the snowpack base to the prescribed value.
 	// This only in case the soil_flux is not used.
@@ -1037,7 +1065,6 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 				prn_msg(__FILE__, __LINE__, "err", Mdata.date, "Temperature out of bound at beginning of iteration!");
 				prn_msg(__FILE__, __LINE__, "msg", Date(), "At node n=%d (nN=%d, SoilNode=%d): T=%.2lf", n, nN, Xdata.SoilNode, U[n]);
 
-				free(U); free(dU); free(ddU);
 				throw IOException("Runtime error in compTemperatureProfile", AT);
 			}
 		}
@@ -1070,7 +1097,7 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 	do {
 		iteration++;
 		// Reset the matrix data and zero out all the increment vectors
-		ds_Solve(ResetMatrixData, (SD_MATRIX_DATA*)Kt, 0);
+		solveTemperatureMatrix(ResetMatrixData, Xdata, 0);
 		for (size_t n = 0; n < nN; n++) {
 			ddU[n] = dU[n];
 			dU[n] = 0.0;
@@ -1162,10 +1189,9 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 				prn_msg(__FILE__, __LINE__, "msg+", Mdata.date, "Error in sn_ElementKtMatrix @ element %d:", e);
 				for (size_t n = 0; n < nN; n++)
 					fprintf(stdout, "U[%u]=%g K\n", (unsigned int)n, U[n]);
-				free(U); free(dU); free(ddU);
 				throw IOException("Runtime error in compTemperatureProfile", AT);
 			}
-			ds_AssembleMatrix( (SD_MATRIX_DATA*)Kt, 2, Ie, 2,  (double*) Se );
+			assembleTemperatureMatrix(Xdata, 2, Ie, 2, (double*) Se);
 			EL_RGT_ASSEM( dU, Ie, Fe );
 		}
 
@@ -1180,7 +1206,7 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 			EL_INCID(static_cast<int>(nE-1), Ie);
 			EL_TEMP(Ie, T0, TN, NDS, U);
 			neumannBoundaryConditions(Mdata, Bdata, Xdata, T0[1], TN[1], Se, Fe);
-			ds_AssembleMatrix( (SD_MATRIX_DATA*)Kt, 2, Ie, 2,  (double*) Se );
+			assembleTemperatureMatrix(Xdata, 2, Ie, 2, (double*) Se);
 			EL_RGT_ASSEM( dU, Ie, Fe );
 		}
 
@@ -1189,7 +1215,7 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 			// Dirichlet BC at surface: prescribed temperature value
 			// NOTE Insert Big at this location to hold the temperature constant at the prescribed value.
 			Ie[0] = static_cast<int>(nE);
-			ds_AssembleMatrix((SD_MATRIX_DATA*) Kt, 1, Ie, 1, &Big);
+			assembleTemperatureMatrix(Xdata, 1, Ie, 1, &Big);
 		}
 		// Bottom node
 		if (soil_flux && variant != "SEAICE") {
@@ -1197,7 +1223,7 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 			EL_INCID(0, Ie);
 			EL_TEMP(Ie, T0, TN, NDS, U);
 			neumannBoundaryConditionsSoil(Bdata.qg, T0[1], Se, Fe);
-			ds_AssembleMatrix((SD_MATRIX_DATA*)Kt, 2, Ie, 2, (double*) Se);
+			assembleTemperatureMatrix(Xdata, 2, Ie, 2, (double*) Se);
 			EL_RGT_ASSEM(dU, Ie, Fe);
 		} else if ((Xdata.getNumberOfElements() < 3) && (Xdata.Edata[0].theta[WATER] >= 0.9 * Xdata.Edata[0].res_wat_cont)) {
 			dU[0] = 0.;
@@ -1205,7 +1231,7 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 			// Dirichlet BC at bottom: prescribed temperature value
 			// NOTE Insert Big at this location to hold the temperature constant at the prescribed value.
 			Ie[0] = 0;
-			ds_AssembleMatrix((SD_MATRIX_DATA*) Kt, 1, Ie, 1, &Big);
+			assembleTemperatureMatrix(Xdata, 1, Ie, 1, &Big);
 		}
 
 		/*
@@ -1214,7 +1240,7 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 		 * the solution of the system of equations, the new temperature.
 		 * It will throw an exception whenever the linear solver failed
 		 */
-		if (!ds_Solve(ComputeSolution, (SD_MATRIX_DATA*) Kt, dU)) {
+		if (!solveTemperatureMatrix(ComputeSolution, Xdata, dU)) {
 			  prn_msg(__FILE__, __LINE__, "err", Mdata.date,
 			  "Linear solver failed to solve for dU on the %d-th iteration.",
 			  iteration);
@@ -1269,7 +1295,6 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 				prn_msg(__FILE__, __LINE__, "msg", Date(),
 				        "Latent: %lf  Sensible: %lf  Rain: %lf  NetLong:%lf  NetShort: %lf",
 				        Bdata.ql, Bdata.qs, Bdata.qr, Bdata.lw_net, I0);
-				free(U); free(dU); free(ddU);
 				throw IOException("Runtime error in compTemperatureProfile", AT);
 			} else {
 				TempEqConverged = false;	// Set return value of function
@@ -1351,7 +1376,6 @@ bool Snowpack::compTemperatureProfile(const CurrentMeteo& Mdata, SnowStation& Xd
 			EMS[e].gradT = (NDS[e+1].T - NDS[e].T) / EMS[e].L;
 		}
 	}
-	free(U); free(dU); free(ddU);
 	if(useNewPhaseChange) {
 		// Ensure that when top element consists of ice, its upper node does not exceed melting temperature
 		// This is to have consistent surface energy balance calculation and for having good looking output
@@ -32,6 +32,7 @@
 #include <snowpack/TechnicalSnow.h>
 #include <snowpack/snowpackCore/Metamorphism.h>
 #include <snowpack/snowpackCore/PhaseChange.h>
+#include <snowpack/snowpackCore/Solver.h>
 
 #include <meteoio/MeteoIO.h>
 #include <vector>
@@ -77,6 +78,16 @@ class Snowpack {
 			EVAP_NONE
 		} soil_evap_model;
 
+		/**
+		 * @brief Linear solver used for the heat equation: the general sparse solver (SPARSE) or the
+		 * dedicated solver for tridiagonal matrices (TRIDIAGONAL) that does not redo the symbolic
+		 * factorization and reuses its workspace from one call to the next.
+		 */
+		typedef enum HEAT_SOLVER {
+			HEAT_SOLVER_SPARSE,
+			HEAT_SOLVER_TRIDIAGONAL
+		} heat_solver_type;
+
 		double getParameterizedAlbedo(const SnowStation& Xdata,
 		                              const CurrentMeteo& Mdata) const;
 		double getModelAlbedo(const SnowStation& Xdata, CurrentMeteo& Mdata) const;
@@ -94,6 +105,9 @@ class Snowpack {
 		static void EL_TEMP( const int Ie[], double Te0[], double Tei[], const std::vector<NodeData> &T0, const double Ti[] );
 		static void EL_RGT_ASSEM(double F[], const int Ie[], const double Fe[]);
 
+		void assembleTemperatureMatrix(SnowStation& Xdata, const int& nEq, int Eq[], const int& Dim, const double *ElMat) const;
+		bool solveTemperatureMatrix(const SD_MATRIX_WHAT& Code, SnowStation& Xdata, double *pX) const;
+
 		void compSnowCreep(const CurrentMeteo& Mdata, SnowStation& Xdata, SurfaceFluxes& Sdata);
 
 		bool sn_ElementKtMatrix(ElementData &Edata, double dt, const double dvdz, double T0[ N_OF_INCIDENCES ],
@@ -170,6 +184,7 @@ class Snowpack {
 		bool forestfloor_alb;
 		bool rime_index, newsnow_lwc, read_dsm;
 		soil_evap_model soil_evaporation;
+		heat_solver_type heat_solver;
 }; //end class Snowpack
 
 #endif
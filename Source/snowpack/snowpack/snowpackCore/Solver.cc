@@ -13,6 +13,7 @@
 #include <cstdlib>
 #include <cmath>
 #include <cstring> //for memset
+#include <algorithm> //for fill
 #include <math.h> //for isnan
 
 #ifdef __clang__
@@ -26,7 +27,8 @@
 #pragma GCC diagnostic ignored "-Wconversion"
 #endif
 
-static bool gd_MemErr;
+//set by GD_MALLOC and GD_REALLOC, one flag per thread since several solvers can run in parallel
+static thread_local bool gd_MemErr = false;
 
 typedef struct  {
 	int *pC0, *pSize;
@@ -1924,6 +1926,109 @@ int ds_DefineConnectivity(SD_MATRIX_DATA *pMat0, const int& nEq, int Eq[], const
 
 }  // ds_DefineConnectivity
 
+/*
+ * TRIDIAGONAL SOLVER
+ * For 1D chains of 2-node elements the matrix is always tridiagonal, so that there is no need
+ * to compute its connectivity, ordering and fill-in: it is directly stored by diagonals and
+ * factorized with the Thomas algorithm (no pivoting, as for the sparse solver above).
+ */
+int td_Initialize(const int& MatDim, SD_TRIDIAG_MATRIX_DATA **ppMat)
+{
+	if ( MatDim < 1 ) {
+		USER_ERROR("The dimension of a tridiagonal matrix must be at least 1");
+	}
+
+	SD_TRIDIAG_MATRIX_DATA *pMat = *ppMat;
+	if ( pMat == NULL ) {
+		pMat = new SD_TRIDIAG_MATRIX_DATA;
+		*ppMat = pMat;
+	}
+
+	pMat->nEq = MatDim;
+	//resizing below the current capacity does not reallocate
+	pMat->Diag.assign(MatDim, 0.);
+	pMat->Upper.assign(MatDim, 0.);
+	pMat->Pivot.assign(MatDim, 0.);
+
+	return 0;
+
+}  /* td_Initialize */
+
+int td_AssembleMatrix(SD_TRIDIAG_MATRIX_DATA *pMat, const int& nEq, int Eq[], const int& Dim, const double *ElMat)
+{
+	for (int Row = 0; Row < nEq; Row++) {
+		const int i = Eq[Row];
+		for (int Col = 0; Col < nEq; Col++) {
+			const int j = Eq[Col];
+			if ( j < i ) {
+				continue;
+			}
+			const double value = ( Row<Col )? ElMat[ Row*Dim + Col ] : ElMat[ Col*Dim + Row ];
+			if ( j == i ) {
+				pMat->Diag[i] += value;
+			} else if ( j == i+1 ) {
+				pMat->Upper[i] += value;
+			} else {
+				ERROR_SOLVER("Element equations are not compatible with a tridiagonal matrix");
+			}
+		}
+	}
+	return 0;
+
+}  /* td_AssembleMatrix */
+
+bool td_Solve(const SD_MATRIX_WHAT& Code, SD_TRIDIAG_MATRIX_DATA *pMat, double *X)
+{
+	bool success = true;
+	const int n = pMat->nEq;
+	const double *Diag = &pMat->Diag[0];
+	const double *Upper = &pMat->Upper[0];
+	double *Pivot = &pMat->Pivot[0];
+
+	// SymbolicFactorize: nothing to do, the structure of the matrix is known
+
+	// NumericFactorize: [A] = [L][D][L]^T with L[i][i-1] = A[i-1][i] / D[i-1]
+	if ( Code & NumericFactorize ){
+		Pivot[0] = Diag[0];
+		if ( Pivot[0] == 0. ) return false;
+		for (int i = 1; i < n; i++) {
+			Pivot[i] = Diag[i] - Upper[i-1] * Upper[i-1] / Pivot[i-1];
+			if ( Pivot[i] == 0. ) return false;
+		}
+	}
+
+	// BackForwardSubst
+	if ( Code & BackForwardSubst ){
+		for (int i = 1; i < n; i++) {
+			X[i] -= Upper[i-1] / Pivot[i-1] * X[i-1];
+		}
+		X[n-1] /= Pivot[n-1];
+		for (int i = n-1; i > 0; i--) {
+			X[i-1] = (X[i-1] - Upper[i-1] * X[i]) / Pivot[i-1];
+		}
+
+		// Check for NaN
+		success = !std::isnan(X[0]);
+	}
+
+	// ResetMatrixData
+	if ( Code & ResetMatrixData ){
+		if ( Code != ResetMatrixData ){
+			USER_ERROR("You cannot reset the matrix together with other operations");
+		}
+		std::fill(pMat->Diag.begin(), pMat->Diag.end(), 0.);
+		std::fill(pMat->Upper.begin(), pMat->Upper.end(), 0.);
+	}
+
+	// ReleaseMatrixData
+	if ( Code & ReleaseMatrixData ){
+		delete pMat;
+	}
+
+	return success;
+
+}  /* td_Solve */
+
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
@@ -24,6 +24,7 @@
 #define  SOLVER_H
 
 #include <cstddef> //needed for int
+#include <vector>
 
 /**
  * @file Solver.h
@@ -319,4 +320,52 @@ bool ds_Solve(const SD_MATRIX_WHAT& Code, SD_MATRIX_DATA *pMat, double *pX);
 
 int ReleaseConMatrix( SD_CON_MATRIX_DATA * pMat );
 int ReleaseBlockMatrix( SD_BLOCK_MATRIX_DATA * pMat );
+
+/**
+ * @struct SD_TRIDIAG_MATRIX_DATA
+ * @brief Banded storage for a symmetric tridiagonal matrix [A], as produced by a 1D chain of
+ * 2-node finite elements. Since the connectivity of such a matrix is known in advance, there is
+ * no symbolic factorization, no fill-in and no permutation: the matrix is factorized as
+ * [A] = [L][D][L]^T with the Thomas algorithm. The vectors are only reallocated when the
+ * matrix grows beyond their capacity, so the same data can be reused from one call to the next.
+ */
+typedef struct
+{
+	int                 nEq;    ///< dimension of the matrix [A]
+	std::vector<double> Diag;   ///< main diagonal A[i][i]
+	std::vector<double> Upper;  ///< first upper diagonal A[i][i+1] (== A[i+1][i])
+	std::vector<double> Pivot;  ///< diagonal [D] of the factorized matrix
+} SD_TRIDIAG_MATRIX_DATA;
+
+/**
+ * @brief Equivalent of ds_Initialize() for tridiagonal matrices. If *ppMat is NULL, a new matrix
+ * is allocated, otherwise the existing one is resized to MatDim and its coefficients are reset.
+ * There is no need to define the connectivity nor to call td_Solve(SymbolicFactorize, ...).
+ * @param MatDim dimension of the matrix [A]
+ * @param ppMat A pointer to the tridiagonal matrix data
+ */
+int td_Initialize( const int& MatDim, SD_TRIDIAG_MATRIX_DATA **ppMat );
+
+/**
+ * @brief Equivalent of ds_AssembleMatrix() for tridiagonal matrices. As for the symmetric
+ * sparse solver, only the upper triangular part of [ElMat] is used. The element equations must
+ * be at most one apart from each other, otherwise the matrix would not be tridiagonal and an
+ * error is returned.
+ * @param [in] pMat pointer to the matrix [A] returned by td_Initialize()
+ * @param [in] nEq no. of equations for one element forming a crique
+ * @param [in] Eq Element list of equations for one element.
+ * @param [in] Dim first dimension of the 2D-array ElMat[][Dim]
+ * @param [in] ElMat element square matrix to be assembled in the matrix [A]
+ */
+int td_AssembleMatrix( SD_TRIDIAG_MATRIX_DATA *pMat, const int& nEq, int Eq[], const int& Dim, const double *ElMat );
+
+/**
+ * @brief Equivalent of ds_Solve() for tridiagonal matrices, accepting the same codes.
+ * SymbolicFactorize is a no-op and ReleaseMatrixData deletes the matrix data.
+ * @param [in] Code functionlaity code defined above
+ * @param [in] pMat pointer to the matrix [A] returned by td_Initialize()
+ * @param [in] pX right hand side vector {B} to be overwritten by the solution vector {X}:  B[i] := X[i]
+ * @param [out] return false whenever the factorization met a zero pivot or the solve produced NaNs
+ */
+bool td_Solve(const SD_MATRIX_WHAT& Code, SD_TRIDIAG_MATRIX_DATA *pMat, double *pX);
 #endif
@@ -9,6 +9,7 @@ using namespace mio;
 
 // Forward declarations
 void EL_INCID(const size_t &e, int Ie[]);
+void checkSolution(const Matrix& x, const vector<double>& dU, const string& testname);
 
 // PARAMETERS
 const double tol_inf = 1e-6;  // Tolerance for the infinite-norm error
@@ -41,6 +42,7 @@ int main(int argc, char *argv[]) {
   /* General memory allocations and declarations */
   // The FEM discretization uses 1D elements with two nodes
   void *Kt = NULL;
+  SD_TRIDIAG_MATRIX_DATA *KtTridiag = NULL;
   int Ie[2];
   double Se[2][2];
 
@@ -110,6 +112,7 @@ int main(int argc, char *argv[]) {
     ds_DefineConnectivity((SD_MATRIX_DATA*) Kt, 2, Nodes, 1, 0);
   }
   ds_Solve(SymbolicFactorize, (SD_MATRIX_DATA*) Kt, 0);
+  td_Initialize(nN, &KtTridiag);
 
   /* Filling matrix A and compute RHS */
   Matrix A(nN, nN);
@@ -125,6 +128,7 @@ int main(int argc, char *argv[]) {
   diag1.pop_back();
 
   ds_AssembleMatrix((SD_MATRIX_DATA*) Kt, 2, Ie, 2, (double*) Se);
+  td_AssembleMatrix(KtTridiag, 2, Ie, 2, (double*) Se);
 
   // Last entry of solution vector
   x(nE + 1, 1) = sol.back();
@@ -140,6 +144,7 @@ int main(int argc, char *argv[]) {
     diag1.pop_back();
     Se[1][1] = 0.0;
     ds_AssembleMatrix((SD_MATRIX_DATA*) Kt, 2, Ie, 2, (double*) Se);
+    td_AssembleMatrix(KtTridiag, 2, Ie, 2, (double*) Se);
 
     x(e + 1, 1) = sol.back();
     sol.pop_back();
@@ -156,6 +161,17 @@ int main(int argc, char *argv[]) {
     dU.push_back(b(i, 1));
   }
 
+  // Solve with the tridiagonal solver of solver.h
+  if (!rankDeficient) {
+    vector<double> dUt(dU);
+    if (!td_Solve(ComputeSolution, KtTridiag, dUt.data())) {
+      cerr << "Matrix from " << testname << " could not be inverted by the tridiagonal solver" << endl;
+      exit(1);
+    }
+    checkSolution(x, dUt, testname + " (tridiagonal solver)");
+  }
+  td_Solve(ReleaseMatrixData, KtTridiag, 0);
+
   // Solve with solver.h
   if (ds_Solve(ComputeSolution, (SD_MATRIX_DATA*) Kt, dU.data())) {
     if (!rankDeficient) {  // Testing solver behavior if matrix is rank deficient!
@@ -166,14 +182,28 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  checkSolution(x, dU, testname);
+
+  return 0;
+}
+
+void EL_INCID(const size_t &e, int Ie[]) {
+  Ie[0] = static_cast<int>(e);
+  Ie[1] = static_cast<int>(e + 1);
+
+}
+
+/**
+ * @brief Compare the computed solution dU against the exact solution x, exit on failure
+ */
+void checkSolution(const Matrix& x, const vector<double>& dU, const string& testname) {
   // Retrieve result and for nan value
   Matrix xStar(dU.size(), (size_t) 1);
   size_t j = 1;
-  for (vector<double>::iterator it = dU.begin(); it != dU.end(); it++) {
+  for (vector<double>::const_iterator it = dU.begin(); it != dU.end(); it++) {
     xStar(j++, 1) = *(it);
   }
 
-
   /* Result comparison */
   // 2-norm and maximum/infinite norm
   Matrix error = x - xStar;
@@ -194,12 +224,4 @@ int main(int argc, char *argv[]) {
          << "\n- 2-norm: " << norm_error_2 << " > " << tol_2 << "\n";
     exit(1);
   }
-
-  return 0;
-}
-
-void EL_INCID(const size_t &e, int Ie[]) {
-  Ie[0] = static_cast<int>(e);
-  Ie[1] = static_cast<int>(e + 1);
-
 }